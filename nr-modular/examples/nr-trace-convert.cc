@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Binary Output Converter
+ *
+ * Prints the binary files of a run as text:
+ * - DCI / TB / RLC traces (metrics.binaryTraces, *.nrtrace): tab-separated,
+ *   one line per record, with the column names of the 5G-LENA text traces
+ * - columnar results (*.nrcol, plain or compressed): tab-separated, a
+ *   header line of column names, then one line per row
+ * - telemetry recordings (*.telemetry.nrz): the recorded JSON states,
+ *   one per line
+ *
+ * The format is recognised from the file's magic bytes.
+ *
+ * Run with:
+ *   ./ns3 run "nr-trace-convert --input=results.json.tb.nrtrace"
+ *   ./ns3 run "nr-trace-convert --input=results.json.dci.nrtrace --output=dci.txt"
+ *   ./ns3 run "nr-trace-convert --input=results.ue.nrcol --output=ue.tsv"
+ *   ./ns3 run "nr-trace-convert --input=results.json.telemetry.nrz"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/nr-binary-trace.h"
+#include "ns3/nr-block-codec.h"
+#include "ns3/nr-columnar-writer.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * \brief Print the records of a compressed log as they were appended
+ * \param path Compressed log file
+ * \param os Output
+ * \param error Reason on failure
+ * \return false if the file is unreadable or damaged
+ */
+bool
+PrintLogRecords(const std::string& path, std::ostream& os, std::string* error)
+{
+    bool ok = NrCompressedLog::ForEachBlock(path, [&os](const uint8_t* data, size_t size) {
+        os.write(reinterpret_cast<const char*>(data), size);
+        return static_cast<bool>(os);
+    });
+    if (!ok)
+    {
+        *error = "unreadable or damaged file";
+    }
+    return ok;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output = "-";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("input", "Binary file (*.nrtrace, *.nrcol, *.telemetry.nrz)", input);
+    cmd.AddValue("output", "Text file (- = stdout)", output);
+    cmd.Parse(argc, argv);
+
+    if (input.empty())
+    {
+        std::cerr << "✗ --input is required" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (output != "-")
+    {
+        file.open(output);
+        if (!file)
+        {
+            std::cerr << "✗ Cannot create " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = (output == "-") ? std::cout : file;
+
+    // NRCOL...: columnar results; NRZLOG..: trace or telemetry log
+    char magic[8] = {};
+    std::ifstream probe(input, std::ios::binary);
+    probe.read(magic, sizeof(magic));
+    bool columnar = std::memcmp(magic, "NRCOL", 5) == 0;
+    bool trace = input.size() >= 8 && input.compare(input.size() - 8, 8, ".nrtrace") == 0;
+
+    std::string error;
+    bool ok = columnar ? NrColumnarReader::ConvertToText(input, os, &error)
+              : trace  ? NrBinaryTrace::ConvertToText(input, os, &error)
+                       : PrintLogRecords(input, os, &error);
+    if (!ok)
+    {
+        std::cerr << "✗ " << input << ": " << error << std::endl;
+        return 1;
+    }
+    return 0;
+}
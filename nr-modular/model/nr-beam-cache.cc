@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Beam Cache - Implementation File
+ */
+
+#include "nr-beam-cache.h"
+
+#include "utils/nr-sim-config.h"
+
+#include "ns3/abort.h"
+#include "ns3/beamforming-vector.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/nr-spectrum-phy.h"
+#include "ns3/pointer.h"
+#include "ns3/uniform-planar-array.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrBeamCache");
+NS_OBJECT_ENSURE_REGISTERED(NrBeamCache);
+NS_OBJECT_ENSURE_REGISTERED(NrCachedDirectPathBeamforming);
+
+// ============================================================================
+// BEAM CACHE
+// ============================================================================
+
+TypeId
+NrBeamCache::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrBeamCache")
+                            .SetParent<Object>()
+                            .SetGroupName("NrModular")
+                            .AddConstructor<NrBeamCache>();
+    return tid;
+}
+
+NrBeamCache::NrBeamCache()
+    : m_angleStep(0.0),
+      m_logDistanceStep(0.0),
+      m_moveThreshold(0.0)
+{
+    NS_LOG_FUNCTION(this);
+    NrSimConfig::ChannelParams::BeamformingParams defaults;
+    SetQuantization(defaults.cacheAngleStep,
+                    defaults.cacheDistanceStep,
+                    defaults.cacheMoveThreshold);
+
+    NrMetricsRegistry& registry = NrMetricsRegistry::Get();
+    m_hitMetric = registry.GetCounter("nr_beam_cache_lookups_total",
+                                      "Beamforming vector requests",
+                                      "result=\"hit\"");
+    m_missMetric = registry.GetCounter("nr_beam_cache_lookups_total",
+                                       "Beamforming vector requests",
+                                       "result=\"miss\"");
+}
+
+NrBeamCache::~NrBeamCache()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrBeamCache::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_entries.clear();
+    Object::DoDispose();
+}
+
+void
+NrBeamCache::SetConfig(const Ptr<NrSimConfig>& config)
+{
+    NS_ABORT_MSG_IF(config == nullptr, "NrBeamCache: config cannot be null");
+    const auto& beamforming = config->channel.beamforming;
+    SetQuantization(beamforming.cacheAngleStep,
+                    beamforming.cacheDistanceStep,
+                    beamforming.cacheMoveThreshold);
+}
+
+void
+NrBeamCache::SetQuantization(double angleStep, double distanceStep, double moveThreshold)
+{
+    NS_LOG_FUNCTION(this << angleStep << distanceStep << moveThreshold);
+    NS_ABORT_MSG_IF(angleStep <= 0 || distanceStep <= 0 || moveThreshold < 0,
+                    "Beam cache steps must be > 0 and the move threshold >= 0");
+    m_angleStep = angleStep * M_PI / 180.0;
+    m_logDistanceStep = std::log1p(distanceStep);
+    m_moveThreshold = moveThreshold;
+    m_entries.clear();
+}
+
+NrBeamCache::GeometryKey
+NrBeamCache::GetGeometryKey(const Vector& gnbPosition, const Vector& uePosition) const
+{
+    Vector d = uePosition - gnbPosition;
+    double distance = d.GetLength();
+
+    GeometryKey key;
+    key.azimuth = static_cast<int32_t>(std::floor(std::atan2(d.y, d.x) / m_angleStep));
+    key.inclination =
+        distance > 0.0
+            ? static_cast<int32_t>(std::floor(std::acos(d.z / distance) / m_angleStep))
+            : 0;
+    // Buckets below 1 m collapse into one
+    key.distance = static_cast<int32_t>(
+        std::floor(std::log(std::max(distance, 1.0)) / m_logDistanceStep));
+    return key;
+}
+
+BeamformingVectorPair
+NrBeamCache::ComputeBeams(const Ptr<MobilityModel>& gnbMobility,
+                          const Ptr<MobilityModel>& ueMobility,
+                          const Ptr<const UniformPlanarArray>& gnbAntenna,
+                          const Ptr<const UniformPlanarArray>& ueAntenna)
+{
+    // As DirectPathBeamforming: each array steered at the other end
+    BeamformingVector gnbBfv =
+        std::make_pair(CreateDirectPathBfv(gnbMobility, ueMobility, gnbAntenna),
+                       BeamId::GetEmptyBeamId());
+    BeamformingVector ueBfv =
+        std::make_pair(CreateDirectPathBfv(ueMobility, gnbMobility, ueAntenna),
+                       BeamId::GetEmptyBeamId());
+    return std::make_pair(gnbBfv, ueBfv);
+}
+
+BeamformingVectorPair
+NrBeamCache::GetBeams(const Ptr<MobilityModel>& gnbMobility,
+                      const Ptr<MobilityModel>& ueMobility,
+                      const Ptr<const UniformPlanarArray>& gnbAntenna,
+                      const Ptr<const UniformPlanarArray>& ueAntenna)
+{
+    m_stats.lookups++;
+
+    PairKey pair{PeekPointer(gnbMobility),
+                 PeekPointer(ueMobility),
+                 PeekPointer(gnbAntenna),
+                 PeekPointer(ueAntenna)};
+    Vector gnbPosition = gnbMobility->GetPosition();
+    Vector uePosition = ueMobility->GetPosition();
+
+    auto it = m_entries.find(pair);
+    if (it != m_entries.end())
+    {
+        Entry& entry = it->second;
+        if (CalculateDistance(entry.uePosition, uePosition) <= m_moveThreshold &&
+            CalculateDistance(entry.gnbPosition, gnbPosition) <= m_moveThreshold)
+        {
+            m_stats.stillHits++;
+            m_hitMetric->Inc();
+            return entry.beams;
+        }
+
+        GeometryKey geometry = GetGeometryKey(gnbPosition, uePosition);
+        entry.gnbPosition = gnbPosition;
+        entry.uePosition = uePosition;
+        if (geometry == entry.geometry)
+        {
+            m_stats.geometryHits++;
+            m_hitMetric->Inc();
+            return entry.beams;
+        }
+        entry.geometry = geometry;
+        entry.beams = ComputeBeams(gnbMobility, ueMobility, gnbAntenna, ueAntenna);
+        m_stats.recomputes++;
+        m_missMetric->Inc();
+        return entry.beams;
+    }
+
+    Entry entry;
+    entry.gnbPosition = gnbPosition;
+    entry.uePosition = uePosition;
+    entry.geometry = GetGeometryKey(gnbPosition, uePosition);
+    entry.beams = ComputeBeams(gnbMobility, ueMobility, gnbAntenna, ueAntenna);
+    m_stats.recomputes++;
+    m_missMetric->Inc();
+    return m_entries.emplace(pair, std::move(entry)).first->second.beams;
+}
+
+void
+NrBeamCache::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_entries.clear();
+}
+
+std::vector<NrMemoryItem>
+NrBeamCache::GetMemoryUsage() const
+{
+    uint64_t bytes = NrMemoryProfiler::HashBytes(m_entries);
+    for (const auto& [pair, entry] : m_entries)
+    {
+        bytes += (entry.beams.first.first.GetSize() + entry.beams.second.first.GetSize()) *
+                 sizeof(std::complex<double>);
+    }
+    return {{"beams", bytes, m_entries.size(), "pairs"}};
+}
+
+void
+NrBeamCache::PrintSummary(std::ostream& os) const
+{
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+    os << "\n========================================\n";
+    os << "BEAM CACHE\n";
+    os << "========================================\n";
+    os << "  Pairs cached:       " << m_entries.size() << "\n";
+    os << "  Beam requests:      " << m_stats.lookups << "\n";
+    os << "  Reused:             " << m_stats.stillHits << " unmoved, " << m_stats.geometryHits
+       << " same geometry (" << m_stats.GetHitRate() * 100.0 << "%)\n";
+    os << "  Computed:           " << m_stats.recomputes << "\n";
+    os << "========================================\n" << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
+// ============================================================================
+// CACHED DIRECT-PATH BEAMFORMING
+// ============================================================================
+
+TypeId
+NrCachedDirectPathBeamforming::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrCachedDirectPathBeamforming")
+            .SetParent<DirectPathBeamforming>()
+            .SetGroupName("NrModular")
+            .AddConstructor<NrCachedDirectPathBeamforming>()
+            .AddAttribute("Cache",
+                          "Beam cache shared by all pairs (none = no caching)",
+                          PointerValue(),
+                          MakePointerAccessor(&NrCachedDirectPathBeamforming::m_cache),
+                          MakePointerChecker<NrBeamCache>());
+    return tid;
+}
+
+BeamformingVectorPair
+NrCachedDirectPathBeamforming::GetBeamformingVectors(
+    const Ptr<NrSpectrumPhy>& gnbSpectrumPhy,
+    const Ptr<NrSpectrumPhy>& ueSpectrumPhy) const
+{
+    if (!m_cache)
+    {
+        return DirectPathBeamforming::GetBeamformingVectors(gnbSpectrumPhy, ueSpectrumPhy);
+    }
+
+    Ptr<const UniformPlanarArray> gnbAntenna =
+        gnbSpectrumPhy->GetAntenna()->GetObject<UniformPlanarArray>();
+    Ptr<const UniformPlanarArray> ueAntenna =
+        ueSpectrumPhy->GetAntenna()->GetObject<UniformPlanarArray>();
+    return m_cache->GetBeams(gnbSpectrumPhy->GetMobility(),
+                             ueSpectrumPhy->GetMobility(),
+                             gnbAntenna,
+                             ueAntenna);
+}
+
+} // namespace ns3
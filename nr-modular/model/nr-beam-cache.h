@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Beam Cache - Header File
+ *
+ * Responsibilities:
+ * - Keep the direct-path beams of every gNB-UE pair (channel.beamforming.cache)
+ * - Reuse them while the pair's quantized geometry is unchanged
+ * - Count reuses and recomputations
+ *
+ * IdealBeamformingHelper asks its algorithm for the beams of every pair
+ * each update period. DirectPathBeamforming steers both arrays at each
+ * other, so its beams depend only on the relative geometry of the pair.
+ * The cache stores them with the geometry key they were computed for:
+ *
+ *   (azimuth bucket, inclination bucket, log-distance bucket)
+ *
+ * of the UE seen from the gNB. On an update:
+ * - neither end moved more than cacheMoveThreshold since the beams were
+ *   stored: reuse them without any trigonometry
+ * - otherwise the key is recomputed; same key: reuse them and re-anchor
+ *   the positions; new key: compute fresh beams
+ *
+ * The pointing error of a reused beam is bounded by about one angle
+ * bucket (nr-beam-cache-benchmark measures the array gain this costs).
+ * Reused beams are bit-identical, so the 3GPP spectrum model can also
+ * keep the beamformed long-term channel of the pair.
+ *
+ * NrCachedDirectPathBeamforming is the BeamformingMethod that consults
+ * the cache; without a cache it behaves as DirectPathBeamforming.
+ */
+
+#ifndef NR_BEAM_CACHE_H
+#define NR_BEAM_CACHE_H
+
+#include "ns3/ideal-beamforming-algorithm.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "utils/nr-memory-profiler.h"
+#include "utils/nr-metrics-registry.h"
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+class NrSimConfig;
+class NrSpectrumPhy;
+class UniformPlanarArray;
+
+/**
+ * \ingroup nr-modular
+ *
+ * \brief Direct-path beams per gNB-UE pair, keyed by quantized geometry
+ */
+class NrBeamCache : public Object
+{
+  public:
+    /**
+     * @brief Get the TypeId
+     * @return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Constructor
+     */
+    NrBeamCache();
+
+    /**
+     * @brief Destructor
+     */
+    ~NrBeamCache() override;
+
+    /**
+     * @brief Set the configuration (channel.beamforming)
+     * @param config Simulation configuration
+     */
+    void SetConfig(const Ptr<NrSimConfig>& config);
+
+    /**
+     * @brief Set the quantization directly
+     * @param angleStep Degrees per azimuth / inclination bucket
+     * @param distanceStep Relative width of a distance bucket (0.25 = 25%)
+     * @param moveThreshold Meters either end may move before the key is checked
+     */
+    void SetQuantization(double angleStep, double distanceStep, double moveThreshold);
+
+    /**
+     * @brief Quantized geometry of a pair
+     */
+    struct GeometryKey
+    {
+        int32_t azimuth = 0;      ///< Azimuth bucket
+        int32_t inclination = 0;  ///< Inclination bucket
+        int32_t distance = 0;     ///< Log-distance bucket
+
+        bool operator==(const GeometryKey& other) const
+        {
+            return azimuth == other.azimuth && inclination == other.inclination &&
+                   distance == other.distance;
+        }
+    };
+
+    /**
+     * @brief Quantize the position of the UE seen from the gNB
+     * @param gnbPosition gNB position
+     * @param uePosition UE position
+     * @return Geometry key
+     */
+    GeometryKey GetGeometryKey(const Vector& gnbPosition, const Vector& uePosition) const;
+
+    /**
+     * @brief Get the beams of a pair, from the cache or freshly computed
+     * @param gnbMobility gNB mobility
+     * @param ueMobility UE mobility
+     * @param gnbAntenna gNB array (one per BWP)
+     * @param ueAntenna UE array (one per BWP)
+     * @return gNB and UE beamforming vectors
+     */
+    BeamformingVectorPair GetBeams(const Ptr<MobilityModel>& gnbMobility,
+                                   const Ptr<MobilityModel>& ueMobility,
+                                   const Ptr<const UniformPlanarArray>& gnbAntenna,
+                                   const Ptr<const UniformPlanarArray>& ueAntenna);
+
+    /**
+     * @brief Compute the direct-path beams of a pair (no caching)
+     * @param gnbMobility gNB mobility
+     * @param ueMobility UE mobility
+     * @param gnbAntenna gNB array
+     * @param ueAntenna UE array
+     * @return gNB and UE beamforming vectors
+     */
+    static BeamformingVectorPair ComputeBeams(const Ptr<MobilityModel>& gnbMobility,
+                                              const Ptr<MobilityModel>& ueMobility,
+                                              const Ptr<const UniformPlanarArray>& gnbAntenna,
+                                              const Ptr<const UniformPlanarArray>& ueAntenna);
+
+    /**
+     * @brief Drop all cached beams (statistics are kept)
+     */
+    void Clear();
+
+    /**
+     * @brief Get the number of cached pairs
+     * @return Entries
+     */
+    size_t GetNumEntries() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * @brief Lookup counters
+     */
+    struct Statistics
+    {
+        uint64_t lookups = 0;       ///< Beam requests
+        uint64_t stillHits = 0;     ///< Reused, neither end moved past the threshold
+        uint64_t geometryHits = 0;  ///< Reused, moved but same geometry key
+        uint64_t recomputes = 0;    ///< New pair or new geometry key
+
+        /**
+         * @brief Get the share of requests served from the cache
+         * @return Fraction in [0, 1]
+         */
+        double GetHitRate() const
+        {
+            return lookups > 0 ? double(stillHits + geometryHits) / lookups : 0.0;
+        }
+    };
+
+    /**
+     * @brief Get the lookup counters
+     * @return Statistics
+     */
+    Statistics GetStatistics() const
+    {
+        return m_stats;
+    }
+
+    /**
+     * @brief Estimate the memory held by the cached beams
+     * @return Container sizes (memory profiler)
+     */
+    std::vector<NrMemoryItem> GetMemoryUsage() const;
+
+    /**
+     * @brief Print the hit rate and the beam computations saved
+     * @param os Output stream
+     */
+    void PrintSummary(std::ostream& os) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * @brief Identity of a pair on one BWP
+     */
+    struct PairKey
+    {
+        const MobilityModel* gnbMobility;      ///< gNB node
+        const MobilityModel* ueMobility;       ///< UE node
+        const UniformPlanarArray* gnbAntenna;  ///< gNB array of the BWP
+        const UniformPlanarArray* ueAntenna;   ///< UE array of the BWP
+
+        bool operator==(const PairKey& other) const
+        {
+            return gnbMobility == other.gnbMobility && ueMobility == other.ueMobility &&
+                   gnbAntenna == other.gnbAntenna && ueAntenna == other.ueAntenna;
+        }
+    };
+
+    /**
+     * @brief Hash of a pair identity
+     */
+    struct PairKeyHash
+    {
+        size_t operator()(const PairKey& key) const
+        {
+            std::hash<const void*> h;
+            size_t seed = h(key.gnbMobility);
+            for (const void* p : {static_cast<const void*>(key.ueMobility),
+                                  static_cast<const void*>(key.gnbAntenna),
+                                  static_cast<const void*>(key.ueAntenna)})
+            {
+                seed ^= h(p) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+
+    /**
+     * @brief Cached beams of a pair
+     */
+    struct Entry
+    {
+        Vector gnbPosition;          ///< gNB position at the last key check
+        Vector uePosition;           ///< UE position at the last key check
+        GeometryKey geometry;        ///< Key the beams were computed for
+        BeamformingVectorPair beams; ///< gNB and UE beams
+    };
+
+    double m_angleStep;                                        ///< Radians per angle bucket
+    double m_logDistanceStep;                                  ///< log(1 + distance step)
+    double m_moveThreshold;                                    ///< Meters
+    std::unordered_map<PairKey, Entry, PairKeyHash> m_entries; ///< Per pair and BWP
+    Statistics m_stats;                                        ///< Lookup counters
+    NrMetricCounter* m_hitMetric;                              ///< Registry: reused beams
+    NrMetricCounter* m_missMetric;                             ///< Registry: computed beams
+};
+
+/**
+ * \ingroup nr-modular
+ *
+ * \brief DirectPathBeamforming served from an NrBeamCache
+ */
+class NrCachedDirectPathBeamforming : public DirectPathBeamforming
+{
+  public:
+    /**
+     * @brief Get the TypeId
+     * @return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Get the beams of a pair (cached when a Cache is set)
+     * @param gnbSpectrumPhy gNB spectrum PHY
+     * @param ueSpectrumPhy UE spectrum PHY
+     * @return gNB and UE beamforming vectors
+     */
+    BeamformingVectorPair GetBeamformingVectors(
+        const Ptr<NrSpectrumPhy>& gnbSpectrumPhy,
+        const Ptr<NrSpectrumPhy>& ueSpectrumPhy) const override;
+
+  private:
+    Ptr<NrBeamCache> m_cache;  ///< Shared cache (attribute "Cache")
+};
+
+} // namespace ns3
+
+#endif /* NR_BEAM_CACHE_H */
@@ -15,6 +15,7 @@
 
 #include <fstream>
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <iomanip>
 
@@ -50,9 +51,27 @@ NrBwpManager::NrBwpManager()
       m_hasLoadedSolution(false),
       m_totalSlots(0),
       m_totalBandwidthPrbs(0),
-      m_numUes(0)
+      m_numUes(0),
+      m_planPrbs(0),
+      m_planSlots(0),
+      m_granularity(1),
+      m_metrics()
 {
     NS_LOG_FUNCTION(this);
+    
+    NrMetricsRegistry& registry = NrMetricsRegistry::Get();
+    m_metrics.plansLoaded = registry.GetCounter("nr_bwp_plans_loaded_total",
+                                                "MILP plans loaded into BWP managers");
+    m_metrics.plannedPrbs = registry.GetCounter("nr_bwp_planned_prb_slots_total",
+                                                "PRB-slots in loaded MILP plans");
+    m_metrics.slotHits = registry.GetCounter("nr_bwp_slot_queries_total",
+                                             "Per-slot plan lookups", "result=\"allocated\"");
+    m_metrics.slotIdle = registry.GetCounter("nr_bwp_slot_queries_total",
+                                             "Per-slot plan lookups", "result=\"idle\"");
+    m_metrics.blockExpansions = registry.GetCounter("nr_bwp_block_expansions_total",
+                                                    "Coarse-plan blocks expanded to slots");
+    m_metrics.unplacedBudget = registry.GetCounter("nr_bwp_block_unplaced_prb_slots_total",
+                                                   "Coarse-plan budget that did not fit its block");
 }
 
 NrBwpManager::~NrBwpManager()
@@ -65,6 +84,11 @@ NrBwpManager::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     ClearSolution();
+    m_ueCell.clear();
+    m_edgeUes.clear();
+    m_cellRestrictions.clear();
+    m_servingCell.clear();
+    m_ueMaxGapSlots.clear();
     Object::DoDispose();
 }
 
@@ -93,6 +117,12 @@ NrBwpManager::LoadMilpSolution(const MilpSolution& solution)
         return false;
     }
     
+    // Coarse plan: index the block budgets, slots are expanded on demand
+    if (!m_solution.budgets.empty())
+    {
+        return LoadBlockBudgets();
+    }
+    
     // Check if solution has allocations
     if (m_solution.allocations.empty())
     {
@@ -143,6 +173,8 @@ NrBwpManager::LoadMilpSolution(const MilpSolution& solution)
     ComputeStatistics();
     
     m_hasLoadedSolution = true;
+    m_metrics.plansLoaded->Inc();
+    m_metrics.plannedPrbs->Inc(m_statistics.totalPrbsAllocated);
     
     NS_LOG_INFO("MILP solution loaded successfully");
     NS_LOG_INFO("Active slots: " << m_statistics.numActiveSlots 
@@ -171,6 +203,466 @@ NrBwpManager::ClearSolution()
     m_totalSlots = 0;
     m_totalBandwidthPrbs = 0;
     m_numUes = 0;
+    m_granularity = 1;
+    m_blockBudgets.clear();
+    m_expandedBlocks.clear();
+    m_lookaheadBlocks.clear();
+    m_unplacedBudget.clear();
+}
+
+bool
+NrBwpManager::LoadBlockBudgets()
+{
+    NS_LOG_FUNCTION(this);
+    
+    if (m_planPrbs == 0)
+    {
+        NS_LOG_ERROR("Coarse MILP solution loaded without SetBlockPlanning()");
+        ClearSolution();
+        return false;
+    }
+    
+    m_granularity = std::max<uint32_t>(1, m_solution.granularitySlots);
+    m_totalBandwidthPrbs = m_planPrbs;
+    
+    uint32_t maxUeId = 0;
+    uint32_t maxBlockId = 0;
+    for (const auto& budget : m_solution.budgets)
+    {
+        if (budget.prbSlots == 0)
+        {
+            continue;
+        }
+        m_blockBudgets[budget.blockId].emplace_back(budget.ueId, budget.prbSlots);
+        maxUeId = std::max(maxUeId, budget.ueId);
+        maxBlockId = std::max(maxBlockId, budget.blockId);
+    }
+    
+    // One entry per UE and block, in UE order (fixes the interleaving)
+    for (auto& [blockId, entries] : m_blockBudgets)
+    {
+        std::sort(entries.begin(), entries.end());
+        std::vector<std::pair<uint32_t, uint32_t>> merged;
+        for (const auto& entry : entries)
+        {
+            if (!merged.empty() && merged.back().first == entry.first)
+            {
+                merged.back().second += entry.second;
+            }
+            else
+            {
+                merged.push_back(entry);
+            }
+        }
+        entries.swap(merged);
+    }
+    
+    m_numUes = maxUeId + 1;
+    m_totalSlots = (m_planSlots > 0) ? m_planSlots : (maxBlockId + 1) * m_granularity;
+    
+    NS_LOG_INFO("Coarse plan: " << m_solution.budgets.size() << " budgets over "
+                << m_blockBudgets.size() << " blocks of " << m_granularity << " slots");
+    
+    if (!ValidateSolution())
+    {
+        NS_LOG_ERROR("Solution validation failed");
+        ClearSolution();
+        return false;
+    }
+    
+    // Expands every block once (not cached) for exact statistics
+    ComputeStatistics();
+    
+    m_hasLoadedSolution = true;
+    m_metrics.plansLoaded->Inc();
+    m_metrics.plannedPrbs->Inc(m_statistics.totalPrbsAllocated);
+    
+    NS_LOG_INFO("MILP solution loaded successfully");
+    return true;
+}
+
+// ============================================================================
+// INTER-CELL COORDINATION
+// ============================================================================
+
+void
+NrBwpManager::SetCellCoordination(const MilpProblem& problem)
+{
+    NS_LOG_FUNCTION(this);
+    
+    m_ueCell.clear();
+    m_edgeUes.clear();
+    m_cellRestrictions.clear();
+    m_servingCell.clear();
+    
+    if (!problem.coordinated)
+    {
+        return;
+    }
+    
+    for (const auto& cell : problem.cells)
+    {
+        for (uint32_t ueId : cell.ueIds)
+        {
+            m_ueCell[ueId] = cell.cellId;
+        }
+        m_edgeUes.insert(cell.edgeUeIds.begin(), cell.edgeUeIds.end());
+    }
+    for (const auto& restriction : problem.prbRestrictions)
+    {
+        m_cellRestrictions[restriction.cellId].push_back(restriction);
+    }
+    
+    NS_LOG_INFO("Cell coordination: " << problem.cells.size() << " cells, "
+                << m_edgeUes.size() << " edge UEs, " << problem.prbRestrictions.size()
+                << " PRB restrictions");
+}
+
+bool
+NrBwpManager::IsCoordinated() const
+{
+    return !m_ueCell.empty();
+}
+
+std::optional<uint32_t>
+NrBwpManager::GetUeCell(uint32_t ueId) const
+{
+    auto it = m_ueCell.find(ueId);
+    if (it == m_ueCell.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void
+NrBwpManager::SetServingCell(uint32_t ueId, uint32_t cellId)
+{
+    NS_LOG_FUNCTION(this << ueId << cellId);
+    
+    auto it = m_ueCell.find(ueId);
+    if (it == m_ueCell.end())
+    {
+        return;
+    }
+    if (it->second == cellId)
+    {
+        m_servingCell.erase(ueId);
+    }
+    else
+    {
+        m_servingCell[ueId] = cellId;
+    }
+}
+
+std::optional<uint32_t>
+NrBwpManager::GetServingCell(uint32_t ueId) const
+{
+    auto it = m_servingCell.find(ueId);
+    if (it != m_servingCell.end())
+    {
+        return it->second;
+    }
+    return GetUeCell(ueId);
+}
+
+bool
+NrBwpManager::IsCellEdgeUe(uint32_t ueId) const
+{
+    return m_edgeUes.count(ueId) > 0;
+}
+
+std::vector<PrbRestriction>
+NrBwpManager::GetPrbRestrictions(uint32_t cellId) const
+{
+    auto it = m_cellRestrictions.find(cellId);
+    if (it == m_cellRestrictions.end())
+    {
+        return {};
+    }
+    return it->second;
+}
+
+// ============================================================================
+// COARSE (BLOCK) PLANS
+// ============================================================================
+
+void
+NrBwpManager::SetBlockPlanning(const MilpProblem& problem)
+{
+    NS_LOG_FUNCTION(this);
+    
+    m_planPrbs = problem.totalBandwidthPrbs;
+    m_planSlots = problem.totalSlots;
+    
+    m_ueMaxGapSlots.clear();
+    for (const auto& ue : problem.ues)
+    {
+        double gap = (problem.slotDuration > 0.0)
+                         ? ue.latencyMs / 1000.0 / problem.slotDuration
+                         : 0.0;
+        m_ueMaxGapSlots[ue.ueId] =
+            std::max<uint32_t>(1, static_cast<uint32_t>(std::floor(gap + 1e-9)));
+    }
+}
+
+bool
+NrBwpManager::IsBlockPlan() const
+{
+    return !m_blockBudgets.empty();
+}
+
+uint64_t
+NrBwpManager::GetUnplacedBudget() const
+{
+    uint64_t total = 0;
+    for (const auto& [blockId, prbSlots] : m_unplacedBudget)
+    {
+        total += prbSlots;
+    }
+    return total;
+}
+
+std::vector<std::vector<PrbAllocation>>
+NrBwpManager::ExpandBlock(uint32_t blockId) const
+{
+    uint32_t firstSlot = blockId * m_granularity;
+    uint32_t numSlots = (firstSlot < m_totalSlots)
+                            ? std::min(m_granularity, m_totalSlots - firstSlot)
+                            : 0;
+    std::vector<std::vector<PrbAllocation>> slots(numSlots);
+    
+    auto bit = m_blockBudgets.find(blockId);
+    if (bit == m_blockBudgets.end() || numSlots == 0)
+    {
+        return slots;
+    }
+    const auto& entries = bit->second;
+    size_t n = entries.size();
+    
+    std::vector<uint32_t> released(n, 0);  // Budget released so far
+    std::vector<uint32_t> granted(n, 0);   // Budget granted so far
+    std::vector<uint32_t> owed(n, 0);      // Released but not granted
+    std::vector<uint32_t> idle(n, 0);      // Slots since the last grant
+    std::vector<uint32_t> maxGap(n, UINT32_MAX);
+    std::vector<uint32_t> cell(n, 0);
+    std::vector<uint8_t> allowed(n, 1);    // Highest PRB limit the UE may use
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto git = m_ueMaxGapSlots.find(entries[i].first);
+        if (git != m_ueMaxGapSlots.end())
+        {
+            maxGap[i] = git->second;
+        }
+        cell[i] = GetUeCell(entries[i].first).value_or(0);
+        allowed[i] = IsCellEdgeUe(entries[i].first) ? 0 : 1;
+    }
+    auto urgent = [&](size_t i) { return idle[i] + 1 >= maxGap[i]; };
+    
+    // PRB limits per cell: 0 = any UE, 1 = not cell-edge UEs, 2 = muted
+    struct CellPrbs
+    {
+        std::vector<uint8_t> limit;  ///< Per PRB
+        std::vector<bool> used;      ///< Granted in the current slot
+        uint32_t firstFree = 0;      ///< No unused PRB below
+    };
+    std::map<uint32_t, CellPrbs> cellPrbs;
+    for (uint32_t cellId : cell)
+    {
+        auto [cit, added] = cellPrbs.try_emplace(cellId);
+        if (!added)
+        {
+            continue;
+        }
+        auto& limit = cit->second.limit;
+        limit.assign(m_totalBandwidthPrbs, 0);
+        auto rit = m_cellRestrictions.find(cellId);
+        if (rit == m_cellRestrictions.end())
+        {
+            continue;
+        }
+        for (const auto& r : rit->second)
+        {
+            uint32_t end = std::min(r.startPrb + r.numPrbs, m_totalBandwidthPrbs);
+            for (uint32_t p = r.startPrb; p < end; ++p)
+            {
+                limit[p] = std::max<uint8_t>(limit[p], r.muted ? 2 : 1);
+            }
+        }
+    }
+    
+    std::vector<size_t> order;
+    order.reserve(n);
+    
+    for (uint32_t s = 0; s < numSlots; ++s)
+    {
+        // ----- Release: floor(B·(s+1)/K), phase-shifted per UE -----
+        order.clear();
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t phase = static_cast<uint64_t>(i) * numSlots / n;
+            uint32_t rel = static_cast<uint32_t>(
+                (static_cast<uint64_t>(entries[i].second) * (s + 1) + phase) / numSlots);
+            owed[i] += rel - released[i];
+            released[i] = rel;
+            if (granted[i] < entries[i].second && (owed[i] > 0 || urgent(i)))
+            {
+                order.push_back(i);
+            }
+        }
+        
+        // ----- Priority: latency-urgent, then most owed, then UE id -----
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (urgent(a) != urgent(b))
+            {
+                return urgent(a);
+            }
+            if (owed[a] != owed[b])
+            {
+                return owed[a] > owed[b];
+            }
+            return entries[a].first < entries[b].first;
+        });
+        
+        for (auto& counter : idle)
+        {
+            ++counter;
+        }
+        
+        // ----- Pack from the lowest free PRB the UE may use in its cell -----
+        for (auto& [cellId, prbs] : cellPrbs)
+        {
+            prbs.used.assign(m_totalBandwidthPrbs, false);
+            prbs.firstFree = 0;
+        }
+        for (size_t i : order)
+        {
+            CellPrbs& prbs = cellPrbs[cell[i]];
+            auto usable = [&](uint32_t p) { return !prbs.used[p] && prbs.limit[p] <= allowed[i]; };
+            uint32_t want = std::min(std::max<uint32_t>(owed[i], 1), entries[i].second - granted[i]);
+            uint32_t grant = 0;
+            for (uint32_t p = prbs.firstFree; p < m_totalBandwidthPrbs && grant < want;)
+            {
+                if (!usable(p))
+                {
+                    ++p;
+                    continue;
+                }
+                uint32_t start = p;
+                for (; p < m_totalBandwidthPrbs && grant < want && usable(p); ++p, ++grant)
+                {
+                    prbs.used[p] = true;
+                }
+                slots[s].emplace_back(entries[i].first, firstSlot + s, start, p - start);
+            }
+            while (prbs.firstFree < m_totalBandwidthPrbs && prbs.used[prbs.firstFree])
+            {
+                ++prbs.firstFree;
+            }
+            if (grant == 0)
+            {
+                continue;
+            }
+            granted[i] += grant;
+            owed[i] -= std::min(owed[i], grant);
+            idle[i] = 0;
+        }
+    }
+    
+    // ----- Budget the block had no room for (restricted PRBs) -----
+    uint32_t unplaced = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        unplaced += entries[i].second - granted[i];
+    }
+    if (unplaced > 0 && m_unplacedBudget.emplace(blockId, unplaced).second)
+    {
+        NS_LOG_WARN("Block " << blockId << ": " << unplaced
+                    << " PRB-slots of budget did not fit the usable PRBs");
+        m_metrics.unplacedBudget->Inc(unplaced);
+    }
+    
+    return slots;
+}
+
+const std::vector<std::vector<PrbAllocation>>&
+NrBwpManager::PeekBlock(uint32_t blockId) const
+{
+    auto it = m_expandedBlocks.find(blockId);
+    if (it != m_expandedBlocks.end())
+    {
+        return it->second;
+    }
+    it = m_lookaheadBlocks.find(blockId);
+    if (it == m_lookaheadBlocks.end())
+    {
+        if (m_lookaheadBlocks.size() >= MAX_LOOKAHEAD_BLOCKS)
+        {
+            m_lookaheadBlocks.erase(m_lookaheadBlocks.begin());
+        }
+        it = m_lookaheadBlocks.emplace(blockId, ExpandBlock(blockId)).first;
+        m_metrics.blockExpansions->Inc();
+    }
+    return it->second;
+}
+
+void
+NrBwpManager::ForEachExpandedSlot(
+    const std::function<void(uint32_t, const std::vector<PrbAllocation>&)>& visit) const
+{
+    uint32_t numBlocks = (m_totalSlots + m_granularity - 1) / m_granularity;
+    for (uint32_t blockId = 0; blockId < numBlocks; ++blockId)
+    {
+        if (m_blockBudgets.count(blockId) == 0)
+        {
+            continue;
+        }
+        for (const auto& allocations : ExpandBlock(blockId))
+        {
+            if (!allocations.empty())
+            {
+                visit(allocations.front().slotId, allocations);
+            }
+        }
+    }
+}
+
+const std::vector<PrbAllocation>*
+NrBwpManager::FindSlotAllocations(uint32_t slotId) const
+{
+    if (!IsBlockPlan())
+    {
+        auto it = m_slotAllocations.find(slotId);
+        return (it != m_slotAllocations.end()) ? &it->second : nullptr;
+    }
+    
+    if (slotId >= m_totalSlots)
+    {
+        return nullptr;
+    }
+    
+    uint32_t blockId = slotId / m_granularity;
+    auto it = m_expandedBlocks.find(blockId);
+    if (it == m_expandedBlocks.end())
+    {
+        if (m_expandedBlocks.size() >= MAX_EXPANDED_BLOCKS)
+        {
+            m_expandedBlocks.erase(m_expandedBlocks.begin());
+        }
+        auto ahead = m_lookaheadBlocks.find(blockId);
+        if (ahead != m_lookaheadBlocks.end())
+        {
+            it = m_expandedBlocks.insert(m_lookaheadBlocks.extract(ahead)).position;
+        }
+        else
+        {
+            it = m_expandedBlocks.emplace(blockId, ExpandBlock(blockId)).first;
+            m_metrics.blockExpansions->Inc();
+        }
+    }
+    
+    const auto& allocations = it->second[slotId - blockId * m_granularity];
+    return allocations.empty() ? nullptr : &allocations;
 }
 
 // ============================================================================
@@ -188,16 +680,18 @@ NrBwpManager::GetAllocationForSlot(uint32_t slotId) const
         return {};
     }
     
-    // O(1) hash map lookup
-    auto it = m_slotAllocations.find(slotId);
-    if (it != m_slotAllocations.end())
+    // O(1) hash map lookup (coarse plans: block cache)
+    const auto* allocations = FindSlotAllocations(slotId);
+    if (allocations)
     {
-        NS_LOG_DEBUG("Found " << it->second.size() 
+        NS_LOG_DEBUG("Found " << allocations->size() 
                      << " allocations for slot " << slotId);
-        return it->second;
+        m_metrics.slotHits->Inc();
+        return *allocations;
     }
     
     NS_LOG_DEBUG("No allocations for slot " << slotId << " (idle slot)");
+    m_metrics.slotIdle->Inc();
     return {};
 }
 
@@ -211,7 +705,7 @@ NrBwpManager::HasAllocationsForSlot(uint32_t slotId) const
         return false;
     }
     
-    return m_slotAllocations.find(slotId) != m_slotAllocations.end();
+    return FindSlotAllocations(slotId) != nullptr;
 }
 
 uint32_t
@@ -224,10 +718,10 @@ NrBwpManager::GetNumUesInSlot(uint32_t slotId) const
         return 0;
     }
     
-    auto it = m_slotAllocations.find(slotId);
-    if (it != m_slotAllocations.end())
+    const auto* allocations = FindSlotAllocations(slotId);
+    if (allocations)
     {
-        return static_cast<uint32_t>(it->second.size());
+        return static_cast<uint32_t>(allocations->size());
     }
     
     return 0;
@@ -249,15 +743,15 @@ NrBwpManager::GetUeAllocationForSlot(uint32_t slotId, uint32_t ueId) const
     }
     
     // Get all allocations for this slot
-    auto it = m_slotAllocations.find(slotId);
-    if (it == m_slotAllocations.end())
+    const auto* allocations = FindSlotAllocations(slotId);
+    if (!allocations)
     {
         // Slot has no allocations
         return std::nullopt;
     }
     
     // Search for specific UE (typically only 1-3 UEs per slot)
-    for (const auto& alloc : it->second)
+    for (const auto& alloc : *allocations)
     {
         if (alloc.ueId == ueId)
         {
@@ -269,6 +763,73 @@ NrBwpManager::GetUeAllocationForSlot(uint32_t slotId, uint32_t ueId) const
     return std::nullopt;
 }
 
+bool
+NrBwpManager::IsUePlannedInWindow(uint32_t ueId, uint32_t firstSlot, uint32_t lastSlot) const
+{
+    NS_LOG_FUNCTION(this << ueId << firstSlot << lastSlot);
+    
+    if (!m_hasLoadedSolution || m_totalSlots == 0)
+    {
+        return false;
+    }
+    lastSlot = std::min(lastSlot, m_totalSlots - 1);
+    
+    auto hasUe = [ueId](const std::vector<PrbAllocation>& allocations) {
+        return std::any_of(allocations.begin(), allocations.end(), [ueId](const PrbAllocation& a) {
+            return a.ueId == ueId;
+        });
+    };
+    
+    if (!IsBlockPlan())
+    {
+        for (uint32_t slot = firstSlot; slot <= lastSlot; ++slot)
+        {
+            auto it = m_slotAllocations.find(slot);
+            if (it != m_slotAllocations.end() && hasUe(it->second))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    for (uint32_t blockId = firstSlot / m_granularity;
+         firstSlot <= lastSlot && blockId <= lastSlot / m_granularity;
+         ++blockId)
+    {
+        // No budget for the UE in this block: nothing to expand
+        auto bit = m_blockBudgets.find(blockId);
+        if (bit == m_blockBudgets.end())
+        {
+            continue;
+        }
+        const auto& entries = bit->second;
+        auto eit = std::lower_bound(entries.begin(),
+                                    entries.end(),
+                                    ueId,
+                                    [](const std::pair<uint32_t, uint32_t>& e, uint32_t id) {
+                                        return e.first < id;
+                                    });
+        if (eit == entries.end() || eit->first != ueId || eit->second == 0)
+        {
+            continue;
+        }
+        
+        const auto& slots = PeekBlock(blockId);
+        uint32_t blockStart = blockId * m_granularity;
+        uint32_t from = std::max(firstSlot, blockStart) - blockStart;
+        uint32_t to = std::min<uint32_t>(lastSlot - blockStart, slots.size() - 1);
+        for (uint32_t s = from; s <= to; ++s)
+        {
+            if (hasUe(slots[s]))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 std::vector<PrbAllocation>
 NrBwpManager::GetUeAllocations(uint32_t ueId) const
 {
@@ -282,6 +843,20 @@ NrBwpManager::GetUeAllocations(uint32_t ueId) const
     
     std::vector<PrbAllocation> ueAllocations;
     
+    if (IsBlockPlan())
+    {
+        ForEachExpandedSlot([&](uint32_t, const std::vector<PrbAllocation>& allocations) {
+            for (const auto& alloc : allocations)
+            {
+                if (alloc.ueId == ueId)
+                {
+                    ueAllocations.push_back(alloc);
+                }
+            }
+        });
+        return ueAllocations;
+    }
+    
     // Iterate through all allocations (O(N))
     for (const auto& alloc : m_solution.allocations)
     {
@@ -335,11 +910,107 @@ NrBwpManager::GetMilpSolution() const
     return m_solution;
 }
 
+std::vector<NrMemoryItem>
+NrBwpManager::GetMemoryUsage() const
+{
+    using Mem = NrMemoryProfiler;
+    std::vector<NrMemoryItem> items;
+    auto add = [&items](const char* name, uint64_t bytes, uint64_t count, const char* unit) {
+        if (bytes > 0)
+        {
+            items.push_back({name, bytes, count, unit});
+        }
+    };
+
+    // Solver output kept next to the index built from it
+    add("solution",
+        Mem::VectorBytes(m_solution.allocations) + Mem::TreeBytes(m_solution.summary) +
+            Mem::VectorBytes(m_solution.budgets),
+        m_solution.allocations.size() + m_solution.budgets.size(),
+        "entries");
+
+    uint64_t slotPlan = Mem::HashBytes(m_slotAllocations);
+    for (const auto& [slotId, allocations] : m_slotAllocations)
+    {
+        slotPlan += Mem::VectorBytes(allocations);
+    }
+    add("slot_plan", slotPlan, m_slotAllocations.size(), "slots");
+
+    uint64_t blockPlan = Mem::HashBytes(m_blockBudgets) + Mem::TreeBytes(m_expandedBlocks) +
+                         Mem::TreeBytes(m_lookaheadBlocks) + Mem::HashBytes(m_unplacedBudget);
+    for (const auto& [blockId, budgets] : m_blockBudgets)
+    {
+        blockPlan += Mem::VectorBytes(budgets);
+    }
+    for (const auto* cache : {&m_expandedBlocks, &m_lookaheadBlocks})
+    {
+        for (const auto& [blockId, slots] : *cache)
+        {
+            blockPlan += Mem::VectorBytes(slots);
+            for (const auto& slot : slots)
+            {
+                blockPlan += Mem::VectorBytes(slot);
+            }
+        }
+    }
+    add("block_plan", blockPlan, m_blockBudgets.size(), "blocks");
+
+    add("ue_index",
+        Mem::HashBytes(m_ueTotalPrbs) + Mem::HashBytes(m_ueCell) + Mem::HashBytes(m_edgeUes) +
+            Mem::HashBytes(m_ueMaxGapSlots) + Mem::HashBytes(m_servingCell),
+        m_numUes,
+        "UEs");
+
+    uint64_t restrictions = Mem::HashBytes(m_cellRestrictions);
+    for (const auto& [cellId, cellRestrictions] : m_cellRestrictions)
+    {
+        restrictions += Mem::VectorBytes(cellRestrictions);
+    }
+    add("cell_restrictions", restrictions, m_cellRestrictions.size(), "cells");
+
+    return items;
+}
+
 bool
 NrBwpManager::ValidateSolution() const
 {
     NS_LOG_FUNCTION(this);
     
+    // Coarse plans: budgets must fit their block (overlaps are ruled out
+    // by construction in ExpandBlock)
+    if (IsBlockPlan())
+    {
+        for (const auto& [blockId, entries] : m_blockBudgets)
+        {
+            uint32_t firstSlot = blockId * m_granularity;
+            if (firstSlot >= m_totalSlots)
+            {
+                NS_LOG_ERROR("Invalid block ID: " << blockId << " (slots: " << m_totalSlots
+                             << ", " << m_granularity << " per block)");
+                return false;
+            }
+            uint64_t capacity = static_cast<uint64_t>(m_totalBandwidthPrbs) *
+                                std::min(m_granularity, m_totalSlots - firstSlot);
+            std::map<uint32_t, uint64_t> cellPrbSlots;
+            for (const auto& [ueId, prbSlots] : entries)
+            {
+                cellPrbSlots[GetUeCell(ueId).value_or(0)] += prbSlots;
+            }
+            for (const auto& [cellId, prbSlots] : cellPrbSlots)
+            {
+                if (prbSlots > capacity)
+                {
+                    NS_LOG_ERROR("Block " << blockId << " budgets " << prbSlots
+                                 << " PRB-slots in cell " << cellId << " > capacity "
+                                 << capacity);
+                    return false;
+                }
+            }
+        }
+        NS_LOG_INFO("Solution validation passed");
+        return true;
+    }
+    
     if (m_solution.allocations.empty())
     {
         NS_LOG_ERROR("Solution has no allocations");
@@ -408,6 +1079,16 @@ NrBwpManager::PrintSummary(std::ostream& os) const
     os << "Solution Status: " << m_solution.status << std::endl;
     os << "Objective Value: " << m_solution.objectiveValue << " Mbps" << std::endl;
     os << "Solve Time: " << m_solution.solveTimeSeconds << " seconds" << std::endl;
+    if (IsBlockPlan())
+    {
+        os << "Planning: " << m_granularity << "-slot blocks (" << m_solution.budgets.size()
+           << " budgets, expanded on demand)" << std::endl;
+        if (!m_unplacedBudget.empty())
+        {
+            os << "Unplaced budget: " << GetUnplacedBudget() << " PRB-slots in "
+               << m_unplacedBudget.size() << " blocks (restricted PRBs)" << std::endl;
+        }
+    }
     os << std::endl;
     
     os << "Resource Allocation:" << std::endl;
@@ -460,8 +1141,8 @@ NrBwpManager::PrintSlotAllocations(uint32_t slotId, std::ostream& os) const
         return;
     }
     
-    auto it = m_slotAllocations.find(slotId);
-    if (it == m_slotAllocations.end())
+    const auto* allocations = FindSlotAllocations(slotId);
+    if (!allocations)
     {
         os << "  No allocations (idle slot)" << std::endl;
         return;
@@ -469,7 +1150,7 @@ NrBwpManager::PrintSlotAllocations(uint32_t slotId, std::ostream& os) const
     
     uint32_t totalPrbsInSlot = 0;
     
-    for (const auto& alloc : it->second)
+    for (const auto& alloc : *allocations)
     {
         os << "  UE " << alloc.ueId << ": PRBs [" 
            << alloc.startPrb << "-" << (alloc.startPrb + alloc.numPrbs - 1) 
@@ -512,6 +1193,13 @@ NrBwpManager::ExportToCsv(const std::string& filename) const
     
     // Write allocations (sorted by slot ID for readability)
     std::vector<PrbAllocation> sortedAllocations = m_solution.allocations;
+    if (IsBlockPlan())
+    {
+        ForEachExpandedSlot([&](uint32_t, const std::vector<PrbAllocation>& allocations) {
+            sortedAllocations.insert(sortedAllocations.end(), allocations.begin(),
+                                     allocations.end());
+        });
+    }
     std::sort(sortedAllocations.begin(), sortedAllocations.end(),
               [](const PrbAllocation& a, const PrbAllocation& b) {
                   if (a.slotId != b.slotId) return a.slotId < b.slotId;
@@ -572,12 +1260,8 @@ NrBwpManager::ComputeStatistics()
     // Initialize
     m_statistics = Statistics();
     m_statistics.totalSlots = m_totalSlots;
-    m_statistics.numActiveSlots = static_cast<uint32_t>(m_slotAllocations.size());
-    m_statistics.numIdleSlots = m_totalSlots - m_statistics.numActiveSlots;
-    m_statistics.slotUtilization = static_cast<double>(m_statistics.numActiveSlots) / 
-                                    static_cast<double>(m_totalSlots);
-    
-    m_statistics.totalAllocations = static_cast<uint32_t>(m_solution.allocations.size());
+    m_statistics.numActiveSlots = 0;
+    m_statistics.totalAllocations = 0;
     m_statistics.totalPrbsAllocated = 0;
     
     m_statistics.maxPrbsPerSlot = 0;
@@ -588,17 +1272,24 @@ NrBwpManager::ComputeStatistics()
     uint32_t totalPrbsInActiveSlots = 0;
     uint32_t totalUesInActiveSlots = 0;
     
-    // Per-slot statistics
-    for (const auto& [slotId, allocations] : m_slotAllocations)
-    {
+    // Per-slot statistics (coarse plans: also the per-UE totals, since
+    // budgets that do not fit are not granted)
+    bool blockPlan = IsBlockPlan();
+    auto accumulate = [&](uint32_t, const std::vector<PrbAllocation>& allocations) {
         uint32_t prbsInSlot = 0;
         
         for (const auto& alloc : allocations)
         {
             prbsInSlot += alloc.numPrbs;
             m_statistics.totalPrbsAllocated += alloc.numPrbs;
+            if (blockPlan)
+            {
+                m_ueTotalPrbs[alloc.ueId] += alloc.numPrbs;
+            }
         }
         
+        m_statistics.numActiveSlots++;
+        m_statistics.totalAllocations += static_cast<uint32_t>(allocations.size());
         m_statistics.maxPrbsPerSlot = std::max(m_statistics.maxPrbsPerSlot, prbsInSlot);
         m_statistics.minPrbsPerSlot = std::min(m_statistics.minPrbsPerSlot, prbsInSlot);
         
@@ -607,8 +1298,24 @@ NrBwpManager::ComputeStatistics()
         uint32_t uesInSlot = static_cast<uint32_t>(allocations.size());
         m_statistics.maxUesPerSlot = std::max(m_statistics.maxUesPerSlot, uesInSlot);
         totalUesInActiveSlots += uesInSlot;
+    };
+    if (blockPlan)
+    {
+        m_ueTotalPrbs.clear();
+        ForEachExpandedSlot(accumulate);
+    }
+    else
+    {
+        for (const auto& [slotId, allocations] : m_slotAllocations)
+        {
+            accumulate(slotId, allocations);
+        }
     }
     
+    m_statistics.numIdleSlots = m_totalSlots - m_statistics.numActiveSlots;
+    m_statistics.slotUtilization = static_cast<double>(m_statistics.numActiveSlots) / 
+                                    static_cast<double>(m_totalSlots);
+    
     // Averages
     if (m_statistics.numActiveSlots > 0)
     {
@@ -646,6 +1353,12 @@ NrBwpManager::ValidateNoPrbOverlaps() const
                 const auto& a1 = allocations[i];
                 const auto& a2 = allocations[j];
                 
+                // Coordinated plans reuse PRBs across cells
+                if (GetUeCell(a1.ueId) != GetUeCell(a2.ueId))
+                {
+                    continue;
+                }
+                
                 // Compute end PRB indices
                 uint32_t a1_end = a1.startPrb + a1.numPrbs;
                 uint32_t a2_end = a2.startPrb + a2.numPrbs;
@@ -23,6 +23,10 @@
  * - Query per slot: O(1) average (hash map lookup)
  * - Query per UE: O(k) where k = UEs per slot (~1-3)
  * 
+ * Coarse plans (K-slot blocks of per-UE PRB budgets) are not indexed per
+ * slot: a block is expanded to slot allocations when first queried and
+ * only the last few expanded blocks are kept.
+ * 
  * Usage:
  * 1. Create BWP Manager
  * 2. Load MILP solution → builds indexed structure
@@ -35,8 +39,13 @@
 
 #include "ns3/object.h"
 #include "utils/nr-milp-types.h"
+#include "utils/nr-metrics-registry.h"
+#include "utils/nr-memory-profiler.h"
 
+#include <functional>
+#include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <optional>
 #include <cstdint>
@@ -233,6 +242,20 @@ class NrBwpManager : public Object
     std::optional<PrbAllocation> GetUeAllocationForSlot(uint32_t slotId, 
                                                          uint32_t ueId) const;
     
+    /**
+     * \brief Check whether a UE is planned in a window of slots
+     * \param ueId UE identifier
+     * \param firstSlot First slot of the window
+     * \param lastSlot Last slot of the window (inclusive)
+     * \return true if the plan grants the UE PRBs in any slot of the window
+     * 
+     * Lookahead for deadlines (URLLC preemption). Coarse plans skip blocks
+     * without budget for the UE and expand the others into a separate
+     * lookahead cache, so looking ahead never evicts the block the
+     * scheduler is executing.
+     */
+    bool IsUePlannedInWindow(uint32_t ueId, uint32_t firstSlot, uint32_t lastSlot) const;
+    
     /**
      * \brief Get all allocations for a specific UE across all slots
      * \param ueId UE identifier
@@ -266,6 +289,95 @@ class NrBwpManager : public Object
      */
     uint32_t GetTotalPrbsForUe(uint32_t ueId) const;
     
+    // ========================================================================
+    // INTER-CELL COORDINATION
+    // ========================================================================
+    
+    /**
+     * \brief Attach the cell structure of a coordinated MILP problem
+     * \param problem Problem with coordinated = true (cells + restrictions)
+     * 
+     * Call before LoadMilpSolution(): coordinated plans reuse PRBs across
+     * cells, so overlap validation then applies per cell. Survives
+     * ClearSolution(); an uncoordinated problem clears it.
+     */
+    void SetCellCoordination(const MilpProblem& problem);
+    
+    /**
+     * \brief Check whether a coordinated cell structure is attached
+     * \return true after SetCellCoordination() with a coordinated problem
+     */
+    bool IsCoordinated() const;
+    
+    /**
+     * \brief Get the planned serving cell of a UE
+     * \param ueId UE identifier
+     * \return Cell id, or std::nullopt if not coordinated / unknown UE
+     */
+    std::optional<uint32_t> GetUeCell(uint32_t ueId) const;
+    
+    /**
+     * \brief Record the cell that serves a UE now (attachment, handover)
+     * \param ueId UE identifier
+     * \param cellId Serving cell (gNB index)
+     * 
+     * No-op without a coordinated plan. The plan keeps the planned cell
+     * (GetUeCell()); executors map UEs by GetServingCell().
+     */
+    void SetServingCell(uint32_t ueId, uint32_t cellId);
+    
+    /**
+     * \brief Get the cell that serves a UE now
+     * \param ueId UE identifier
+     * \return Last SetServingCell() value, else the planned cell
+     */
+    std::optional<uint32_t> GetServingCell(uint32_t ueId) const;
+    
+    /**
+     * \brief Check whether a UE was classified as cell-edge
+     * \param ueId UE identifier
+     * \return true for cell-edge UEs of a coordinated plan
+     */
+    bool IsCellEdgeUe(uint32_t ueId) const;
+    
+    /**
+     * \brief Get the PRB restrictions a cell must honour
+     * \param cellId Cell (gNB index)
+     * \return Muted / power-limited PRB ranges of this cell
+     */
+    std::vector<PrbRestriction> GetPrbRestrictions(uint32_t cellId) const;
+    
+    // ========================================================================
+    // COARSE (BLOCK) PLANS
+    // ========================================================================
+    
+    /**
+     * \brief Attach the dimensions a coarse plan is expanded against
+     * \param problem Problem the solution was planned for
+     * 
+     * Call before LoadMilpSolution() with a solution carrying budgets:
+     * stores the PRBs per slot, the slot count and, per UE, the longest
+     * gap between grants its latency bound allows (latencyMs / slot
+     * duration, at least one slot). Survives ClearSolution().
+     */
+    void SetBlockPlanning(const MilpProblem& problem);
+    
+    /**
+     * \brief Check whether the loaded solution is a coarse plan
+     * \return true if slot allocations are expanded from block budgets
+     */
+    bool IsBlockPlan() const;
+    
+    /**
+     * \brief Get the budget that did not fit its block
+     * \return PRB-slots left ungranted at the end of their block, over the
+     *         blocks expanded so far
+     * 
+     * Validation only checks budgets against the full bandwidth; muted
+     * and power-limited PRBs can leave less room than that.
+     */
+    uint64_t GetUnplacedBudget() const;
+    
     // ========================================================================
     // STATISTICS AND VALIDATION
     // ========================================================================
@@ -331,6 +443,13 @@ class NrBwpManager : public Object
      */
     const MilpSolution& GetMilpSolution() const;
     
+    /**
+     * \brief Estimate the memory held by the plan containers
+     * \return Per-container bytes; the slot plan counts slots, so the
+     *         profiling report shows the plan cost per slot
+     */
+    std::vector<NrMemoryItem> GetMemoryUsage() const;
+    
     /**
      * \brief Validate solution integrity
      * \return true if solution is valid, false otherwise
@@ -418,6 +537,63 @@ class NrBwpManager : public Object
      */
     bool ValidateNoPrbOverlaps() const;
     
+    /**
+     * \brief Index the budgets of a coarse plan (LoadMilpSolution tail)
+     * \return true if the budgets fit the planned dimensions
+     */
+    bool LoadBlockBudgets();
+    
+    /**
+     * \brief Find the allocations of one slot
+     * \param slotId Slot index
+     * \return Allocations of the slot, or nullptr for an idle slot
+     * 
+     * Per-slot plans: index lookup. Coarse plans: expands the slot's block
+     * into the block cache first; the pointer is valid until the next
+     * lookup.
+     */
+    const std::vector<PrbAllocation>* FindSlotAllocations(uint32_t slotId) const;
+    
+    /**
+     * \brief Expand one block of budgets to per-slot allocations
+     * \param blockId Block index
+     * \return One allocation vector per slot of the block
+     * 
+     * Deterministic interleaving, per slot:
+     * 1. Each UE's budget B is released evenly over the block's slots
+     *    (floor(B·(s+1)/K), phase-shifted per UE to spread the UEs)
+     * 2. UEs about to exceed their latency gap are served first, then by
+     *    PRBs released but not yet granted, then by UE id
+     * 3. Grants are packed from the lowest free PRB the UE's cell may use:
+     *    muted PRBs are skipped, and so are power-limited PRBs for
+     *    cell-edge UEs (as the executor's ApplyPrbRestrictions()); a grant
+     *    may span several ranges
+     * 
+     * The gap bound holds within a block as long as the block's PRBs
+     * suffice; idle counters restart at each block boundary. Budget still
+     * ungranted at the end of the block is recorded in m_unplacedBudget.
+     */
+    std::vector<std::vector<PrbAllocation>> ExpandBlock(uint32_t blockId) const;
+    
+    /**
+     * \brief Get an expanded block without touching the block cache
+     * \param blockId Block index
+     * \return Slots of the block (valid until the next lookahead)
+     * 
+     * Served from the block cache when present, else from the lookahead
+     * cache (expanded there on a miss).
+     */
+    const std::vector<std::vector<PrbAllocation>>& PeekBlock(uint32_t blockId) const;
+    
+    /**
+     * \brief Visit every slot of a coarse plan in order
+     * \param visit Called with (slotId, allocations) for each active slot
+     * 
+     * Expands one block at a time without caching it.
+     */
+    void ForEachExpandedSlot(
+        const std::function<void(uint32_t, const std::vector<PrbAllocation>&)>& visit) const;
+    
     // ========================================================================
     // MEMBER VARIABLES
     // ========================================================================
@@ -483,6 +659,86 @@ class NrBwpManager : public Object
      * \brief Number of UEs (from problem)
      */
     uint32_t m_numUes;
+    
+    /**
+     * \brief Coordinated plan: serving cell per UE (empty otherwise)
+     */
+    std::unordered_map<uint32_t, uint32_t> m_ueCell;
+    
+    /**
+     * \brief Coordinated plan: cell-edge UEs
+     */
+    std::unordered_set<uint32_t> m_edgeUes;
+    
+    /**
+     * \brief Coordinated plan: PRB restrictions per cell
+     */
+    std::unordered_map<uint32_t, std::vector<PrbRestriction>> m_cellRestrictions;
+    
+    /**
+     * \brief Coordinated plan: UEs served by a cell other than the planned one
+     */
+    std::unordered_map<uint32_t, uint32_t> m_servingCell;
+    
+    /**
+     * \brief Coarse plans: PRBs per slot and slot count (SetBlockPlanning)
+     */
+    uint32_t m_planPrbs;
+    uint32_t m_planSlots;
+    
+    /**
+     * \brief Coarse plans: longest allowed gap between grants, per UE (slots)
+     */
+    std::unordered_map<uint32_t, uint32_t> m_ueMaxGapSlots;
+    
+    /**
+     * \brief Coarse plans: slots per block (1 = per-slot plan)
+     */
+    uint32_t m_granularity;
+    
+    /**
+     * \brief Coarse plans: blockId → (ueId, prbSlots), sorted by ueId
+     */
+    std::unordered_map<uint32_t, std::vector<std::pair<uint32_t, uint32_t>>> m_blockBudgets;
+    
+    /**
+     * \brief Coarse plans: recently expanded blocks (blockId → slots)
+     * 
+     * Bounded by MAX_EXPANDED_BLOCKS; the lowest block id is evicted
+     * first since the scheduler only moves forward.
+     */
+    mutable std::map<uint32_t, std::vector<std::vector<PrbAllocation>>> m_expandedBlocks;
+    
+    static constexpr size_t MAX_EXPANDED_BLOCKS = 4;  ///< Block cache size
+    
+    /**
+     * \brief Coarse plans: future blocks expanded by IsUePlannedInWindow()
+     * 
+     * Kept apart from m_expandedBlocks so lookahead cannot evict the block
+     * in execution; FindSlotAllocations() moves a block from here into the
+     * block cache when the scheduler reaches it.
+     */
+    mutable std::map<uint32_t, std::vector<std::vector<PrbAllocation>>> m_lookaheadBlocks;
+    
+    static constexpr size_t MAX_LOOKAHEAD_BLOCKS = 2;  ///< Lookahead cache size
+    
+    /**
+     * \brief Coarse plans: PRB-slots of budget that did not fit, per block
+     */
+    mutable std::unordered_map<uint32_t, uint32_t> m_unplacedBudget;
+    
+    /**
+     * \brief Live counters in NrMetricsRegistry (shared by all BWPs)
+     */
+    struct RegistryMetrics
+    {
+        NrMetricCounter* plansLoaded = nullptr;      ///< Plans loaded
+        NrMetricCounter* plannedPrbs = nullptr;      ///< PRB-slots in loaded plans
+        NrMetricCounter* slotHits = nullptr;         ///< Slot queries with allocations
+        NrMetricCounter* slotIdle = nullptr;         ///< Slot queries without
+        NrMetricCounter* blockExpansions = nullptr;  ///< Coarse block cache misses
+        NrMetricCounter* unplacedBudget = nullptr;   ///< Coarse budget that did not fit
+    } m_metrics;
 };
 
 } // namespace ns3
@@ -206,6 +206,17 @@ NrConfigManager::SaveToJson(const Ptr<NrSimConfig>& config, const std::string& f
         j["channel"]["propagationModel"] = config->channel.propagationModel;
         j["channel"]["frequency"] = config->channel.frequency;
         j["channel"]["bandwidth"] = config->channel.bandwidth;
+        if (!config->channel.carriers.empty())
+        {
+            json carriers = json::array();
+            for (const auto& carrier : config->channel.carriers)
+            {
+                carriers.push_back({{"frequency", carrier.frequency},
+                                    {"bandwidth", carrier.bandwidth},
+                                    {"numerology", carrier.numerology}});
+            }
+            j["channel"]["carriers"] = carriers;
+        }
 
         // Mobility section
         j["mobility"]["defaultModel"] = config->mobility.defaultModel;
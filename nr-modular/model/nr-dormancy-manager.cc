@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Dormancy Manager - Implementation File
+ */
+
+#include "nr-dormancy-manager.h"
+
+#include "nr-network-manager.h"
+#include "nr-traffic-manager.h"
+#include "utils/nr-sim-config.h"
+
+#include "ns3/abort.h"
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/log.h"
+#include "ns3/nr-spectrum-phy.h"
+#include "ns3/nr-ue-net-device.h"
+#include "ns3/nr-ue-phy.h"
+#include "ns3/nr-ue-rrc.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-channel.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrDormancyManager");
+NS_OBJECT_ENSURE_REGISTERED(NrDormancyManager);
+
+TypeId
+NrDormancyManager::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrDormancyManager")
+                            .SetParent<Object>()
+                            .SetGroupName("NrModular")
+                            .AddConstructor<NrDormancyManager>();
+    return tid;
+}
+
+NrDormancyManager::NrDormancyManager()
+    : m_config(nullptr),
+      m_networkManager(nullptr),
+      m_trafficManager(nullptr),
+      m_inactivityTimer(Seconds(1.0)),
+      m_startTime(Seconds(0)),
+      m_numDormant(0)
+{
+    NS_LOG_FUNCTION(this);
+
+    NrMetricsRegistry& registry = NrMetricsRegistry::Get();
+    m_dormantMetric = registry.GetGauge("nr_dormant_ues", "UEs detached from the PHY");
+    m_promotionMetric = registry.GetCounter("nr_ue_dormancy_transitions_total",
+                                            "UE dormancy transitions",
+                                            "to=\"connected\"");
+    m_demotionMetric = registry.GetCounter("nr_ue_dormancy_transitions_total",
+                                           "UE dormancy transitions",
+                                           "to=\"dormant\"");
+}
+
+NrDormancyManager::~NrDormancyManager()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrDormancyManager::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& ue : m_ues)
+    {
+        ue.timer.Cancel();
+    }
+    m_ues.clear();
+    m_config = nullptr;
+    m_networkManager = nullptr;
+    m_trafficManager = nullptr;
+    Object::DoDispose();
+}
+
+void
+NrDormancyManager::SetConfig(const Ptr<NrSimConfig>& config)
+{
+    NS_ABORT_MSG_IF(config == nullptr, "NrDormancyManager: config cannot be null");
+    m_config = config;
+    m_inactivityTimer = Seconds(config->traffic.dormancy.inactivityTimer);
+}
+
+void
+NrDormancyManager::SetManagers(Ptr<NrNetworkManager> networkManager,
+                               Ptr<NrTrafficManager> trafficManager)
+{
+    m_networkManager = networkManager;
+    m_trafficManager = trafficManager;
+}
+
+void
+NrDormancyManager::Enable()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_config == nullptr || !m_networkManager || !m_trafficManager,
+                    "Config and managers must be set before enabling dormancy");
+    NS_ABORT_MSG_IF(!m_trafficManager->IsInstalled(), "Must call InstallTraffic() first");
+
+    ApplicationContainer dlSources = m_trafficManager->GetDlClientApps();
+    ApplicationContainer dlSinks = m_trafficManager->GetDlServerApps();
+    ApplicationContainer ulSources = m_trafficManager->GetUlClientApps();
+    ApplicationContainer ulSinks = m_trafficManager->GetUlServerApps();
+
+    uint32_t numUes = m_networkManager->GetUeDevices().GetN();
+    m_startTime = Seconds(m_trafficManager->GetTrafficStartTime());
+    m_ues.assign(numUes, UeState());
+
+    for (uint32_t ueId = 0; ueId < numUes; ++ueId)
+    {
+        UeState& ue = m_ues[ueId];
+        Ptr<NrUeNetDevice> device = m_networkManager->GetUeDevice(ueId);
+        ue.rrc = device->GetRrc();
+        for (uint32_t bwp = 0; bwp < device->GetCcMapSize(); ++bwp)
+        {
+            Ptr<NrSpectrumPhy> phy = device->GetPhy(bwp)->GetSpectrumPhy();
+            ue.phys.emplace_back(phy->GetSpectrumChannel(), phy);
+        }
+
+        // One flow per UE and direction, installed in UE order
+        auto tx = MakeCallback(&NrDormancyManager::NotifyTx, this).Bind(ueId);
+        auto rx = MakeCallback(&NrDormancyManager::NotifyRx, this).Bind(ueId);
+        if (ueId < dlSources.GetN())
+        {
+            dlSources.Get(ueId)->TraceConnectWithoutContext("Tx", tx);
+            dlSinks.Get(ueId)->TraceConnectWithoutContext("Rx", rx);
+        }
+        if (ueId < ulSources.GetN())
+        {
+            ulSources.Get(ueId)->TraceConnectWithoutContext("Tx", tx);
+            ulSinks.Get(ueId)->TraceConnectWithoutContext("Rx", rx);
+        }
+
+        ue.lastActivity = m_startTime;
+        ue.timer = Simulator::Schedule(m_startTime + m_inactivityTimer - Simulator::Now(),
+                                       &NrDormancyManager::CheckInactivity,
+                                       this,
+                                       ueId);
+    }
+
+    std::cout << "  ✓ Dormant-UE mode: " << numUes << " UEs leave the PHY after "
+              << m_inactivityTimer.GetSeconds() << " s without packets" << std::endl;
+}
+
+bool
+NrDormancyManager::IsDormant(uint32_t ueId) const
+{
+    return ueId < m_ues.size() && m_ues[ueId].dormant;
+}
+
+void
+NrDormancyManager::NotifyTx(uint32_t ueId, Ptr<const Packet> /* packet */)
+{
+    NotifyActivity(ueId);
+}
+
+void
+NrDormancyManager::NotifyRx(uint32_t ueId,
+                            Ptr<const Packet> /* packet */,
+                            const Address& /* from */)
+{
+    NotifyActivity(ueId);
+}
+
+void
+NrDormancyManager::NotifyActivity(uint32_t ueId)
+{
+    UeState& ue = m_ues[ueId];
+    Time now = Simulator::Now();
+    ue.lastActivity = now;
+    if (!ue.dormant)
+    {
+        return;
+    }
+
+    // Promote: the packet is still in the core / RLC, so the UE is back on
+    // the channel before the gNB schedules it
+    NS_LOG_INFO("UE " << ueId << " promoted at " << now.As(Time::S));
+    SetPhysAttached(ue, true);
+    ue.dormant = false;
+    m_stats.dormantUeSeconds += (now - ue.dormantSince).GetSeconds();
+    m_stats.promotions++;
+    m_numDormant--;
+    m_promotionMetric->Inc();
+    m_dormantMetric->Set(m_numDormant);
+
+    ue.timer = Simulator::Schedule(m_inactivityTimer,
+                                   &NrDormancyManager::CheckInactivity,
+                                   this,
+                                   ueId);
+}
+
+void
+NrDormancyManager::CheckInactivity(uint32_t ueId)
+{
+    UeState& ue = m_ues[ueId];
+    Time now = Simulator::Now();
+    Time idleUntil = ue.lastActivity + m_inactivityTimer;
+    if (now < idleUntil)
+    {
+        ue.timer = Simulator::Schedule(idleUntil - now,
+                                       &NrDormancyManager::CheckInactivity,
+                                       this,
+                                       ueId);
+        return;
+    }
+    if (ue.rrc->GetState() != NrUeRrc::CONNECTED_NORMALLY)
+    {
+        // Attaching or in handover: the UE needs its PHY, look again later
+        ue.timer = Simulator::Schedule(m_inactivityTimer,
+                                       &NrDormancyManager::CheckInactivity,
+                                       this,
+                                       ueId);
+        return;
+    }
+
+    // Demote; the timer stays off until the next packet promotes the UE
+    NS_LOG_INFO("UE " << ueId << " dormant at " << now.As(Time::S));
+    SetPhysAttached(ue, false);
+    ue.dormant = true;
+    ue.dormantSince = now;
+    m_stats.demotions++;
+    m_numDormant++;
+    m_stats.peakDormant = std::max(m_stats.peakDormant, m_numDormant);
+    m_demotionMetric->Inc();
+    m_dormantMetric->Set(m_numDormant);
+}
+
+void
+NrDormancyManager::SetPhysAttached(UeState& ue, bool attached)
+{
+    for (auto& [channel, phy] : ue.phys)
+    {
+        if (attached)
+        {
+            channel->AddRx(phy);
+        }
+        else
+        {
+            channel->RemoveRx(phy);
+        }
+    }
+}
+
+NrDormancyManager::Statistics
+NrDormancyManager::GetStatistics() const
+{
+    Statistics stats = m_stats;
+    Time now = Simulator::Now();
+    for (const auto& ue : m_ues)
+    {
+        if (ue.dormant)
+        {
+            stats.dormantUeSeconds += (now - ue.dormantSince).GetSeconds();
+        }
+    }
+    if (now > m_startTime)
+    {
+        stats.ueSeconds = m_ues.size() * (now - m_startTime).GetSeconds();
+    }
+    return stats;
+}
+
+void
+NrDormancyManager::PrintSummary(std::ostream& os) const
+{
+    Statistics stats = GetStatistics();
+    double dormant = stats.GetDormantFraction();
+
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+    os << "\n========================================\n";
+    os << "DORMANT UEs\n";
+    os << "========================================\n";
+    os << "  UEs:                " << m_ues.size() << " (" << m_numDormant
+       << " dormant now, peak " << stats.peakDormant << ")\n";
+    os << "  Transitions:        " << stats.demotions << " to dormant, " << stats.promotions
+       << " to connected\n";
+    os << "  Dormant UE-time:    " << dormant * 100.0 << "% of " << stats.ueSeconds
+       << " UE-s\n";
+    // DL reception work scales with the UEs on the channel
+    os << "  PHY reception work: " << (1.0 - dormant) * 100.0 << "% of always-on (up to "
+       << std::setprecision(2) << (dormant < 1.0 ? 1.0 / (1.0 - dormant) : 0.0)
+       << "x fewer receptions)\n";
+    os << "========================================\n" << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace ns3
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Dormancy Manager - Header File
+ *
+ * Responsibilities:
+ * - Keep UEs without traffic dormant (traffic.dormancy)
+ * - Promote a dormant UE when a packet for or from it appears
+ * - Demote a UE after an inactivity timer without packets
+ * - Count transitions and dormant UE-time
+ *
+ * A dormant UE has its spectrum PHYs detached from their channels: it
+ * receives no DL transmission, so no SINR, interference or CQI work is
+ * done for it - the dominant per-UE cost once many UEs share a cell.
+ * Its mobility model keeps tracking its position and its RRC context
+ * stays on the gNB, so promotion is immediate (an RRC resume with ideal
+ * signalling).
+ *
+ * Activity is read from the UE's traffic applications (OnOff sources:
+ * Tx, packet sinks: Rx). The inactivity timer is lazy: packets only
+ * stamp the last-activity time, and the timer event re-arms itself when
+ * it fires before the UE has been idle long enough.
+ *
+ * Limitations:
+ * - UE PHY/MAC still receive slot indications (5G-LENA has no UE sleep)
+ * - a dormant UE makes no measurements, so it is only handed over after
+ *   promotion
+ * - UEs are demoted only in RRC CONNECTED_NORMALLY (never during attach
+ *   or handover)
+ */
+
+#ifndef NR_DORMANCY_MANAGER_H
+#define NR_DORMANCY_MANAGER_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "utils/nr-metrics-registry.h"
+
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+class Address;
+class NrNetworkManager;
+class NrSimConfig;
+class NrTrafficManager;
+class NrUeRrc;
+class Packet;
+class SpectrumChannel;
+class SpectrumPhy;
+
+/**
+ * \ingroup nr-modular
+ *
+ * \brief Moves idle UEs out of the PHY and back when traffic arrives
+ */
+class NrDormancyManager : public Object
+{
+  public:
+    /**
+     * @brief Get the TypeId
+     * @return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Constructor
+     */
+    NrDormancyManager();
+
+    /**
+     * @brief Destructor
+     */
+    ~NrDormancyManager() override;
+
+    /**
+     * @brief Set the configuration (traffic.dormancy)
+     * @param config Simulation configuration
+     */
+    void SetConfig(const Ptr<NrSimConfig>& config);
+
+    /**
+     * @brief Set the managers owning the UE devices and applications
+     * @param networkManager Network manager (UE devices)
+     * @param trafficManager Traffic manager (per-UE applications)
+     */
+    void SetManagers(Ptr<NrNetworkManager> networkManager,
+                     Ptr<NrTrafficManager> trafficManager);
+
+    /**
+     * @brief Hook the traffic applications and arm the inactivity timers
+     *
+     * Timers start with the traffic, so UEs are attached and active until
+     * they have been idle for one inactivity period. Must be called after
+     * NrTrafficManager::InstallTraffic() and before the simulation runs.
+     */
+    void Enable();
+
+    /**
+     * @brief Check whether a UE is dormant
+     * @param ueId UE index
+     * @return true if its PHYs are detached
+     */
+    bool IsDormant(uint32_t ueId) const;
+
+    /**
+     * @brief Get the number of dormant UEs
+     * @return UEs currently dormant
+     */
+    uint32_t GetNumDormant() const
+    {
+        return m_numDormant;
+    }
+
+    /**
+     * @brief Transition counters and dormant time
+     */
+    struct Statistics
+    {
+        uint64_t promotions = 0;        ///< Dormant → connected
+        uint64_t demotions = 0;         ///< Connected → dormant
+        uint32_t peakDormant = 0;       ///< Most UEs dormant at once
+        double dormantUeSeconds = 0.0;  ///< Sum of dormant time over UEs
+        double ueSeconds = 0.0;         ///< UEs x time since traffic start
+
+        /**
+         * @brief Get the share of UE-time spent dormant
+         * @return Fraction in [0, 1]
+         */
+        double GetDormantFraction() const
+        {
+            return ueSeconds > 0.0 ? dormantUeSeconds / ueSeconds : 0.0;
+        }
+    };
+
+    /**
+     * @brief Get the statistics up to now
+     * @return Statistics
+     */
+    Statistics GetStatistics() const;
+
+    /**
+     * @brief Print transitions, dormant share and the PHY work saved
+     * @param os Output stream
+     */
+    void PrintSummary(std::ostream& os) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * @brief Per-UE dormancy state
+     */
+    struct UeState
+    {
+        bool dormant = false;      ///< PHYs detached
+        Time lastActivity;         ///< Last packet of the UE
+        Time dormantSince;         ///< Start of the current dormant period
+        EventId timer;             ///< Inactivity check
+        Ptr<NrUeRrc> rrc;          ///< UE RRC (demotion only when connected)
+        std::vector<std::pair<Ptr<SpectrumChannel>, Ptr<SpectrumPhy>>> phys; ///< Per BWP
+    };
+
+    /**
+     * @brief Trace sink: OnOff source Tx of a UE flow
+     */
+    void NotifyTx(uint32_t ueId, Ptr<const Packet> packet);
+
+    /**
+     * @brief Trace sink: packet sink Rx of a UE flow
+     */
+    void NotifyRx(uint32_t ueId, Ptr<const Packet> packet, const Address& from);
+
+    /**
+     * @brief Stamp activity and promote the UE if dormant
+     * @param ueId UE index
+     */
+    void NotifyActivity(uint32_t ueId);
+
+    /**
+     * @brief Inactivity timer: demote the UE or re-arm the timer
+     * @param ueId UE index
+     */
+    void CheckInactivity(uint32_t ueId);
+
+    /**
+     * @brief Attach or detach the UE's spectrum PHYs
+     * @param ue UE state
+     * @param attached true to attach
+     */
+    void SetPhysAttached(UeState& ue, bool attached);
+
+    Ptr<NrSimConfig> m_config;                  ///< Simulation configuration
+    Ptr<NrNetworkManager> m_networkManager;     ///< UE devices
+    Ptr<NrTrafficManager> m_trafficManager;     ///< UE applications
+    Time m_inactivityTimer;                     ///< Idle time before demotion
+    Time m_startTime;                           ///< Traffic start
+    std::vector<UeState> m_ues;                 ///< Indexed by UE
+    uint32_t m_numDormant;                      ///< UEs currently dormant
+    Statistics m_stats;                         ///< Closed dormant periods, counters
+    NrMetricGauge* m_dormantMetric;             ///< Registry: dormant UEs
+    NrMetricCounter* m_promotionMetric;         ///< Registry: promotions
+    NrMetricCounter* m_demotionMetric;          ///< Registry: demotions
+};
+
+} // namespace ns3
+
+#endif /* NR_DORMANCY_MANAGER_H */
@@ -17,7 +17,9 @@
 #include "ns3/nr-phy-mac-common.h"             // For DciFormat, VarTtiType
 
 #include <algorithm>
+#include <array>
 #include <functional>  // For std::bind
+#include <unordered_set>
 
 namespace ns3
 {
@@ -50,7 +52,11 @@ NrMilpExecutorScheduler::NrMilpExecutorScheduler()
       m_currentSlot(0),
       m_rbgSize(0),
       m_totalRbgs(0),
-      m_initialized(false)
+      m_initialized(false),
+      m_preemptionEnabled(false),
+      m_slotsPerMs(1),
+      m_harqAware(false),
+      m_retxPoolStartPrb(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -82,6 +88,7 @@ NrMilpExecutorScheduler::Initialize(Ptr<NrNetworkManager> networkManager)
     NS_LOG_FUNCTION(this << networkManager);
     
     NS_ABORT_MSG_IF(networkManager == nullptr, "Network Manager cannot be null");
+    m_networkManager = networkManager;
     
     /*
      * CRITICAL INITIALIZATION: Cache RNTI Mappings
@@ -104,9 +111,24 @@ NrMilpExecutorScheduler::Initialize(Ptr<NrNetworkManager> networkManager)
     m_ueIdToRnti.clear();
     m_rntiToUeId.clear();
     
+    // Coordinated plan: UEs this cell serves only, plus its PRB restrictions
+    bool perCell = m_cellId.has_value() && m_bwpManager && m_bwpManager->IsCoordinated();
+    m_prbRestrictions.clear();
+    if (perCell)
+    {
+        m_prbRestrictions = m_bwpManager->GetPrbRestrictions(*m_cellId);
+        NS_LOG_INFO("Cell " << *m_cellId << ": " << m_prbRestrictions.size()
+                    << " PRB restrictions");
+    }
+    
     // Build bidirectional mapping
     for (uint32_t ueId = 0; ueId < numUes; ueId++)
     {
+        if (perCell && m_bwpManager->GetServingCell(ueId) != m_cellId)
+        {
+            continue;
+        }
+        
         // Get RNTI from Network Manager (which gets it from NrUeMac)
         uint16_t rnti = networkManager->GetUeRnti(ueId);
         
@@ -122,6 +144,730 @@ NrMilpExecutorScheduler::Initialize(Ptr<NrNetworkManager> networkManager)
     NS_LOG_INFO("MILP Executor Scheduler initialized successfully");
 }
 
+void
+NrMilpExecutorScheduler::SetCellId(uint32_t cellId)
+{
+    NS_LOG_FUNCTION(this << cellId);
+    m_cellId = cellId;
+}
+
+void
+NrMilpExecutorScheduler::UpdateServingCell(uint32_t ueId)
+{
+    NS_LOG_FUNCTION(this << ueId);
+    
+    if (!m_initialized || !m_cellId.has_value() || !m_bwpManager->IsCoordinated())
+    {
+        return;
+    }
+    
+    auto it = m_ueIdToRnti.find(ueId);
+    if (it != m_ueIdToRnti.end())
+    {
+        m_rntiToUeId.erase(it->second);
+        m_ueIdToRnti.erase(it);
+    }
+    if (m_bwpManager->GetServingCell(ueId) == m_cellId)
+    {
+        uint16_t rnti = m_networkManager->GetUeRnti(ueId);
+        m_ueIdToRnti[ueId] = rnti;
+        m_rntiToUeId[rnti] = ueId;
+        NS_LOG_INFO("Cell " << *m_cellId << ": UE " << ueId << " ↔ RNTI " << rnti);
+    }
+}
+
+std::vector<bool>
+NrMilpExecutorScheduler::OrderPlannedUesFirst(std::vector<PrbAllocation>& allocations) const
+{
+    if (!m_cellId.has_value() || !m_bwpManager->IsCoordinated())
+    {
+        return {};
+    }
+    std::stable_partition(allocations.begin(),
+                          allocations.end(),
+                          [this](const PrbAllocation& a) {
+                              return m_bwpManager->GetUeCell(a.ueId) == m_cellId;
+                          });
+    return std::vector<bool>(m_totalRbgs, false);
+}
+
+void
+NrMilpExecutorScheduler::SetSliceManager(Ptr<NrSliceManager> sliceManager)
+{
+    NS_LOG_FUNCTION(this << sliceManager);
+    m_sliceManager = sliceManager;
+}
+
+void
+NrMilpExecutorScheduler::ApplySliceQuotas(std::vector<PrbAllocation>& allocations,
+                                          const ActiveUeMap& activeUes,
+                                          uint32_t symAvail,
+                                          bool downlink) const
+{
+    // Quotas are shares of this BWP: other cells' UEs must not count
+    allocations.erase(std::remove_if(allocations.begin(),
+                                     allocations.end(),
+                                     [this](const PrbAllocation& a) {
+                                         return m_ueIdToRnti.find(a.ueId) == m_ueIdToRnti.end();
+                                     }),
+                      allocations.end());
+    
+    // Usable PRBs: the plannable part of the BWP, minus this slot's DL
+    // retransmissions and the PRBs muted for this cell
+    uint32_t totalPrbs = m_totalRbgs * m_rbgSize;
+    uint32_t plannedPrbs = m_harqAware ? std::min(m_retxPoolStartPrb, totalPrbs) : totalPrbs;
+    m_sliceSlot.slot = m_currentSlot;
+    m_sliceSlot.rbgSize = m_rbgSize;
+    m_sliceSlot.usablePrbs.assign(plannedPrbs, true);
+    auto hold = [this, plannedPrbs](uint32_t startPrb, uint32_t numPrbs) {
+        for (uint32_t p = startPrb; p < startPrb + numPrbs && p < plannedPrbs; ++p)
+        {
+            m_sliceSlot.usablePrbs[p] = false;
+        }
+    };
+    for (uint32_t rbg = 0; downlink && rbg < m_dlRetxRbgs.size(); ++rbg)
+    {
+        if (m_dlRetxRbgs[rbg])
+        {
+            hold(rbg * m_rbgSize, m_rbgSize);
+        }
+    }
+    for (const auto& r : m_prbRestrictions)
+    {
+        if (r.muted)
+        {
+            hold(r.startPrb, r.numPrbs);
+        }
+    }
+    
+    // Demand: each active UE's buffer in whole RBGs at its current MCS
+    m_sliceSlot.demand.clear();
+    for (const auto& [beamId, ueList] : activeUes)
+    {
+        for (const auto& [ueInfo, bufferBytes] : ueList)
+        {
+            auto it = m_rntiToUeId.find(ueInfo->m_rnti);
+            if (it == m_rntiToUeId.end())
+            {
+                continue;
+            }
+            uint32_t rbgBytes = downlink
+                                    ? GetDlTbSize(ueInfo->m_dlMcs, 1, symAvail, symAvail)
+                                    : m_ulAmc->CalculateTbSize(ueInfo->m_ulMcs, 1, m_rbgSize);
+            uint32_t rbgs = (rbgBytes > 0) ? (bufferBytes + rbgBytes - 1) / rbgBytes : m_totalRbgs;
+            m_sliceSlot.demand.push_back({it->second, std::min(rbgs, m_totalRbgs) * m_rbgSize});
+        }
+    }
+    m_sliceManager->ApplySlotQuotas(allocations, m_sliceSlot, downlink);
+}
+
+void
+NrMilpExecutorScheduler::ApplyPrbRestrictions(uint32_t ueId, std::vector<uint16_t>& rbgs) const
+{
+    if (m_prbRestrictions.empty())
+    {
+        return;
+    }
+    
+    bool edgeUe = m_bwpManager->IsCellEdgeUe(ueId);
+    size_t before = rbgs.size();
+    rbgs.erase(std::remove_if(rbgs.begin(), rbgs.end(),
+                              [&](uint16_t rbg) {
+                                  for (const auto& r : m_prbRestrictions)
+                                  {
+                                      if ((r.muted || edgeUe) &&
+                                          r.Overlaps(rbg * m_rbgSize, m_rbgSize))
+                                      {
+                                          return true;
+                                      }
+                                  }
+                                  return false;
+                              }),
+               rbgs.end());
+    
+    if (rbgs.size() != before)
+    {
+        NS_LOG_DEBUG("  UE " << ueId << ": dropped " << (before - rbgs.size())
+                     << " restricted RBGs");
+    }
+}
+
+// ============================================================================
+// URLLC MINI-SLOT PREEMPTION
+// ============================================================================
+
+NrMilpExecutorScheduler::PreemptionStats&
+NrMilpExecutorScheduler::PreemptionStats::operator+=(const PreemptionStats& other)
+{
+    miniSlots += other.miniSlots;
+    preemptions += other.preemptions;
+    victimDcis += other.victimDcis;
+    freeRbgSymbols += other.freeRbgSymbols;
+    preemptedRbgSymbols += other.preemptedRbgSymbols;
+    urllcBytes += other.urllcBytes;
+    embbBytesLost += other.embbBytesLost;
+    deferrals += other.deferrals;
+    blocked += other.blocked;
+    served += other.served;
+    deadlineMisses += other.deadlineMisses;
+    totalWaitMs += other.totalWaitMs;
+    maxWaitMs = std::max(maxWaitMs, other.maxWaitMs);
+    return *this;
+}
+
+void
+NrMilpExecutorScheduler::PreemptionStats::Print(std::ostream& os) const
+{
+    os << "  Mini-slots:          " << miniSlots << " (" << preemptions
+       << " preempting eMBB, " << victimDcis << " eMBB DCIs shortened)\n"
+       << "  RBG-symbols:         " << freeRbgSymbols << " idle, " << preemptedRbgSymbols
+       << " taken from eMBB\n"
+       << "  Bytes:               " << urllcBytes << " URLLC in mini-slots, " << embbBytesLost
+       << " eMBB lost\n"
+       << "  Deferred to plan:    " << deferrals << " slot(s), blocked " << blocked << "\n"
+       << "  URLLC wait:          mean "
+       << (served ? totalWaitMs / served : 0.0) << " ms, max " << maxWaitMs << " ms, "
+       << deadlineMisses << "/" << served << " over budget\n";
+}
+
+void
+NrMilpExecutorScheduler::EnableUrllcPreemption(const PreemptionParams& params)
+{
+    NS_LOG_FUNCTION(this << params.miniSlotSymbols << params.maxPreemptedFraction);
+    
+    NS_ABORT_MSG_IF(params.miniSlotSymbols == 0, "Mini-slot needs at least one symbol");
+    NS_ABORT_MSG_IF(params.maxPreemptedFraction <= 0.0 || params.maxPreemptedFraction > 1.0,
+                    "maxPreemptedFraction must be in (0, 1]");
+    
+    m_preemption = params;
+    m_preemptionEnabled = true;
+}
+
+void
+NrMilpExecutorScheduler::SetUeLatencyBudget(uint32_t ueId, double latencyMs)
+{
+    NS_LOG_FUNCTION(this << ueId << latencyMs);
+    
+    NS_ABORT_MSG_IF(latencyMs <= 0.0, "UE " << ueId << ": latency budget must be > 0");
+    m_ueLatencyBudgetMs[ueId] = latencyMs;
+}
+
+const NrMilpExecutorScheduler::PreemptionStats&
+NrMilpExecutorScheduler::GetPreemptionStats() const
+{
+    return m_preemptionStats;
+}
+
+uint32_t
+NrMilpExecutorScheduler::GetDlTbSize(uint8_t mcs,
+                                     uint32_t numRbgs,
+                                     uint32_t numSym,
+                                     uint32_t slotSym) const
+{
+    if (numRbgs == 0 || numSym == 0 || slotSym == 0)
+    {
+        return 0;
+    }
+    uint32_t numPrbs = std::max<uint32_t>(1, numRbgs * m_rbgSize * numSym / slotSym);
+    return m_dlAmc->CalculateTbSize(mcs, 1, numPrbs);  // rank 1 (SISO)
+}
+
+void
+NrMilpExecutorScheduler::PreemptForUrllc(uint32_t symAvail, const ActiveUeMap& activeDl) const
+{
+    uint32_t miniSym = m_preemption.miniSlotSymbols;
+    if (miniSym >= symAvail)
+    {
+        return;
+    }
+    
+    using UePtr = std::shared_ptr<NrMacSchedulerUeInfo>;
+    
+    // URLLC UE with buffered data in this slot
+    struct Candidate
+    {
+        UePtr ue;
+        uint32_t ueId;
+        uint32_t bufferBytes;
+        uint32_t arrivalSlot;
+        double budgetMs;
+    };
+    
+    // ----- Split active UEs: URLLC candidates vs eMBB holders -----
+    // RBGs of this slot's HARQ retransmissions are never lent or preempted
+    std::vector<bool> busy(m_totalRbgs, false);
+    for (uint32_t rbg = 0; rbg < m_dlRetxRbgs.size() && rbg < m_totalRbgs; ++rbg)
+    {
+        busy[rbg] = m_dlRetxRbgs[rbg];
+    }
+    std::vector<UePtr> victims;
+    std::vector<Candidate> candidates;
+    std::unordered_set<uint16_t> backlogged;
+    
+    for (const auto& [beamId, ueList] : activeDl)
+    {
+        for (const auto& [ueInfo, bufferBytes] : ueList)
+        {
+            for (uint16_t rbg : ueInfo->m_dlRBG)
+            {
+                if (rbg < m_totalRbgs)
+                {
+                    busy[rbg] = true;
+                }
+            }
+            auto ueIdIt = m_rntiToUeId.find(ueInfo->m_rnti);
+            if (ueIdIt == m_rntiToUeId.end())
+            {
+                continue;
+            }
+            auto budgetIt = m_ueLatencyBudgetMs.find(ueIdIt->second);
+            if (budgetIt == m_ueLatencyBudgetMs.end())
+            {
+                if (!ueInfo->m_dlRBG.empty())
+                {
+                    victims.push_back(ueInfo);
+                }
+                continue;
+            }
+            
+            // A new backlog starts its latency clock now
+            auto arrivalIt = m_urllcArrivalSlot.emplace(ueInfo->m_rnti, m_currentSlot).first;
+            backlogged.insert(ueInfo->m_rnti);
+            candidates.push_back(
+                {ueInfo, ueIdIt->second, bufferBytes, arrivalIt->second, budgetIt->second});
+        }
+    }
+    
+    // Backlogs drained since the last slot
+    for (auto it = m_urllcArrivalSlot.begin(); it != m_urllcArrivalSlot.end();)
+    {
+        it = backlogged.count(it->first) ? std::next(it) : m_urllcArrivalSlot.erase(it);
+    }
+    
+    if (candidates.empty())
+    {
+        return;
+    }
+    
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.arrivalSlot < b.arrivalSlot;
+    });
+    
+    std::vector<uint16_t> idleRbgs;
+    for (uint32_t rbg = m_totalRbgs; rbg-- > 0;)
+    {
+        if (!busy[rbg])
+        {
+            idleRbgs.push_back(static_cast<uint16_t>(rbg));
+        }
+    }
+    std::vector<uint16_t> lentRbgs;  // Victims' RBGs left over during the mini-slot
+    uint32_t rbgBudget =
+        static_cast<uint32_t>(m_preemption.maxPreemptedFraction * m_totalRbgs);
+    
+    auto recordService = [this](const Candidate& c) {
+        double waitMs = static_cast<double>(m_currentSlot - c.arrivalSlot) / m_slotsPerMs;
+        m_preemptionStats.served++;
+        m_preemptionStats.totalWaitMs += waitMs;
+        m_preemptionStats.maxWaitMs = std::max(m_preemptionStats.maxWaitMs, waitMs);
+        m_preemptionStats.deadlineMisses += (waitMs > c.budgetMs) ? 1 : 0;
+        m_urllcArrivalSlot[c.ue->m_rnti] = m_currentSlot + 1;  // Rest of the buffer
+    };
+    
+    for (const Candidate& c : candidates)
+    {
+        // ----- Served by the plan in this slot -----
+        if (!c.ue->m_dlRBG.empty())
+        {
+            recordService(c);
+            continue;
+        }
+        
+        // ----- Plan serves it before the deadline: wait -----
+        uint32_t deadline = c.arrivalSlot + static_cast<uint32_t>(c.budgetMs * m_slotsPerMs);
+        if (m_bwpManager->IsUePlannedInWindow(c.ueId, m_currentSlot + 1, deadline))
+        {
+            m_preemptionStats.deferrals++;
+            continue;
+        }
+        
+        // ----- Size the mini-slot from the buffer -----
+        uint32_t want = 0;
+        while (want < rbgBudget &&
+               GetDlTbSize(c.ue->m_dlMcs, want, miniSym, symAvail) < c.bufferBytes)
+        {
+            want++;
+        }
+        
+        // Idle and already-lent RBGs cost eMBB nothing
+        std::vector<uint16_t> rbgs;
+        uint32_t idleUsed = 0;
+        while (rbgs.size() < want && !idleRbgs.empty())
+        {
+            rbgs.push_back(idleRbgs.back());
+            idleRbgs.pop_back();
+            idleUsed++;
+        }
+        while (rbgs.size() < want && !lentRbgs.empty())
+        {
+            rbgs.push_back(lentRbgs.back());
+            lentRbgs.pop_back();
+        }
+        
+        // Shorten eMBB victims: smallest one covering the remainder, else
+        // the largest, so the fewest eMBB symbols are lost
+        bool preempted = false;
+        while (rbgs.size() < want && !victims.empty())
+        {
+            size_t remaining = want - rbgs.size();
+            auto pick = victims.begin();
+            for (auto it = std::next(victims.begin()); it != victims.end(); ++it)
+            {
+                size_t n = (*it)->m_dlRBG.size();
+                size_t best = (*pick)->m_dlRBG.size();
+                bool covers = n >= remaining;
+                bool bestCovers = best >= remaining;
+                if ((covers && (!bestCovers || n < best)) || (!covers && !bestCovers && n > best))
+                {
+                    pick = it;
+                }
+            }
+            UePtr victim = *pick;
+            victims.erase(pick);
+            
+            uint32_t n = victim->m_dlRBG.size();
+            m_dlSymbolWindows[victim->m_rnti] = {miniSym, symAvail - miniSym};
+            m_preemptionStats.victimDcis++;
+            m_preemptionStats.preemptedRbgSymbols += static_cast<uint64_t>(n) * miniSym;
+            m_preemptionStats.embbBytesLost +=
+                GetDlTbSize(victim->m_dlMcs, n, symAvail, symAvail) -
+                GetDlTbSize(victim->m_dlMcs, n, symAvail - miniSym, symAvail);
+            for (uint16_t rbg : victim->m_dlRBG)
+            {
+                (rbgs.size() < want ? rbgs : lentRbgs).push_back(rbg);
+            }
+            preempted = true;
+        }
+        
+        if (rbgs.empty())
+        {
+            m_preemptionStats.blocked++;
+            continue;
+        }
+        
+        std::sort(rbgs.begin(), rbgs.end());
+        c.ue->m_dlRBG = rbgs;
+        m_dlSymbolWindows[c.ue->m_rnti] = {0, miniSym};
+        rbgBudget -= std::min<uint32_t>(rbgBudget, rbgs.size());
+        
+        m_preemptionStats.miniSlots++;
+        m_preemptionStats.preemptions += preempted ? 1 : 0;
+        m_preemptionStats.freeRbgSymbols += static_cast<uint64_t>(idleUsed) * miniSym;
+        m_preemptionStats.urllcBytes += GetDlTbSize(c.ue->m_dlMcs, rbgs.size(), miniSym, symAvail);
+        recordService(c);
+        
+        NS_LOG_DEBUG("  URLLC UE " << c.ueId << ": mini-slot of " << miniSym << " symbols on "
+                     << rbgs.size() << " RBGs (" << idleUsed << " idle)"
+                     << (preempted ? ", preempting eMBB" : ""));
+    }
+}
+
+// ============================================================================
+// HARQ-AWARE EXECUTION
+// ============================================================================
+
+NrMilpExecutorScheduler::HarqUeStats&
+NrMilpExecutorScheduler::HarqUeStats::operator+=(const HarqUeStats& other)
+{
+    dlRetx += other.dlRetx;
+    dlRetxPrbs += other.dlRetxPrbs;
+    dlFromPool += other.dlFromPool;
+    dlFromOwnPlan += other.dlFromOwnPlan;
+    dlFromOthers += other.dlFromOthers;
+    dlTimeDomain += other.dlTimeDomain;
+    displacedPrbs += other.displacedPrbs;
+    ulRetx += other.ulRetx;
+    ulRetxPrbs += other.ulRetxPrbs;
+    return *this;
+}
+
+void
+NrMilpExecutorScheduler::EnableHarqAwareExecution(uint32_t reservedFromPrb)
+{
+    NS_LOG_FUNCTION(this << reservedFromPrb);
+    
+    m_retxPoolStartPrb = reservedFromPrb;
+    m_harqAware = true;
+}
+
+const std::unordered_map<uint32_t, NrMilpExecutorScheduler::HarqUeStats>&
+NrMilpExecutorScheduler::GetHarqStats() const
+{
+    return m_harqStats;
+}
+
+void
+NrMilpExecutorScheduler::CacheRbgParameters() const
+{
+    if (m_rbgSize == 0)
+    {
+        m_rbgSize = GetNumRbPerRbg();
+        m_totalRbgs = GetBandwidthInRbg();
+        
+        NS_LOG_INFO("Cached RBG parameters: rbgSize=" << m_rbgSize 
+                    << ", totalRbgs=" << m_totalRbgs);
+    }
+}
+
+bool
+NrMilpExecutorScheduler::PlaceDlRetx(const DciInfoElementTdma& dci,
+                                     const std::vector<uint16_t>& plannedOwner,
+                                     std::vector<bool>& usedRbgs,
+                                     DlRetxPlacement& placement) const
+{
+    uint32_t need = std::count(dci.m_rbgBitmask.begin(), dci.m_rbgBitmask.end(), true);
+    
+    // Preference: 0 = reserved pool, 1 = own plan, 2 = idle, 3 = other UEs' plan
+    auto tierOf = [&](uint32_t rbg) {
+        if (rbg * m_rbgSize >= m_retxPoolStartPrb)
+        {
+            return 0;
+        }
+        if (plannedOwner[rbg] == dci.m_rnti)
+        {
+            return 1;
+        }
+        return (plannedOwner[rbg] == 0) ? 2 : 3;
+    };
+    
+    std::vector<uint16_t> chosen;
+    std::array<uint32_t, 4> fromTier{};
+    for (int tier = 0; tier < 4 && chosen.size() < need; ++tier)
+    {
+        for (uint32_t rbg = 0; rbg < m_totalRbgs && chosen.size() < need; ++rbg)
+        {
+            if (!usedRbgs[rbg] && tierOf(rbg) == tier)
+            {
+                chosen.push_back(static_cast<uint16_t>(rbg));
+                fromTier[tier]++;
+            }
+        }
+    }
+    if (chosen.size() < need)
+    {
+        return false;
+    }
+    
+    placement.rbgBitmask.assign(m_totalRbgs, false);
+    for (uint16_t rbg : chosen)
+    {
+        placement.rbgBitmask[rbg] = true;
+        usedRbgs[rbg] = true;
+    }
+    if (fromTier[0] == need)
+    {
+        placement.source = DlRetxPlacement::POOL;
+    }
+    else if (fromTier[2] + fromTier[3] == 0)
+    {
+        placement.source = DlRetxPlacement::OWN_PLAN;
+    }
+    else
+    {
+        placement.source = DlRetxPlacement::OTHERS;
+    }
+    return true;
+}
+
+uint8_t
+NrMilpExecutorScheduler::ScheduleDlHarq(
+    PointInFTPlane* startingPoint,
+    uint8_t symAvail,
+    const ActiveHarqMap& activeDlHarq,
+    const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap,
+    std::vector<DlHarqInfo>* dlHarqToRetransmit,
+    const std::vector<DlHarqInfo>& dlHarqFeedback,
+    SlotAllocInfo* slotAlloc) const
+{
+    NS_LOG_FUNCTION(this);
+    
+    uint8_t dataSym = startingPoint->m_sym;
+    size_t first = slotAlloc->m_varTtiAllocInfo.size();
+    uint8_t symUsed = NrMacSchedulerTdma::ScheduleDlHarq(startingPoint,
+                                                         symAvail,
+                                                         activeDlHarq,
+                                                         ueMap,
+                                                         dlHarqToRetransmit,
+                                                         dlHarqFeedback,
+                                                         slotAlloc);
+    
+    // Retransmission DCIs the base appended for this slot
+    std::vector<size_t> retx;
+    for (size_t i = first; i < slotAlloc->m_varTtiAllocInfo.size(); ++i)
+    {
+        const auto& dci = slotAlloc->m_varTtiAllocInfo[i].m_dci;
+        if (dci->m_format == DciInfoElementTdma::DL && dci->m_type == DciInfoElementTdma::DATA)
+        {
+            retx.push_back(i);
+        }
+    }
+    
+    for (size_t i : retx)
+    {
+        const auto& dci = slotAlloc->m_varTtiAllocInfo[i].m_dci;
+        auto ueIdIt = m_rntiToUeId.find(dci->m_rnti);
+        if (ueIdIt != m_rntiToUeId.end())
+        {
+            HarqUeStats& stats = m_harqStats[ueIdIt->second];
+            stats.dlRetx++;
+            stats.dlRetxPrbs +=
+                std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), true) *
+                GetNumRbPerRbg();
+        }
+    }
+    
+    if (!m_harqAware || retx.empty() || !m_bwpManager)
+    {
+        return symUsed;
+    }
+    
+    CacheRbgParameters();
+    
+    // Owner of every RBG in this slot's plan
+    std::vector<uint16_t> plannedOwner(m_totalRbgs, 0);
+    for (const auto& alloc : m_bwpManager->GetAllocationForSlot(m_currentSlot))
+    {
+        auto rntiIt = m_ueIdToRnti.find(alloc.ueId);
+        if (rntiIt == m_ueIdToRnti.end() || alloc.numPrbs == 0)
+        {
+            continue;
+        }
+        uint32_t endRbg = std::min<uint32_t>(m_totalRbgs,
+                                             (alloc.startPrb + alloc.numPrbs + m_rbgSize - 1) /
+                                                 m_rbgSize);
+        for (uint32_t rbg = alloc.startPrb / m_rbgSize; rbg < endRbg; ++rbg)
+        {
+            plannedOwner[rbg] = rntiIt->second;
+        }
+    }
+    
+    // All retransmissions move into frequency, or none do: a partial move
+    // could overlap the ones the base stacked in time. Dry run first.
+    std::vector<bool> usedRbgs(m_totalRbgs, false);
+    std::vector<DlRetxPlacement> placements(retx.size());
+    bool allPlaced = true;
+    for (size_t k = 0; k < retx.size() && allPlaced; ++k)
+    {
+        allPlaced = PlaceDlRetx(*slotAlloc->m_varTtiAllocInfo[retx[k]].m_dci,
+                                plannedOwner,
+                                usedRbgs,
+                                placements[k]);
+    }
+    
+    if (!allPlaced)
+    {
+        for (size_t i : retx)
+        {
+            auto ueIdIt = m_rntiToUeId.find(slotAlloc->m_varTtiAllocInfo[i].m_dci->m_rnti);
+            if (ueIdIt != m_rntiToUeId.end())
+            {
+                m_harqStats[ueIdIt->second].dlTimeDomain++;
+            }
+        }
+        m_dlRetxRbgs.clear();
+        NS_LOG_DEBUG("Slot " << m_currentSlot << ": " << retx.size()
+                     << " DL retx do not fit in frequency, " << +symUsed << " symbols used");
+        return symUsed;
+    }
+    
+    // Commit: the base's DCIs are shared with their HARQ processes and
+    // their symbol is const, so each retx gets a copy on the first data
+    // symbol that replaces it in the slot and in the HARQ process
+    m_dlRetxRbgs = usedRbgs;
+    for (size_t k = 0; k < retx.size(); ++k)
+    {
+        std::shared_ptr<DciInfoElementTdma> old = slotAlloc->m_varTtiAllocInfo[retx[k]].m_dci;
+        auto dci = std::make_shared<DciInfoElementTdma>(dataSym,
+                                                        old->m_numSym,
+                                                        old->m_ndi,
+                                                        old->m_rv,
+                                                        *old);
+        dci->m_rbgBitmask = placements[k].rbgBitmask;
+        slotAlloc->m_varTtiAllocInfo[retx[k]].m_dci = dci;
+        
+        auto harqIt = activeDlHarq.find(old->m_rnti);
+        if (harqIt != activeDlHarq.end())
+        {
+            for (const auto& process : harqIt->second)
+            {
+                if (process->second.m_dciElement == old)
+                {
+                    process->second.m_dciElement = dci;
+                }
+            }
+        }
+        
+        auto ueIdIt = m_rntiToUeId.find(old->m_rnti);
+        if (ueIdIt != m_rntiToUeId.end())
+        {
+            HarqUeStats& stats = m_harqStats[ueIdIt->second];
+            switch (placements[k].source)
+            {
+            case DlRetxPlacement::POOL:
+                stats.dlFromPool++;
+                break;
+            case DlRetxPlacement::OWN_PLAN:
+                stats.dlFromOwnPlan++;
+                break;
+            case DlRetxPlacement::OTHERS:
+                stats.dlFromOthers++;
+                break;
+            }
+        }
+    }
+    
+    NS_LOG_DEBUG("Slot " << m_currentSlot << ": " << retx.size()
+                 << " DL retx placed on data symbols, plan keeps " << +symAvail << " symbols");
+    startingPoint->m_sym = dataSym;
+    return 0;
+}
+
+uint8_t
+NrMilpExecutorScheduler::ScheduleUlHarq(
+    PointInFTPlane* startingPoint,
+    uint8_t symAvail,
+    const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap,
+    std::vector<UlHarqInfo>* ulHarqToRetransmit,
+    const std::vector<UlHarqInfo>& ulHarqFeedback,
+    SlotAllocInfo* slotAlloc) const
+{
+    NS_LOG_FUNCTION(this);
+    
+    size_t first = slotAlloc->m_varTtiAllocInfo.size();
+    uint8_t symUsed = NrMacSchedulerTdma::ScheduleUlHarq(startingPoint,
+                                                         symAvail,
+                                                         ueMap,
+                                                         ulHarqToRetransmit,
+                                                         ulHarqFeedback,
+                                                         slotAlloc);
+    
+    for (size_t i = first; i < slotAlloc->m_varTtiAllocInfo.size(); ++i)
+    {
+        const auto& dci = slotAlloc->m_varTtiAllocInfo[i].m_dci;
+        auto ueIdIt = m_rntiToUeId.find(dci->m_rnti);
+        if (dci->m_format != DciInfoElementTdma::UL || ueIdIt == m_rntiToUeId.end())
+        {
+            continue;
+        }
+        HarqUeStats& stats = m_harqStats[ueIdIt->second];
+        stats.ulRetx++;
+        stats.ulRetxPrbs +=
+            std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), true) *
+            GetNumRbPerRbg();
+    }
+    return symUsed;
+}
+
 // ============================================================================
 // TRIGGER METHODS (Track Current Slot)
 // ============================================================================
@@ -143,21 +889,18 @@ NrMilpExecutorScheduler::DoSchedDlTriggerReq(
      * Using GetEncoding() directly causes unordered_map::at() crash in the parent
      * because the packed value (e.g. 984576) is not a key in m_slotAllocations.
      *
-     * Correct formula for μ=1 (30 kHz SCS, 0.5 ms slots):
-     *   slotsPerSubframe = 2^μ = 2
-     *   slotsPerFrame    = 10 * 2 = 20
-     *   absoluteSlot     = frame * 20 + subframe * 2 + slot
+     * Absolute slot index, with slotsPerSubframe = 2^μ of this BWP:
+     *   absoluteSlot = frame * 10 * 2^μ + subframe * 2^μ + slot
      *
-     * Example: t=0.153s → absolute slot 306
+     * Example (μ=1): t=0.153s → absolute slot 306
      *   frame=15, subframe=3, slot=0 → 15*20 + 3*2 + 0 = 306 ✓
+     *
+     * SfnSf::Normalize() computes exactly this using the SfnSf's own
+     * numerology, so carriers with μ≠1 index their own plan correctly.
      */
-    {
-        uint32_t frame    = params.m_snfSf.GetFrame();
-        uint32_t subframe = params.m_snfSf.GetSubframe();
-        uint32_t slot     = params.m_snfSf.GetSlot();
-        // μ=1 → 2 slots/subframe, 20 slots/frame (fixed in this project)
-        m_currentSlot = frame * 20 + subframe * 2 + slot;
-    }
+    m_currentSlot = static_cast<uint32_t>(params.m_snfSf.Normalize());
+    m_slotsPerMs = 1u << params.m_snfSf.GetNumerology();
+    m_dlRetxRbgs.clear();  // Filled by ScheduleDlHarq() for this slot
     
     std::cout << "[MILP-DBG] DL Trigger: slot=" << m_currentSlot
               << " harqFeedback=" << params.m_dlHarqInfoList.size() << std::flush << std::endl;
@@ -187,16 +930,11 @@ NrMilpExecutorScheduler::DoSchedUlTriggerReq(
     /*
      * Same as DL trigger — convert SfnSf to absolute slot index.
      *
-     * Note: UL scheduling happens with N2 delay (N2=2 slots for μ=1).
+     * Note: UL scheduling happens with N2 delay (N2 slots of this BWP's numerology).
      * params.m_snfSf refers to the UL slot being prepared, not the current DL slot.
      * We use the same absolute conversion so MILP allocations match correctly.
      */
-    {
-        uint32_t frame    = params.m_snfSf.GetFrame();
-        uint32_t subframe = params.m_snfSf.GetSubframe();
-        uint32_t slot     = params.m_snfSf.GetSlot();
-        m_currentSlot = frame * 20 + subframe * 2 + slot;
-    }
+    m_currentSlot = static_cast<uint32_t>(params.m_snfSf.Normalize());
     
     std::cout << "[MILP-DBG] UL Trigger: slot=" << m_currentSlot << std::flush << std::endl;
 
@@ -264,14 +1002,7 @@ NrMilpExecutorScheduler::AssignDLRBG(uint32_t symAvail,
     }
     
     // Initialize RBG size and total RBGs (cached for efficiency)
-    if (m_rbgSize == 0)
-    {
-        m_rbgSize = GetNumRbPerRbg();
-        m_totalRbgs = GetBandwidthInRbg();
-        
-        NS_LOG_INFO("Cached RBG parameters: rbgSize=" << m_rbgSize 
-                    << ", totalRbgs=" << m_totalRbgs);
-    }
+    CacheRbgParameters();
     
     // ========================================================================
     // Step 2: Query MILP Allocations for Current Slot
@@ -279,11 +1010,16 @@ NrMilpExecutorScheduler::AssignDLRBG(uint32_t symAvail,
     
     // Get MILP allocations for this slot
     auto milpAllocations = m_bwpManager->GetAllocationForSlot(m_currentSlot);
+    if (m_sliceManager)
+    {
+        ApplySliceQuotas(milpAllocations, activeDl, symAvail, true);
+    }
     
     NS_LOG_DEBUG("Slot " << m_currentSlot << ": Found " << milpAllocations.size() 
                  << " MILP allocations");
     
-    if (milpAllocations.empty())
+    // Idle slots may still carry URLLC mini-slots
+    if (milpAllocations.empty() && !m_preemptionEnabled)
     {
         NS_LOG_DEBUG("No MILP allocations for this slot (idle slot)");
         BeamSymbolMap emptyMap;
@@ -294,6 +1030,18 @@ NrMilpExecutorScheduler::AssignDLRBG(uint32_t symAvail,
     // Step 3: Assign RBGs to Each UE Based on MILP Allocation
     // ========================================================================
     
+    std::vector<bool> assigned = OrderPlannedUesFirst(milpAllocations);
+    
+    // Only this slot's RBGs may reach CreateDlDci()
+    m_dlSymbolWindows.clear();
+    for (const auto& [beamId, ueList] : activeDl)
+    {
+        for (const auto& [ueInfo, bufferStatus] : ueList)
+        {
+            ueInfo->m_dlRBG.clear();
+        }
+    }
+    
     for (const auto& alloc : milpAllocations)
     {
         /*
@@ -338,12 +1086,21 @@ NrMilpExecutorScheduler::AssignDLRBG(uint32_t symAvail,
                     uint32_t numRbg = (alloc.numPrbs + m_rbgSize - 1) / m_rbgSize;  // Round up
                     
                     // Store in UE info (used by CreateDlDci)
-                    // m_dlRBG is a vector of RBG indices
-                    ueInfo->m_dlRBG.clear();
+                    // m_dlRBG is a vector of RBG indices; a UE may hold
+                    // several ranges in one slot, so append
                     for (uint32_t rbg = startRbg; rbg < startRbg + numRbg; rbg++)
                     {
+                        if (!assigned.empty())
+                        {
+                            if (rbg >= assigned.size() || assigned[rbg])
+                            {
+                                continue;
+                            }
+                            assigned[rbg] = true;
+                        }
                         ueInfo->m_dlRBG.push_back(static_cast<uint16_t>(rbg));
                     }
+                    ApplyPrbRestrictions(alloc.ueId, ueInfo->m_dlRBG);
                     
                     NS_LOG_DEBUG("  UE " << alloc.ueId << " (RNTI " << rnti << "): "
                                  << "PRBs [" << alloc.startPrb << "-" 
@@ -363,6 +1120,36 @@ NrMilpExecutorScheduler::AssignDLRBG(uint32_t symAvail,
         }
     }
     
+    // HARQ retransmissions own their RBGs in this slot
+    if (!m_dlRetxRbgs.empty())
+    {
+        for (const auto& [beamId, ueList] : activeDl)
+        {
+            for (const auto& [ueInfo, bufferStatus] : ueList)
+            {
+                auto& rbgs = ueInfo->m_dlRBG;
+                size_t before = rbgs.size();
+                rbgs.erase(std::remove_if(rbgs.begin(),
+                                          rbgs.end(),
+                                          [this](uint16_t rbg) {
+                                              return rbg < m_dlRetxRbgs.size() &&
+                                                     m_dlRetxRbgs[rbg];
+                                          }),
+                           rbgs.end());
+                auto ueIdIt = m_rntiToUeId.find(ueInfo->m_rnti);
+                if (rbgs.size() != before && ueIdIt != m_rntiToUeId.end())
+                {
+                    m_harqStats[ueIdIt->second].displacedPrbs += (before - rbgs.size()) * m_rbgSize;
+                }
+            }
+        }
+    }
+    
+    if (m_preemptionEnabled)
+    {
+        PreemptForUrllc(symAvail, activeDl);
+    }
+    
     // ========================================================================
     // Step 4: Return Symbol Allocation (OFDMA Style)
     // ========================================================================
@@ -410,14 +1197,14 @@ NrMilpExecutorScheduler::AssignULRBG(uint32_t symAvail,
     }
     
     // Initialize RBG parameters if needed
-    if (m_rbgSize == 0)
-    {
-        m_rbgSize = GetNumRbPerRbg();
-        m_totalRbgs = GetBandwidthInRbg();
-    }
+    CacheRbgParameters();
     
     // Query MILP allocations
     auto milpAllocations = m_bwpManager->GetAllocationForSlot(m_currentSlot);
+    if (m_sliceManager)
+    {
+        ApplySliceQuotas(milpAllocations, activeUl, symAvail, false);
+    }
     
     NS_LOG_DEBUG("UL Slot " << m_currentSlot << ": Found " << milpAllocations.size() 
                  << " MILP allocations");
@@ -428,7 +1215,17 @@ NrMilpExecutorScheduler::AssignULRBG(uint32_t symAvail,
         return emptyMap;
     }
     
-    // Assign RBGs to UEs
+    std::vector<bool> assigned = OrderPlannedUesFirst(milpAllocations);
+    
+    // Assign RBGs to UEs (only this slot's RBGs may reach CreateUlDci())
+    for (const auto& [beamId, ueList] : activeUl)
+    {
+        for (const auto& [ueInfo, bufferStatus] : ueList)
+        {
+            ueInfo->m_ulRBG.clear();
+        }
+    }
+    
     for (const auto& alloc : milpAllocations)
     {
         auto rntiIt = m_ueIdToRnti.find(alloc.ueId);
@@ -449,11 +1246,20 @@ NrMilpExecutorScheduler::AssignULRBG(uint32_t symAvail,
                     uint32_t numRbg = (alloc.numPrbs + m_rbgSize - 1) / m_rbgSize;
                     
                     // Store in UE info (m_ulRBG is a vector of RBG indices)
-                    ueInfo->m_ulRBG.clear();
+                    // A UE may hold several ranges in one slot: append
                     for (uint32_t rbg = startRbg; rbg < startRbg + numRbg; rbg++)
                     {
+                        if (!assigned.empty())
+                        {
+                            if (rbg >= assigned.size() || assigned[rbg])
+                            {
+                                continue;
+                            }
+                            assigned[rbg] = true;
+                        }
                         ueInfo->m_ulRBG.push_back(static_cast<uint16_t>(rbg));
                     }
+                    ApplyPrbRestrictions(alloc.ueId, ueInfo->m_ulRBG);
                     
                     NS_LOG_DEBUG("  UL UE " << alloc.ueId << " (RNTI " << rnti << "): "
                                  << "RBGs [" << startRbg << "-" << (startRbg + numRbg - 1) << "]");
@@ -526,10 +1332,12 @@ NrMilpExecutorScheduler::CreateDlDci(
      * 
      * Steps:
      * 1. Map RNTI → ueId
-     * 2. Query MILP allocation for this UE at current slot
-     * 3. If no allocation, return nullptr (UE not scheduled)
-     * 4. Convert PRB → RBG bitmask
-     * 5. Assign symbols (all symbols - OFDMA)
+     * 2. Take the RBGs AssignDLRBG() stored for this slot (plan after
+     *    slice quotas, PRB restrictions and URLLC preemption)
+     * 3. If none, return nullptr (UE not scheduled)
+     * 4. Convert RBG list → bitmask
+     * 5. Assign symbols (all symbols - OFDMA, or the UE's mini-slot /
+     *    post-mini-slot window)
      * 6. Set MCS (from UE info)
      * 7. Calculate TBS (Transport Block Size)
      * 8. Return DCI
@@ -551,35 +1359,46 @@ NrMilpExecutorScheduler::CreateDlDci(
     uint32_t ueId = ueIdIt->second;
     
     // ========================================================================
-    // Step 2: Query MILP Allocation
+    // Step 2: RBGs Assigned for This Slot
     // ========================================================================
     
-    auto alloc = m_bwpManager->GetUeAllocationForSlot(m_currentSlot, ueId);
+    const std::vector<uint16_t>& rbgs = ueInfo->m_dlRBG;
     
-    if (!alloc.has_value())
+    if (rbgs.empty())
     {
         // No allocation for this UE in this slot
-        NS_LOG_DEBUG("No MILP allocation for UE " << ueId << " at slot " << m_currentSlot);
+        NS_LOG_DEBUG("No RBGs for UE " << ueId << " at slot " << m_currentSlot);
         return nullptr;
     }
     
     NS_LOG_DEBUG("Creating DL DCI for UE " << ueId << " (RNTI " << rnti << ")");
     
     // ========================================================================
-    // Step 3: Convert PRB → RBG Bitmask
+    // Step 3: Convert RBG List → Bitmask
     // ========================================================================
     
     /*
-     * MILP allocation: PRBs [startPrb, startPrb + numPrbs - 1]
      * ns-3 needs: RBG bitmask (vector of bool)
      */
     
-    std::vector<bool> rbgBitmask = ConvertPrbToRbgBitmask(
-        alloc->startPrb,
-        alloc->numPrbs,
-        m_rbgSize,
-        m_totalRbgs
-    );
+    std::vector<bool> rbgBitmask(m_totalRbgs, false);
+    for (uint16_t rbg : rbgs)
+    {
+        if (rbg < m_totalRbgs)
+        {
+            rbgBitmask[rbg] = true;
+        }
+    }
+    
+    // Mini-slot UEs and their eMBB victims use part of the slot
+    uint32_t symOffset = 0;
+    uint32_t numSym = maxSym;
+    auto windowIt = m_dlSymbolWindows.find(rnti);
+    if (windowIt != m_dlSymbolWindows.end())
+    {
+        symOffset = windowIt->second.first;
+        numSym = windowIt->second.second;
+    }
     
     // ========================================================================
     // Step 4: Create DCI Using Constructor
@@ -600,8 +1419,8 @@ NrMilpExecutorScheduler::CreateDlDci(
      */
     
     auto dci = std::make_shared<DciInfoElementTdma>(
-        spoint->m_sym,                          // symStart
-        maxSym,                                 // numSym (all symbols - OFDMA)
+        spoint->m_sym + symOffset,              // symStart
+        numSym,                                 // numSym (all symbols - OFDMA)
         DciInfoElementTdma::DL,                 // DciFormat::DL (qualified)
         DciInfoElementTdma::DATA,               // VarTtiType::DATA (qualified)
         rbgBitmask                              // RBG bitmask
@@ -627,18 +1446,15 @@ NrMilpExecutorScheduler::CreateDlDci(
      * CalculateTbSize(mcs, rank, nprb)
      * - mcs: Modulation/Coding Scheme
      * - rank: MIMO rank (1 for SISO, 2 for 2x2 MIMO, etc.)
-     * - nprb: Number of PRBs
+     * - nprb: Number of PRBs (scaled by the share of symbols used)
      * 
      * m_tbSize is also const, so we need const_cast.
      */
     
-    uint32_t numPrbs = alloc->numPrbs;
-    uint8_t rank = 1;  // SISO (single antenna)
-    
-    uint32_t tbSize = m_dlAmc->CalculateTbSize(dci->m_mcs, rank, numPrbs);
+    uint32_t tbSize = GetDlTbSize(dci->m_mcs, rbgs.size(), numSym, maxSym);
     const_cast<uint32_t&>(dci->m_tbSize) = tbSize;
     
-    NS_LOG_DEBUG("  DCI: RBGs=" << (alloc->numPrbs / m_rbgSize) 
+    NS_LOG_DEBUG("  DCI: RBGs=" << rbgs.size() 
                  << ", Symbols=[" << dci->m_symStart << "-" 
                  << (dci->m_symStart + dci->m_numSym - 1) << "]"
                  << ", MCS=" << static_cast<uint32_t>(dci->m_mcs)
@@ -656,7 +1472,7 @@ NrMilpExecutorScheduler::CreateDlDci(
      */
     
     // Move cursor in frequency (RBG dimension)
-    spoint->m_rbg += (alloc->numPrbs / m_rbgSize);
+    spoint->m_rbg += rbgs.size();
     
     return dci;
 }
@@ -683,22 +1499,24 @@ NrMilpExecutorScheduler::CreateUlDci(
     }
     uint32_t ueId = ueIdIt->second;
     
-    // Query MILP allocation
-    auto alloc = m_bwpManager->GetUeAllocationForSlot(m_currentSlot, ueId);
-    if (!alloc.has_value())
+    // RBGs assigned by AssignULRBG() for this slot
+    const std::vector<uint16_t>& rbgs = ueInfo->m_ulRBG;
+    if (rbgs.empty())
     {
         return nullptr;
     }
     
     NS_LOG_DEBUG("Creating UL DCI for UE " << ueId << " (RNTI " << rnti << ")");
     
-    // Convert PRB → RBG bitmask
-    std::vector<bool> rbgBitmask = ConvertPrbToRbgBitmask(
-        alloc->startPrb,
-        alloc->numPrbs,
-        m_rbgSize,
-        m_totalRbgs
-    );
+    // Convert RBG list → bitmask
+    std::vector<bool> rbgBitmask(m_totalRbgs, false);
+    for (uint16_t rbg : rbgs)
+    {
+        if (rbg < m_totalRbgs)
+        {
+            rbgBitmask[rbg] = true;
+        }
+    }
     
     // Create DCI using constructor (properly qualified enum values)
     auto dci = std::make_shared<DciInfoElementTdma>(
@@ -716,20 +1534,20 @@ NrMilpExecutorScheduler::CreateUlDci(
     const_cast<uint8_t&>(dci->m_mcs) = ueInfo->m_ulMcs;
     
     // Calculate TBS (m_tbSize is also const)
-    uint32_t numPrbs = alloc->numPrbs;
+    uint32_t numPrbs = rbgs.size() * m_rbgSize;
     uint8_t rank = 1;  // SISO
     
     uint32_t tbSize = m_ulAmc->CalculateTbSize(dci->m_mcs, rank, numPrbs);
     const_cast<uint32_t&>(dci->m_tbSize) = tbSize;
     
-    NS_LOG_DEBUG("  UL DCI: RBGs=" << (alloc->numPrbs / m_rbgSize)
+    NS_LOG_DEBUG("  UL DCI: RBGs=" << rbgs.size()
                  << ", Symbols=[" << dci->m_symStart << "-"
                  << (dci->m_symStart + dci->m_numSym - 1) << "]"
                  << ", MCS=" << static_cast<uint32_t>(dci->m_mcs)
                  << ", TBS=" << dci->m_tbSize << " bytes");
     
     // Update cursor
-    spoint->m_rbg += (alloc->numPrbs / m_rbgSize);
+    spoint->m_rbg += rbgs.size();
     
     return dci;
 }
@@ -873,9 +1691,9 @@ std::vector<bool>
 NrMilpExecutorScheduler::ConvertPrbToRbgBitmask(uint32_t startPrb,
                                                  uint32_t numPrbs,
                                                  uint32_t rbgSize,
-                                                 uint32_t totalRbgs) const
+                                                 uint32_t totalRbgs)
 {
-    NS_LOG_FUNCTION(this << startPrb << numPrbs << rbgSize << totalRbgs);
+    NS_LOG_FUNCTION(startPrb << numPrbs << rbgSize << totalRbgs);
     
     /*
      * Convert PRB allocation to RBG bitmask.
@@ -78,9 +78,13 @@
 
 #include "ns3/nr-mac-scheduler-tdma.h"
 #include "nr-bwp-manager.h"
+#include "nr-slice-manager.h"
 #include "nr-network-manager.h"
 
+#include <optional>
+#include <ostream>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -95,7 +99,8 @@ namespace ns3
  * 
  * Key Characteristics:
  * - NO CQI consideration (blind to channel quality)
- * - NO buffer awareness (ignores queue status)
+ * - NO buffer awareness (ignores queue status), except for URLLC
+ *   mini-slot preemption (EnableUrllcPreemption())
  * - NO HARQ retransmissions (only fresh data)
  * - FIXED MCS (from UE SLA configuration)
  * - OFDMA-style allocation (multiple UEs per slot)
@@ -183,6 +188,191 @@ class NrMilpExecutorScheduler : public NrMacSchedulerTdma
      */
     void Initialize(Ptr<NrNetworkManager> networkManager);
     
+    /**
+     * \brief Set the cell (gNB index) this scheduler serves
+     * \param cellId gNB index, as used in MilpCell::cellId
+     * 
+     * Needed for coordinated (multi-cell) plans. Call BEFORE Initialize():
+     * only UEs served by this cell are mapped (RNTIs are per cell, so
+     * other cells' UEs may share them), and the cell's PRB restrictions
+     * are enforced on every allocation:
+     * - muted PRBs are never scheduled
+     * - power-limited PRBs are dropped for cell-edge UEs
+     */
+    void SetCellId(uint32_t cellId);
+    
+    /**
+     * \brief Re-map a UE whose serving cell changed (coordinated plans)
+     * \param ueId MILP UE identifier
+     * 
+     * Call after NrBwpManager::SetServingCell(): the UE is mapped with its
+     * current RNTI if this cell serves it now, and unmapped otherwise. A
+     * UE that handed over in keeps its planned PRBs, but only where this
+     * cell's planned UEs leave them free.
+     */
+    void UpdateServingCell(uint32_t ueId);
+    
+    /**
+     * \brief Enforce per-slice PRB quotas on every slot's plan
+     * \param sliceManager Slice manager (may be shared by all schedulers)
+     * 
+     * Allocations of this scheduler's UEs are trimmed to their slice
+     * grants before the PRB → RBG conversion. Without a slice manager
+     * the plan is executed as is.
+     */
+    void SetSliceManager(Ptr<NrSliceManager> sliceManager);
+    
+    // ========================================================================
+    // URLLC MINI-SLOT PREEMPTION
+    // ========================================================================
+    
+    /**
+     * \brief Mini-slot preemption parameters
+     */
+    struct PreemptionParams
+    {
+        uint32_t miniSlotSymbols = 2;        ///< Symbols of a URLLC mini-slot
+        double maxPreemptedFraction = 0.5;   ///< Max share of RBGs per slot
+    };
+    
+    /**
+     * \brief Preemption counters (DL)
+     */
+    struct PreemptionStats
+    {
+        uint64_t miniSlots = 0;            ///< URLLC mini-slot DCIs scheduled
+        uint64_t preemptions = 0;          ///< Mini-slots that displaced eMBB symbols
+        uint64_t victimDcis = 0;           ///< eMBB DCIs shortened by a mini-slot
+        uint64_t freeRbgSymbols = 0;       ///< Idle RBG-symbols given to URLLC
+        uint64_t preemptedRbgSymbols = 0;  ///< eMBB RBG-symbols given up
+        uint64_t urllcBytes = 0;           ///< TBS scheduled in mini-slots
+        uint64_t embbBytesLost = 0;        ///< eMBB TBS lost to preemption
+        uint64_t deferrals = 0;            ///< Slots a URLLC UE waited for its plan
+        uint64_t blocked = 0;              ///< Slots preemption found no RBGs
+        uint64_t served = 0;               ///< URLLC backlogs served (plan or mini-slot)
+        uint64_t deadlineMisses = 0;       ///< Served after UeSla::latencyMs
+        double totalWaitMs = 0.0;          ///< Sum of arrival → service waits
+        double maxWaitMs = 0.0;            ///< Longest arrival → service wait
+        
+        /**
+         * \brief Accumulate counters of another scheduler
+         * \param other Counters to add
+         * \return *this
+         */
+        PreemptionStats& operator+=(const PreemptionStats& other);
+        
+        /**
+         * \brief Print counters to output stream
+         * \param os Output stream
+         */
+        void Print(std::ostream& os) const;
+    };
+    
+    /**
+     * \brief Let URLLC UEs preempt eMBB symbols within a slot
+     * \param params Mini-slot size and per-slot preemption cap
+     * 
+     * Every DL slot, a UE with a latency budget (SetUeLatencyBudget())
+     * and buffered data that the plan does not serve in time gets a
+     * mini-slot DCI: the first miniSlotSymbols symbols on idle RBGs,
+     * then on RBGs of eMBB UEs whose DCIs are shortened to start after
+     * the mini-slot. UEs the plan serves within the budget are left to
+     * the plan, so no capacity is reserved statically.
+     */
+    void EnableUrllcPreemption(const PreemptionParams& params);
+    
+    /**
+     * \brief Mark a UE as URLLC with a latency budget
+     * \param ueId MILP UE identifier
+     * \param latencyMs Budget from buffer arrival to DL service (UeSla::latencyMs)
+     */
+    void SetUeLatencyBudget(uint32_t ueId, double latencyMs);
+    
+    /**
+     * \brief Get the preemption counters
+     * \return Counters since simulation start
+     */
+    const PreemptionStats& GetPreemptionStats() const;
+    
+    // ========================================================================
+    // HARQ-AWARE EXECUTION
+    // ========================================================================
+    
+    /**
+     * \brief Per-UE HARQ retransmission counters
+     */
+    struct HarqUeStats
+    {
+        uint64_t dlRetx = 0;            ///< DL retransmissions scheduled
+        uint64_t dlRetxPrbs = 0;        ///< PRBs used by DL retransmissions
+        uint64_t dlFromPool = 0;        ///< DL retx placed in the reserved pool
+        uint64_t dlFromOwnPlan = 0;     ///< DL retx placed on the UE's own planned RBGs
+        uint64_t dlFromOthers = 0;      ///< DL retx placed on idle or other UEs' RBGs
+        uint64_t dlTimeDomain = 0;      ///< DL retx left before the data (no room)
+        uint64_t displacedPrbs = 0;     ///< Planned new-data PRBs given up to retx
+        uint64_t ulRetx = 0;            ///< UL retransmissions scheduled
+        uint64_t ulRetxPrbs = 0;        ///< PRBs used by UL retransmissions
+        
+        /**
+         * \brief Accumulate counters of the same UE on another BWP
+         * \param other Counters to add
+         * \return *this
+         */
+        HarqUeStats& operator+=(const HarqUeStats& other);
+    };
+    
+    /**
+     * \brief Schedule DL retransmissions inside the planned slot
+     * \param reservedFromPrb First PRB of the retransmission pool; PRBs
+     *        from here to the end of the BWP are never planned (pass the
+     *        BWP size for no pool)
+     * 
+     * Retransmissions are placed first in every slot, on the same
+     * symbols as the planned new data but on their own RBGs: the
+     * reserved pool first, then the owning UE's planned RBGs, then idle
+     * RBGs, then other UEs' planned RBGs. Planned allocations shrink by
+     * the RBGs taken, so the plan never collides with a retransmission
+     * and keeps all data symbols. Without this, the TDMA base places
+     * retransmissions in time before the data and the plan loses those
+     * symbols.
+     */
+    void EnableHarqAwareExecution(uint32_t reservedFromPrb);
+    
+    /**
+     * \brief Get retransmission counters of all UEs served
+     * \return ueId → counters
+     */
+    const std::unordered_map<uint32_t, HarqUeStats>& GetHarqStats() const;
+    
+    // ========================================================================
+    // PRB → RBG CONVERSION
+    // ========================================================================
+    
+    /**
+     * \brief Convert PRB allocation to RBG bitmask
+     * \param startPrb Starting PRB index
+     * \param numPrbs Number of contiguous PRBs
+     * \param rbgSize Number of PRBs per RBG
+     * \param totalRbgs Total number of RBGs in bandwidth
+     * \return Bitmask where true = RBG allocated
+     * 
+     * MILP works in PRBs, ns-3 works in RBGs.
+     * This method converts between the two.
+     * 
+     * Example:
+     * - Input: startPrb=0, numPrbs=10, rbgSize=4
+     * - Output: RBGs [0, 1, 2] = true (covering PRBs 0-11)
+     * 
+     * Rounding up to cover all PRBs.
+     * 
+     * Static and side-effect free so it can be exercised outside a
+     * running scheduler (e.g. by the MILP data-path benchmark).
+     */
+    static std::vector<bool> ConvertPrbToRbgBitmask(uint32_t startPrb,
+                                                     uint32_t numPrbs,
+                                                     uint32_t rbgSize,
+                                                     uint32_t totalRbgs);
+    
     // ========================================================================
     // OVERRIDE: Pure Virtual Methods from NrMacSchedulerNs3
     // ========================================================================
@@ -207,7 +397,8 @@ class NrMilpExecutorScheduler : public NrMacSchedulerTdma
      *    a. Map ueId → RNTI
      *    b. Convert PRB → RBG
      *    c. Store in UE info (m_dlRBG, m_dlRbgStart)
-     * 4. Return all symbols for single beam (OFDMA style)
+     * 4. With preemption enabled, add URLLC mini-slots (PreemptForUrllc())
+     * 5. Return all symbols for single beam (OFDMA style)
      * 
      * Why OFDMA style?
      * - MILP allocates multiple UEs in same slot
@@ -270,10 +461,10 @@ class NrMilpExecutorScheduler : public NrMacSchedulerTdma
      * 
      * Flow:
      * 1. Map RNTI → ueId
-     * 2. Query MILP allocation for this UE at current slot
-     * 3. If no allocation, return nullptr
-     * 4. Convert PRB → RBG and create bitmask
-     * 5. Assign symbols (all symbols - OFDMA)
+     * 2. Take the RBGs AssignDLRBG() stored in ueInfo->m_dlRBG
+     * 3. If none, return nullptr
+     * 4. Convert RBG list → bitmask
+     * 5. Assign symbols (all symbols - OFDMA, or the mini-slot window)
      * 6. Set MCS (fixed from SLA)
      * 7. Calculate TBS (Transport Block Size)
      * 8. Return DCI
@@ -455,32 +646,46 @@ class NrMilpExecutorScheduler : public NrMacSchedulerTdma
     void DoSchedUlTriggerReq(
         const NrMacSchedSapProvider::SchedUlTriggerReqParameters& params) override;
     
-  private:
     // ========================================================================
-    // HELPER METHODS
+    // OVERRIDE: HARQ Retransmissions (NrMacSchedulerTdma)
     // ========================================================================
     
     /**
-     * \brief Convert PRB allocation to RBG bitmask
-     * \param startPrb Starting PRB index
-     * \param numPrbs Number of contiguous PRBs
-     * \param rbgSize Number of PRBs per RBG
-     * \param totalRbgs Total number of RBGs in bandwidth
-     * \return Bitmask where true = RBG allocated
+     * \brief Schedule DL retransmissions (called before AssignDLRBG())
+     * \return Symbols used by retransmissions (0 when all were placed in
+     *         frequency, see EnableHarqAwareExecution())
      * 
-     * MILP works in PRBs, ns-3 works in RBGs.
-     * This method converts between the two.
-     * 
-     * Example:
-     * - Input: startPrb=0, numPrbs=10, rbgSize=4
-     * - Output: RBGs [0, 1, 2] = true (covering PRBs 0-11)
+     * Runs the TDMA base, then replaces the retransmission DCIs it created
+     * (in the slot and in their HARQ processes) by copies on the slot's
+     * first data symbol and on free RBGs. Either all of them move or none.
+     */
+    uint8_t ScheduleDlHarq(
+        PointInFTPlane* startingPoint,
+        uint8_t symAvail,
+        const ActiveHarqMap& activeDlHarq,
+        const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap,
+        std::vector<DlHarqInfo>* dlHarqToRetransmit,
+        const std::vector<DlHarqInfo>& dlHarqFeedback,
+        SlotAllocInfo* slotAlloc) const override;
+    
+    /**
+     * \brief Schedule UL retransmissions
+     * \return Symbols used by retransmissions
      * 
-     * Rounding up to cover all PRBs.
+     * Placement is left to the TDMA base; retransmissions are counted.
      */
-    std::vector<bool> ConvertPrbToRbgBitmask(uint32_t startPrb,
-                                              uint32_t numPrbs,
-                                              uint32_t rbgSize,
-                                              uint32_t totalRbgs) const;
+    uint8_t ScheduleUlHarq(
+        PointInFTPlane* startingPoint,
+        uint8_t symAvail,
+        const std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo>>& ueMap,
+        std::vector<UlHarqInfo>* ulHarqToRetransmit,
+        const std::vector<UlHarqInfo>& ulHarqFeedback,
+        SlotAllocInfo* slotAlloc) const override;
+    
+  private:
+    // ========================================================================
+    // HELPER METHODS
+    // ========================================================================
     
     /**
      * \brief Get current slot index
@@ -490,6 +695,108 @@ class NrMilpExecutorScheduler : public NrMacSchedulerTdma
      */
     uint32_t GetCurrentSlot() const;
     
+    /**
+     * \brief Order a slot's allocations for execution in this cell
+     * \param allocations Allocations of the slot (reordered in place)
+     * \return Per-RBG "already assigned" flags, or empty if RBGs need no
+     *         arbitration (uncoordinated plan)
+     * 
+     * With a coordinated plan, UEs planned on this cell go first. UEs that
+     * handed over in were planned on another cell's PRBs and only get the
+     * RBGs still unassigned when their turn comes.
+     */
+    std::vector<bool> OrderPlannedUesFirst(std::vector<PrbAllocation>& allocations) const;
+    
+    /**
+     * \brief Remove RBGs this cell may not use for a UE
+     * \param ueId MILP UE identifier
+     * \param rbgs RBG indices from the MILP allocation (filtered in place)
+     * 
+     * No-op without a coordinated plan. An RBG is dropped if any of its
+     * PRBs is muted for this cell, or power-limited and ueId is cell-edge.
+     */
+    void ApplyPrbRestrictions(uint32_t ueId, std::vector<uint16_t>& rbgs) const;
+    
+    /**
+     * \brief Enforce the slice grants on one slot's allocations
+     * \param allocations Allocations of the slot (modified in place)
+     * \param activeUes Active UEs and their buffered bytes
+     * \param symAvail Data symbols of the slot (DL TB size)
+     * \param downlink DL (true) or UL
+     * 
+     * Drops allocations of UEs this scheduler does not serve, converts
+     * each active UE's buffer into PRBs at its MCS, and lets the slice
+     * manager trim and lend on the PRBs not held by DL retransmissions,
+     * the retransmission pool or muted restrictions. Requires
+     * m_sliceManager.
+     */
+    void ApplySliceQuotas(std::vector<PrbAllocation>& allocations,
+                          const ActiveUeMap& activeUes,
+                          uint32_t symAvail,
+                          bool downlink) const;
+    
+    /**
+     * \brief Give mini-slots to URLLC UEs the plan cannot serve in time
+     * \param symAvail Data symbols of this slot
+     * \param activeDl Active DL UEs (m_dlRBG already holds the plan)
+     * 
+     * Per URLLC UE (oldest backlog first): defer if the plan serves it
+     * before its deadline; otherwise size a mini-slot from the buffer,
+     * fill it with idle RBGs, then with whole RBG sets of eMBB victims
+     * (smallest victim that covers the remainder, else the largest).
+     * Victims keep their RBGs and lose the mini-slot symbols.
+     */
+    void PreemptForUrllc(uint32_t symAvail, const ActiveUeMap& activeDl) const;
+    
+    /**
+     * \brief DL TBS of an RBG set over part of a slot
+     * \param mcs MCS index
+     * \param numRbgs Number of RBGs
+     * \param numSym Symbols used
+     * \param slotSym Data symbols of the slot
+     * \return TBS in bytes (full-slot TBS scaled by numSym / slotSym)
+     */
+    uint32_t GetDlTbSize(uint8_t mcs, uint32_t numRbgs, uint32_t numSym, uint32_t slotSym) const;
+    
+    /**
+     * \brief Frequency placement of one DL retransmission
+     */
+    struct DlRetxPlacement
+    {
+        /**
+         * \brief Where the RBGs came from (for HarqUeStats)
+         */
+        enum Source
+        {
+            POOL,     ///< Only the reserved pool
+            OWN_PLAN, ///< Pool and the UE's own planned RBGs
+            OTHERS    ///< Also idle or other UEs' RBGs
+        };
+
+        std::vector<bool> rbgBitmask; ///< RBGs chosen for the retransmission
+        Source source = POOL;         ///< Where they came from
+    };
+
+    /**
+     * \brief Find free RBGs of this slot for one DL retransmission
+     * \param dci Retransmission DCI created by the TDMA base
+     * \param plannedOwner RBG → RNTI of the planned new data (0 = none)
+     * \param usedRbgs RBGs taken by earlier retransmissions (updated if placed)
+     * \param placement Chosen RBGs (set if placed)
+     * \return true if placed
+     *
+     * Dry run only: neither the DCI nor any statistic is touched.
+     */
+    bool PlaceDlRetx(const DciInfoElementTdma& dci,
+                     const std::vector<uint16_t>& plannedOwner,
+                     std::vector<bool>& usedRbgs,
+                     DlRetxPlacement& placement) const;
+    
+    /**
+     * \brief Cache RBG size / count on first use
+     */
+    void CacheRbgParameters() const;
+    
     // ========================================================================
     // MEMBER VARIABLES
     // ========================================================================
@@ -542,6 +849,88 @@ class NrMilpExecutorScheduler : public NrMacSchedulerTdma
      * \brief Flag indicating if scheduler is initialized
      */
     bool m_initialized;
+    
+    /**
+     * \brief Cell served by this scheduler (coordinated plans)
+     */
+    std::optional<uint32_t> m_cellId;
+    
+    /**
+     * \brief RNTI source for re-mapping UEs after handovers
+     */
+    Ptr<NrNetworkManager> m_networkManager;
+    
+    /**
+     * \brief This cell's PRB restrictions (cached in Initialize())
+     */
+    std::vector<PrbRestriction> m_prbRestrictions;
+    
+    /**
+     * \brief Slice quota enforcement (null = slicing disabled)
+     */
+    Ptr<NrSliceManager> m_sliceManager;
+    
+    /**
+     * \brief Scratch: usable PRBs and demand handed to the slice manager
+     */
+    mutable NrSliceManager::SlotResources m_sliceSlot;
+    
+    /**
+     * \brief URLLC preemption enabled (EnableUrllcPreemption())
+     */
+    bool m_preemptionEnabled;
+    
+    /**
+     * \brief Mini-slot preemption parameters
+     */
+    PreemptionParams m_preemption;
+    
+    /**
+     * \brief Latency budget per URLLC ueId (ms)
+     */
+    std::unordered_map<uint32_t, double> m_ueLatencyBudgetMs;
+    
+    /**
+     * \brief Slot at which each URLLC RNTI's current backlog arrived
+     */
+    mutable std::unordered_map<uint16_t, uint32_t> m_urllcArrivalSlot;
+    
+    /**
+     * \brief Per-RNTI DL symbol window of this slot: (offset, numSym)
+     * 
+     * Set for mini-slot UEs and their victims; other UEs use all symbols.
+     */
+    mutable std::unordered_map<uint16_t, std::pair<uint32_t, uint32_t>> m_dlSymbolWindows;
+    
+    /**
+     * \brief Slots per millisecond of this BWP (2^μ, from the trigger)
+     */
+    uint32_t m_slotsPerMs;
+    
+    /**
+     * \brief Preemption counters
+     */
+    mutable PreemptionStats m_preemptionStats;
+    
+    /**
+     * \brief HARQ-aware placement enabled (EnableHarqAwareExecution())
+     */
+    bool m_harqAware;
+    
+    /**
+     * \brief First PRB of the retransmission pool
+     */
+    uint32_t m_retxPoolStartPrb;
+    
+    /**
+     * \brief RBGs taken by DL retransmissions in this slot
+     */
+    mutable std::vector<bool> m_dlRetxRbgs;
+    
+    /**
+     * \brief Retransmission counters per ueId
+     */
+    mutable std::unordered_map<uint32_t, HarqUeStats> m_harqStats;
 };
 
 } // namespace ns3
@@ -16,12 +16,17 @@
 #include <nlohmann/json.hpp>
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <atomic>
+#include <charconv>
 #include <cstring>
 #include <sstream>
 #include <iomanip>
@@ -53,18 +58,52 @@ NrMilpInterface::GetTypeId()
 // ============================================================================
 
 NrMilpInterface::NrMilpInterface()
-    : m_solverAddress("localhost"),
+    : m_transport(TRANSPORT_TCP),
+      m_solverAddress("localhost"),
       m_solverPort(8888),
+      m_socketPath(),
+      m_shmSize(64 << 20),
       m_connectionTimeout(10.0),
       m_solveTimeout(60.0),
+      m_targetGap(0.0),
+      m_deadlineMargin(1.0),
       m_autoReconnect(true),
       m_maxRetries(3),
       m_socketFd(-1),
       m_isConnected(false),
       m_reconnectAttempts(0),
-      m_statistics()
+      m_shmName(),
+      m_shmBase(nullptr),
+      m_statistics(),
+      m_metrics()
 {
     NS_LOG_FUNCTION(this);
+    
+    NrMetricsRegistry& registry = NrMetricsRegistry::Get();
+    m_metrics.problems = registry.GetCounter("nr_milp_problems_total",
+                                             "MILP problems submitted to the solver");
+    m_metrics.solutions = registry.GetCounter("nr_milp_solutions_total",
+                                              "MILP solutions received");
+    m_metrics.incumbents = registry.GetCounter("nr_milp_incumbents_total",
+                                               "Solutions accepted as deadline incumbents");
+    m_metrics.timeouts = registry.GetCounter("nr_milp_timeouts_total",
+                                             "Solves that timed out");
+    m_metrics.errors = registry.GetCounter("nr_milp_errors_total",
+                                           "MILP interface errors");
+    m_metrics.reconnections = registry.GetCounter("nr_milp_reconnections_total",
+                                                  "Solver connection retries");
+    m_metrics.bytesSent = registry.GetCounter("nr_milp_bytes_total",
+                                              "Solver payload bytes", "direction=\"sent\"");
+    m_metrics.bytesReceived = registry.GetCounter("nr_milp_bytes_total",
+                                                  "Solver payload bytes",
+                                                  "direction=\"received\"");
+    m_metrics.shmBytes = registry.GetCounter("nr_milp_shm_bytes_total",
+                                             "Payload bytes moved through shared memory");
+    m_metrics.solveSeconds = registry.GetHistogram("nr_milp_solve_seconds",
+                                                   "Round-trip MILP solve time",
+                                                   {0.01, 0.05, 0.1, 0.5, 1, 5, 10, 30, 60});
+    m_metrics.lastGap = registry.GetGauge("nr_milp_last_gap",
+                                          "Relative MIP gap of the last solution");
 }
 
 NrMilpInterface::~NrMilpInterface()
@@ -89,6 +128,7 @@ void
 NrMilpInterface::SetSolverAddress(const std::string& address)
 {
     NS_LOG_FUNCTION(this << address);
+    m_transport = TRANSPORT_TCP;
     m_solverAddress = address;
 }
 
@@ -99,6 +139,81 @@ NrMilpInterface::SetSolverPort(uint16_t port)
     m_solverPort = port;
 }
 
+void
+NrMilpInterface::SetSolverUri(const std::string& uri)
+{
+    NS_LOG_FUNCTION(this << uri);
+    
+    size_t sep = uri.find("://");
+    NS_ABORT_MSG_IF(sep == std::string::npos,
+                    "Solver URI '" << uri << "' has no scheme (tcp://, unix://, shm://)");
+    std::string scheme = uri.substr(0, sep);
+    std::string endpoint = uri.substr(sep + 3);
+    NS_ABORT_MSG_IF(endpoint.empty(), "Solver URI '" << uri << "' has no endpoint");
+    
+    if (scheme == "tcp")
+    {
+        // The TCP transport resolves and connects over IPv4 only
+        NS_ABORT_MSG_IF(endpoint.front() == '[',
+                        "Solver URI '" << uri << "': IPv6 addresses are not supported");
+        size_t colon = endpoint.rfind(':');
+        std::string host = endpoint.substr(0, colon);
+        NS_ABORT_MSG_IF(host.empty(), "Solver URI '" << uri << "' has no host");
+        uint16_t port = m_solverPort;
+        if (colon != std::string::npos)
+        {
+            const char* first = endpoint.data() + colon + 1;
+            const char* last = endpoint.data() + endpoint.size();
+            uint32_t value = 0;
+            auto [end, ec] = std::from_chars(first, last, value);
+            NS_ABORT_MSG_IF(first == last || ec != std::errc() || end != last || value == 0 ||
+                                value > 65535,
+                            "Solver URI '" << uri << "' has an invalid port (1-65535)");
+            port = static_cast<uint16_t>(value);
+        }
+        m_transport = TRANSPORT_TCP;
+        m_solverAddress = host;
+        m_solverPort = port;
+    }
+    else if (scheme == "unix" || scheme == "shm")
+    {
+        m_transport = (scheme == "unix") ? TRANSPORT_UNIX : TRANSPORT_SHM;
+        m_socketPath = endpoint;
+    }
+    else
+    {
+        NS_ABORT_MSG("Unknown solver URI scheme '" << scheme << "' (tcp, unix, shm)");
+    }
+}
+
+std::string
+NrMilpInterface::GetSolverUri() const
+{
+    switch (m_transport)
+    {
+    case TRANSPORT_UNIX:
+        return "unix://" + m_socketPath;
+    case TRANSPORT_SHM:
+        return "shm://" + m_socketPath;
+    default:
+        return "tcp://" + m_solverAddress + ":" + std::to_string(m_solverPort);
+    }
+}
+
+NrMilpInterface::Transport
+NrMilpInterface::GetTransport() const
+{
+    return m_transport;
+}
+
+void
+NrMilpInterface::SetSharedMemorySize(size_t bytes)
+{
+    NS_LOG_FUNCTION(this << bytes);
+    NS_ABORT_MSG_IF(bytes < 4096, "Shared-memory region must be >= 4096 bytes, got " << bytes);
+    m_shmSize = bytes;
+}
+
 void
 NrMilpInterface::SetConnectionTimeout(double timeout)
 {
@@ -113,6 +228,22 @@ NrMilpInterface::SetSolveTimeout(double timeout)
     m_solveTimeout = timeout;
 }
 
+void
+NrMilpInterface::SetTargetGap(double gap)
+{
+    NS_LOG_FUNCTION(this << gap);
+    NS_ABORT_MSG_IF(gap < 0.0, "MIP gap target must be >= 0, got " << gap);
+    m_targetGap = gap;
+}
+
+void
+NrMilpInterface::SetDeadlineMargin(double margin)
+{
+    NS_LOG_FUNCTION(this << margin);
+    NS_ABORT_MSG_IF(margin < 0.0, "Deadline margin must be >= 0, got " << margin);
+    m_deadlineMargin = margin;
+}
+
 void
 NrMilpInterface::SetAutoReconnect(bool enable)
 {
@@ -154,57 +285,17 @@ NrMilpInterface::Connect()
         return true;
     }
     
-    NS_LOG_INFO("Connecting to MILP solver at " << m_solverAddress 
-                << ":" << m_solverPort);
+    NS_LOG_INFO("Connecting to MILP solver at " << GetSolverUri());
     
     uint32_t attempts = 0;
     bool connected = false;
     
     do
     {
-        // Create socket
-        m_socketFd = socket(AF_INET, SOCK_STREAM, 0);
+        m_socketFd = OpenSocket();
         if (m_socketFd < 0)
         {
-            NS_LOG_ERROR("Failed to create socket: " << strerror(errno));
-            attempts++;
-            sleep(1);
-            continue;
-        }
-        
-        // Set socket timeout for connect
-        struct timeval tv;
-        tv.tv_sec = static_cast<long>(m_connectionTimeout);
-        tv.tv_usec = static_cast<long>((m_connectionTimeout - tv.tv_sec) * 1e6);
-        setsockopt(m_socketFd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-        setsockopt(m_socketFd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
-        
-        // Resolve hostname
-        struct hostent* server = gethostbyname(m_solverAddress.c_str());
-        if (server == nullptr)
-        {
-            NS_LOG_ERROR("Cannot resolve hostname: " << m_solverAddress);
-            close(m_socketFd);
-            m_socketFd = -1;
-            attempts++;
-            sleep(1);
-            continue;
-        }
-        
-        // Setup server address
-        struct sockaddr_in serverAddr;
-        memset(&serverAddr, 0, sizeof(serverAddr));
-        serverAddr.sin_family = AF_INET;
-        memcpy(&serverAddr.sin_addr.s_addr, server->h_addr, server->h_length);
-        serverAddr.sin_port = htons(m_solverPort);
-        
-        // Connect
-        if (connect(m_socketFd, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0)
-        {
-            NS_LOG_WARN("Connection attempt " << (attempts + 1) 
-                        << " failed: " << strerror(errno));
-            close(m_socketFd);
-            m_socketFd = -1;
+            NS_LOG_WARN("Connection attempt " << (attempts + 1) << " failed");
             attempts++;
             
             if (m_autoReconnect && attempts <= m_maxRetries)
@@ -228,13 +319,158 @@ NrMilpInterface::Connect()
         NS_LOG_ERROR("Failed to connect to MILP solver after " 
                      << attempts << " attempts");
         m_statistics.totalReconnections += attempts;
+        m_metrics.reconnections->Inc(attempts);
         return false;
     }
     
     m_statistics.totalReconnections += attempts;
+    m_metrics.reconnections->Inc(attempts);
+    
+    if (m_transport == TRANSPORT_SHM && !AttachSharedMemory())
+    {
+        NS_LOG_ERROR("Shared-memory transport setup failed");
+        CloseSocket();
+        return false;
+    }
+    return true;
+}
+
+int
+NrMilpInterface::OpenSocket()
+{
+    NS_LOG_FUNCTION(this);
+    
+    // Create socket
+    int fd = socket((m_transport == TRANSPORT_TCP) ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        NS_LOG_ERROR("Failed to create socket: " << strerror(errno));
+        return -1;
+    }
+    
+    // Set socket timeout for connect
+    struct timeval tv;
+    tv.tv_sec = static_cast<long>(m_connectionTimeout);
+    tv.tv_usec = static_cast<long>((m_connectionTimeout - tv.tv_sec) * 1e6);
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    
+    int result;
+    if (m_transport == TRANSPORT_TCP)
+    {
+        // Resolve hostname
+        struct hostent* server = gethostbyname(m_solverAddress.c_str());
+        if (server == nullptr)
+        {
+            NS_LOG_ERROR("Cannot resolve hostname: " << m_solverAddress);
+            close(fd);
+            return -1;
+        }
+        
+        // Setup server address
+        struct sockaddr_in serverAddr;
+        memset(&serverAddr, 0, sizeof(serverAddr));
+        serverAddr.sin_family = AF_INET;
+        memcpy(&serverAddr.sin_addr.s_addr, server->h_addr, server->h_length);
+        serverAddr.sin_port = htons(m_solverPort);
+        result = connect(fd, (struct sockaddr*)&serverAddr, sizeof(serverAddr));
+    }
+    else
+    {
+        struct sockaddr_un serverAddr;
+        memset(&serverAddr, 0, sizeof(serverAddr));
+        serverAddr.sun_family = AF_UNIX;
+        if (m_socketPath.size() >= sizeof(serverAddr.sun_path))
+        {
+            NS_LOG_ERROR("Socket path too long: " << m_socketPath);
+            close(fd);
+            return -1;
+        }
+        strncpy(serverAddr.sun_path, m_socketPath.c_str(), sizeof(serverAddr.sun_path) - 1);
+        result = connect(fd, (struct sockaddr*)&serverAddr, sizeof(serverAddr));
+    }
+    
+    if (result < 0)
+    {
+        NS_LOG_WARN("Connect to " << GetSolverUri() << " failed: " << strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool
+NrMilpInterface::AttachSharedMemory()
+{
+    NS_LOG_FUNCTION(this);
+    
+    static uint32_t regionCount = 0;
+    m_shmName = "/nr-milp-" + std::to_string(getpid()) + "-" + std::to_string(regionCount++);
+    
+    int fd = shm_open(m_shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        NS_LOG_ERROR("shm_open(" << m_shmName << ") failed: " << strerror(errno));
+        m_shmName.clear();
+        return false;
+    }
+    void* base = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(m_shmSize)) == 0)
+    {
+        base = mmap(nullptr, m_shmSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);  // The mapping keeps the region alive
+    if (base == MAP_FAILED)
+    {
+        NS_LOG_ERROR("Mapping " << m_shmSize << " bytes of " << m_shmName
+                     << " failed: " << strerror(errno));
+        DetachSharedMemory();
+        return false;
+    }
+    m_shmBase = static_cast<uint8_t*>(base);
+    
+    // Announce the region; the solver maps it and confirms
+    json attach;
+    attach["type"] = "shm_attach";
+    attach["region"] = m_shmName;
+    attach["size"] = m_shmSize;
+    std::string reply;
+    if (!SendFrame(attach.dump()) || !ReceiveFrame(reply, m_connectionTimeout))
+    {
+        NS_LOG_ERROR("Solver did not answer the shared-memory announcement");
+        DetachSharedMemory();
+        return false;
+    }
+    json replyJson = json::parse(reply, nullptr, false);
+    if (replyJson.is_discarded() || replyJson.value("type", "") != "shm_ready")
+    {
+        NS_LOG_ERROR("Solver rejected shared-memory region " << m_shmName << ": " << reply);
+        DetachSharedMemory();
+        return false;
+    }
+    
+    NS_LOG_INFO("Shared-memory region " << m_shmName << " attached (" << m_shmSize
+                << " bytes)");
     return true;
 }
 
+void
+NrMilpInterface::DetachSharedMemory()
+{
+    NS_LOG_FUNCTION(this);
+    
+    if (m_shmBase != nullptr)
+    {
+        munmap(m_shmBase, m_shmSize);
+        m_shmBase = nullptr;
+    }
+    if (!m_shmName.empty())
+    {
+        shm_unlink(m_shmName.c_str());
+        m_shmName.clear();
+    }
+}
+
 void
 NrMilpInterface::Disconnect()
 {
@@ -325,6 +561,7 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
         MilpSolution errorSol;
         errorSol.status = "error";
         m_statistics.totalErrors++;
+        m_metrics.errors->Inc();
         return errorSol;
     }
     
@@ -337,15 +574,18 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
             MilpSolution errorSol;
             errorSol.status = "error";
             m_statistics.totalErrors++;
+            m_metrics.errors->Inc();
             return errorSol;
         }
     }
     
-    // Serialize problem to JSON
+    // Serialize problem to JSON; the solver gets a deadline short of the
+    // timeout so its incumbent arrives before we stop waiting
+    double deadline = std::max(customTimeout - m_deadlineMargin, 0.1 * customTimeout);
     std::string jsonRequest;
     try
     {
-        jsonRequest = SerializeProblem(problem);
+        jsonRequest = SerializeProblem(problem, deadline);
         NS_LOG_INFO("Serialized problem: " << jsonRequest.length() << " bytes");
     }
     catch (const std::exception& e)
@@ -354,6 +594,7 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
         MilpSolution errorSol;
         errorSol.status = "error";
         m_statistics.totalErrors++;
+        m_metrics.errors->Inc();
         return errorSol;
     }
     
@@ -364,6 +605,7 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
         MilpSolution errorSol;
         errorSol.status = "error";
         m_statistics.totalErrors++;
+        m_metrics.errors->Inc();
         return errorSol;
     }
     
@@ -371,6 +613,7 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
                 << customTimeout << "s)...");
     
     m_statistics.totalProblemsSubmitted++;
+    m_metrics.problems->Inc();
     
     // Receive solution
     std::string jsonResponse;
@@ -380,6 +623,7 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
         MilpSolution timeoutSol;
         timeoutSol.status = "timeout";
         m_statistics.totalTimeouts++;
+        m_metrics.timeouts->Inc();
         return timeoutSol;
     }
     
@@ -393,7 +637,16 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
         NS_LOG_INFO("Solution status: " << solution.status);
         NS_LOG_INFO("Objective value: " << solution.objectiveValue);
         NS_LOG_INFO("Solver time: " << solution.solveTimeSeconds << " seconds");
+        NS_LOG_INFO("MIP gap: " << solution.mipGap);
         NS_LOG_INFO("Allocations: " << solution.allocations.size());
+        NS_LOG_INFO("Budgets: " << solution.budgets.size());
+        
+        if (problem.aggregated)
+        {
+            solution = ExpandClassSolution(problem, solution);
+            NS_LOG_INFO("Expanded " << problem.classes.size() << " SLA classes to "
+                        << solution.allocations.size() << " UE allocations");
+        }
     }
     catch (const std::exception& e)
     {
@@ -401,6 +654,7 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
         MilpSolution errorSol;
         errorSol.status = "error";
         m_statistics.totalErrors++;
+        m_metrics.errors->Inc();
         return errorSol;
     }
     
@@ -414,6 +668,15 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
                      jsonResponse.length());
     
     m_statistics.totalSolutionsReceived++;
+    m_metrics.solutions->Inc();
+    RecordGap(solution);
+    if (solution.IsIncumbent())
+    {
+        m_statistics.totalIncumbents++;
+        m_metrics.incumbents->Inc();
+        NS_LOG_WARN("Solver deadline (" << deadline << " s) reached, accepted incumbent with gap "
+                    << solution.mipGap * 100 << "%");
+    }
     
     return solution;
 }
@@ -423,7 +686,7 @@ NrMilpInterface::SolveProblem(const MilpProblem& problem, double customTimeout)
 // ============================================================================
 
 std::string
-NrMilpInterface::SerializeProblem(const MilpProblem& problem)
+NrMilpInterface::SerializeProblem(const MilpProblem& problem, double deadlineSeconds)
 {
     NS_LOG_FUNCTION(this);
     
@@ -452,6 +715,62 @@ NrMilpInterface::SerializeProblem(const MilpProblem& problem)
         j["ues"].push_back(ueJson);
     }
     
+    // Joint multi-cell planning: per-cell UE sets and neighbour protection
+    if (problem.coordinated)
+    {
+        j["coordinated"] = true;
+        j["cells"] = json::array();
+        for (const auto& cell : problem.cells)
+        {
+            json cellJson;
+            cellJson["cellId"] = cell.cellId;
+            cellJson["ueIds"] = cell.ueIds;
+            cellJson["edgeUeIds"] = cell.edgeUeIds;
+            cellJson["neighbourCellIds"] = cell.neighbourCellIds;
+            j["cells"].push_back(cellJson);
+        }
+        j["prbRestrictions"] = json::array();
+        for (const auto& restriction : problem.prbRestrictions)
+        {
+            json rJson;
+            rJson["cellId"] = restriction.cellId;
+            rJson["startPrb"] = restriction.startPrb;
+            rJson["numPrbs"] = restriction.numPrbs;
+            rJson["muted"] = restriction.muted;
+            rJson["powerBackoffDb"] = restriction.powerBackoffDb;
+            j["prbRestrictions"].push_back(rJson);
+        }
+    }
+    
+    // Anytime solving: stop at the gap target or the deadline, whichever
+    // comes first, and return the best incumbent
+    if (deadlineSeconds > 0.0)
+    {
+        j["deadlineSeconds"] = deadlineSeconds;
+        j["mipGapTarget"] = m_targetGap;
+    }
+    
+    // Coarse planning: the solver answers with per-block budgets
+    if (problem.planningGranularitySlots > 1)
+    {
+        j["planningGranularitySlots"] = problem.planningGranularitySlots;
+    }
+    
+    // SLA classes: the solver plans class budgets; member counts let it
+    // weigh classes (expansion to UEs happens on this side)
+    if (problem.aggregated)
+    {
+        j["aggregated"] = true;
+        j["classes"] = json::array();
+        for (const auto& cls : problem.classes)
+        {
+            json classJson;
+            classJson["classId"] = cls.classId;
+            classJson["numUes"] = cls.ueIds.size();
+            j["classes"].push_back(classJson);
+        }
+    }
+    
     return j.dump();  // Convert to string
 }
 
@@ -470,6 +789,7 @@ NrMilpInterface::DeserializeSolution(const std::string& jsonStr)
         solution.status = j.value("status", "unknown");
         solution.objectiveValue = j.value("objectiveValue", 0.0);
         solution.solveTimeSeconds = j.value("solveTimeSeconds", 0.0);
+        solution.mipGap = j.value("mipGap", solution.IsOptimal() ? 0.0 : -1.0);
         
         // Allocations
         if (j.contains("allocations") && j["allocations"].is_array())
@@ -485,6 +805,18 @@ NrMilpInterface::DeserializeSolution(const std::string& jsonStr)
             }
         }
         
+        // Budgets (coarse plans: PRB-slots per UE and K-slot block)
+        solution.granularitySlots = j.value("granularitySlots", 1u);
+        if (j.contains("budgets") && j["budgets"].is_array())
+        {
+            for (const auto& budgetJson : j["budgets"])
+            {
+                solution.budgets.emplace_back(budgetJson.value("ueId", 0u),
+                                              budgetJson.value("blockId", 0u),
+                                              budgetJson.value("prbSlots", 0u));
+            }
+        }
+        
         // Summary (per-UE statistics)
         if (j.contains("summary") && j["summary"].is_object())
         {
@@ -532,10 +864,16 @@ void
 NrMilpInterface::PrintInfo(std::ostream& os) const
 {
     os << "MILP Interface Configuration:" << std::endl;
-    os << "  Solver Address: " << m_solverAddress << std::endl;
-    os << "  Solver Port: " << m_solverPort << std::endl;
+    os << "  Solver URI: " << GetSolverUri() << std::endl;
+    if (m_transport == TRANSPORT_SHM)
+    {
+        os << "  Shared Memory: " << m_shmSize << " bytes"
+           << (m_shmBase ? " (" + m_shmName + ")" : std::string()) << std::endl;
+    }
     os << "  Connection Timeout: " << m_connectionTimeout << " s" << std::endl;
     os << "  Solve Timeout: " << m_solveTimeout << " s" << std::endl;
+    os << "  Solver Deadline Margin: " << m_deadlineMargin << " s" << std::endl;
+    os << "  MIP Gap Target: " << m_targetGap * 100 << " %" << std::endl;
     os << "  Auto-Reconnect: " << (m_autoReconnect ? "Yes" : "No") << std::endl;
     os << "  Max Retries: " << m_maxRetries << std::endl;
     os << "  Connected: " << (m_isConnected ? "Yes" : "No") << std::endl;
@@ -550,6 +888,62 @@ NrMilpInterface::SendData(const std::string& data)
 {
     NS_LOG_FUNCTION(this << data.length());
     
+    // Shared memory: payload into the request half, descriptor on the socket
+    if (m_shmBase != nullptr && data.length() <= m_shmSize / 2)
+    {
+        memcpy(m_shmBase, data.data(), data.length());
+        std::atomic_thread_fence(std::memory_order_release);
+        m_statistics.totalShmBytes += data.length();
+        m_metrics.shmBytes->Inc(data.length());
+        return SendFrame("{\"shm\":[0," + std::to_string(data.length()) + "]}");
+    }
+    
+    return SendFrame(data);
+}
+
+bool
+NrMilpInterface::ReceiveData(std::string& data, double timeout)
+{
+    NS_LOG_FUNCTION(this << timeout);
+    
+    if (!ReceiveFrame(data, timeout))
+    {
+        return false;
+    }
+    if (m_shmBase == nullptr || data.compare(0, 7, "{\"shm\":") != 0)
+    {
+        return true;  // Inline payload
+    }
+    
+    // Descriptor: the payload sits in the response half of the region
+    json descriptor = json::parse(data, nullptr, false);
+    if (descriptor.is_discarded() || !descriptor["shm"].is_array() ||
+        descriptor["shm"].size() != 2)
+    {
+        NS_LOG_ERROR("Malformed shared-memory descriptor: " << data);
+        return false;
+    }
+    uint64_t offset = descriptor["shm"][0].get<uint64_t>();
+    uint64_t length = descriptor["shm"][1].get<uint64_t>();
+    if (offset < m_shmSize / 2 || offset > m_shmSize || length > m_shmSize - offset)
+    {
+        NS_LOG_ERROR("Shared-memory descriptor [" << offset << ", " << length
+                     << "] outside the response half");
+        return false;
+    }
+    
+    std::atomic_thread_fence(std::memory_order_acquire);
+    data.assign(reinterpret_cast<const char*>(m_shmBase + offset), length);
+    m_statistics.totalShmBytes += length;
+    m_metrics.shmBytes->Inc(length);
+    return true;
+}
+
+bool
+NrMilpInterface::SendFrame(const std::string& data)
+{
+    NS_LOG_FUNCTION(this << data.length());
+    
     if (!m_isConnected || m_socketFd < 0)
     {
         NS_LOG_ERROR("Socket not connected");
@@ -598,7 +992,7 @@ NrMilpInterface::SendData(const std::string& data)
 }
 
 bool
-NrMilpInterface::ReceiveData(std::string& data, double timeout)
+NrMilpInterface::ReceiveFrame(std::string& data, double timeout)
 {
     NS_LOG_FUNCTION(this << timeout);
     
@@ -713,6 +1107,7 @@ NrMilpInterface::CloseSocket()
         close(m_socketFd);
         m_socketFd = -1;
     }
+    DetachSharedMemory();
     
     m_isConnected = false;
 }
@@ -744,9 +1139,11 @@ NrMilpInterface::UpdateStatistics(bool success, double solveTime,
     if (!success)
     {
         m_statistics.totalErrors++;
+        m_metrics.errors->Inc();
     }
     
     m_statistics.totalSolveTime += solveTime;
+    m_metrics.solveSeconds->Observe(solveTime);
     
     // Update min/max
     if (m_statistics.totalSolutionsReceived == 0)
@@ -769,6 +1166,24 @@ NrMilpInterface::UpdateStatistics(bool success, double solveTime,
     
     m_statistics.totalBytesSent += bytesSent;
     m_statistics.totalBytesReceived += bytesReceived;
+    m_metrics.bytesSent->Inc(bytesSent);
+    m_metrics.bytesReceived->Inc(bytesReceived);
+}
+
+void
+NrMilpInterface::RecordGap(const MilpSolution& solution)
+{
+    if (solution.mipGap < 0.0)
+    {
+        return;
+    }
+    
+    m_statistics.totalGapReports++;
+    m_statistics.lastGap = solution.mipGap;
+    m_metrics.lastGap->Set(solution.mipGap);
+    m_statistics.maxGap = std::max(m_statistics.maxGap, solution.mipGap);
+    m_statistics.avgGap += (solution.mipGap - m_statistics.avgGap) /
+                           m_statistics.totalGapReports;
 }
 
 // ============================================================================
@@ -794,7 +1209,20 @@ NrMilpInterface::Statistics::Print(std::ostream& os) const
         os << "    Total: " << totalSolveTime << " s" << std::endl;
     }
     
+    if (totalGapReports > 0)
+    {
+        os << "  Optimality Gap:" << std::endl;
+        os << "    Incumbents at deadline: " << totalIncumbents << std::endl;
+        os << "    Last: " << lastGap * 100 << " %" << std::endl;
+        os << "    Average: " << avgGap * 100 << " %" << std::endl;
+        os << "    Max: " << maxGap * 100 << " %" << std::endl;
+    }
+    
     os << "  Network Traffic:" << std::endl;
+    if (totalShmBytes > 0)
+    {
+        os << "    Via Shared Memory: " << totalShmBytes << " bytes" << std::endl;
+    }
     os << "    Bytes Sent: " << totalBytesSent 
        << " (" << (totalBytesSent / 1024.0) << " KB)" << std::endl;
     os << "    Bytes Received: " << totalBytesReceived 
@@ -27,6 +27,20 @@
  * 5. ns-3 parses JSON and returns MilpSolution
  * 6. Connection closed (or kept alive for multiple problems)
  * 
+ * Transports (SetSolverUri):
+ * - tcp://host:port   TCP socket (default, same as SetSolverAddress/Port)
+ * - unix:///path      Unix-domain stream socket, co-located solver
+ * - shm:///path       Unix-domain socket for signalling only; payloads go
+ *                     through a POSIX shared-memory region that ns-3
+ *                     creates and announces on connect:
+ *                       → {"type": "shm_attach", "region": "/nr-milp-..", "size": N}
+ *                       ← {"type": "shm_ready"}
+ *                     The lower half carries requests, the upper half
+ *                     responses. A frame {"shm": [offset, length]} points
+ *                     into the region; any other frame is an inline payload
+ *                     (used when a payload does not fit its half).
+ * All frames are a 4-byte big-endian length followed by the body.
+ * 
  * JSON Format (Example):
  * 
  * Request (MilpProblem):
@@ -58,6 +72,17 @@
  *     ...
  *   }
  * }
+ * 
+ * Anytime solving: SolveProblem() adds the solver controls
+ *   "deadlineSeconds": 59.0, "mipGapTarget": 0.01
+ * and the solver stops at the first of (gap <= target, deadline). At the
+ * deadline it answers with its best incumbent instead of failing:
+ *   "status": "feasible", "mipGap": 0.034, "allocations": [...]
+ * 
+ * Coarse planning: a request with "planningGranularitySlots": K > 1 is
+ * answered with per-block budgets instead of allocations:
+ *   "granularitySlots": 8,
+ *   "budgets": [{"ueId": 0, "blockId": 0, "prbSlots": 80}, ...]
  */
 
 #ifndef NR_MILP_INTERFACE_H
@@ -65,9 +90,11 @@
 
 #include "ns3/object.h"
 #include "utils/nr-milp-types.h"
+#include "utils/nr-metrics-registry.h"
 
 #include <string>
 #include <cstdint>
+#include <cstddef>
 
 namespace ns3
 {
@@ -121,6 +148,16 @@ namespace ns3
 class NrMilpInterface : public Object
 {
   public:
+    /**
+     * \brief Transport between ns-3 and the solver
+     */
+    enum Transport
+    {
+        TRANSPORT_TCP,   ///< TCP socket (host:port)
+        TRANSPORT_UNIX,  ///< Unix-domain socket (path)
+        TRANSPORT_SHM    ///< Unix-domain signalling + shared-memory payloads
+    };
+    
     /**
      * \brief Get the TypeId for this class
      * \return The TypeId
@@ -157,6 +194,38 @@ class NrMilpInterface : public Object
      */
     void SetSolverPort(uint16_t port);
     
+    /**
+     * \brief Select transport and endpoint from a URI
+     * \param uri tcp://host:port, unix:///socket/path or shm:///socket/path
+     * 
+     * Aborts on an unknown scheme, an empty endpoint or host, a port
+     * outside 1-65535 and a bracketed (IPv6) host: TCP is IPv4 only.
+     * Without a port, tcp:// keeps the current one. Takes effect on the
+     * next Connect().
+     * Default: tcp://localhost:8888
+     */
+    void SetSolverUri(const std::string& uri);
+    
+    /**
+     * \brief Get the solver endpoint as a URI
+     * \return URI of the configured transport
+     */
+    std::string GetSolverUri() const;
+    
+    /**
+     * \brief Get the configured transport
+     * \return Transport selected by SetSolverUri()
+     */
+    Transport GetTransport() const;
+    
+    /**
+     * \brief Set the size of the shared-memory region (shm:// only)
+     * \param bytes Region size; each direction gets half
+     * 
+     * Default: 64 MiB
+     */
+    void SetSharedMemorySize(size_t bytes);
+    
     /**
      * \brief Set connection timeout
      * \param timeout Timeout in seconds
@@ -170,12 +239,32 @@ class NrMilpInterface : public Object
      * \brief Set solve timeout
      * \param timeout Timeout in seconds
      * 
-     * How long to wait for MILP solver to return solution.
-     * If solver exceeds this time, returns timeout error.
+     * How long to wait for MILP solver to return solution. The solver is
+     * given this minus the deadline margin as its deadline and returns
+     * its best incumbent then; only if nothing arrives within the full
+     * timeout is a timeout error returned.
      * Default: 60.0 seconds
      */
     void SetSolveTimeout(double timeout);
     
+    /**
+     * \brief Set the relative optimality gap at which the solver may stop
+     * \param gap Gap target, e.g. 0.01 for 1% (0 = prove optimality)
+     * 
+     * Default: 0.0
+     */
+    void SetTargetGap(double gap);
+    
+    /**
+     * \brief Set the part of the solve timeout kept for returning the plan
+     * \param margin Seconds between the solver deadline and the timeout
+     * 
+     * Covers serialization and transfer of the incumbent. The deadline
+     * never drops below 10% of the timeout.
+     * Default: 1.0 seconds
+     */
+    void SetDeadlineMargin(double margin);
+    
     /**
      * \brief Enable/disable automatic reconnection
      * \param enable If true, automatically retry connection on failure
@@ -214,7 +303,8 @@ class NrMilpInterface : public Object
      * \brief Connect to MILP solver
      * \return true if connection successful, false otherwise
      * 
-     * Opens TCP socket connection to solver.
+     * Opens the TCP or Unix-domain socket to the solver; for shm:// also
+     * creates and announces the shared-memory region.
      * Blocks until connection succeeds or timeout.
      * 
      * This is called automatically by SolveProblem() if not connected.
@@ -281,12 +371,16 @@ class NrMilpInterface : public Object
      * 4. Sends JSON via socket
      * 5. Waits for response (blocks up to solveTimeout)
      * 6. Deserializes JSON to MilpSolution
-     * 7. Returns solution
+     * 7. Expands class-level solutions of aggregated problems
+     *    (see AggregateSlaClasses()) to individual UEs
+     * 8. Returns solution
      * 
      * Return value:
-     * - solution.status == "optimal" → Success
+     * - solution.status == "optimal" → Success (gap <= target)
+     * - solution.status == "feasible" → Deadline reached, best incumbent
+     *   returned (solution.mipGap holds its gap)
      * - solution.status == "infeasible" → No solution exists
-     * - solution.status == "timeout" → Solver exceeded time limit
+     * - solution.status == "timeout" → No answer within the timeout
      * - solution.status == "error" → Communication or parsing error
      * 
      * Example:
@@ -298,9 +392,9 @@ class NrMilpInterface : public Object
      *   } else if (sol.status == "infeasible") {
      *       NS_LOG_WARN("SLAs too strict, cannot be satisfied");
      *       // Relax constraints or use heuristic
-     *   } else if (sol.status == "timeout") {
-     *       NS_LOG_WARN("Solver timeout, using best feasible solution");
-     *       // Check if partial solution is available
+     *   } else if (sol.IsIncumbent()) {
+     *       NS_LOG_WARN("Deadline reached, plan within " << sol.mipGap << " of optimum");
+     *       bwpManager->LoadMilpSolution(sol);
      *   } else {
      *       NS_FATAL_ERROR("MILP solver error: " << sol.status);
      *   }
@@ -326,6 +420,8 @@ class NrMilpInterface : public Object
     /**
      * \brief Serialize MILP problem to JSON string
      * \param problem The MILP problem
+     * \param deadlineSeconds Solver deadline; > 0 adds the solver controls
+     *        (deadlineSeconds, mipGapTarget)
      * \return JSON string representation
      * 
      * Made public for unit testing and debugging.
@@ -338,7 +434,7 @@ class NrMilpInterface : public Object
      *   // Can save to file for offline testing
      * \endcode
      */
-    std::string SerializeProblem(const MilpProblem& problem);
+    std::string SerializeProblem(const MilpProblem& problem, double deadlineSeconds = 0.0);
     
     /**
      * \brief Deserialize JSON string to MILP solution
@@ -380,6 +476,13 @@ class NrMilpInterface : public Object
         
         uint64_t totalBytesSent;            ///< Total bytes sent
         uint64_t totalBytesReceived;        ///< Total bytes received
+        uint64_t totalShmBytes;             ///< Payload bytes passed via shared memory
+        
+        uint32_t totalIncumbents;           ///< Solutions returned at the deadline
+        uint32_t totalGapReports;           ///< Solutions that reported a gap
+        double lastGap;                     ///< Gap of the last solution
+        double avgGap;                      ///< Average reported gap
+        double maxGap;                      ///< Largest reported gap
         
         /**
          * \brief Print statistics to output stream
@@ -424,26 +527,65 @@ class NrMilpInterface : public Object
     // ========================================================================
     
     /**
-     * \brief Send data via socket
-     * \param data Data to send
+     * \brief Send a payload to the solver
+     * \param data Payload to send
      * \return true if send successful, false otherwise
      * 
-     * Handles partial writes and errors.
+     * shm://: writes the payload into the request half of the region and
+     * sends a descriptor frame. Otherwise (or if it does not fit) sends
+     * the payload as one frame.
      */
     bool SendData(const std::string& data);
     
     /**
-     * \brief Receive data from socket
+     * \brief Receive a payload from the solver
      * \param data Output buffer for received data
      * \param timeout Timeout in seconds
      * \return true if receive successful, false on timeout or error
      * 
+     * Resolves shared-memory descriptor frames to the payload they
+     * point at.
+     */
+    bool ReceiveData(std::string& data, double timeout);
+    
+    /**
+     * \brief Send one length-prefixed frame over the socket
+     * \param data Frame body
+     * \return true if send successful, false otherwise
+     * 
+     * Handles partial writes and errors.
+     */
+    bool SendFrame(const std::string& data);
+    
+    /**
+     * \brief Receive one length-prefixed frame from the socket
+     * \param data Output buffer for the frame body
+     * \param timeout Timeout in seconds
+     * \return true if receive successful, false on timeout or error
+     * 
      * Blocks until:
-     * - Complete message received (detects end-of-message marker)
+     * - Complete frame received (length prefix)
      * - Timeout occurs
      * - Error occurs
      */
-    bool ReceiveData(std::string& data, double timeout);
+    bool ReceiveFrame(std::string& data, double timeout);
+    
+    /**
+     * \brief Open and connect one socket for the configured transport
+     * \return Connected socket descriptor, or -1 on failure
+     */
+    int OpenSocket();
+    
+    /**
+     * \brief Create, map and announce the shared-memory region (shm://)
+     * \return true once the solver confirmed it attached
+     */
+    bool AttachSharedMemory();
+    
+    /**
+     * \brief Unmap and unlink the shared-memory region
+     */
+    void DetachSharedMemory();
     
     /**
      * \brief Wait for socket to be ready for reading
@@ -482,14 +624,25 @@ class NrMilpInterface : public Object
     void UpdateStatistics(bool success, double solveTime, 
                           uint64_t bytesSent, uint64_t bytesReceived);
     
+    /**
+     * \brief Record the optimality gap of a received solution
+     * \param solution Solution (gap < 0 is not recorded)
+     */
+    void RecordGap(const MilpSolution& solution);
+    
     // ========================================================================
     // MEMBER VARIABLES - CONFIGURATION
     // ========================================================================
     
+    Transport m_transport;              ///< Selected transport
     std::string m_solverAddress;        ///< Solver IP address/hostname
     uint16_t m_solverPort;              ///< Solver TCP port
+    std::string m_socketPath;           ///< Unix-domain socket path (unix://, shm://)
+    size_t m_shmSize;                   ///< Shared-memory region size (bytes)
     double m_connectionTimeout;         ///< Connection timeout (seconds)
     double m_solveTimeout;              ///< Solve timeout (seconds)
+    double m_targetGap;                 ///< Relative gap the solver may stop at
+    double m_deadlineMargin;            ///< Timeout minus solver deadline (seconds)
     bool m_autoReconnect;               ///< Auto-reconnect on failure
     uint32_t m_maxRetries;              ///< Max connection retry attempts
     
@@ -501,11 +654,32 @@ class NrMilpInterface : public Object
     bool m_isConnected;                 ///< Connection status flag
     uint32_t m_reconnectAttempts;       ///< Current reconnection attempt counter
     
+    std::string m_shmName;              ///< POSIX name of the mapped region
+    uint8_t* m_shmBase;                 ///< Mapping (nullptr if not attached)
+    
     // ========================================================================
     // MEMBER VARIABLES - STATISTICS
     // ========================================================================
     
     Statistics m_statistics;            ///< Communication statistics
+    
+    /**
+     * \brief Live mirrors of the statistics in NrMetricsRegistry
+     */
+    struct RegistryMetrics
+    {
+        NrMetricCounter* problems = nullptr;         ///< Problems submitted
+        NrMetricCounter* solutions = nullptr;        ///< Solutions received
+        NrMetricCounter* incumbents = nullptr;       ///< Deadline incumbents accepted
+        NrMetricCounter* timeouts = nullptr;         ///< Solve timeouts
+        NrMetricCounter* errors = nullptr;           ///< Errors
+        NrMetricCounter* reconnections = nullptr;    ///< Reconnection attempts
+        NrMetricCounter* bytesSent = nullptr;        ///< Request bytes
+        NrMetricCounter* bytesReceived = nullptr;    ///< Response bytes
+        NrMetricCounter* shmBytes = nullptr;         ///< Bytes via shared memory
+        NrMetricHistogram* solveSeconds = nullptr;   ///< Round-trip solve time
+        NrMetricGauge* lastGap = nullptr;            ///< Last reported MIP gap
+    } m_metrics;                        ///< Registry metrics
 };
 
 } // namespace ns3
@@ -6,6 +6,7 @@
  */
 
 #include "nr-network-manager.h"
+#include "nr-beam-cache.h"
 #include "utils/nr-sim-config.h"
 
 #include "ns3/log.h"
@@ -24,17 +25,28 @@
 #include "ns3/ideal-beamforming-algorithm.h"
 #include "ns3/nr-eps-bearer.h"
 #include "ns3/epc-tft.h"
+#include "ns3/nr-epc-tft.h"
 
 #include "ns3/nr-ue-net-device.h"
 #include "ns3/nr-gnb-net-device.h"
 #include "ns3/config.h"
 #include "ns3/nr-ue-rrc.h"
 #include "ns3/nr-ue-mac.h"
+#include "ns3/nr-ue-phy.h"
+#include "ns3/nr-gnb-mac.h"
+#include "ns3/nr-gnb-phy.h"
+#include "ns3/nr-gnb-rrc.h"
+#include "ns3/nr-phy-mac-common.h"
+#include "ns3/nr-spectrum-phy.h"
 
 // MILP scheduler
 #include "utils/nr-milp-types.h"
 #include "nr-milp-executor-scheduler.h"
+#include "nr-traffic-manager.h"
 
+#include <array>
+#include <cmath>
+#include <functional>
 #include <iostream>
 #include <utility>
 
@@ -44,13 +56,34 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("NrNetworkManager");
 NS_OBJECT_ENSURE_REGISTERED(NrNetworkManager);
 
+namespace
+{
+
+/// QCI used to steer bearers onto carrier k (BwpManagerAlgorithmStatic
+/// attribute name, bearer QCI). Carrier 0 keeps the default bearer QCI.
+const std::array<std::pair<const char*, NrEpsBearer::Qci>, 6> CARRIER_QCIS = {{
+    {"NGBR_VIDEO_TCP_DEFAULT", NrEpsBearer::NGBR_VIDEO_TCP_DEFAULT},
+    {"NGBR_VIDEO_TCP_PREMIUM", NrEpsBearer::NGBR_VIDEO_TCP_PREMIUM},
+    {"NGBR_VIDEO_TCP_OPERATOR", NrEpsBearer::NGBR_VIDEO_TCP_OPERATOR},
+    {"NGBR_VOICE_VIDEO_GAMING", NrEpsBearer::NGBR_VOICE_VIDEO_GAMING},
+    {"NGBR_IMS", NrEpsBearer::NGBR_IMS},
+    {"NGBR_LOW_LAT_EMBB", NrEpsBearer::NGBR_LOW_LAT_EMBB},
+}};
+
+} // namespace
+
 TypeId
 NrNetworkManager::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::NrNetworkManager")
-                            .SetParent<Object>()
-                            .SetGroupName("NrModular")
-                            .AddConstructor<NrNetworkManager>();
+    static TypeId tid =
+        TypeId("ns3::NrNetworkManager")
+            .SetParent<Object>()
+            .SetGroupName("NrModular")
+            .AddConstructor<NrNetworkManager>()
+            .AddTraceSource("ServingCellChanged",
+                            "A UE attached or handed over to a gNB (UE index, gNB index)",
+                            MakeTraceSourceAccessor(&NrNetworkManager::m_servingCellChangedTrace),
+                            "ns3::NrNetworkManager::ServingCellChangedTracedCallback");
     return tid;
 }
 
@@ -63,6 +96,14 @@ NrNetworkManager::NrNetworkManager()
       m_installed(false)
 {
     NS_LOG_FUNCTION(this);
+
+    NrMetricsRegistry& registry = NrMetricsRegistry::Get();
+    m_handoverStartMetric =
+        registry.GetCounter("nr_handovers_total", "UE handovers", "result=\"started\"");
+    m_handoverOkMetric =
+        registry.GetCounter("nr_handovers_total", "UE handovers", "result=\"ok\"");
+    m_handoverErrorMetric =
+        registry.GetCounter("nr_handovers_total", "UE handovers", "result=\"failed\"");
 }
 
 NrNetworkManager::~NrNetworkManager()
@@ -78,8 +119,14 @@ NrNetworkManager::DoDispose()
     m_nrHelper = nullptr;
     m_epcHelper = nullptr;
     m_channelHelper = nullptr;
+    m_beamformingHelper = nullptr;
+    m_beamCache = nullptr;
     m_gnbDevices = NetDeviceContainer();
     m_ueDevices = NetDeviceContainer();
+    m_dciTrace.Close();
+    m_tbTrace.Close();
+    m_rlcTrace.Close();
+    m_tracedRlcs.clear();
     Object::DoDispose();
 }
 
@@ -110,6 +157,7 @@ NrNetworkManager::SetupNrInfrastructure(const NodeContainer& gnbNodes,
     
     m_epcHelper = CreateObject<NrPointToPointEpcHelper>();
     Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper>();
+    m_beamformingHelper = idealBeamformingHelper;
     m_nrHelper = CreateObject<NrHelper>();
     m_channelHelper = CreateObject<NrChannelHelper>();  // ✅ CORRECT: Create early!
     
@@ -152,15 +200,28 @@ NrNetworkManager::SetupNrInfrastructure(const NodeContainer& gnbNodes,
     // =================================================================
     // STEP 3: Create Operation Band (from cttc-nr-demo.cc lines 270-281)
     // =================================================================
-    std::cout << "\nCreating operation band..." << std::endl;
+    // One band per configured carrier, each with a single CC/BWP. The
+    // same CcBwpCreator keeps BWP ids unique (= carrier index).
+    std::cout << "\nCreating operation bands..." << std::endl;
     
     CcBwpCreator ccBwpCreator;
     const uint8_t numCcPerBand = 1;
-    
-    CcBwpCreator::SimpleOperationBandConf bandConf(frequency, bandwidth, numCcPerBand);
-    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
-    
-    std::cout << "  ✓ Operation band created" << std::endl;
+
+    std::vector<NrSimConfig::ChannelParams::CarrierParams> carriers = m_config->GetCarriers();
+    m_bands.clear();
+    m_bands.reserve(carriers.size());
+    for (const auto& carrier : carriers)
+    {
+        CcBwpCreator::SimpleOperationBandConf bandConf(carrier.frequency,
+                                                       carrier.bandwidth,
+                                                       numCcPerBand);
+        m_bands.push_back(ccBwpCreator.CreateOperationBandContiguousCc(bandConf));
+        std::cout << "  ✓ Band " << (m_bands.size() - 1) << ": "
+                  << carrier.frequency / 1e9 << " GHz, " << carrier.bandwidth / 1e6
+                  << " MHz, numerology " << carrier.numerology << std::endl;
+    }
+    std::vector<std::reference_wrapper<OperationBandInfo>> bandRefs(m_bands.begin(),
+                                                                   m_bands.end());
     
     // =================================================================
     // STEP 4: Assign Channels to Bands (from cttc-nr-demo.cc line 320 or 326)
@@ -168,7 +229,7 @@ NrNetworkManager::SetupNrInfrastructure(const NodeContainer& gnbNodes,
     std::cout << "\nAssigning channel to band..." << std::endl;
     
     // ✅ CORRECT: Assign AFTER ConfigureFactories
-    m_channelHelper->AssignChannelsToBands({band});
+    m_channelHelper->AssignChannelsToBands(bandRefs);
     
     std::cout << "  ✓ Channel assigned to band" << std::endl;
 
@@ -178,7 +239,7 @@ NrNetworkManager::SetupNrInfrastructure(const NodeContainer& gnbNodes,
     // =================================================================
     std::cout << "\nRetrieving BWPs..." << std::endl;
     
-    m_allBwps = CcBwpCreator::GetAllBwps({band});
+    m_allBwps = CcBwpCreator::GetAllBwps(bandRefs);
     
     std::cout << "  ✓ BWPs retrieved: " << m_allBwps.size() << std::endl;
 
@@ -187,31 +248,55 @@ NrNetworkManager::SetupNrInfrastructure(const NodeContainer& gnbNodes,
     // =================================================================
     std::cout << "\nConfiguring beamforming..." << std::endl;
     
-    idealBeamformingHelper->SetAttribute("BeamformingMethod",
-                                         TypeIdValue(DirectPathBeamforming::GetTypeId()));
-    
-    std::cout << "  ✓ Direct path beamforming enabled" << std::endl;
+    const auto& beamforming = m_config->channel.beamforming;
+    idealBeamformingHelper->SetAttribute("BeamformingPeriodicity",
+                                         TimeValue(Seconds(beamforming.updatePeriod)));
+    if (beamforming.cache)
+    {
+        // Same beams as DirectPathBeamforming, reused while the pair's
+        // quantized geometry is unchanged
+        m_beamCache = CreateObject<NrBeamCache>();
+        m_beamCache->SetConfig(m_config);
+        idealBeamformingHelper->SetAttribute(
+            "BeamformingMethod",
+            TypeIdValue(NrCachedDirectPathBeamforming::GetTypeId()));
+        idealBeamformingHelper->SetBeamformingAlgorithmAttribute("Cache",
+                                                                 PointerValue(m_beamCache));
+        std::cout << "  ✓ Direct path beamforming enabled (cached: "
+                  << beamforming.cacheAngleStep << " deg / "
+                  << beamforming.cacheDistanceStep * 100 << "% distance buckets, re-checked after "
+                  << beamforming.cacheMoveThreshold << " m)" << std::endl;
+    }
+    else
+    {
+        idealBeamformingHelper->SetAttribute("BeamformingMethod",
+                                             TypeIdValue(DirectPathBeamforming::GetTypeId()));
+        std::cout << "  ✓ Direct path beamforming enabled" << std::endl;
+    }
+    std::cout << "  ✓ Beams updated every " << beamforming.updatePeriod * 1e3 << " ms"
+              << std::endl;
 
     // =================================================================
     // STEP 7: Configure Antennas (from cttc-nr-demo.cc lines 361-371)
     // =================================================================
     std::cout << "\nConfiguring antennas..." << std::endl;
 
-    // UE antennas: 2x4 later 1x2 now for speed
-    m_nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(1));
-    m_nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(2));
+    // UE antennas (default 1x2; 2x4 is affordable with the beam cache)
+    m_nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(beamforming.ueRows));
+    m_nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(beamforming.ueColumns));
     m_nrHelper->SetUeAntennaAttribute("AntennaElement",
                                       PointerValue(CreateObject<IsotropicAntennaModel>()));
 
-    // gNB antennas: 4x8 (or 8x8 from simple-ran example) later 2x4 now for speed
-    m_nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(2));
-    m_nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(4));
+    // gNB antennas (default 2x4; 4x8 or 8x8 as in the simple-ran example)
+    m_nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(beamforming.gnbRows));
+    m_nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(beamforming.gnbColumns));
     m_nrHelper->SetGnbAntennaAttribute("AntennaElement",
                                        PointerValue(CreateObject<IsotropicAntennaModel>()));
 
-    // std::cout << "  ✓ UE antenna: 2x4" << std::endl;
-    // std::cout << "  ✓ gNB antenna: 4x8" << std::endl;
-    // Display actual antenna config
+    std::cout << "  ✓ UE antenna: " << beamforming.ueRows << "x" << beamforming.ueColumns
+              << std::endl;
+    std::cout << "  ✓ gNB antenna: " << beamforming.gnbRows << "x" << beamforming.gnbColumns
+              << std::endl;
 
     m_setup = true;
 
@@ -239,29 +324,39 @@ NrNetworkManager::SetupNrInfrastructure(const NodeContainer& gnbNodes,
     // NrHelper installs the scheduler during InstallGnbDevice().
     // It must be configured HERE - it cannot be swapped after installation.
     //
-    // TODO: Read from m_config->scheduling.mode once NrSimConfig has that field.
-    // For now: set via a local flag. Set to true for MILP Baseline 2.
-    
-    bool useMilpScheduler = true;  // ← Change to false for default PF scheduler
-    
-    // if (useMilpScheduler)
-    // {
-    //     std::cout << "  Setting MILP Executor Scheduler..." << std::endl;
-    //     m_nrHelper->SetSchedulerTypeId(
-    //         TypeId::LookupByName("ns3::NrMilpExecutorScheduler"));
-    //     std::cout << "  ✓ Scheduler: ns3::NrMilpExecutorScheduler" << std::endl;
-    // }
-    // else
-    // {
-    //     // Default: Proportional Fair scheduler (ns-3 NR built-in)
-    //     std::cout << "  ✓ Scheduler: default (NrMacSchedulerTdmaPF)" << std::endl;
-    // }
-
-        // STEP 8: Configure Scheduler Type
-    std::cout << "  Setting MILP Executor Scheduler Type..." << std::endl;
-    // Use the TypeId directly. This tells the helper: "When you install gNBs, 
-    // create an instance of NrMilpExecutorScheduler for each one."
-    m_nrHelper->SetSchedulerTypeId(NrMilpExecutorScheduler::GetTypeId());
+    // The scheduler comes from m_config->scheduling.schedulerType
+    // (default: ns3::NrMilpExecutorScheduler for MILP Baseline 2).
+    // Any registered NrMacScheduler subclass can be used, which lets the
+    // same scenario run under TDMA/OFDMA RR/PF for comparison.
+    std::string schedulerType = m_config->scheduling.schedulerType;
+    TypeId schedulerTid;
+    NS_ABORT_MSG_IF(!TypeId::LookupByNameFailSafe(schedulerType, &schedulerTid),
+                    "Unknown scheduler type: " << schedulerType);
+    NS_ABORT_MSG_IF(!schedulerTid.IsChildOf(NrMacScheduler::GetTypeId()),
+                    schedulerType << " is not an NrMacScheduler");
+
+    std::cout << "  Setting scheduler type..." << std::endl;
+    m_nrHelper->SetSchedulerTypeId(schedulerTid);
+    std::cout << "  ✓ Scheduler: " << schedulerType << std::endl;
+    // =================================================================
+    // STEP 8a: Carrier aggregation - map bearers to carriers
+    // =================================================================
+    // The static BWP manager routes bearers to BWPs by QCI. Carrier k
+    // gets the k-th QCI below; ActivateCarrierBearers() gives each UE a
+    // bearer with its carrier's QCI.
+    AssignUeCarriers(ueNodes.GetN());
+    if (m_bands.size() > 1)
+    {
+        for (uint16_t k = 0; k < m_bands.size(); ++k)
+        {
+            m_nrHelper->SetGnbBwpManagerAlgorithmAttribute(CARRIER_QCIS[k].first,
+                                                          UintegerValue(k));
+            m_nrHelper->SetUeBwpManagerAlgorithmAttribute(CARRIER_QCIS[k].first,
+                                                         UintegerValue(k));
+        }
+        std::cout << "  ✓ " << m_bands.size() << " carriers mapped to BWPs by QCI" << std::endl;
+    }
+
     // =================================================================
     // STEP 8b: Install gNB and UE devices
     // =================================================================
@@ -271,9 +366,36 @@ NrNetworkManager::SetupNrInfrastructure(const NodeContainer& gnbNodes,
     m_gnbDevices = m_nrHelper->InstallGnbDevice(gnbNodes, m_allBwps);
     std::cout << "  ✓ " << m_gnbDevices.GetN() << " gNB devices installed" << std::endl;
    
+    // Sharded runs: interference from cells simulated on other ranks is
+    // approximated as a rise over the UE noise figure currently in effect
+    if (m_config->partition.enabled && m_config->partition.interferenceMarginDb > 0.0)
+    {
+        TypeId::AttributeInformation info;
+        NS_ABORT_MSG_IF(!NrUePhy::GetTypeId().LookupAttributeByName("NoiseFigure", &info),
+                        "NrUePhy has no NoiseFigure attribute");
+        double noiseFigure = DynamicCast<const DoubleValue>(info.initialValue)->Get();
+        m_nrHelper->SetUePhyAttribute(
+            "NoiseFigure",
+            DoubleValue(noiseFigure + m_config->partition.interferenceMarginDb));
+        std::cout << "  ✓ Out-of-shard interference margin: "
+                  << m_config->partition.interferenceMarginDb << " dB (UE noise figure "
+                  << noiseFigure << " -> " << noiseFigure + m_config->partition.interferenceMarginDb
+                  << " dB)" << std::endl;
+    }
+
     std::cout << "\nInstalling UE devices..." << std::endl;
     m_ueDevices = m_nrHelper->InstallUeDevice(ueNodes, m_allBwps);
     std::cout << "  ✓ " << m_ueDevices.GetN() << " UE devices installed" << std::endl;
+
+    // Per-carrier numerology (UEs pick it up from the cell configuration)
+    for (uint16_t k = 0; k < carriers.size(); ++k)
+    {
+        for (uint32_t i = 0; i < m_gnbDevices.GetN(); ++i)
+        {
+            m_nrHelper->GetGnbPhy(m_gnbDevices.Get(i), k)
+                ->SetAttribute("Numerology", UintegerValue(carriers[k].numerology));
+        }
+    }
     
     std::cout << "\n========================================" << std::endl;
     std::cout << "NR infrastructure setup complete!" << std::endl;
@@ -434,6 +556,11 @@ NrNetworkManager::NotifyConnectionEstablished(std::string context, uint64_t imsi
     std::cout << "[ATTACH] t=" << std::fixed << std::setprecision(3) << now << "s "
               << "UE " << ueIndex << " (IMSI:" << imsi << ") "
               << "✓ Connected to gNB " << cellId << " (Cell ID: " << cellId << ")" << std::endl;
+
+    if (std::optional<uint32_t> gnbIndex = GetGnbIndex(cellId))
+    {
+        m_servingCellChangedTrace(ueIndex, *gnbIndex);
+    }
 }
 
 void 
@@ -450,6 +577,7 @@ NrNetworkManager::NotifyHandoverStart(std::string context, uint64_t imsi,
     
     m_totalHandovers++;
     m_handoverCountPerUe[ueIndex]++;
+    m_handoverStartMetric->Inc();
 }
 
 void
@@ -460,10 +588,16 @@ NrNetworkManager::NotifyHandoverEndOk(std::string context, uint64_t imsi, uint16
     
     // Update serving gNB
     m_ueToGnbMap[imsi] = cellId;
+    m_handoverOkMetric->Inc();
     
     std::cout << "[HANDOVER] t=" << std::fixed << std::setprecision(3) << now << "s "
               << "UE " << ueIndex << " (IMSI:" << imsi << ") "
               << "✓ handover SUCCESS to gNB " << cellId << std::endl;
+
+    if (std::optional<uint32_t> gnbIndex = GetGnbIndex(cellId))
+    {
+        m_servingCellChangedTrace(ueIndex, *gnbIndex);
+    }
 }
 
 void
@@ -471,6 +605,7 @@ NrNetworkManager::NotifyHandoverEndError(std::string context, uint64_t imsi, uin
 {
     uint32_t ueIndex = ImsiToUeIndex(imsi);
     double now = Simulator::Now().GetSeconds();
+    m_handoverErrorMetric->Inc();
     
     std::cout << "[HANDOVER] t=" << std::fixed << std::setprecision(3) << now << "s "
               << "UE " << ueIndex << " (IMSI:" << imsi << ") "
@@ -488,6 +623,244 @@ NrNetworkManager::ImsiToUeIndex(uint64_t imsi) const
     return static_cast<uint32_t>(imsi - 1);
 }
 
+// ============================================================================
+// BINARY TRACES
+// ============================================================================
+
+void
+NrNetworkManager::EnableBinaryTraces(const std::string& prefix)
+{
+    NS_LOG_FUNCTION(this << prefix);
+    NS_ABORT_MSG_IF(!m_installed, "Must call SetupNrInfrastructure() first");
+
+    if (!m_dciTrace.Open<NrDciTraceRecord>(prefix + ".dci.nrtrace") ||
+        !m_tbTrace.Open<NrTbTraceRecord>(prefix + ".tb.nrtrace") ||
+        !m_rlcTrace.Open<NrRlcTraceRecord>(prefix + ".rlc.nrtrace"))
+    {
+        std::cout << "  ⚠ Binary traces disabled: cannot create " << prefix << ".*.nrtrace"
+                  << std::endl;
+        m_dciTrace.Close();
+        m_tbTrace.Close();
+        m_rlcTrace.Close();
+        return;
+    }
+
+    // MAC scheduling and PHY reception are fixed per carrier
+    for (uint32_t i = 0; i < m_gnbDevices.GetN(); ++i)
+    {
+        Ptr<NetDevice> device = m_gnbDevices.Get(i);
+        Ptr<NrGnbNetDevice> gnbDevice = DynamicCast<NrGnbNetDevice>(device);
+        for (uint32_t bwp = 0; bwp < gnbDevice->GetCcMapSize(); ++bwp)
+        {
+            Ptr<NrGnbPhy> phy = gnbDevice->GetPhy(bwp);
+            uint16_t cellId = phy->GetCellId();
+            Ptr<NrGnbMac> mac = gnbDevice->GetMac(bwp);
+            mac->TraceConnectWithoutContext(
+                "DlScheduling",
+                MakeCallback(&NrNetworkManager::TraceDci, this).Bind(cellId, false));
+            mac->TraceConnectWithoutContext(
+                "UlScheduling",
+                MakeCallback(&NrNetworkManager::TraceDci, this).Bind(cellId, true));
+            phy->GetSpectrumPhy()->TraceConnectWithoutContext(
+                "RxPacketTraceGnb",
+                MakeCallback(&NrNetworkManager::TraceTb, this).Bind(true));
+        }
+        gnbDevice->GetRrc()->TraceConnectWithoutContext(
+            "NewUeContext",
+            MakeCallback(&NrNetworkManager::NotifyGnbNewUeContext, this).Bind(device));
+    }
+    for (uint32_t i = 0; i < m_ueDevices.GetN(); ++i)
+    {
+        Ptr<NetDevice> device = m_ueDevices.Get(i);
+        Ptr<NrUeNetDevice> ueDevice = DynamicCast<NrUeNetDevice>(device);
+        for (uint32_t bwp = 0; bwp < ueDevice->GetCcMapSize(); ++bwp)
+        {
+            ueDevice->GetPhy(bwp)->GetSpectrumPhy()->TraceConnectWithoutContext(
+                "RxPacketTraceUe",
+                MakeCallback(&NrNetworkManager::TraceTb, this).Bind(false));
+        }
+        // RLC entities only exist once their bearer is set up
+        ueDevice->GetRrc()->TraceConnectWithoutContext(
+            "DrbCreated",
+            MakeCallback(&NrNetworkManager::NotifyUeDrbCreated, this).Bind(device));
+    }
+
+    std::cout << "  ✓ Binary DCI/TB/RLC traces → " << prefix << ".{dci,tb,rlc}.nrtrace"
+              << std::endl;
+}
+
+void
+NrNetworkManager::StopBinaryTraces()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_dciTrace.IsOpen())
+    {
+        return;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "BINARY TRACES" << std::endl;
+    std::cout << "========================================" << std::endl;
+    for (NrBinaryTraceWriter* trace : {&m_dciTrace, &m_tbTrace, &m_rlcTrace})
+    {
+        bool ok = trace->Close();
+        std::cout << "  " << (ok ? "✓ " : "✗ ") << trace->GetPath() << ": "
+                  << trace->GetNumRecords() << " records, " << std::fixed << std::setprecision(1)
+                  << trace->GetStoredBytes() / 1048576.0 << " MiB ("
+                  << trace->GetRawBytes() / 1048576.0 << " MiB raw)"
+                  << (ok ? "" : " - write error") << std::endl;
+    }
+    std::cout << "========================================\n" << std::endl;
+    m_tracedRlcs.clear();
+}
+
+void
+NrNetworkManager::TraceDci(uint16_t cellId, bool uplink, NrSchedulingCallbackInfo info)
+{
+    NrDciTraceRecord record{};
+    record.time = Simulator::Now().GetSeconds();
+    record.tbSize = info.m_tbSize;
+    record.frame = info.m_frameNum;
+    record.cellId = cellId;
+    record.rnti = info.m_rnti;
+    record.subframe = info.m_subframeNum;
+    record.slot = static_cast<uint8_t>(info.m_slotNum);
+    record.symStart = info.m_symStart;
+    record.numSym = info.m_numSym;
+    record.mcs = info.m_mcs;
+    record.rank = info.m_rank;
+    record.bwpId = info.m_bwpId;
+    record.harqId = info.m_harqId;
+    record.ndi = info.m_ndi;
+    record.rv = info.m_rv;
+    record.direction = static_cast<uint8_t>(uplink ? NrTraceDirection::UL : NrTraceDirection::DL);
+    m_dciTrace.Write(record);
+}
+
+void
+NrNetworkManager::TraceTb(bool uplink, RxPacketTraceParams params)
+{
+    NrTbTraceRecord record{};
+    record.time = Simulator::Now().GetSeconds();
+    record.sinrDb = static_cast<float>(10.0 * std::log10(params.m_sinr));
+    record.sinrMinDb = static_cast<float>(10.0 * std::log10(params.m_sinrMin));
+    record.tbler = static_cast<float>(params.m_tbler);
+    record.tbSize = params.m_tbSize;
+    record.frame = params.m_frameNum;
+    record.cellId = static_cast<uint16_t>(params.m_cellId);
+    record.rnti = params.m_rnti;
+    record.rbs = static_cast<uint16_t>(params.m_rbAssignedNum);
+    record.subframe = params.m_subframeNum;
+    record.slot = static_cast<uint8_t>(params.m_slotNum);
+    record.symStart = params.m_symStart;
+    record.numSym = params.m_numSym;
+    record.mcs = params.m_mcs;
+    record.rank = params.m_rank;
+    record.rv = params.m_rv;
+    record.bwpId = static_cast<uint8_t>(params.m_bwpId);
+    record.corrupt = params.m_corrupt ? 1 : 0;
+    record.direction = static_cast<uint8_t>(uplink ? NrTraceDirection::UL : NrTraceDirection::DL);
+    record.cqi = params.m_cqi;
+    m_tbTrace.Write(record);
+}
+
+void
+NrNetworkManager::TraceRlcTx(uint32_t nodeId,
+                             bool atGnb,
+                             uint16_t rnti,
+                             uint8_t lcid,
+                             uint32_t size)
+{
+    NrRlcTraceRecord record{};
+    record.time = Simulator::Now().GetSeconds();
+    record.size = size;
+    record.nodeId = nodeId;
+    record.rnti = rnti;
+    record.lcid = lcid;
+    record.event = NrRlcTraceRecord::TX;
+    record.atGnb = atGnb ? 1 : 0;
+    m_rlcTrace.Write(record);
+}
+
+void
+NrNetworkManager::TraceRlcRx(uint32_t nodeId,
+                             bool atGnb,
+                             uint16_t rnti,
+                             uint8_t lcid,
+                             uint32_t size,
+                             uint64_t delayNs)
+{
+    NrRlcTraceRecord record{};
+    record.time = Simulator::Now().GetSeconds();
+    record.delayNs = delayNs;
+    record.size = size;
+    record.nodeId = nodeId;
+    record.rnti = rnti;
+    record.lcid = lcid;
+    record.event = NrRlcTraceRecord::RX;
+    record.atGnb = atGnb ? 1 : 0;
+    m_rlcTrace.Write(record);
+}
+
+void
+NrNetworkManager::NotifyUeDrbCreated(Ptr<NetDevice> ueDevice,
+                                     uint64_t imsi,
+                                     uint16_t cellId,
+                                     uint16_t rnti,
+                                     uint8_t lcid)
+{
+    NS_LOG_FUNCTION(this << imsi << cellId << rnti << +lcid);
+    std::ostringstream path;
+    path << "/NodeList/" << ueDevice->GetNode()->GetId() << "/DeviceList/"
+         << ueDevice->GetIfIndex() << "/$ns3::NrUeNetDevice/NrUeRrc/DataRadioBearerMap/*/NrRlc";
+    ConnectRlcTraces(path.str(), ueDevice->GetNode()->GetId(), false);
+}
+
+void
+NrNetworkManager::NotifyGnbNewUeContext(Ptr<NetDevice> gnbDevice, uint16_t cellId, uint16_t rnti)
+{
+    NS_LOG_FUNCTION(this << cellId << rnti);
+    Ptr<NrGnbRrc> rrc = DynamicCast<NrGnbNetDevice>(gnbDevice)->GetRrc();
+    rrc->GetUeManager(rnti)->TraceConnectWithoutContext(
+        "DrbCreated",
+        MakeCallback(&NrNetworkManager::NotifyGnbDrbCreated, this).Bind(gnbDevice));
+}
+
+void
+NrNetworkManager::NotifyGnbDrbCreated(Ptr<NetDevice> gnbDevice,
+                                      uint64_t imsi,
+                                      uint16_t cellId,
+                                      uint16_t rnti,
+                                      uint8_t lcid)
+{
+    NS_LOG_FUNCTION(this << imsi << cellId << rnti << +lcid);
+    std::ostringstream path;
+    path << "/NodeList/" << gnbDevice->GetNode()->GetId() << "/DeviceList/"
+         << gnbDevice->GetIfIndex() << "/$ns3::NrGnbNetDevice/NrGnbRrc/UeMap/" << rnti
+         << "/DataRadioBearerMap/*/NrRlc";
+    ConnectRlcTraces(path.str(), gnbDevice->GetNode()->GetId(), true);
+}
+
+void
+NrNetworkManager::ConnectRlcTraces(const std::string& rlcPath, uint32_t nodeId, bool atGnb)
+{
+    Config::MatchContainer rlcs = Config::LookupMatches(rlcPath);
+    for (auto it = rlcs.Begin(); it != rlcs.End(); ++it)
+    {
+        Ptr<Object> rlc = *it;
+        if (!m_tracedRlcs.insert(rlc).second)
+        {
+            continue;  // Hooked when an earlier bearer was created
+        }
+        rlc->TraceConnectWithoutContext(
+            "TxPDU",
+            MakeCallback(&NrNetworkManager::TraceRlcTx, this).Bind(nodeId, atGnb));
+        rlc->TraceConnectWithoutContext(
+            "RxPDU",
+            MakeCallback(&NrNetworkManager::TraceRlcRx, this).Bind(nodeId, atGnb));
+    }
+}
+
 uint32_t
 NrNetworkManager::GetTotalHandovers() const
 {
@@ -535,6 +908,20 @@ NrNetworkManager::GetServingGnb(uint32_t ueId) const
     return 0; // Not attached
 }
 
+std::optional<uint32_t>
+NrNetworkManager::GetGnbIndex(uint16_t cellId) const
+{
+    for (uint32_t i = 0; i < m_gnbDevices.GetN(); ++i)
+    {
+        Ptr<NrGnbNetDevice> gnbDevice = DynamicCast<NrGnbNetDevice>(m_gnbDevices.Get(i));
+        if (gnbDevice && gnbDevice->GetCellId() == cellId)
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
 void
 NrNetworkManager::PrintAttachmentStatus() const
 {
@@ -603,6 +990,24 @@ NrNetworkManager::GetNrHelper() const
     return m_nrHelper;
 }
 
+Ptr<NrBeamCache>
+NrNetworkManager::GetBeamCache() const
+{
+    return m_beamCache;
+}
+
+uint32_t
+NrNetworkManager::GetNumBwps() const
+{
+    return m_allBwps.size();
+}
+
+BandwidthPartInfoPtrVector
+NrNetworkManager::GetAllBwps() const
+{
+    return m_allBwps;
+}
+
 Ptr<NrPointToPointEpcHelper>
 NrNetworkManager::GetEpcHelper() const
 {
@@ -615,14 +1020,105 @@ NrNetworkManager::GetUeIpInterfaces() const
     return m_ueIpInterfaces;
 }
 
+// ============================================================================
+// CARRIER AGGREGATION
+// ============================================================================
+
+void
+NrNetworkManager::AssignUeCarriers(uint32_t numUes)
+{
+    NS_LOG_FUNCTION(this << numUes);
+
+    NS_ABORT_MSG_IF(m_bands.size() > CARRIER_QCIS.size(),
+                    "At most " << CARRIER_QCIS.size() << " carriers are supported, got "
+                               << m_bands.size());
+
+    // Weighted round-robin: next UE goes to the carrier with the lowest
+    // load per Hz, so UE counts follow carrier bandwidth
+    std::vector<NrSimConfig::ChannelParams::CarrierParams> carriers = m_config->GetCarriers();
+    std::vector<uint32_t> load(carriers.size(), 0);
+    m_ueCarrier.assign(numUes, 0);
+    for (uint32_t ueId = 0; ueId < numUes; ++ueId)
+    {
+        uint16_t best = 0;
+        for (uint16_t k = 1; k < carriers.size(); ++k)
+        {
+            if ((load[k] + 1) / carriers[k].bandwidth <
+                (load[best] + 1) / carriers[best].bandwidth)
+            {
+                best = k;
+            }
+        }
+        m_ueCarrier[ueId] = best;
+        load[best]++;
+    }
+}
+
+uint16_t
+NrNetworkManager::GetUeCarrier(uint32_t ueId) const
+{
+    return (ueId < m_ueCarrier.size()) ? m_ueCarrier[ueId] : 0;
+}
+
+uint32_t
+NrNetworkManager::GetBwpRbNum(uint16_t bwpId) const
+{
+    NS_ABORT_MSG_IF(!m_installed || m_gnbDevices.GetN() == 0,
+                    "Devices must be installed before querying BWP size");
+    return m_nrHelper->GetGnbPhy(m_gnbDevices.Get(0), bwpId)->GetRbNum();
+}
+
+void
+NrNetworkManager::ActivateCarrierBearers()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_bands.size() <= 1)
+    {
+        return;
+    }
+
+    uint32_t activated = 0;
+    for (uint32_t ueId = 0; ueId < m_ueDevices.GetN(); ++ueId)
+    {
+        uint16_t carrier = GetUeCarrier(ueId);
+        if (carrier == 0)
+        {
+            continue;  // Default bearer already maps to BWP 0
+        }
+
+        Ptr<NrEpcTft> tft = Create<NrEpcTft>();
+
+        NrEpcTft::PacketFilter dl;
+        dl.direction = NrEpcTft::DOWNLINK;
+        dl.localPortStart = NrTrafficManager::DL_PORT_BASE + ueId;
+        dl.localPortEnd = NrTrafficManager::DL_PORT_BASE + ueId;
+        tft->Add(dl);
+
+        NrEpcTft::PacketFilter ul;
+        ul.direction = NrEpcTft::UPLINK;
+        ul.remotePortStart = NrTrafficManager::UL_PORT_BASE + ueId;
+        ul.remotePortEnd = NrTrafficManager::UL_PORT_BASE + ueId;
+        tft->Add(ul);
+
+        m_nrHelper->ActivateDedicatedEpsBearer(m_ueDevices.Get(ueId),
+                                               NrEpsBearer(CARRIER_QCIS[carrier].second),
+                                               tft);
+        activated++;
+    }
+
+    std::cout << "  ✓ Carrier bearers: " << activated << " of " << m_ueDevices.GetN()
+              << " UEs steered off carrier 0" << std::endl;
+}
+
 // ============================================================================
 // UE IDENTIFIER MAPPING
 // ============================================================================
 
 uint16_t
-NrNetworkManager::GetUeRnti(uint32_t ueId) const
+NrNetworkManager::GetUeRnti(uint32_t ueId, uint8_t bwpId) const
 {
-    NS_LOG_FUNCTION(this << ueId);
+    NS_LOG_FUNCTION(this << ueId << static_cast<int>(bwpId));
     
     // Validate UE ID
     if (ueId >= m_ueDevices.GetN())
@@ -639,12 +1135,11 @@ NrNetworkManager::GetUeRnti(uint32_t ueId) const
         NS_FATAL_ERROR("Device " << ueId << " is not an NrUeNetDevice");
     }
     
-    // Get MAC for BWP 0 (single BWP scenario)
-    Ptr<NrUeMac> ueMac = ueNetDev->GetMac(0);
+    Ptr<NrUeMac> ueMac = ueNetDev->GetMac(bwpId);
     
     if (!ueMac)
     {
-        NS_FATAL_ERROR("UE " << ueId << " has no MAC at BWP 0");
+        NS_FATAL_ERROR("UE " << ueId << " has no MAC at BWP " << static_cast<int>(bwpId));
     }
     
     // Get RNTI from MAC
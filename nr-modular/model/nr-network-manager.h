@@ -26,10 +26,15 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/cc-bwp-helper.h"
 #include "ns3/nr-ue-net-device.h"
+#include "ns3/traced-callback.h"
+#include "utils/nr-binary-trace.h"
+#include "utils/nr-metrics-registry.h"
 
 
 #include <vector>
 #include <map>
+#include <optional>
+#include <set>
 
 namespace ns3
 {
@@ -39,8 +44,11 @@ class NrHelper;
 class NrPointToPointEpcHelper;
 class NrChannelHelper;
 class IdealBeamformingHelper;
+class NrBeamCache;
 class NrSimConfig;
 class FlowMonitor;
+struct NrSchedulingCallbackInfo;
+struct RxPacketTraceParams;
 
 /**
  * \ingroup nr-modular
@@ -121,8 +129,8 @@ public:
      * 2. Creates NrHelper and links it to EPC
      * 3. Creates and configures channel helper
      * 4. Configures operation band and BWPs
-     * 5. Configures beamforming helper
-     * 6. Configures antenna models (gNB: 8x8, UE: 2x4)
+     * 5. Configures beamforming helper (direct path, optionally cached)
+     * 6. Configures antenna models (channel.beamforming, default gNB 2x4, UE 1x2)
      * 
      * \param gnbs Container of gNB nodes (must have positions already)
      * \param ues Container of UE nodes (must have positions already)
@@ -233,7 +241,41 @@ public:
      * @return Cell ID of serving gNB
      */
     uint16_t GetServingGnb(uint32_t ueId) const;
-    
+
+    /**
+     * @brief Map a cell ID to the index of its gNB device
+     * @param cellId Cell ID (as reported by RRC traces)
+     * @return gNB index in GetGnbDevices(), or std::nullopt if unknown
+     */
+    std::optional<uint32_t> GetGnbIndex(uint16_t cellId) const;
+
+    /**
+     * @brief Signature of the ServingCellChanged trace source
+     * @param ueId UE index
+     * @param gnbIndex Index of the new serving gNB in GetGnbDevices()
+     */
+    typedef void (*ServingCellChangedTracedCallback)(uint32_t ueId, uint32_t gnbIndex);
+
+    // ========================================================================
+    // BINARY TRACES
+    // ========================================================================
+    /**
+     * @brief Record DCI, TB reception and RLC PDU traces to binary files
+     * @param prefix Path prefix; writes <prefix>.dci.nrtrace,
+     *        <prefix>.tb.nrtrace and <prefix>.rlc.nrtrace
+     *
+     * Replaces the NrHelper text traces: records are fixed-size, and
+     * compression and file writes run on background threads. RLC entities
+     * are hooked as their bearers are created. Convert the files with the
+     * nr-trace-convert tool. Must be called after AttachUes().
+     */
+    void EnableBinaryTraces(const std::string& prefix);
+
+    /**
+     * @brief Flush and close the binary trace files and print their sizes
+     */
+    void StopBinaryTraces();
+
     // ========================================================================
     // PHASE 5: CONNECTIVITY TESTING (Optional but Recommended)
     // ========================================================================
@@ -414,6 +456,12 @@ public:
      * \return Pointer to NR helper
      */
     Ptr<NrHelper> GetNrHelper() const;
+
+    /**
+     * \brief Get the beam cache
+     * \return Cache, or nullptr unless channel.beamforming.cache is set
+     */
+    Ptr<NrBeamCache> GetBeamCache() const;
     
     /**
      * \brief Get number of BWPs configured
@@ -426,6 +474,33 @@ public:
      * \return Vector of bandwidth part information
      */
     BandwidthPartInfoPtrVector GetAllBwps() const;
+
+    /**
+     * \brief Get the component carrier (= BWP id) a UE's traffic uses
+     * \param ueId UE index (0-based)
+     * \return Carrier index into NrSimConfig::GetCarriers()
+     *
+     * UEs are spread over carriers in proportion to carrier bandwidth.
+     * With a single carrier this is always 0.
+     */
+    uint16_t GetUeCarrier(uint32_t ueId) const;
+
+    /**
+     * \brief Get the number of PRBs of a BWP as configured on the gNB PHY
+     * \param bwpId BWP index
+     * \return Number of resource blocks
+     */
+    uint32_t GetBwpRbNum(uint16_t bwpId) const;
+
+    /**
+     * \brief Steer each UE's traffic onto its assigned carrier
+     *
+     * UEs on carrier 0 use the default bearer. For every other UE a
+     * dedicated bearer is activated whose QCI the static BWP manager maps
+     * to that UE's carrier, with a TFT matching the UE's DL/UL ports.
+     * No-op with a single carrier. Call after AttachUes().
+     */
+    void ActivateCarrierBearers();
     
     // ========================================================================
     // UE IDENTIFIER MAPPING (for MILP Scheduler)
@@ -444,9 +519,10 @@ public:
      *   uint16_t rnti = netMgr->GetUeRnti(0);  // Get RNTI for UE 0
      * \endcode
      * 
-     * Note: Accesses BWP 0 (single BWP scenario)
+     * The RNTI is per cell, so every BWP of the serving cell reports the
+     * same value; bwpId only selects which MAC is asked.
      */
-    uint16_t GetUeRnti(uint32_t ueId) const;
+    uint16_t GetUeRnti(uint32_t ueId, uint8_t bwpId = 0) const;
     
     /**
      * \brief Get UE ID from RNTI (reverse lookup)
@@ -517,6 +593,7 @@ private:
     Ptr<NrHelper> m_nrHelper;                           ///< NR helper (PHY/MAC/RLC/PDCP)
     Ptr<NrChannelHelper> m_channelHelper;               ///< Channel helper (propagation)
     Ptr<IdealBeamformingHelper> m_beamformingHelper;    ///< Beamforming helper
+    Ptr<NrBeamCache> m_beamCache;                       ///< Cached direct-path beams
     
     // ========================================================================
     // HANDOVER AND MOBILITY
@@ -525,6 +602,12 @@ private:
     bool m_enableHandoverTracing;
     uint32_t m_totalHandovers;
     std::map<uint32_t, uint32_t> m_handoverCountPerUe;
+    NrMetricCounter* m_handoverStartMetric;   ///< Registry: handovers started
+    NrMetricCounter* m_handoverOkMetric;      ///< Registry: handovers completed
+    NrMetricCounter* m_handoverErrorMetric;   ///< Registry: handovers failed
+
+    /// Fired on attachment and successful handover (needs handover tracing)
+    TracedCallback<uint32_t, uint32_t> m_servingCellChangedTrace;
 
     void NotifyConnectionEstablished(std::string context, uint64_t imsi, 
                                     uint16_t cellId, uint16_t rnti);
@@ -552,12 +635,77 @@ private:
      */
     uint32_t ImsiToUeIndex(uint64_t imsi) const;
 
+    // ========================================================================
+    // BINARY TRACES
+    // ========================================================================
+    NrBinaryTraceWriter m_dciTrace;       ///< gNB MAC DL/UL scheduling
+    NrBinaryTraceWriter m_tbTrace;        ///< TB reception at UE and gNB
+    NrBinaryTraceWriter m_rlcTrace;       ///< RLC PDUs at UE and gNB
+    std::set<Ptr<Object>> m_tracedRlcs;   ///< RLC entities already hooked
+
+    /**
+     * @brief Trace sink: gNB MAC DlScheduling / UlScheduling
+     */
+    void TraceDci(uint16_t cellId, bool uplink, NrSchedulingCallbackInfo info);
+
+    /**
+     * @brief Trace sink: spectrum PHY RxPacketTraceUe / RxPacketTraceGnb
+     */
+    void TraceTb(bool uplink, RxPacketTraceParams params);
+
+    /**
+     * @brief Trace sink: RLC TxPDU
+     */
+    void TraceRlcTx(uint32_t nodeId, bool atGnb, uint16_t rnti, uint8_t lcid, uint32_t size);
+
+    /**
+     * @brief Trace sink: RLC RxPDU
+     */
+    void TraceRlcRx(uint32_t nodeId,
+                    bool atGnb,
+                    uint16_t rnti,
+                    uint8_t lcid,
+                    uint32_t size,
+                    uint64_t delayNs);
+
+    /**
+     * @brief UE RRC DrbCreated: hook the UE's new RLC entities
+     */
+    void NotifyUeDrbCreated(Ptr<NetDevice> ueDevice,
+                            uint64_t imsi,
+                            uint16_t cellId,
+                            uint16_t rnti,
+                            uint8_t lcid);
+
+    /**
+     * @brief gNB RRC NewUeContext: watch the UE context for bearers
+     */
+    void NotifyGnbNewUeContext(Ptr<NetDevice> gnbDevice, uint16_t cellId, uint16_t rnti);
+
+    /**
+     * @brief gNB UE context DrbCreated: hook the gNB's new RLC entities
+     */
+    void NotifyGnbDrbCreated(Ptr<NetDevice> gnbDevice,
+                             uint64_t imsi,
+                             uint16_t cellId,
+                             uint16_t rnti,
+                             uint8_t lcid);
+
+    /**
+     * @brief Connect the RLC traces of every not yet hooked entity under a path
+     * @param rlcPath Config path matching NrRlc objects
+     * @param nodeId Node owning the entities
+     * @param atGnb True for gNB-side entities
+     */
+    void ConnectRlcTraces(const std::string& rlcPath, uint32_t nodeId, bool atGnb);
+
     // OPERATION BAND AND BWPs
     // ========================================================================
     
     OperationBandInfo m_operationBand;                  ///< Operation band configuration
     std::vector<OperationBandInfo> m_bands;  // ← Store in vector!          ///< All operation bands
     BandwidthPartInfoPtrVector m_allBwps;               ///< All bandwidth parts
+    std::vector<uint16_t> m_ueCarrier;                  ///< Carrier (BWP) per UE
     
     // ========================================================================
     // DEVICES AND INTERFACES
@@ -610,6 +758,14 @@ private:
      * Called internally by SetupNrInfrastructure()
      */
     void ConfigureBeamforming();
+
+    /**
+     * \brief Assign each UE to a carrier, weighted by carrier bandwidth
+     * \param numUes Number of UEs to assign
+     *
+     * Called internally by SetupNrInfrastructure()
+     */
+    void AssignUeCarriers(uint32_t numUes);
 };
 
 } // namespace ns3
@@ -32,9 +32,11 @@
 #include "ns3/nr-mac-scheduler.h"
 
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
+#include <unordered_map>
 #include <ctime>
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -49,6 +51,35 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE("NrOutputManager");
 NS_OBJECT_ENSURE_REGISTERED(NrOutputManager);
 
+namespace
+{
+/// Smallest UE range handed to a collection worker
+constexpr size_t MIN_UES_PER_WORKER = 256;
+
+// Steps kept by compressed result streams (ns-3 time resolution, 1 cm,
+// 1 bit/s, 0.001 dB); other floats are stored exactly
+constexpr double TIME_QUANTUM_S = 1e-9;
+constexpr double POSITION_QUANTUM_M = 0.01;
+constexpr double RATE_QUANTUM_MBPS = 1e-6;
+constexpr double RADIO_QUANTUM_DB = 1e-3;
+
+/// Raw telemetry bytes collected before the recording compresses a block
+constexpr size_t RECORDING_BLOCK_BYTES = 1 << 20;
+
+/// Stored size and compression ratio for the summary, e.g. "1.2 MiB, 11.4x"
+std::string
+FormatStoredSize(uint64_t rawBytes, uint64_t storedBytes)
+{
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << storedBytes / 1048576.0 << " MiB";
+    if (storedBytes > 0 && rawBytes > storedBytes)
+    {
+        text << ", " << static_cast<double>(rawBytes) / storedBytes << "x";
+    }
+    return text.str();
+}
+} // namespace
+
 TypeId
 NrOutputManager::GetTypeId(void)
 {
@@ -83,6 +114,8 @@ NrOutputManager::NrOutputManager()
       m_tcpConnected(false),
       m_publishedStateCount(0),
       m_failedPublishCount(0),
+      m_consecutiveOverBudget(0),
+      m_resultsInterval(Seconds(0)),
       m_publishInterval(Seconds(0.1))
     //   m_bwpConfigurationSent(false)
 
@@ -92,6 +125,18 @@ NrOutputManager::NrOutputManager()
     // Initialize wall clock start time
     m_wallClockStart = std::chrono::steady_clock::now();
     m_simulationStartTime = Simulator::Now();
+
+    NrMetricsRegistry& registry = NrMetricsRegistry::Get();
+    m_publishOkMetric = registry.GetCounter("nr_telemetry_publishes_total",
+                                            "Telemetry state publications", "result=\"ok\"");
+    m_publishFailMetric = registry.GetCounter("nr_telemetry_publishes_total",
+                                              "Telemetry state publications",
+                                              "result=\"failed\"");
+    m_publishBytesMetric = registry.GetCounter("nr_telemetry_published_bytes_total",
+                                               "JSON bytes of successful publications");
+    m_tickMsMetric = registry.GetHistogram("nr_telemetry_tick_milliseconds",
+                                           "Telemetry collect + encode + send time per tick",
+                                           {0.1, 0.5, 1, 5, 10, 50, 100, 500});
 }
 
 NrOutputManager::~NrOutputManager()
@@ -125,6 +170,16 @@ NrOutputManager::DoDispose()
     {
         m_outputFile.close();
     }
+
+    // Result streams not stopped by WriteResults() (aborted run): keep
+    // what was sampled, without taking a sample from disposed managers
+    Simulator::Cancel(m_resultsEvent);
+    m_ueResults.Close();
+    m_cellResults.Close();
+    m_recording.Close();
+
+    m_collectPool.reset();
+    m_ueSlots.clear();
     
     // Clear references
     m_config = nullptr;
@@ -208,6 +263,10 @@ void
 NrOutputManager::WriteResultsToFile(const std::string& filepath)
 {
     NS_LOG_FUNCTION(this << filepath);
+
+    // Close the result streams first so the summary can reference them
+    StopResultsStream();
+    StopRecording();
     
     // Collect final state
     SimulationState finalState = CollectCurrentState();
@@ -229,6 +288,196 @@ NrOutputManager::WriteResultsToFile(const std::string& filepath)
     }
 }
 
+// ================================================================
+// STREAMED RESULTS
+// ================================================================
+
+bool
+NrOutputManager::StartResultsStream(double interval,
+                                    const std::string& basePath,
+                                    bool csv,
+                                    bool compress)
+{
+    NS_LOG_FUNCTION(this << interval << basePath << csv << compress);
+
+    NS_ABORT_MSG_IF(interval <= 0.0, "Results interval must be > 0, got " << interval);
+    NS_ABORT_MSG_IF(m_topologyManager == nullptr, "TopologyManager not set");
+
+    using Col = NrColumnarWriter;
+    std::vector<Col::Column> ueSchema = {
+        {"time_s", Col::FLOAT64, TIME_QUANTUM_S},
+        {"ue_id", Col::UINT32},
+        {"cell_id", Col::UINT32},
+        {"pos_x", Col::FLOAT64, POSITION_QUANTUM_M},
+        {"pos_y", Col::FLOAT64, POSITION_QUANTUM_M},
+        {"dl_mbps", Col::FLOAT64, RATE_QUANTUM_MBPS},
+        {"ul_mbps", Col::FLOAT64, RATE_QUANTUM_MBPS},
+        {"dl_tx_packets", Col::UINT64},
+        {"dl_rx_packets", Col::UINT64},
+        {"ul_tx_packets", Col::UINT64},
+        {"ul_rx_packets", Col::UINT64},
+        {"dl_loss_pct", Col::FLOAT64},
+        {"ul_loss_pct", Col::FLOAT64},
+        {"delay_ms", Col::FLOAT64},
+        {"sinr_db", Col::FLOAT64, RADIO_QUANTUM_DB},
+        {"rsrp_dbm", Col::FLOAT64, RADIO_QUANTUM_DB},
+        {"mcs", Col::UINT32},
+        {"bwp_id", Col::UINT32},
+    };
+    std::vector<Col::Column> cellSchema = {
+        {"time_s", Col::FLOAT64, TIME_QUANTUM_S},
+        {"gnb_id", Col::UINT32},
+        {"cell_id", Col::UINT32},
+        {"attached_ues", Col::UINT32},
+        {"dl_mbps", Col::FLOAT64, RATE_QUANTUM_MBPS},
+        {"ul_mbps", Col::FLOAT64, RATE_QUANTUM_MBPS},
+        {"allocated_rbs", Col::UINT32},
+        {"total_rbs", Col::UINT32},
+        {"utilization_pct", Col::FLOAT64},
+        {"dl_queue_bytes", Col::UINT64},
+    };
+
+    // Every sample writes one row per UE / per gNB, so the previous value
+    // of the same entity is that many rows back
+    m_ueResults.SetCompression(compress, m_topologyManager->GetUeNodes().GetN());
+    m_cellResults.SetCompression(compress, m_topologyManager->GetGnbNodes().GetN());
+
+    if (!m_ueResults.Open(basePath + ".ue.nrcol", "ue", ueSchema,
+                          csv ? basePath + ".ue.csv" : "") ||
+        !m_cellResults.Open(basePath + ".cell.nrcol", "cell", cellSchema,
+                            csv ? basePath + ".cell.csv" : ""))
+    {
+        m_ueResults.Close();
+        m_cellResults.Close();
+        std::cout << "  ✗ Cannot create result streams at " << basePath << ".*.nrcol" << std::endl;
+        return false;
+    }
+
+    m_resultsFiles.clear();
+    m_resultsInterval = Seconds(interval);
+    m_resultsEvent = Simulator::Schedule(m_resultsInterval,
+                                         &NrOutputManager::RecordResultsSample, this);
+
+    std::cout << "  ✓ Streaming results every " << interval << " s to " << basePath
+              << ".{ue,cell}.nrcol" << (compress ? " (compressed)" : "")
+              << (csv ? " (+ CSV)" : "") << std::endl;
+    return true;
+}
+
+void
+NrOutputManager::StopResultsStream()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_ueResults.IsOpen())
+    {
+        return;
+    }
+    RecordResultsSample();  // End-of-run values
+    Simulator::Cancel(m_resultsEvent);
+
+    for (NrColumnarWriter* stream : {&m_ueResults, &m_cellResults})
+    {
+        std::string path = stream->GetPath();
+        uint64_t rows = stream->GetNumRows();
+        bool ok = stream->Close();
+        std::string size = FormatStoredSize(stream->GetValueBytes(), stream->GetFileBytes());
+        m_resultsFiles.push_back(path + " (" + std::to_string(rows) + " rows, " + size + ")");
+        std::cout << (ok ? "✓ " : "✗ ") << "Results stream " << path << ": " << rows << " rows, "
+                  << size << std::endl;
+    }
+}
+
+bool
+NrOutputManager::StartRecording(const std::string& path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    m_recordingSummary.clear();
+    if (!m_recording.Open(path, RECORDING_BLOCK_BYTES))
+    {
+        std::cout << "  ✗ Cannot create telemetry recording " << path << std::endl;
+        return false;
+    }
+    std::cout << "  ✓ Recording telemetry (compressed) to " << path << std::endl;
+    return true;
+}
+
+void
+NrOutputManager::StopRecording()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_recording.IsOpen())
+    {
+        return;
+    }
+    std::string path = m_recording.GetPath();
+    uint64_t states = m_recording.GetNumRecords();
+    bool ok = m_recording.Close();
+    std::string size = FormatStoredSize(m_recording.GetRawBytes(), m_recording.GetStoredBytes());
+    m_recordingSummary = path + " (" + std::to_string(states) + " states, " + size + ")";
+    std::cout << (ok ? "✓ " : "✗ ") << "Telemetry recording " << path << ": " << states
+              << " states, " << size << std::endl;
+}
+
+void
+NrOutputManager::RecordResultsSample()
+{
+    NS_LOG_FUNCTION(this);
+
+    SimulationState state = CollectCurrentState();
+    double now = state.simulationTime;
+
+    std::unordered_map<uint16_t, std::pair<double, double>> cellThroughput;
+    for (const auto& ue : state.ues)
+    {
+        m_ueResults.Put(now);
+        m_ueResults.Put(ue.ueId);
+        m_ueResults.Put(ue.cellId);
+        m_ueResults.Put(ue.position.x);
+        m_ueResults.Put(ue.position.y);
+        m_ueResults.Put(ue.dlThroughputMbps);
+        m_ueResults.Put(ue.ulThroughputMbps);
+        m_ueResults.Put(ue.dlPacketsTx);
+        m_ueResults.Put(ue.dlPacketsRx);
+        m_ueResults.Put(ue.ulPacketsTx);
+        m_ueResults.Put(ue.ulPacketsRx);
+        m_ueResults.Put(ue.dlLossPct);
+        m_ueResults.Put(ue.ulLossPct);
+        m_ueResults.Put(ue.avgDelayMs);
+        m_ueResults.Put(ue.hasRadioMetrics ? ue.sinrDb : 0.0);
+        m_ueResults.Put(ue.hasRadioMetrics ? ue.rsrpDbm : 0.0);
+        m_ueResults.Put(ue.hasRadioMetrics ? ue.mcs : 0);
+        m_ueResults.Put(ue.currentBwpId);
+        m_ueResults.EndRow();
+
+        auto& cell = cellThroughput[ue.cellId];
+        cell.first += ue.dlThroughputMbps;
+        cell.second += ue.ulThroughputMbps;
+    }
+
+    for (const auto& gnb : state.gnbs)
+    {
+        auto it = cellThroughput.find(gnb.cellId);
+        m_cellResults.Put(now);
+        m_cellResults.Put(gnb.gnbId);
+        m_cellResults.Put(gnb.cellId);
+        m_cellResults.Put(gnb.attachedUeCount);
+        m_cellResults.Put(it != cellThroughput.end() ? it->second.first : 0.0);
+        m_cellResults.Put(it != cellThroughput.end() ? it->second.second : 0.0);
+        m_cellResults.Put(gnb.hasSchedulerMetrics ? gnb.allocatedRbs : 0);
+        m_cellResults.Put(gnb.hasSchedulerMetrics ? gnb.totalRbs : 0);
+        m_cellResults.Put(gnb.hasSchedulerMetrics ? gnb.resourceUtilizationPct : 0.0);
+        m_cellResults.Put(gnb.hasBufferMetrics ? gnb.dlQueueBytes : 0);
+        m_cellResults.EndRow();
+    }
+
+    Simulator::Cancel(m_resultsEvent);
+    m_resultsEvent = Simulator::Schedule(m_resultsInterval,
+                                         &NrOutputManager::RecordResultsSample, this);
+}
+
 // ================================================================
 // TELEMETRY INITIALIZATION
 // ================================================================
@@ -252,13 +501,16 @@ NrOutputManager::InitializeTelemetry()
     // Initialize buffers
     m_stateHistory.clear();
     m_handoverEvents.clear();
-    m_eventLog.clear();
+    m_eventLog.Clear();
+    m_ueSlots.clear();  // Re-resolved on the next collection
     
     // Reset statistics
     m_publishedStateCount = 0;
     m_failedPublishCount = 0;
     m_stateGenTimes.clear();
     m_jsonSizes.clear();
+    m_telemetryCost = TelemetryCost();
+    m_consecutiveOverBudget = 0;
     
     m_telemetryInitialized = true;
     
@@ -359,9 +611,11 @@ NrOutputManager::OnUeAttachment(uint32_t ueId, uint16_t cellId)
     NS_LOG_FUNCTION(this << ueId << cellId);
     
     // Log event
-    std::ostringstream desc;
-    desc << "UE " << ueId << " attached to cell " << cellId;
-    LogEvent("attachment", desc.str());
+    NrEventRecord evt;
+    evt.type = NrEventType::ATTACHMENT;
+    evt.ueId = ueId;
+    evt.cellId = cellId;
+    LogEvent(evt);
     
     // Trigger update if enabled
     if (m_telemetryConfig.eventTriggeredUpdates && m_telemetryEnabled)
@@ -395,10 +649,13 @@ NrOutputManager::OnHandover(uint32_t ueId, uint16_t sourceCellId,
     }
     
     // Log event
-    std::ostringstream desc;
-    desc << "UE " << ueId << " handover " << sourceCellId << " → " << targetCellId
-         << (success ? " ✓" : " ✗");
-    LogEvent("handover", desc.str());
+    NrEventRecord evt;
+    evt.type = NrEventType::HANDOVER;
+    evt.ueId = ueId;
+    evt.cellId = sourceCellId;
+    evt.targetCellId = targetCellId;
+    evt.success = success;
+    LogEvent(evt);
     
     // Trigger update if enabled
     if (m_telemetryConfig.eventTriggeredUpdates && m_telemetryEnabled)
@@ -465,18 +722,54 @@ NrOutputManager::CollectCurrentState()
         state.ueCount = ueNodes.GetN();
         state.gnbCount = gnbNodes.GetN();
         
-        // Collect UE states
+        // ----- Simulator thread: shared ns-3 objects and mobility -----
+        if (m_ueSlots.size() != state.ueCount)
+        {
+            ResolveUeSlots(ueNodes);
+        }
+        m_gnbPositions.clear();
+        for (uint32_t g = 0; g < state.gnbCount; ++g)
+        {
+            Ptr<MobilityModel> gnbMob = gnbNodes.Get(g)->GetObject<MobilityModel>();
+            if (gnbMob != nullptr)
+            {
+                m_gnbPositions.emplace_back(g, gnbMob->GetPosition());
+            }
+        }
+        m_servingCells.assign(state.ueCount, 0);
+        
+        state.ues.resize(state.ueCount);
         for (uint32_t i = 0; i < state.ueCount; ++i)
         {
-            SimulationState::UeState ueState = CollectUeState(i);
-            state.ues.push_back(ueState);
+            CollectUeMobility(i, state.ues[i]);
+        }
+        
+        // ----- Collection workers: per-UE lookups into preassigned slots -----
+        auto collectRange = [this, &state](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                CollectUeState(static_cast<uint32_t>(i), state.ues[i]);
+            }
+        };
+        uint32_t threads = m_telemetryConfig.collectionThreads;
+        if (threads != 1 && state.ueCount >= 2 * MIN_UES_PER_WORKER)
+        {
+            if (!m_collectPool || (threads != 0 && m_collectPool->GetNumThreads() != threads))
+            {
+                m_collectPool = std::make_unique<NrWorkerPool>(threads);
+            }
+            m_collectPool->ParallelFor(state.ueCount, collectRange, MIN_UES_PER_WORKER);
+        }
+        else
+        {
+            collectRange(0, state.ueCount);
         }
         
         // Collect gNB states
+        state.gnbs.reserve(state.gnbCount);
         for (uint32_t i = 0; i < state.gnbCount; ++i)
         {
-            SimulationState::GnbState gnbState = CollectGnbState(i);
-            state.gnbs.push_back(gnbState);
+            state.gnbs.push_back(CollectGnbState(i, gnbNodes));
         }
     }
     else
@@ -507,13 +800,14 @@ NrOutputManager::CollectCurrentState()
     // ===== Event log =====
     if (m_telemetryConfig.includeEventLog)
     {
-        state.recentEvents = m_eventLog;
+        m_eventLog.CopyTo(state.recentEvents);
     }
     
     // ===== Track generation time =====
     auto endTime = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-    m_stateGenTimes.push_back(duration.count());
+    double collectMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    m_stateGenTimes.push_back(collectMs);
+    m_telemetryCost.lastCollectMs = collectMs;
     
     // Keep history buffer limited
     if (m_stateGenTimes.size() > 1000)
@@ -535,109 +829,129 @@ NrOutputManager::CollectCurrentState()
     return state;
 }
 
-NrOutputManager::SimulationState::UeState
-NrOutputManager::CollectUeState(uint32_t ueId)
+void
+NrOutputManager::ResolveUeSlots(const NodeContainer& ueNodes)
 {
-    SimulationState::UeState ueState;
+    NS_LOG_FUNCTION(this << ueNodes.GetN());
     
-    // Basic info
-    ueState.ueId = ueId;
-    ueState.imsi = 0;  // Will be set if available
+    m_ueSlots.assign(ueNodes.GetN(), UeSlot{nullptr, "none", nullptr});
     
-    // Get UE node
-    NodeContainer ueNodes = m_topologyManager->GetUeNodes();
-    if (ueId >= ueNodes.GetN())
+    NetDeviceContainer ueDevices;
+    if (m_networkManager != nullptr)
     {
-        NS_LOG_WARN("UE " << ueId << " out of range");
-        return ueState;
+        ueDevices = m_networkManager->GetUeDevices();
     }
     
-    Ptr<Node> ueNode = ueNodes.Get(ueId);
-    
-    // ===== IMSI =====
-    // Try to get IMSI from NetworkManager if method exists
-    // For now, use approximation based on typical assignment
-    ueState.imsi = ueId + 7;  // TODO: Add GetUeImsi() to NetworkManager
-    
-    // ===== Position and Velocity =====
-    if (m_telemetryConfig.includePositions)
+    for (uint32_t i = 0; i < ueNodes.GetN(); ++i)
     {
-        Ptr<MobilityModel> mobility = ueNode->GetObject<MobilityModel>();
+        UeSlot& slot = m_ueSlots[i];
+        
+        Ptr<MobilityModel> mobility = ueNodes.Get(i)->GetObject<MobilityModel>();
         if (mobility != nullptr)
         {
-            ueState.position = mobility->GetPosition();
-            
-            if (m_telemetryConfig.includeVelocities)
-            {
-                ueState.velocity = mobility->GetVelocity();
-                ueState.speed = ueState.velocity.GetLength();
-            }
-            else
-            {
-                ueState.velocity = Vector(0, 0, 0);
-                ueState.speed = 0.0;
-            }
-            
-            // Determine mobility model type
+            slot.mobility = mobility;
             if (DynamicCast<WaypointMobilityModel>(mobility) != nullptr)
-            {
-                ueState.mobilityModel = "waypoint";
-                // TODO: Get current waypoint index if WaypointMobilityModel exposes it
-                ueState.currentWaypoint = 0;
-                ueState.totalWaypoints = 0;
-            }
+                slot.mobilityModel = "waypoint";
             else if (DynamicCast<RandomWalk2dMobilityModel>(mobility) != nullptr)
-            {
-                ueState.mobilityModel = "random_walk";
-                ueState.currentWaypoint = 0;
-                ueState.totalWaypoints = 0;
-            }
+                slot.mobilityModel = "random_walk";
             else
+                slot.mobilityModel = "static";
+        }
+        
+        if (i < ueDevices.GetN())
+        {
+            Ptr<NrUeNetDevice> ueNetDev = DynamicCast<NrUeNetDevice>(ueDevices.Get(i));
+            if (ueNetDev != nullptr)
             {
-                ueState.mobilityModel = "static";
-                ueState.currentWaypoint = 0;
-                ueState.totalWaypoints = 0;
+                try
+                {
+                    slot.phy = ueNetDev->GetPhy(0);
+                }
+                catch (...)
+                {
+                    NS_LOG_DEBUG("UE " << i << ": GetPhy(0) failed, no radio metrics");
+                }
             }
         }
+    }
+}
+
+void
+NrOutputManager::CollectUeMobility(uint32_t ueId, SimulationState::UeState& ueState)
+{
+    if (!m_telemetryConfig.includePositions)
+    {
+        return;
+    }
+    
+    const UeSlot& slot = m_ueSlots[ueId];
+    ueState.mobilityModel = slot.mobilityModel;
+    // TODO: Get current waypoint index if WaypointMobilityModel exposes it
+    ueState.currentWaypoint = 0;
+    ueState.totalWaypoints = 0;
+    
+    if (slot.mobility != nullptr)
+    {
+        ueState.position = slot.mobility->GetPosition();
+        
+        if (m_telemetryConfig.includeVelocities)
+        {
+            ueState.velocity = slot.mobility->GetVelocity();
+            ueState.speed = ueState.velocity.GetLength();
+        }
         else
         {
-            ueState.position = Vector(0, 0, 0);
             ueState.velocity = Vector(0, 0, 0);
             ueState.speed = 0.0;
-            ueState.mobilityModel = "none";
-            ueState.currentWaypoint = 0;
-            ueState.totalWaypoints = 0;
         }
     }
+    else
+    {
+        ueState.position = Vector(0, 0, 0);
+        ueState.velocity = Vector(0, 0, 0);
+        ueState.speed = 0.0;
+    }
+}
+
+void
+NrOutputManager::CollectUeState(uint32_t ueId, SimulationState::UeState& ueState)
+{
+    // Basic info
+    ueState.ueId = ueId;
+    
+    // ===== IMSI =====
+    // Try to get IMSI from NetworkManager if method exists
+    // For now, use approximation based on typical assignment
+    ueState.imsi = ueId + 7;  // TODO: Add GetUeImsi() to NetworkManager
+    
+    uint16_t servingCell = 0;
+    if (m_networkManager != nullptr)
+    {
+        servingCell = m_networkManager->GetServingGnb(ueId);
+    }
+    m_servingCells[ueId] = servingCell;
     
     // ===== Network Attachment =====
     if (m_telemetryConfig.includeAttachments && m_networkManager != nullptr)
     {
-        ueState.cellId = m_networkManager->GetServingGnb(ueId);
+        ueState.cellId = servingCell;
         // gnbId will be resolved below via the distance loop (closest gNB index)
         ueState.gnbId = 0;  // default; overwritten when positions are available
         
         // Calculate distance to serving gNB AND resolve gnbId
         if (m_telemetryConfig.includePositions)
         {
-            NodeContainer gnbNodes = m_topologyManager->GetGnbNodes();
-            
             // Find the closest gNB — this also gives us the node index,
             // which is the gnbId the dashboard needs to draw connection lines.
             double   minDist       = 1e9;
             uint32_t closestGnbIdx = 0;
-            for (uint32_t g = 0; g < gnbNodes.GetN(); ++g)
+            for (const auto& [g, gnbPos] : m_gnbPositions)
             {
-                Ptr<MobilityModel> gnbMob = gnbNodes.Get(g)->GetObject<MobilityModel>();
-                if (gnbMob != nullptr)
+                double dist = CalculateDistance(ueState.position, gnbPos);
+                if (dist < minDist)
                 {
-                    Vector gnbPos = gnbMob->GetPosition();
-                    double dist   = CalculateDistance(ueState.position, gnbPos);
-                    if (dist < minDist)
-                    {
-                        minDist       = dist;
-                        closestGnbIdx = g;
-                    }
+                    minDist       = dist;
+                    closestGnbIdx = g;
                 }
             }
             ueState.distanceToGnb = minDist;
@@ -705,12 +1019,10 @@ NrOutputManager::CollectUeState(uint32_t ueId)
     {
         CollectUeBufferMetrics(ueState);
     }
-    
-    return ueState;
 }
 
 NrOutputManager::SimulationState::GnbState
-NrOutputManager::CollectGnbState(uint32_t gnbId)
+NrOutputManager::CollectGnbState(uint32_t gnbId, const NodeContainer& gnbNodes)
 {
     SimulationState::GnbState gnbState;
     
@@ -721,7 +1033,6 @@ NrOutputManager::CollectGnbState(uint32_t gnbId)
     gnbState.hasBufferMetrics = false;
     
     // Get gNB node
-    NodeContainer gnbNodes = m_topologyManager->GetGnbNodes();
     if (gnbId >= gnbNodes.GetN())
     {
         NS_LOG_WARN("gNB " << gnbId << " out of range");
@@ -795,11 +1106,9 @@ NrOutputManager::CollectGnbState(uint32_t gnbId)
     // Count attached UEs
     if (m_networkManager != nullptr)
     {
-        NodeContainer ueNodes = m_topologyManager->GetUeNodes();
-        for (uint32_t i = 0; i < ueNodes.GetN(); ++i)
+        for (uint32_t i = 0; i < m_servingCells.size(); ++i)
         {
-            uint16_t servingCell = m_networkManager->GetServingGnb(i);
-            if (servingCell == gnbState.cellId)
+            if (m_servingCells[i] == gnbState.cellId)
             {
                 gnbState.attachedUeCount++;
                 gnbState.attachedUeIds.push_back(i);
@@ -897,70 +1206,19 @@ NrOutputManager::CollectUeRadioMetrics(SimulationState::UeState& ueState)
     ueState.cqi = 0;
     ueState.mcs = 0;
     
-    std::cout << "DEBUG: CollectUeRadioMetrics for UE " << ueState.ueId << std::endl;
-    
-    if (m_networkManager == nullptr)
-    {
-        std::cout << "  FAIL: m_networkManager is nullptr" << std::endl;
-        return;
-    }
-    
-    std::cout << "  NetworkManager OK" << std::endl;
-    
-    // Access the UE device from NetworkManager's container
-    NetDeviceContainer ueDevices = m_networkManager->GetUeDevices();
-    std::cout << "  GetUeDevices returned container with " << ueDevices.GetN() << " devices" << std::endl;
-    
-    if (ueState.ueId >= ueDevices.GetN())
-    {
-        std::cout << "  FAIL: UE " << ueState.ueId << " >= " << ueDevices.GetN() << std::endl;
-        return;
-    }
-    
-    Ptr<NetDevice> dev = ueDevices.Get(ueState.ueId);
-    std::cout << "  Got NetDevice pointer: " << (dev ? "valid" : "nullptr") << std::endl;
-    
-    Ptr<NrUeNetDevice> ueNetDev = DynamicCast<NrUeNetDevice>(dev);
-    std::cout << "  DynamicCast result: " << (ueNetDev ? "valid" : "nullptr") << std::endl;
-    
-    if (ueNetDev == nullptr)
-    {
-        std::cout << "  FAIL: DynamicCast returned nullptr" << std::endl;
-        // Try to see what type it actually is
-        std::cout << "  Device TypeId: " << dev->GetInstanceTypeId().GetName() << std::endl;
-        return;
-    }
-    
-    // Get the PHY from the primary BWP
-    Ptr<NrUePhy> uePhy = nullptr;
-    try
-    {
-        std::cout << "  Attempting GetPhy(0)..." << std::endl;
-        uePhy = ueNetDev->GetPhy(0);
-        std::cout << "  GetPhy(0) returned: " << (uePhy ? "valid" : "nullptr") << std::endl;
-    }
-    catch (const std::exception& e)
-    {
-        std::cout << "  EXCEPTION in GetPhy(0): " << e.what() << std::endl;
-        return;
-    }
-    catch (...)
-    {
-        std::cout << "  UNKNOWN EXCEPTION in GetPhy(0)" << std::endl;
-        return;
-    }
-    
-    if (uePhy == nullptr)
+    // PHY resolved on the simulator thread (ResolveUeSlots); no Ptr copy here
+    if (ueState.ueId >= m_ueSlots.size() || !m_ueSlots[ueState.ueId].phy)
     {
-        std::cout << "  FAIL: uePhy is nullptr" << std::endl;
+        NS_LOG_DEBUG("UE " << ueState.ueId << ": no NrUePhy, radio metrics unavailable");
         return;
     }
+    const Ptr<NrUePhy>& uePhy = m_ueSlots[ueState.ueId].phy;
     
     // Extract RSRP
     ueState.hasRadioMetrics = true;
     ueState.rsrpDbm = uePhy->GetRsrp();
     
-    std::cout << "  SUCCESS: RSRP = " << ueState.rsrpDbm << " dBm" << std::endl;
+    NS_LOG_DEBUG("  SUCCESS: RSRP = " << ueState.rsrpDbm << " dBm");
 }
 
 void
@@ -1299,9 +1557,29 @@ NrOutputManager::StateToJson(const SimulationState& state, bool prettyPrint)
         {
             json jEvt;
             jEvt["timestamp"] = evt.timestamp;
-            jEvt["type"] = evt.type;
-            jEvt["description"] = evt.description;
-            jEvt["details"] = evt.details;
+            jEvt["type"] = NrEventTypeToString(evt.type);
+            jEvt["description"] = m_eventLog.Describe(evt);
+            jEvt["details"] = json::object();
+            switch (evt.type)
+            {
+            case NrEventType::ATTACHMENT:
+                jEvt["details"]["ue_id"] = evt.ueId;
+                jEvt["details"]["cell_id"] = evt.cellId;
+                break;
+            case NrEventType::HANDOVER:
+                jEvt["details"]["ue_id"] = evt.ueId;
+                jEvt["details"]["source_cell_id"] = evt.cellId;
+                jEvt["details"]["target_cell_id"] = evt.targetCellId;
+                jEvt["details"]["success"] = evt.success;
+                break;
+            case NrEventType::TELEMETRY_BUDGET:
+                jEvt["details"]["tick_ms"] = evt.value;
+                jEvt["details"]["budget_ms"] = evt.threshold;
+                jEvt["details"]["disabled"] = m_eventLog.GetText(evt.textId);
+                break;
+            default:
+                break;
+            }
             
             j["events"]["recent"].push_back(jEvt);
         }
@@ -1387,6 +1665,24 @@ NrOutputManager::GenerateSummaryReport(const SimulationState& state)
         report << "  Total Handovers: " << state.totalHandovers << "\n\n";
     }
     
+    if (!m_recordingSummary.empty())
+    {
+        report << "Telemetry Recording:\n";
+        report << "  " << m_recordingSummary << "\n\n";
+    }
+    
+    if (!m_resultsFiles.empty())
+    {
+        // Per-UE and per-cell time series are in the columnar streams
+        report << "Result Streams:\n";
+        for (const auto& file : m_resultsFiles)
+        {
+            report << "  " << file << "\n";
+        }
+        report << "\n========================================\n";
+        return report.str();
+    }
+    
     report << "Per-UE Statistics:\n";
     for (const auto& ue : state.ues)
     {
@@ -1451,11 +1747,13 @@ NrOutputManager::PublishState(const SimulationState& state, const std::string& t
 {
     NS_LOG_FUNCTION(this << trigger);
     
-    if (m_publishMethod == PUBLISH_DISABLED)
+    if (m_publishMethod == PUBLISH_DISABLED && !m_recording.IsOpen())
         return;
     
     // Convert to JSON
+    auto encodeStart = std::chrono::steady_clock::now();
     std::string json = StateToJson(state, false);
+    auto sendStart = std::chrono::steady_clock::now();
     
     // Publish via configured method
     bool success = false;
@@ -1478,13 +1776,43 @@ NrOutputManager::PublishState(const SimulationState& state, const std::string& t
             success = PublishToPipe(json);
             break;
             
+        case PUBLISH_DISABLED:
+            success = true;  // Recording only
+            break;
+            
         default:
             return;
     }
     
+    if (m_recording.IsOpen())
+    {
+        json += '\n';  // One state per line
+        m_recording.Append(json.data(), json.size());
+        json.pop_back();
+    }
+    
+    auto sendEnd = std::chrono::steady_clock::now();
+    
+    // Per-stage cost (collect time was recorded by CollectCurrentState)
+    m_telemetryCost.ticks++;
+    m_telemetryCost.lastEncodeMs =
+        std::chrono::duration<double, std::milli>(sendStart - encodeStart).count();
+    m_telemetryCost.lastSendMs =
+        std::chrono::duration<double, std::milli>(sendEnd - sendStart).count();
+    m_telemetryCost.totalCollectMs += m_telemetryCost.lastCollectMs;
+    m_telemetryCost.totalEncodeMs += m_telemetryCost.lastEncodeMs;
+    m_telemetryCost.totalSendMs += m_telemetryCost.lastSendMs;
+    
+    double tickMs = m_telemetryCost.lastCollectMs + m_telemetryCost.lastEncodeMs +
+                    m_telemetryCost.lastSendMs;
+    m_tickMsMetric->Observe(tickMs);
+    EnforceTelemetryBudget(tickMs);
+    
     if (success)
     {
         m_publishedStateCount++;
+        m_publishOkMetric->Inc();
+        m_publishBytesMetric->Inc(json.size());
         m_lastPublishTime = Simulator::Now();
         
         NS_LOG_DEBUG("Published state #" << m_publishedStateCount 
@@ -1493,6 +1821,7 @@ NrOutputManager::PublishState(const SimulationState& state, const std::string& t
     else
     {
         m_failedPublishCount++;
+        m_publishFailMetric->Inc();
         NS_LOG_WARN("Failed to publish state (failure #" << m_failedPublishCount << ")");
     }
 }
@@ -1656,20 +1985,16 @@ NrOutputManager::GetCurrentTimeIso8601()
 }
 
 void
-NrOutputManager::LogEvent(const std::string& type, const std::string& description)
+NrOutputManager::LogEvent(NrEventRecord event)
 {
-    SimulationState::SimulationEvent evt;
-    evt.timestamp = Simulator::Now().GetSeconds();
-    evt.type = type;
-    evt.description = description;
-    
-    m_eventLog.push_back(evt);
-    
-    // Maintain max size
-    while (m_eventLog.size() > m_telemetryConfig.maxEventHistory)
+    // Follows SetTelemetryConfig(); reallocates only when the limit changes
+    if (m_eventLog.GetCapacity() != m_telemetryConfig.maxEventHistory)
     {
-        m_eventLog.pop_front();
+        m_eventLog.SetCapacity(m_telemetryConfig.maxEventHistory);
     }
+    
+    event.timestamp = Simulator::Now().GetSeconds();
+    m_eventLog.Record(event);
 }
 
 void
@@ -1685,6 +2010,104 @@ NrOutputManager::ScheduleNextUpdate()
     );
 }
 
+// ================================================================
+// TELEMETRY BUDGET
+// ================================================================
+
+void
+NrOutputManager::EnforceTelemetryBudget(double tickMs)
+{
+    if (m_telemetryConfig.tickBudgetMs <= 0.0)
+        return;
+    
+    if (tickMs <= m_telemetryConfig.tickBudgetMs)
+    {
+        m_consecutiveOverBudget = 0;
+        return;
+    }
+    
+    m_telemetryCost.overBudgetTicks++;
+    m_consecutiveOverBudget++;
+    
+    if (m_consecutiveOverBudget < std::max<uint32_t>(1, m_telemetryConfig.budgetGraceTicks))
+        return;
+    
+    m_consecutiveOverBudget = 0;
+    
+    std::string disabled = DegradeTelemetry();
+    if (disabled.empty())
+    {
+        NS_LOG_WARN("Telemetry over budget (" << tickMs << " ms > "
+                    << m_telemetryConfig.tickBudgetMs << " ms), nothing left to disable");
+        return;
+    }
+    
+    m_telemetryCost.disabledFields.push_back(disabled);
+    
+    NrEventRecord evt;
+    evt.type = NrEventType::TELEMETRY_BUDGET;
+    evt.value = tickMs;
+    evt.threshold = m_telemetryConfig.tickBudgetMs;
+    evt.textId = m_eventLog.Intern(disabled);
+    LogEvent(evt);
+    
+    std::string desc = m_eventLog.Describe(evt);
+    NS_LOG_WARN(desc);
+    std::cout << "⚠ " << desc << std::endl;
+}
+
+std::string
+NrOutputManager::DegradeTelemetry()
+{
+    TelemetryConfig& cfg = m_telemetryConfig;
+    
+    // Fixed order (see TelemetryCost): expected cost and least essential first
+    if (cfg.includeRadioMetrics)
+    {
+        cfg.includeRadioMetrics = false;
+        return "radio_metrics";
+    }
+    if (cfg.maxHistorySize > 0)
+    {
+        cfg.maxHistorySize = 0;
+        m_stateHistory.clear();
+        return "state_history";
+    }
+    if (cfg.includeBufferMetrics)
+    {
+        cfg.includeBufferMetrics = false;
+        return "buffer_metrics";
+    }
+    if (cfg.includeSchedulerMetrics)
+    {
+        cfg.includeSchedulerMetrics = false;
+        return "scheduler_metrics";
+    }
+    if (cfg.includeEventLog)
+    {
+        cfg.includeEventLog = false;
+        return "event_log";
+    }
+    if (cfg.includeVelocities)
+    {
+        cfg.includeVelocities = false;
+        return "velocities";
+    }
+    if (cfg.includeHandovers)
+    {
+        cfg.includeHandovers = false;
+        return "handovers";
+    }
+    if (cfg.includeTrafficStats)
+    {
+        cfg.includeTrafficStats = false;
+        return "traffic_stats";
+    }
+    
+    // Positions and attachments are the core of the dashboard view
+    return "";
+}
+
 // ================================================================
 // STATE HISTORY
 // ================================================================
@@ -1751,6 +2174,82 @@ NrOutputManager::GetAvgJsonSizeBytes() const
     return sum / m_jsonSizes.size();
 }
 
+NrOutputManager::TelemetryCost
+NrOutputManager::GetTelemetryCost() const
+{
+    return m_telemetryCost;
+}
+
+std::vector<NrMemoryItem>
+NrOutputManager::GetMemoryUsage() const
+{
+    using Mem = NrMemoryProfiler;
+    std::vector<NrMemoryItem> items;
+
+    uint64_t history = 0;
+    for (const auto& state : m_stateHistory)
+    {
+        history += sizeof(SimulationState) + Mem::VectorBytes(state.ues) +
+                   Mem::VectorBytes(state.gnbs) + Mem::VectorBytes(state.recentEvents);
+        for (const auto& gnb : state.gnbs)
+        {
+            history += Mem::VectorBytes(gnb.attachedUeIds);
+        }
+    }
+    items.push_back({"state_history", history, m_stateHistory.size(), "states"});
+
+    items.push_back({"event_log",
+                     m_eventLog.GetCapacity() * sizeof(NrEventRecord) +
+                         m_handoverEvents.size() * sizeof(SimulationState::HandoverEvent),
+                     m_eventLog.GetCapacity() + m_handoverEvents.size(),
+                     "events"});
+
+    items.push_back({"ue_slots",
+                     Mem::VectorBytes(m_ueSlots) + Mem::VectorBytes(m_gnbPositions) +
+                         Mem::VectorBytes(m_servingCells),
+                     m_ueSlots.size(),
+                     "UEs"});
+
+    items.push_back({"output_buffers",
+                     m_ueResults.GetBufferBytes() + m_cellResults.GetBufferBytes() +
+                         m_recording.GetBufferBytes(),
+                     static_cast<uint64_t>(m_ueResults.IsOpen()) + m_cellResults.IsOpen() +
+                         m_recording.IsOpen(),
+                     "files"});
+    return items;
+}
+
+double
+NrOutputManager::TelemetryCost::GetAvgTickMs() const
+{
+    if (ticks == 0)
+        return 0.0;
+    
+    return (totalCollectMs + totalEncodeMs + totalSendMs) / ticks;
+}
+
+void
+NrOutputManager::TelemetryCost::Print(std::ostream& os) const
+{
+    os << "Telemetry cost over " << ticks << " ticks:" << std::endl;
+    if (ticks > 0)
+    {
+        os << "  Collect: " << totalCollectMs / ticks << " ms/tick" << std::endl;
+        os << "  Encode:  " << totalEncodeMs / ticks << " ms/tick" << std::endl;
+        os << "  Send:    " << totalSendMs / ticks << " ms/tick" << std::endl;
+    }
+    os << "  Over-budget ticks: " << overBudgetTicks << std::endl;
+    if (!disabledFields.empty())
+    {
+        os << "  Disabled by budget:";
+        for (const auto& field : disabledFields)
+        {
+            os << " " << field;
+        }
+        os << std::endl;
+    }
+}
+
 void
 NrOutputManager::PrintTelemetryStats() const
 {
@@ -1773,7 +2272,9 @@ NrOutputManager::PrintTelemetryStats() const
     
     std::cout << "State history: " << m_stateHistory.size() << " snapshots" << std::endl;
     std::cout << "Handover events: " << m_handoverEvents.size() << " events" << std::endl;
-    std::cout << "Event log: " << m_eventLog.size() << " events" << std::endl;
+    std::cout << "Event log: " << m_eventLog.GetSize() << " events" << std::endl;
+    
+    m_telemetryCost.Print(std::cout);
     
     std::cout << "========================================\n" << std::endl;
 }
@@ -14,6 +14,12 @@
 #include "ns3/event-id.h"
 #include "ns3/vector.h"
 #include "ns3/ipv4-address.h"
+#include "utils/nr-metrics-registry.h"
+#include "utils/nr-columnar-writer.h"
+#include "utils/nr-block-codec.h"
+#include "utils/nr-memory-profiler.h"
+#include "utils/nr-event-log.h"
+#include "utils/nr-worker-pool.h"
 
 #include <string>
 #include <vector>
@@ -29,6 +35,7 @@ namespace ns3 {
 class Node;
 class NodeContainer;
 class MobilityModel;
+class NrUePhy;
 
 // Forward declarations - Our managers
 class NrSimConfig;
@@ -120,6 +127,49 @@ public:
      */
     void WriteResultsToFile(const std::string& filepath);
 
+    // ================================================================
+    // STREAMED RESULTS (columnar, time-resolved)
+    // ================================================================
+
+    /**
+     * \brief Stream per-UE and per-cell rows every interval
+     * \param interval Sampling period in simulation seconds
+     * \param basePath Files are basePath + ".ue.nrcol" / ".cell.nrcol"
+     * \param csv Also write basePath + ".ue.csv" / ".cell.csv"
+     * \param compress Write compressed row groups (positions kept to 1 cm,
+     *        rates to 1 bit/s, SINR/RSRP to 0.001 dB)
+     * \return true if the files were created
+     *
+     * Rows go through NrColumnarWriter (see its header for the format).
+     * WriteResults() records a final sample, writes the footers and
+     * lists the files in the text summary instead of per-UE lines.
+     */
+    bool StartResultsStream(double interval,
+                            const std::string& basePath,
+                            bool csv,
+                            bool compress = false);
+
+    /**
+     * \brief Record a final sample and close the result streams
+     */
+    void StopResultsStream();
+
+    /**
+     * \brief Record every published telemetry state to a compressed file
+     * \param path Output file (NrCompressedLog, one JSON state per line)
+     * \return true if the file was created
+     *
+     * Works with any publish method, including PUBLISH_DISABLED.
+     * Compression and writing run on a background thread; WriteResults()
+     * closes the file and lists it in the text summary.
+     */
+    bool StartRecording(const std::string& path);
+
+    /**
+     * \brief Close the telemetry recording
+     */
+    void StopRecording();
+
     // ================================================================
     // REAL-TIME TELEMETRY (PHASE 2 - NEW)
     // ================================================================
@@ -320,15 +370,8 @@ public:
         BwpConfiguration bwpConfiguration;
         BwpStats bwpStats;
         
-        // Event log (circular buffer)
-        struct SimulationEvent
-        {
-            double timestamp;
-            std::string type;       // "attachment", "handover", "traffic_alert", etc.
-            std::string description;
-            std::map<std::string, std::string> details;
-        };
-        std::deque<SimulationEvent> recentEvents;
+        // Event log, oldest first (descriptions are formatted on publish)
+        std::vector<NrEventRecord> recentEvents;
     };
 
 
@@ -434,6 +477,11 @@ public:
         
         bool eventTriggeredUpdates; ///< Publish on events (in addition to periodic)
         
+        double tickBudgetMs;        ///< Per-tick budget for collect+encode+send (0 = unlimited)
+        uint32_t budgetGraceTicks;  ///< Consecutive over-budget ticks before degrading
+        
+        uint32_t collectionThreads; ///< Threads for per-UE collection (0 = hardware, 1 = serial)
+        
         TelemetryConfig()
             : includePositions(true),
               includeVelocities(true),
@@ -447,10 +495,65 @@ public:
               maxHistorySize(100),
               maxHandoverHistory(50),
               maxEventHistory(100),
-              eventTriggeredUpdates(true)
+              eventTriggeredUpdates(true),
+              tickBudgetMs(0.0),
+              budgetGraceTicks(3),
+              collectionThreads(0)
         {}
     };
 
+    /**
+     * \brief Per-stage cost of telemetry publication
+     *
+     * Each publication is split into collection (CollectCurrentState),
+     * encoding (StateToJson) and sending (publish method). When
+     * TelemetryConfig::tickBudgetMs is set and the sum stays above it for
+     * budgetGraceTicks consecutive ticks, the next optional field group in
+     * a fixed degradation order is switched off and recorded in
+     * disabledFields. Per-group cost is not measured; the order puts the
+     * groups expected to be costly and least essential first:
+     *
+     *   radio metrics, state history, buffer metrics, scheduler metrics,
+     *   event log, velocities, handovers, traffic stats
+     *
+     * Positions and attachments are never disabled.
+     */
+    struct TelemetryCost
+    {
+        uint64_t ticks;             ///< Publications measured
+        double lastCollectMs;       ///< Last state collection time
+        double lastEncodeMs;        ///< Last JSON encoding time
+        double lastSendMs;          ///< Last publish (send) time
+        double totalCollectMs;      ///< Sum of collection times
+        double totalEncodeMs;       ///< Sum of encoding times
+        double totalSendMs;         ///< Sum of send times
+        uint64_t overBudgetTicks;   ///< Ticks that exceeded tickBudgetMs
+        std::vector<std::string> disabledFields;  ///< Field groups disabled by the budget
+
+        TelemetryCost()
+            : ticks(0),
+              lastCollectMs(0.0),
+              lastEncodeMs(0.0),
+              lastSendMs(0.0),
+              totalCollectMs(0.0),
+              totalEncodeMs(0.0),
+              totalSendMs(0.0),
+              overBudgetTicks(0)
+        {}
+
+        /**
+         * \brief Average collect+encode+send time per tick
+         * \return Milliseconds per tick
+         */
+        double GetAvgTickMs() const;
+
+        /**
+         * \brief Print cost breakdown
+         * \param os Output stream
+         */
+        void Print(std::ostream& os) const;
+    };
+
     /**
      * \brief Set telemetry configuration
      * \param config Telemetry configuration
@@ -491,6 +594,18 @@ public:
      */
     uint64_t GetAvgJsonSizeBytes() const;
 
+    /**
+     * \brief Get per-stage telemetry cost and budget actions
+     * \return Telemetry cost breakdown
+     */
+    TelemetryCost GetTelemetryCost() const;
+
+    /**
+     * \brief Estimate the memory held by telemetry history and output buffers
+     * \return Per-container bytes (see NrMemoryProfiler)
+     */
+    std::vector<NrMemoryItem> GetMemoryUsage() const;
+
     /**
      * \brief Print telemetry statistics
      */
@@ -505,14 +620,42 @@ private:
     // ================================================================
 
     /**
-     * \brief Collect UE position and mobility state
+     * \brief Resolve the per-UE objects read during collection
+     * \param ueNodes UE nodes
+     *
+     * Done on the simulator thread when the UE count changes, so the
+     * collection workers never copy Ptrs or call GetObject().
+     */
+    void ResolveUeSlots(const NodeContainer& ueNodes);
+
+    /**
+     * \brief Collect UE position and velocity (simulator thread)
+     * \param ueId UE index
+     * \param ueState Slot to fill
+     *
+     * Kept off the workers: a waypoint model's lazy update may fire
+     * CourseChange traces.
+     */
+    void CollectUeMobility(uint32_t ueId, SimulationState::UeState& ueState);
+
+    /**
+     * \brief Collect the rest of a UE's state (collection worker)
+     * \param ueId UE index
+     * \param ueState Slot with position already filled
+     *
+     * Reads only this UE's objects, m_ueSlots and m_gnbPositions, and
+     * writes only ueState and m_servingCells[ueId].
      */
-    SimulationState::UeState CollectUeState(uint32_t ueId);
+    void CollectUeState(uint32_t ueId, SimulationState::UeState& ueState);
 
     /**
      * \brief Collect gNB state
+     * \param gnbId gNB index
+     * \param gnbNodes gNB nodes (fetched once per tick by the caller)
+     *
+     * Attached UEs come from m_servingCells of the same tick.
      */
-    SimulationState::GnbState CollectGnbState(uint32_t gnbId);
+    SimulationState::GnbState CollectGnbState(uint32_t gnbId, const NodeContainer& gnbNodes);
 
     /**
      * \brief Collect traffic statistics for a UE
@@ -548,6 +691,11 @@ private:
      */
     void PeriodicPublish();
 
+    /**
+     * \brief Append one per-UE and per-cell sample to the result streams
+     */
+    void RecordResultsSample();
+
     /**
      * \brief Publish state via configured method
      */
@@ -588,15 +736,28 @@ private:
     std::string GetCurrentTimeIso8601();
 
     /**
-     * \brief Add event to event log
+     * \brief Add event to event log (stamped with the current time)
+     * \param event Typed event
      */
-    void LogEvent(const std::string& type, const std::string& description);
+    void LogEvent(NrEventRecord event);
 
     /**
      * \brief Schedule next periodic update
      */
     void ScheduleNextUpdate();
 
+    /**
+     * \brief Account one tick against TelemetryConfig::tickBudgetMs
+     * \param tickMs Collect + encode + send time of the tick
+     */
+    void EnforceTelemetryBudget(double tickMs);
+
+    /**
+     * \brief Disable the next optional field group in degradation order
+     * \return Name of the disabled group, empty if nothing is left to disable
+     */
+    std::string DegradeTelemetry();
+
     // ================================================================
     // MEMBER VARIABLES
     // ================================================================
@@ -618,6 +779,13 @@ private:
     bool m_telemetryEnabled;                ///< Is telemetry active
     bool m_telemetryInitialized;            ///< Has telemetry been initialized
     EventId m_publishEvent;                 ///< Scheduled publish event
+    EventId m_resultsEvent;                 ///< Scheduled results sample
+    Time m_resultsInterval;                 ///< Time between results samples
+    NrColumnarWriter m_ueResults;           ///< Per-UE results stream
+    NrColumnarWriter m_cellResults;         ///< Per-cell results stream
+    std::vector<std::string> m_resultsFiles; ///< Closed stream files (for the summary)
+    NrCompressedLog m_recording;            ///< Telemetry recording
+    std::string m_recordingSummary;         ///< Closed recording (for the summary)
     Time m_publishInterval;                 ///< Time between publishes
     Time m_lastPublishTime;                 ///< Last publish timestamp
 
@@ -637,13 +805,31 @@ private:
 
     // Event tracking
     std::deque<SimulationState::HandoverEvent> m_handoverEvents;
-    std::deque<SimulationState::SimulationEvent> m_eventLog;
+    NrEventLog m_eventLog;                  ///< Ring of maxEventHistory events
+
+    // Parallel state collection
+    struct UeSlot
+    {
+        Ptr<MobilityModel> mobility;        ///< Null if the UE has none
+        const char* mobilityModel;          ///< "waypoint", "random_walk", "static", "none"
+        Ptr<NrUePhy> phy;                   ///< PHY of BWP 0 (null if unavailable)
+    };
+    std::vector<UeSlot> m_ueSlots;          ///< Resolved per-UE objects
+    std::vector<std::pair<uint32_t, Vector>> m_gnbPositions; ///< (gNB, position), current tick
+    std::vector<uint16_t> m_servingCells;   ///< Serving cell per UE, current tick
+    std::unique_ptr<NrWorkerPool> m_collectPool; ///< Created on the first large tick
 
     // Statistics
     uint64_t m_publishedStateCount;         ///< Count of published states
     uint64_t m_failedPublishCount;          ///< Count of failed publishes
     std::vector<double> m_stateGenTimes;    ///< State generation times
     std::vector<uint64_t> m_jsonSizes;      ///< JSON sizes
+    TelemetryCost m_telemetryCost;          ///< Per-stage cost and budget actions
+    uint32_t m_consecutiveOverBudget;       ///< Over-budget ticks in a row
+    NrMetricCounter* m_publishOkMetric;     ///< Registry: successful publishes
+    NrMetricCounter* m_publishFailMetric;   ///< Registry: failed publishes
+    NrMetricCounter* m_publishBytesMetric;  ///< Registry: published JSON bytes
+    NrMetricHistogram* m_tickMsMetric;      ///< Registry: collect+encode+send per tick
 
     // BWP tracking
     bool m_bwpConfigurationSent;  ///< True if static BWP config already sent
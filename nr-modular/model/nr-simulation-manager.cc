@@ -8,6 +8,9 @@
 
 // ns-3 includes
 #include "nr-simulation-manager.h"
+#include "utils/nr-results-store.h"
+#include "utils/nr-memory-profiler.h"
+#include "nr-beam-cache.h"
 
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-static-routing-helper.h"
@@ -18,11 +21,125 @@
 #include "ns3/abort.h"
 #include "ns3/simulator.h"
 #include "ns3/config.h"
+#include "ns3/rng-seed-manager.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("NrSimulationManager");
 NS_OBJECT_ENSURE_REGISTERED (NrSimulationManager);  
 
+namespace
+{
+
+/// Interval between polls of the running sweep workers (us)
+constexpr useconds_t SWEEP_POLL_US = 10000;
+
+/// A contiguous PRB range [start, start + len)
+struct PrbRange
+{
+    uint32_t start;
+    uint32_t len;
+};
+
+/**
+ * Split a PRB range into contiguous shares for one slot. With more UEs
+ * than PRBs the slot index rotates which UEs get a PRB. Shares are equal,
+ * or proportional to weights[ueId] (at least one PRB each) when weights
+ * is not empty.
+ */
+void
+SplitPrbRange(const PrbRange& range,
+              const std::vector<uint32_t>& ues,
+              uint32_t slot,
+              std::vector<PrbAllocation>& out,
+              const std::vector<uint32_t>& weights = {})
+{
+    if (ues.empty() || range.len == 0)
+    {
+        return;
+    }
+    uint32_t n = std::min<uint32_t>(ues.size(), range.len);
+    bool weighted = !weights.empty() && n == ues.size();
+    uint64_t weightSum = 0;
+    for (uint32_t ueId : ues)
+    {
+        weightSum += weighted ? weights[ueId] : 1;
+    }
+    uint32_t share = range.len / n;
+    uint32_t next = range.start;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        uint32_t ueId = ues[(slot + i) % ues.size()];
+        if (weighted)
+        {
+            share = 1 + static_cast<uint32_t>(static_cast<uint64_t>(range.len - n) *
+                                              weights[ueId] / weightSum);
+        }
+        uint32_t num = (i == n - 1) ? (range.start + range.len - next) : share;
+        out.emplace_back(ueId, slot, next, num);
+        next += num;
+    }
+}
+
+/**
+ * Hand UEs to ranges so that PRBs per UE stay as even as possible.
+ * Returns one UE list per range. Ranges left empty are lent to UEs that
+ * already have one, so no usable PRB stays idle.
+ */
+std::vector<std::vector<uint32_t>>
+DistributeUes(const std::vector<PrbRange>& ranges, const std::vector<uint32_t>& ues)
+{
+    std::vector<std::vector<uint32_t>> members(ranges.size());
+    if (ranges.empty())
+    {
+        return members;
+    }
+    for (uint32_t ueId : ues)
+    {
+        size_t best = 0;
+        double bestShare = -1.0;
+        for (size_t r = 0; r < ranges.size(); ++r)
+        {
+            double share = static_cast<double>(ranges[r].len) / (members[r].size() + 1);
+            if (share > bestShare)
+            {
+                bestShare = share;
+                best = r;
+            }
+        }
+        members[best].push_back(ueId);
+    }
+    size_t lend = 0;
+    for (auto& m : members)
+    {
+        if (m.empty() && !ues.empty())
+        {
+            m.push_back(ues[lend++ % ues.size()]);
+        }
+    }
+    return members;
+}
+
+} // namespace
+
 TypeId
 NrSimulationManager::GetTypeId (void)
 {
@@ -45,8 +162,12 @@ NrSimulationManager::NrSimulationManager()
       m_trafficManager(nullptr),
       m_metricsManager(nullptr),
       m_configManager(nullptr),
-      m_outputManager(nullptr)
+      m_outputManager(nullptr),
     //   m_bwpManager(nullptr)
+      m_partitionId(0),
+      m_numPartitions(1),
+      m_initSeconds(0.0),
+      m_runSeconds(0.0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -71,8 +192,12 @@ NrSimulationManager::DoDispose()
     
     // Cleanup MILP components
     m_bwpManager = nullptr;
+    m_bwpManagers.clear();
     m_milpInterface = nullptr;
     m_milpScheduler = nullptr;
+    m_milpSchedulers.clear();
+    m_sliceManager = nullptr;
+    m_dormancyManager = nullptr;
     
     m_config = nullptr;
     Object::DoDispose();
@@ -202,6 +327,15 @@ NrSimulationManager::Initialize()
     NS_LOG_INFO("Step 3/10: Validating configuration...");
     std::cout << "m_config->topology.useFilePositions = " << (m_config->topology.useFilePositions ? "true" : "false") << std::endl;
     m_configManager->ValidateOrAbort(m_config);
+
+    // Identifies runs of the same base configuration in the results
+    // store; taken before partitioning and sweep points modify m_config
+    std::ostringstream configText;
+    m_config->Print(configText);
+    m_configHash = NrResultsStore::HashConfig(configText.str());
+
+    // Heap growth from here on is attributed to the scopes below
+    NrMemoryProfiler::Get().Enable(m_config->memoryProfile);
     
     // =================================================================
     // STEP 4: Set config on all managers
@@ -223,7 +357,24 @@ NrSimulationManager::Initialize()
     
     // STEP 5: Deploy Topology
     std::cout << "Step 5/10: Deploying topology..." << std::endl;
-    m_topologyManager->DeployTopology();
+    {
+        NrMemoryProfiler::Scope memoryScope("topology");
+
+        // Sharded runs create only this rank's sites and UEs
+        if (m_config->partition.enabled)
+        {
+            std::cout << "Step 5a/10: Selecting this rank's shard..." << std::endl;
+            SelectPartition();
+        }
+        m_topologyManager->DeployTopology();
+
+        // STEP 5b: Downstream managers see the shard as the whole scenario
+        if (m_numPartitions > 1)
+        {
+            std::cout << "Step 5b/10: Localizing shard ids..." << std::endl;
+            ApplyPartition();
+        }
+    }
     
     NodeContainer gnbNodes = m_topologyManager->GetGnbNodes();
     NodeContainer ueNodes = m_topologyManager->GetUeNodes();
@@ -232,65 +383,118 @@ NrSimulationManager::Initialize()
     // std::cout << "Step 6/10: Installing gNB mobility..." << std::endl;
     // m_mobilityManager->InstallGnbMobility(gnbNodes);
     std::cout << "Step 6/10: Installing UE mobility..." << std::endl;
-    m_mobilityManager->InstallUeMobility(ueNodes);
+    {
+        NrMemoryProfiler::Scope memoryScope("mobility");
+        m_mobilityManager->InstallUeMobility(ueNodes);
+    }
 
     
     // STEP 7: Setup NR Infrastructure, install devices, attach UEs, assign IPs
     std::cout << "Step 7/10: Setting up NR infrastructure..." << std::endl;
     m_networkManager->SetConfig(m_config);
-    m_networkManager->SetupNrInfrastructure(gnbNodes, ueNodes);
+    {
+        NrMemoryProfiler::Scope memoryScope("nr_devices");
+        m_networkManager->SetupNrInfrastructure(gnbNodes, ueNodes);
+    }
 
     // =================================================================
     // STEP 8c: Setup MILP Scheduler (if enabled)
     // =================================================================
     std::cout << "Step 8c/10: Setting up MILP scheduler (if enabled)..." << std::endl;
-    SetupMilpScheduler();
+    {
+        NrMemoryProfiler::Scope memoryScope("milp_plans");
+        SetupMilpScheduler();
+    }
 
     
 
     
     // STEP 8: Assign IP Addresses
     std::cout << "Step 8/10: Assigning IP addresses and attaching UEs..." << std::endl;
-    m_networkManager->AssignIpAddresses(ueNodes);
+    {
+        NrMemoryProfiler::Scope memoryScope("ip_attach");
+        m_networkManager->AssignIpAddresses(ueNodes);
 
-    std::cout << "\nEnabling handover tracking..." << std::endl;
-    m_networkManager->EnableHandoverTracing(true);
-    // ⭐ NEW: Enable handover tracking (if you have multiple gNBs)
-    // if (m_config->topology.gnbCount > 1)
-    // {
-    //     std::cout << "\nEnabling handover tracking..." << std::endl;
-    //     m_networkManager->EnableHandoverTracing(true);
-    // }
-    
-    // NEW STEP: Now attach after positions are set
-    std::cout << "Step 8b/10: Attaching UEs to closest gNBs..." << std::endl;
-    m_networkManager->AttachUes(
-        m_networkManager->GetNrHelper(),
-        m_networkManager->GetUeDevices(),
-        m_networkManager->GetGnbDevices()
-    );
+        std::cout << "\nEnabling handover tracking..." << std::endl;
+        m_networkManager->EnableHandoverTracing(true);
+        // ⭐ NEW: Enable handover tracking (if you have multiple gNBs)
+        // if (m_config->topology.gnbCount > 1)
+        // {
+        //     std::cout << "\nEnabling handover tracking..." << std::endl;
+        //     m_networkManager->EnableHandoverTracing(true);
+        // }
+    
+        // NEW STEP: Now attach after positions are set
+        std::cout << "Step 8b/10: Attaching UEs to closest gNBs..." << std::endl;
+        m_networkManager->AttachUes(
+            m_networkManager->GetNrHelper(),
+            m_networkManager->GetUeDevices(),
+            m_networkManager->GetGnbDevices()
+        );
+
+        // Secondary carriers: dedicated bearers steer UEs onto their BWP
+        m_networkManager->ActivateCarrierBearers();
+    }
 
     
     // STEP 8d: Link MILP data to the LIVE gNB Schedulers
     std::cout << "Linking MILP data to gNB schedulers..." << std::endl;
+    const auto& preemption = m_config->scheduling.preemption;
+    NrMilpExecutorScheduler::PreemptionParams preemptionParams;
+    preemptionParams.miniSlotSymbols = preemption.miniSlotSymbols;
+    preemptionParams.maxPreemptedFraction = preemption.maxPreemptedFraction;
+    NS_ABORT_MSG_IF(preemption.enabled && !m_sliceManager,
+                    "URLLC preemption requires scheduling.slicing");
+    m_milpSchedulers.clear();
     for (uint32_t i = 0; i < m_networkManager->GetGnbDevices().GetN(); ++i) {
         Ptr<NrGnbNetDevice> gnbDev = DynamicCast<NrGnbNetDevice>(m_networkManager->GetGnbDevices().Get(i));
         
         // Correct way to get the scheduler: 
         // NrGnbNetDevice -> GetMac(bwpId) -> GetScheduler()
-        Ptr<NrMacScheduler> baseSched = gnbDev->GetScheduler(0);
-        Ptr<NrMilpExecutorScheduler> milpSched = DynamicCast<NrMilpExecutorScheduler>(baseSched);
-        
-        if (milpSched) {
-            milpSched->SetBwpManager(m_bwpManager);
-            milpSched->Initialize(m_networkManager);
-            m_milpScheduler = milpSched; 
-            std::cout << "  ✓ Linked MILP data to gNB " << i << std::endl;
-        } else {
-            std::cout << "  ⚠ WARNING: gNB " << i << " is not using NrMilpExecutorScheduler!" << std::endl;
+        // Every BWP has its own scheduler instance and its own plan.
+        for (uint16_t bwp = 0; bwp < m_bwpManagers.size(); ++bwp) {
+            Ptr<NrMacScheduler> baseSched = gnbDev->GetScheduler(bwp);
+            Ptr<NrMilpExecutorScheduler> milpSched = DynamicCast<NrMilpExecutorScheduler>(baseSched);
+
+            if (milpSched) {
+                milpSched->SetBwpManager(m_bwpManagers[bwp]);
+                milpSched->SetCellId(i);  // gNB index = MilpCell::cellId
+                if (m_sliceManager) {
+                    milpSched->SetSliceManager(m_sliceManager);
+                }
+                if (m_config->scheduling.harq.enabled) {
+                    milpSched->EnableHarqAwareExecution(GetPlannedPrbs(bwp));
+                }
+                if (preemption.enabled) {
+                    milpSched->EnableUrllcPreemption(preemptionParams);
+                    for (uint32_t ueId = 0; ueId < m_config->topology.ueCount; ++ueId) {
+                        if (m_sliceManager->GetUeSlice(ueId) == SliceType::uRLLC) {
+                            milpSched->SetUeLatencyBudget(ueId, preemption.urllcLatencyMs);
+                        }
+                    }
+                }
+                m_milpSchedulers.push_back(milpSched);
+                milpSched->Initialize(m_networkManager);
+                if (bwp == 0) {
+                    m_milpScheduler = milpSched;
+                }
+                std::cout << "  ✓ Linked MILP data to gNB " << i << " BWP " << bwp << std::endl;
+            } else {
+                std::cout << "  ⚠ WARNING: gNB " << i << " BWP " << bwp
+                          << " is not using NrMilpExecutorScheduler!" << std::endl;
+            }
         }
     }
 
+    // Coordinated plans group UEs by their t=0 serving cell: follow them
+    // across attachments and handovers
+    if (!m_milpSchedulers.empty() && m_bwpManager && m_bwpManager->IsCoordinated())
+    {
+        m_networkManager->TraceConnectWithoutContext(
+            "ServingCellChanged",
+            MakeCallback(&NrSimulationManager::NotifyServingCellChanged, this));
+    }
+
     // =================================================================
     // DONE
     // =================================================================
@@ -302,8 +506,14 @@ NrSimulationManager::Initialize()
     NS_LOG_INFO("========================================");
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::seconds>(end - start).count();
+    m_initSeconds = std::chrono::duration<double>(end - start).count();
     NS_LOG_INFO("Initialization Time: " << duration << " seconds");
     std::cout << "Initialization Time: " << duration << " seconds" << std::endl;
+
+    if (NrMemoryProfiler::Get().IsEnabled())
+    {
+        PrintMemoryFootprint();
+    }
 }
 
 void
@@ -329,11 +539,29 @@ NrSimulationManager::Run()
     // Install traffic applications
     // =================================================================
     NS_LOG_INFO("STEP 9/10: Installing traffic...");
-    m_trafficManager->InstallTraffic(gnbNodes, ueNodes);
+    {
+        NrMemoryProfiler::Scope memoryScope("traffic");
+        m_trafficManager->InstallTraffic(gnbNodes, ueNodes);
+    }
+
+    // Idle UEs leave the PHY until their next packet
+    if (m_config->traffic.dormancy.enabled)
+    {
+        m_dormancyManager = CreateObject<NrDormancyManager>();
+        m_dormancyManager->SetConfig(m_config);
+        m_dormancyManager->SetManagers(m_networkManager, m_trafficManager);
+        m_dormancyManager->Enable();
+    }
+
+    // monitorInterval <= 0 runs headless: no periodic monitoring or telemetry
+    bool periodicMonitoring = m_config->monitoring.monitorInterval > 0.0;
 
-    NS_LOG_INFO("STEP 9b/10: Enabling real-time traffic monitoring...");
-    std::cout << "Enabling real-time traffic monitoring..." << std::endl;
-    m_trafficManager->EnableRealTimeMonitoring(m_config->monitoring.monitorInterval);
+    if (periodicMonitoring)
+    {
+        NS_LOG_INFO("STEP 9b/10: Enabling real-time traffic monitoring...");
+        std::cout << "Enabling real-time traffic monitoring..." << std::endl;
+        m_trafficManager->EnableRealTimeMonitoring(m_config->monitoring.monitorInterval);
+    }
     
     // =================================================================
     // Setup Output Manager
@@ -341,27 +569,58 @@ NrSimulationManager::Run()
     NS_LOG_INFO("Step 10/10: Setting up Output Manager...");
     std::cout << "Step 10/10: Setting up Output Manager..." << std::endl;
 
-    m_outputManager->SetManagers(
-        m_topologyManager,
-        m_networkManager,
-        m_trafficManager,
-        m_metricsManager,
-        m_channelManager,
-        m_mobilityManager
-        // m_bwpManager
-    );
+    {
+        NrMemoryProfiler::Scope memoryScope("telemetry");
 
-    m_outputManager->InitializeTelemetry();
+        m_outputManager->SetManagers(
+            m_topologyManager,
+            m_networkManager,
+            m_trafficManager,
+            m_metricsManager,
+            m_channelManager,
+            m_mobilityManager
+            // m_bwpManager
+        );
 
-    // Configure for UDP publishing
-    m_outputManager->ConfigurePublishing(
-        NrOutputManager::PUBLISH_UDP,
-        "127.0.0.1",
-        5555
-    );
+        m_outputManager->InitializeTelemetry();
+
+        // Configure for UDP publishing
+        // One telemetry port per partition so ranks do not interleave
+        m_outputManager->ConfigurePublishing(
+            NrOutputManager::PUBLISH_UDP,
+            "127.0.0.1",
+            static_cast<uint16_t>(5555 + m_partitionId)
+        );
 
-    // Start with 100ms updates
-    m_outputManager->StartTelemetry(m_config->monitoring.monitorInterval);
+        // Opened before the first publish so the initial state is recorded
+        // (follows the per-rank / per-sweep-point outputFilePath)
+        if (m_config->recordTelemetry)
+        {
+            m_outputManager->StartRecording(m_config->outputFilePath + ".telemetry.nrz");
+        }
+
+        // Start with 100ms updates
+        if (periodicMonitoring)
+        {
+            m_outputManager->StartTelemetry(m_config->monitoring.monitorInterval);
+        }
+
+        // Time-resolved results next to the final summary (follows the
+        // per-rank / per-sweep-point outputFilePath)
+        if (m_config->resultsInterval > 0)
+        {
+            m_outputManager->StartResultsStream(m_config->resultsInterval,
+                                                m_config->outputFilePath,
+                                                m_config->resultsCsv,
+                                                m_config->resultsCompress);
+        }
+    }
+
+    // PHY/MAC/RLC traces as binary records (per-rank / per-sweep-point path)
+    if (m_config->binaryTraces)
+    {
+        m_networkManager->EnableBinaryTraces(m_config->outputFilePath);
+    }
 
     // =================================================================
     // // NEW: ENABLE BWP EXTERNAL CONTROL
@@ -374,6 +633,42 @@ NrSimulationManager::Run()
     //     m_bwpManager->EnableExternalControl(5556); 
     // }
     
+    // =================================================================
+    // Prometheus metrics export (background threads)
+    // =================================================================
+    // One port / file per partition so ranks do not collide
+    NrMetricsRegistry& metrics = NrMetricsRegistry::Get();
+    if (m_config->monitoring.metricsPort != 0)
+    {
+        uint16_t port = static_cast<uint16_t>(m_config->monitoring.metricsPort + m_partitionId);
+        if (metrics.StartHttpServer(port))
+        {
+            std::cout << "  ✓ Metrics served on http://127.0.0.1:" << port << "/metrics"
+                      << std::endl;
+        }
+        else
+        {
+            std::cout << "  ⚠ Metrics server could not listen on port " << port << std::endl;
+        }
+    }
+    if (!m_config->monitoring.metricsFile.empty())
+    {
+        std::string path = m_config->monitoring.metricsFile;
+        if (m_partitionId != 0)
+        {
+            path += ".rank" + std::to_string(m_partitionId);
+        }
+        if (metrics.StartFileWriter(path, m_config->monitoring.metricsInterval))
+        {
+            std::cout << "  ✓ Metrics written to " << path << " every "
+                      << m_config->monitoring.metricsInterval << " s" << std::endl;
+        }
+        else
+        {
+            std::cout << "  ⚠ Metrics file " << path << " not writable" << std::endl;
+        }
+    }
+
     // =================================================================
     // Run the simulation
     // =================================================================
@@ -382,7 +677,10 @@ NrSimulationManager::Run()
     NS_LOG_INFO("Starting simulation for " << simDuration << " seconds...");
     std::cout << "Starting simulation for " << simDuration << " seconds..." << std::endl;
     Simulator::Stop(Seconds(simDuration));
-    Simulator::Run();
+    {
+        NrMemoryProfiler::Scope memoryScope("simulation_run");
+        Simulator::Run();
+    }
     
     NS_LOG_INFO("Simulation complete!");
     std::cout << "Simulation complete!" << std::endl;
@@ -391,6 +689,7 @@ NrSimulationManager::Run()
     NS_LOG_INFO("========================================");
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::seconds>(end - start).count();
+    m_runSeconds = std::chrono::duration<double>(end - start).count();
     NS_LOG_INFO("Simulation Run Time: " << duration << " seconds");
     std::cout << "Simulation Run Time: " << duration << " seconds" << std::endl;
 }
@@ -441,8 +740,71 @@ NrSimulationManager::Finalize()
     m_trafficManager->CollectMetrics();
     m_trafficManager->PrintMetricsSummary();  // ← ADD THIS!
 
+    if (m_sliceManager)
+    {
+        m_sliceManager->PrintSummary(std::cout);
+    }
+    if (m_dormancyManager)
+    {
+        m_dormancyManager->PrintSummary(std::cout);
+    }
+    if (Ptr<NrBeamCache> beamCache = m_networkManager->GetBeamCache())
+    {
+        beamCache->PrintSummary(std::cout);
+    }
+    if (m_config->scheduling.preemption.enabled)
+    {
+        NrMilpExecutorScheduler::PreemptionStats preemptionStats;
+        for (const auto& sched : m_milpSchedulers)
+        {
+            preemptionStats += sched->GetPreemptionStats();
+        }
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "URLLC MINI-SLOT PREEMPTION (DL)" << std::endl;
+        std::cout << "========================================" << std::endl;
+        preemptionStats.Print(std::cout);
+        std::cout << "========================================\n" << std::endl;
+    }
+    if (m_config->scheduling.harq.enabled)
+    {
+        std::map<uint32_t, NrMilpExecutorScheduler::HarqUeStats> harqStats;
+        for (const auto& sched : m_milpSchedulers)
+        {
+            for (const auto& [ueId, stats] : sched->GetHarqStats())
+            {
+                harqStats[ueId] += stats;
+            }
+        }
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "HARQ RETRANSMISSIONS (per UE)" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "  UE   DL retx  PRBs    pool  own  other  time   displaced  UL retx  PRBs"
+                  << std::endl;
+        for (const auto& [ueId, s] : harqStats)
+        {
+            std::cout << "  " << std::left << std::setw(5) << ueId << std::right << std::setw(7)
+                      << s.dlRetx << std::setw(6) << s.dlRetxPrbs << std::setw(8) << s.dlFromPool
+                      << std::setw(5) << s.dlFromOwnPlan << std::setw(7) << s.dlFromOthers
+                      << std::setw(6) << s.dlTimeDomain << std::setw(12) << s.displacedPrbs
+                      << std::setw(9) << s.ulRetx << std::setw(6) << s.ulRetxPrbs << std::endl;
+        }
+        std::cout << "========================================\n" << std::endl;
+    }
+
     
 
+    // End-of-run footprint, before the output buffers are flushed
+    if (NrMemoryProfiler::Get().IsEnabled())
+    {
+        PrintMemoryFootprint();
+    }
+
+    // Final metrics snapshot, then stop the exporter threads
+    NrMetricsRegistry::Get().StopExporters();
+
+    // Flush the binary trace writers
+    m_networkManager->StopBinaryTraces();
+
     // =================================================================
     // Write results to file
     // =================================================================
@@ -471,6 +833,415 @@ NrSimulationManager::Finalize()
     auto totalDuration = std::chrono::duration_cast<std::chrono::seconds>(end - m_wallClockStart).count();
     NS_LOG_INFO("Total Simulation Time (including finalization): " << totalDuration << " seconds");
     std::cout << "Total Simulation Time (including finalization): " << totalDuration << " seconds" << std::endl;
+
+    if (!m_config->resultsStore.empty())
+    {
+        RecordRunInStore(std::chrono::duration<double>(end - start).count());
+    }
+}
+
+void
+NrSimulationManager::RecordRunInStore(double finalizeSeconds)
+{
+    NS_LOG_FUNCTION(this << m_config->resultsStore);
+
+    auto text = [](auto value) {
+        std::ostringstream os;
+        os << value;
+        return os.str();
+    };
+
+    NrResultsStore::RunRecord record;
+    record.configHash = m_configHash;
+    record.seed = RngSeedManager::GetSeed();
+    record.run = RngSeedManager::GetRun();
+
+    // ----- Parameters a sweep varies on top of the base config -----
+    if (!m_sweepPointName.empty())
+    {
+        record.params["point"] = m_sweepPointName;
+    }
+    if (m_numPartitions > 1)
+    {
+        record.params["rank"] = text(m_partitionId);
+        record.params["ranks"] = text(m_numPartitions);
+    }
+    const NrSimConfig::TrafficParams& traffic = m_config->traffic;
+    record.params["traffic.udpRateDl"] = text(traffic.udpRateDl);
+    record.params["traffic.packetSizeDl"] = text(traffic.packetSizeDl);
+    record.params["traffic.udpRateUl"] = text(traffic.udpRateUl);
+    record.params["traffic.packetSizeUl"] = text(traffic.packetSizeUl);
+    record.params["traffic.enableDownlink"] = traffic.enableDownlink ? "true" : "false";
+    record.params["traffic.enableUplink"] = traffic.enableUplink ? "true" : "false";
+    record.params["traffic.burstInterval"] = text(traffic.burstInterval);
+    record.params["traffic.dormancy"] = traffic.dormancy.enabled ? "true" : "false";
+    const auto& beamforming = m_config->channel.beamforming;
+    record.params["beamforming.gnbArray"] =
+        text(beamforming.gnbRows) + "x" + text(beamforming.gnbColumns);
+    record.params["beamforming.ueArray"] =
+        text(beamforming.ueRows) + "x" + text(beamforming.ueColumns);
+    record.params["beamforming.cache"] = beamforming.cache ? "true" : "false";
+
+    // ----- KPIs -----
+    std::map<std::string, double>& m = record.metrics;
+    AggregateMetrics agg = m_trafficManager->GetAggregateMetrics();
+    m["dl_throughput_mbps"] = agg.totalDlThroughputMbps;
+    m["ul_throughput_mbps"] = agg.totalUlThroughputMbps;
+    m["avg_dl_throughput_mbps"] = agg.avgDlThroughputMbps;
+    m["avg_ul_throughput_mbps"] = agg.avgUlThroughputMbps;
+    m["avg_delay_ms"] = agg.avgSystemDelayMs;
+    m["packets_sent"] = agg.totalPacketsSent;
+    m["packets_received"] = agg.totalPacketsReceived;
+    m["packets_lost"] = agg.totalPacketsLost;
+    m["packet_loss_rate"] = agg.overallPacketLossRate;
+    m["num_ues"] = agg.numUes;
+    m["handovers"] = m_networkManager->GetTotalHandovers();
+
+    // ----- Profiling -----
+    m["sim_duration_s"] = m_config->simDuration;
+    m["wall_init_s"] = m_initSeconds;
+    m["wall_run_s"] = m_runSeconds;
+    m["wall_finalize_s"] = finalizeSeconds;
+    m["wall_total_s"] = m_initSeconds + m_runSeconds + finalizeSeconds;
+    if (m_milpInterface)
+    {
+        NrMilpInterface::Statistics milp = m_milpInterface->GetStatistics();
+        m["milp_problems"] = milp.totalProblemsSubmitted;
+        m["milp_errors"] = milp.totalErrors;
+        m["milp_timeouts"] = milp.totalTimeouts;
+        m["milp_incumbents"] = milp.totalIncumbents;
+        m["milp_solve_avg_s"] = milp.avgSolveTime;
+        m["milp_solve_max_s"] = milp.maxSolveTime;
+    }
+    if (NrMemoryProfiler::Get().IsEnabled())
+    {
+        NrMemoryProfiler::Get().AddMetrics(m, agg.numUes);
+    }
+
+    // ----- Dormant UEs -----
+    if (m_dormancyManager)
+    {
+        NrDormancyManager::Statistics dormancy = m_dormancyManager->GetStatistics();
+        m["dormant_fraction"] = dormancy.GetDormantFraction();
+        m["dormant_peak_ues"] = dormancy.peakDormant;
+        m["ue_promotions"] = dormancy.promotions;
+        m["ue_demotions"] = dormancy.demotions;
+    }
+
+    // ----- Beam cache -----
+    if (Ptr<NrBeamCache> beamCache = m_networkManager->GetBeamCache())
+    {
+        NrBeamCache::Statistics beams = beamCache->GetStatistics();
+        m["beam_requests"] = beams.lookups;
+        m["beam_computations"] = beams.recomputes;
+        m["beam_cache_hit_rate"] = beams.GetHitRate();
+    }
+
+    // ----- SLA compliance (measured DL service against the planned SLA) -----
+    if (!m_ueSlas.empty())
+    {
+        std::map<uint32_t, PerUeMetrics> ueMetrics = m_trafficManager->GetAllUeMetrics();
+        uint32_t throughputMet = 0;
+        uint32_t latencyMet = 0;
+        uint32_t bothMet = 0;
+        for (const auto& [ueId, sla] : m_ueSlas)
+        {
+            auto it = ueMetrics.find(ueId);
+            bool tput = it != ueMetrics.end() && it->second.dlThroughputMbps >= sla.throughputMbps;
+            bool delay = sla.latencyMs <= 0.0 ||
+                         (it != ueMetrics.end() && it->second.dlAvgDelayMs <= sla.latencyMs);
+            throughputMet += tput;
+            latencyMet += delay;
+            bothMet += tput && delay;
+        }
+        double n = m_ueSlas.size();
+        m["sla_ues"] = n;
+        m["sla_throughput_met_fraction"] = throughputMet / n;
+        m["sla_latency_met_fraction"] = latencyMet / n;
+        m["sla_met_fraction"] = bothMet / n;
+    }
+    if (m_sliceManager)
+    {
+        for (const auto& kpi : m_sliceManager->GetSliceKpis(true))
+        {
+            std::string prefix = "slice_" + SliceTypeToString(kpi.slice) + "_";
+            m[prefix + "utilization"] = kpi.utilization;
+            m[prefix + "guarantee_met"] = kpi.guaranteeMet;
+        }
+    }
+    if (m_config->scheduling.preemption.enabled)
+    {
+        NrMilpExecutorScheduler::PreemptionStats preemption;
+        for (const auto& sched : m_milpSchedulers)
+        {
+            preemption += sched->GetPreemptionStats();
+        }
+        m["urllc_served"] = preemption.served;
+        m["urllc_deadline_misses"] = preemption.deadlineMisses;
+    }
+
+    NrResultsStore store;
+    if (store.Open(m_config->resultsStore) && store.Append(record))
+    {
+        std::cout << "✓ Run " << record.runId << " stored in " << m_config->resultsStore
+                  << " (config " << record.configHash << ", seed " << record.seed << ", run "
+                  << record.run << ")" << std::endl;
+    }
+    else
+    {
+        std::cout << "⚠ Could not store run in " << m_config->resultsStore << std::endl;
+    }
+}
+
+// ============================================================================
+// MEMORY FOOTPRINT
+// ============================================================================
+
+void
+NrSimulationManager::PrintMemoryFootprint()
+{
+    NS_LOG_FUNCTION(this);
+
+    NrMemoryProfiler& profiler = NrMemoryProfiler::Get();
+    for (size_t bwp = 0; bwp < m_bwpManagers.size(); ++bwp)
+    {
+        if (m_bwpManagers[bwp])
+        {
+            profiler.SetContainers("bwp" + std::to_string(bwp),
+                                   m_bwpManagers[bwp]->GetMemoryUsage());
+        }
+    }
+    profiler.SetContainers("traffic", m_trafficManager->GetMemoryUsage());
+    if (Ptr<NrBeamCache> beamCache = m_networkManager->GetBeamCache())
+    {
+        profiler.SetContainers("beam_cache", beamCache->GetMemoryUsage());
+    }
+    profiler.SetContainers("output", m_outputManager->GetMemoryUsage());
+    profiler.Print(std::cout, m_topologyManager->GetUeNodes().GetN());
+}
+
+// ============================================================================
+// SPATIAL SHARDING
+// ============================================================================
+
+void
+NrSimulationManager::SelectPartition()
+{
+    NS_LOG_FUNCTION(this);
+
+    uint32_t rank = 0;
+    uint32_t numRanks = 1;
+#ifdef NS3_MPI
+    if (MpiInterface::IsEnabled())
+    {
+        rank = MpiInterface::GetSystemId();
+        numRanks = MpiInterface::GetSize();
+    }
+#endif
+
+    if (numRanks <= 1)
+    {
+        NS_LOG_WARN("Partitioning enabled on a single rank; simulating the whole topology");
+        std::cout << "  ⚠ Partitioning enabled without MPI ranks, running unpartitioned"
+                  << std::endl;
+    }
+
+    m_partitionId = rank;
+    m_numPartitions = numRanks;
+    m_topologyManager->SetPartition(numRanks, rank);
+}
+
+void
+NrSimulationManager::ApplyPartition()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Downstream managers index UEs locally; move waypoints to local ids
+    const std::vector<uint32_t>& globalUeIds = m_topologyManager->GetGlobalUeIds();
+    std::map<uint32_t, UeWaypointConfig> localWaypoints;
+    for (uint32_t localId = 0; localId < globalUeIds.size(); ++localId)
+    {
+        auto it = m_config->mobility.ueWaypoints.find(globalUeIds[localId]);
+        if (it != m_config->mobility.ueWaypoints.end())
+        {
+            localWaypoints[localId] = it->second;
+        }
+    }
+    m_config->mobility.ueWaypoints = localWaypoints;
+
+    m_config->topology.gnbCount = m_topologyManager->GetNumGnbs();
+    m_config->topology.ueCount = m_topologyManager->GetNumUes();
+    m_config->outputFilePath += ".rank" + std::to_string(m_partitionId);
+
+    NS_LOG_INFO("Rank " << m_partitionId << "/" << m_numPartitions << ": "
+                        << m_config->topology.gnbCount << " gNBs, " << m_config->topology.ueCount << " UEs");
+}
+
+// ============================================================================
+// FORKED SWEEPS
+// ============================================================================
+
+std::vector<NrSimulationManager::SweepResult>
+NrSimulationManager::RunForkedSweep(const std::vector<SweepPoint>& points, uint32_t maxWorkers)
+{
+    NS_LOG_FUNCTION(this << points.size() << maxWorkers);
+
+    NS_ABORT_MSG_IF(!m_isInitialized,
+                    "Must call Initialize() before RunForkedSweep()!");
+    NS_ABORT_MSG_IF(m_hasRun,
+                    "RunForkedSweep() must be called before Run()!");
+
+    if (maxWorkers == 0)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        maxWorkers = (cores > 0) ? static_cast<uint32_t>(cores) : 1;
+    }
+
+    std::cout << "Forked sweep: " << points.size() << " point(s), up to "
+              << maxWorkers << " worker(s)" << std::endl;
+
+    struct Running
+    {
+        size_t index;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    std::vector<SweepResult> results(points.size());
+    std::map<pid_t, Running> running;
+    size_t next = 0;
+
+    while (next < points.size() || !running.empty())
+    {
+        // Keep the worker pool full
+        while (next < points.size() && running.size() < maxWorkers)
+        {
+            const SweepPoint& point = points[next];
+            SweepResult& result = results[next];
+            result.name = point.name;
+            result.outputFilePath = point.outputFilePath.empty()
+                                        ? m_config->outputFilePath + "." + point.name
+                                        : point.outputFilePath;
+            result.logPath = result.outputFilePath + ".log";
+
+            // Anything still buffered would otherwise be written once per worker
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+
+            pid_t pid = fork();
+            if (pid == 0)
+            {
+                RunSweepWorker(point, result.outputFilePath, result.logPath);
+            }
+            if (pid < 0)
+            {
+                NS_LOG_ERROR("fork() failed for sweep point '" << point.name
+                             << "': " << std::strerror(errno));
+                std::cout << "  ✗ " << point.name << ": fork failed" << std::endl;
+                ++next;
+                continue;
+            }
+
+            result.pid = pid;
+            running[pid] = {next, std::chrono::steady_clock::now()};
+            ++next;
+        }
+
+        if (running.empty())
+        {
+            continue;
+        }
+
+        // Reap only our own workers: waitpid(-1) would also collect the
+        // children of a benchmark harness or the embedding program
+        int status = 0;
+        auto it = running.begin();
+        for (; it != running.end(); ++it)
+        {
+            pid_t done = waitpid(it->first, &status, WNOHANG);
+            if (done == it->first)
+            {
+                break;
+            }
+            if (done < 0 && errno != EINTR)
+            {
+                // Reaped elsewhere; the exit status is lost
+                NS_LOG_ERROR("waitpid(" << it->first << ") failed: " << std::strerror(errno));
+                status = -1;
+                break;
+            }
+        }
+        if (it == running.end())
+        {
+            usleep(SWEEP_POLL_US);
+            continue;
+        }
+
+        SweepResult& result = results[it->second.index];
+        result.wallSeconds = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - it->second.start)
+                                 .count();
+        if (status == -1)
+        {
+            result.exitCode = -1;
+        }
+        else if (WIFEXITED(status))
+        {
+            result.exitCode = WEXITSTATUS(status);
+        }
+        else if (WIFSIGNALED(status))
+        {
+            result.exitCode = 128 + WTERMSIG(status);
+        }
+        running.erase(it);
+
+        std::cout << "  " << (result.exitCode == 0 ? "✓ " : "✗ ") << result.name
+                  << " (" << result.wallSeconds << " s, exit " << result.exitCode
+                  << ") → " << result.outputFilePath << std::endl;
+    }
+
+    return results;
+}
+
+void
+NrSimulationManager::RunSweepWorker(const SweepPoint& point,
+                                    const std::string& outputFilePath,
+                                    const std::string& logPath)
+{
+    // Child process: anything that fails here surfaces as the exit status
+    int fd = open(logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+    {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+
+    m_config->traffic = point.traffic;
+    m_config->outputFilePath = outputFilePath;
+    if (point.headless)
+    {
+        m_config->monitoring.monitorInterval = 0.0;
+    }
+    // Workers run concurrently: no shared metrics port, one file each
+    m_config->monitoring.metricsPort = 0;
+    if (!m_config->monitoring.metricsFile.empty())
+    {
+        m_config->monitoring.metricsFile += "." + point.name;
+    }
+    RngSeedManager::SetRun(point.rngRun);
+    m_sweepPointName = point.name;
+
+    std::cout << "Sweep point '" << point.name << "' (run " << point.rngRun
+              << ", pid " << getpid() << ")" << std::endl;
+
+    Run();
+    Finalize();
+
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    _exit(0);
 }
 
 bool
@@ -548,6 +1319,24 @@ NrSimulationManager::GetBwpManager() const
     return m_bwpManager;
 }
 
+Ptr<NrBwpManager>
+NrSimulationManager::GetBwpManager(uint16_t bwpId) const
+{
+    return (bwpId < m_bwpManagers.size()) ? m_bwpManagers[bwpId] : nullptr;
+}
+
+Ptr<NrSliceManager>
+NrSimulationManager::GetSliceManager() const
+{
+    return m_sliceManager;
+}
+
+Ptr<NrDormancyManager>
+NrSimulationManager::GetDormancyManager() const
+{
+    return m_dormancyManager;
+}
+
 // ============================================================================
 // MILP SCHEDULER SETUP
 // ============================================================================
@@ -868,48 +1657,155 @@ NrSimulationManager::SetupMilpScheduler()
     
     uint32_t numUes = m_config->topology.ueCount;
     double simDuration = m_config->simDuration;
-    
-    uint32_t numSlots = static_cast<uint32_t>(simDuration * 2000) + 10;
-    uint32_t totalPrbs = 273; 
-    
-    MilpProblem problem;
-    problem.totalSlots = numSlots;
-    problem.numUEs = numUes;
-    problem.totalBandwidthPrbs = totalPrbs;
-    problem.numerology = 1;
-    
-    for (uint32_t ueId = 0; ueId < numUes; ueId++)
+
+    if (numUes == 0)
     {
-        UeSla sla;
-        sla.ueId = ueId;
-        sla.sliceType = SliceType::eMBB;
-        sla.throughputMbps = 10.0;
-        sla.mcs = 16;
-        problem.ues.push_back(sla);
+        // A partition can end up with sites but no UEs
+        std::cout << "  No UEs, skipping MILP plan" << std::endl;
+        m_bwpManagers = {m_bwpManager};
+        return;
     }
     
-    std::cout << "  Solving MILP problem (Stub)..." << std::endl;
-    MilpSolution solution;
-    solution.status = "optimal";
-    
-    uint32_t prbsPerUe = totalPrbs / numUes;
-    for (uint32_t slot = 0; slot < numSlots; slot++)
+    const auto& slicing = m_config->scheduling.slicing;
+    if (slicing.enabled)
+    {
+        // One enforcer for all cells/BWPs: quotas are shares of whichever
+        // BWP is being scheduled, counters aggregate over all of them
+        m_sliceManager = CreateObject<NrSliceManager>();
+        for (const auto& [name, quota] : slicing.quotas)
+        {
+            m_sliceManager->SetSliceQuota(StringToSliceType(name),
+                                          quota.guaranteedShare,
+                                          quota.maxShare);
+        }
+        for (const auto& [ueId, name] : slicing.ueSlices)
+        {
+            m_sliceManager->SetUeSlice(ueId, StringToSliceType(name));
+        }
+        NS_ABORT_MSG_IF(!m_sliceManager->Validate(), "Invalid slice quotas");
+        std::cout << "  ✓ Slicing enabled: " << slicing.quotas.size() << " quota(s), "
+                  << slicing.ueSlices.size() << " UE slice assignment(s)" << std::endl;
+    }
+
+    std::vector<NrSimConfig::ChannelParams::CarrierParams> carriers = m_config->GetCarriers();
+    m_bwpManagers.clear();
+
+    for (uint16_t bwp = 0; bwp < carriers.size(); ++bwp)
     {
-        uint32_t currentStartPrb = 0;
+        // Plan slots in this carrier's own numerology: 2^μ slots per ms
+        uint16_t mu = carriers[bwp].numerology;
+        uint32_t numSlots = static_cast<uint32_t>(simDuration * 1000 * (1u << mu)) + 10;
+        uint32_t totalPrbs = GetPlannedPrbs(bwp);
+        if (totalPrbs < m_networkManager->GetBwpRbNum(bwp))
+        {
+            std::cout << "  ✓ BWP " << bwp << ": PRBs " << totalPrbs << "-"
+                      << m_networkManager->GetBwpRbNum(bwp) - 1
+                      << " reserved for HARQ retransmissions" << std::endl;
+        }
+
+        std::vector<uint32_t> carrierUes;
         for (uint32_t ueId = 0; ueId < numUes; ueId++)
         {
-            PrbAllocation alloc;
-            alloc.ueId = ueId;
-            alloc.slotId = slot;
-            alloc.startPrb = currentStartPrb;
-            alloc.numPrbs = (ueId == numUes - 1) ? (totalPrbs - currentStartPrb) : prbsPerUe;
-            solution.allocations.push_back(alloc);
-            currentStartPrb += alloc.numPrbs;
+            if (m_networkManager->GetUeCarrier(ueId) == bwp)
+            {
+                carrierUes.push_back(ueId);
+            }
+        }
+
+        MilpProblem problem;
+        problem.totalSlots = numSlots;
+        problem.numUEs = carrierUes.size();
+        problem.totalBandwidthPrbs = totalPrbs;
+        problem.numerology = mu;
+        problem.slotDuration = 0.001 / (1u << mu);
+        problem.planningGranularitySlots = m_config->scheduling.planningGranularitySlots;
+
+        for (uint32_t ueId : carrierUes)
+        {
+            UeSla sla;
+            sla.ueId = ueId;
+            sla.sliceType =
+                m_sliceManager ? m_sliceManager->GetUeSlice(ueId) : SliceType::eMBB;
+            if (sla.sliceType == SliceType::uRLLC)
+            {
+                sla.latencyMs = m_config->scheduling.preemption.urllcLatencyMs;
+            }
+            sla.throughputMbps = 10.0;
+            sla.mcs = 16;
+            problem.ues.push_back(sla);
+            m_ueSlas[ueId] = sla;
         }
+
+        std::cout << "  Solving MILP problem (Stub) for BWP " << bwp << ": "
+                  << carrierUes.size() << " UEs, " << totalPrbs << " PRBs, "
+                  << numSlots << " slots (μ=" << mu << ")";
+        if (problem.planningGranularitySlots > 1)
+        {
+            std::cout << " in " << problem.GetNumBlocks() << " blocks of "
+                      << problem.planningGranularitySlots;
+        }
+        std::cout << "..." << std::endl;
+        if (m_config->scheduling.coordination.enabled && !carrierUes.empty())
+        {
+            AddCellCoordination(problem);
+        }
+
+        MilpSolution solution;
+        const auto& aggregation = m_config->scheduling.aggregation;
+        if (aggregation.enabled && !carrierUes.empty())
+        {
+            MilpProblem classProblem = AggregateSlaClasses(problem, aggregation.mcsBandWidth);
+            std::cout << "  ✓ Aggregated " << carrierUes.size() << " UEs into "
+                      << classProblem.classes.size() << " SLA class(es)" << std::endl;
+            solution = ExpandClassSolution(classProblem, BuildStubSolution(classProblem));
+        }
+        else
+        {
+            solution = BuildStubSolution(problem);
+        }
+
+        if (problem.coordinated)
+        {
+            // Planned PRBs per slot, edge vs centre UEs (first slot)
+            uint32_t edgePrbs = 0, centrePrbs = 0, edgeUes = 0;
+            for (const auto& cell : problem.cells)
+            {
+                edgeUes += cell.edgeUeIds.size();
+            }
+            for (const auto& alloc : solution.allocations)
+            {
+                if (alloc.slotId != 0)
+                {
+                    continue;
+                }
+                const MilpCell* cell = problem.FindUeCell(alloc.ueId);
+                (cell && cell->IsEdgeUe(alloc.ueId) ? edgePrbs : centrePrbs) += alloc.numPrbs;
+            }
+            for (const auto& budget : solution.budgets)
+            {
+                if (budget.blockId != 0)
+                {
+                    continue;
+                }
+                const MilpCell* cell = problem.FindUeCell(budget.ueId);
+                (cell && cell->IsEdgeUe(budget.ueId) ? edgePrbs : centrePrbs) +=
+                    budget.prbSlots / solution.granularitySlots;
+            }
+            uint32_t centreUes = carrierUes.size() - edgeUes;
+            std::cout << "  ✓ Coordinated plan: edge UEs "
+                      << (edgeUes ? static_cast<double>(edgePrbs) / edgeUes : 0.0)
+                      << " PRBs/slot, centre UEs "
+                      << (centreUes ? static_cast<double>(centrePrbs) / centreUes : 0.0)
+                      << " PRBs/slot" << std::endl;
+        }
+
+        Ptr<NrBwpManager> bwpManager = (bwp == 0) ? m_bwpManager : CreateObject<NrBwpManager>();
+        bwpManager->SetCellCoordination(problem);
+        bwpManager->SetBlockPlanning(problem);
+        bwpManager->LoadMilpSolution(solution);
+        m_bwpManagers.push_back(bwpManager);
     }
-    
-    std::cout << "  Loading solution into BWP Manager..." << std::endl;
-    m_bwpManager->LoadMilpSolution(solution);
+    std::cout << "  Loaded " << m_bwpManagers.size() << " plan(s) into BWP Managers" << std::endl;
     
     // m_milpScheduler = CreateObject<NrMilpExecutorScheduler>();
     // m_milpScheduler->SetBwpManager(m_bwpManager);
@@ -917,4 +1813,317 @@ NrSimulationManager::SetupMilpScheduler()
     std::cout << "  ✅ MILP data structures prepared!" << std::endl;
 }
 
+void
+NrSimulationManager::AddCellCoordination(MilpProblem& problem) const
+{
+    NS_LOG_FUNCTION(this);
+
+    const auto& coord = m_config->scheduling.coordination;
+    uint32_t subBand =
+        static_cast<uint32_t>(problem.totalBandwidthPrbs * coord.edgeBandFraction) / 3;
+    if (subBand == 0)
+    {
+        std::cout << "  ⚠ Edge band too narrow for 3 sub-bands, coordination disabled"
+                  << std::endl;
+        return;
+    }
+
+    // ----- Cells, edge UEs and the neighbour graph from geometry -----
+    std::vector<NrTopologyManager::UeCellGeometry> geometry =
+        m_topologyManager->ComputeCellGeometry();
+
+    std::map<uint32_t, MilpCell> cells;
+    std::map<uint32_t, std::set<uint32_t>> neighbours;
+    for (const auto& ue : problem.ues)
+    {
+        const auto& g = geometry.at(ue.ueId);
+        MilpCell& cell = cells[g.servingGnb];
+        cell.cellId = g.servingGnb;
+        cell.ueIds.push_back(ue.ueId);
+        if (g.neighbourGnb != g.servingGnb && g.distanceRatio >= coord.edgeDistanceRatio)
+        {
+            cell.edgeUeIds.push_back(ue.ueId);
+            neighbours[g.servingGnb].insert(g.neighbourGnb);
+            neighbours[g.neighbourGnb].insert(g.servingGnb);
+        }
+    }
+
+    // ----- Greedy 3-colouring, most-constrained cells first -----
+    std::vector<uint32_t> order;
+    for (const auto& [id, cell] : cells)
+    {
+        order.push_back(id);
+    }
+    std::stable_sort(order.begin(), order.end(), [&neighbours](uint32_t a, uint32_t b) {
+        return neighbours[a].size() > neighbours[b].size();
+    });
+
+    std::map<uint32_t, uint32_t> colour;
+    uint32_t conflicts = 0;
+    for (uint32_t id : order)
+    {
+        std::array<uint32_t, 3> used{};
+        for (uint32_t n : neighbours[id])
+        {
+            auto it = colour.find(n);
+            if (it != colour.end())
+            {
+                used[it->second]++;
+            }
+        }
+        uint32_t c = std::min_element(used.begin(), used.end()) - used.begin();
+        colour[id] = c;
+        conflicts += used[c];
+    }
+
+    // ----- Restrictions: protect the sub-bands of neighbours' edge UEs -----
+    // Sub-band k = [edgeStart + k*subBand, +subBand). A cell gives up
+    // sub-band k only if a neighbour of colour k has edge UEs, so isolated
+    // cells keep the full carrier.
+    uint32_t edgeStart = problem.totalBandwidthPrbs - 3 * subBand;
+    bool muting = (coord.restriction == "muting");
+
+    problem.cells.clear();
+    problem.prbRestrictions.clear();
+    for (auto& [id, cell] : cells)
+    {
+        cell.neighbourCellIds.assign(neighbours[id].begin(), neighbours[id].end());
+
+        std::array<bool, 3> protect{};
+        for (uint32_t n : neighbours[id])
+        {
+            auto it = cells.find(n);
+            if (it != cells.end() && !it->second.edgeUeIds.empty() && colour[n] != colour[id])
+            {
+                protect[colour[n]] = true;
+            }
+        }
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            if (!protect[k])
+            {
+                continue;
+            }
+            PrbRestriction restriction;
+            restriction.cellId = id;
+            restriction.startPrb = edgeStart + k * subBand;
+            restriction.numPrbs = subBand;
+            restriction.muted = muting;
+            restriction.powerBackoffDb = muting ? 0.0 : coord.powerBackoffDb;
+            problem.prbRestrictions.push_back(restriction);
+        }
+        problem.cells.push_back(cell);
+    }
+    problem.coordinated = true;
+
+    uint32_t edgeUes = 0;
+    for (const auto& cell : problem.cells)
+    {
+        edgeUes += cell.edgeUeIds.size();
+    }
+    std::cout << "  ✓ Coordination: " << problem.cells.size() << " cells, " << edgeUes
+              << " edge UEs, " << problem.prbRestrictions.size() << " " << coord.restriction
+              << " restrictions (" << subBand << " PRBs each)" << std::endl;
+    if (conflicts > 0)
+    {
+        std::cout << "  ⚠ " << conflicts << " neighbour pair(s) share an edge sub-band"
+                  << std::endl;
+    }
+}
+
+uint32_t
+NrSimulationManager::GetPlannedPrbs(uint16_t bwp) const
+{
+    uint32_t totalPrbs = m_networkManager->GetBwpRbNum(bwp);
+    if (!m_config->scheduling.harq.enabled)
+    {
+        return totalPrbs;
+    }
+    auto reserved = static_cast<uint32_t>(
+        std::floor(m_config->scheduling.harq.reservedPrbFraction * totalPrbs));
+    return totalPrbs - reserved;
+}
+
+void
+NrSimulationManager::NotifyServingCellChanged(uint32_t ueId, uint32_t gnbIndex)
+{
+    NS_LOG_FUNCTION(this << ueId << gnbIndex);
+
+    for (const auto& bwpManager : m_bwpManagers)
+    {
+        if (bwpManager && bwpManager->IsCoordinated())
+        {
+            bwpManager->SetServingCell(ueId, gnbIndex);
+        }
+    }
+    for (const auto& sched : m_milpSchedulers)
+    {
+        sched->UpdateServingCell(ueId);
+    }
+    NS_LOG_INFO("UE " << ueId << " now served by cell " << gnbIndex);
+}
+
+MilpSolution
+NrSimulationManager::BuildStubSolution(const MilpProblem& problem) const
+{
+    NS_LOG_FUNCTION(this);
+
+    MilpSolution solution;
+    solution.status = "optimal";
+
+    // Slot-independent layout: PRB ranges and the UEs sharing each
+    std::vector<std::pair<PrbRange, std::vector<uint32_t>>> layout;
+
+    if (!problem.coordinated)
+    {
+        std::vector<uint32_t> ues;
+        for (const auto& ue : problem.ues)
+        {
+            ues.push_back(ue.ueId);
+        }
+        layout.emplace_back(PrbRange{0, problem.totalBandwidthPrbs}, ues);
+    }
+    else
+    {
+        // Per-PRB class of each cell: protected PRBs are those a neighbour
+        // gives up, so this cell's edge UEs see no (or reduced) interference
+        enum PrbClass : uint8_t
+        {
+            FREE,
+            PROTECTED,
+            POWER,
+            MUTED
+        };
+        std::map<uint32_t, std::vector<PrbRestriction>> restrictions;
+        for (const auto& r : problem.prbRestrictions)
+        {
+            restrictions[r.cellId].push_back(r);
+        }
+
+        for (const auto& cell : problem.cells)
+        {
+            std::vector<uint8_t> cls(problem.totalBandwidthPrbs, FREE);
+            for (const auto& r : restrictions[cell.cellId])
+            {
+                std::fill(cls.begin() + r.startPrb, cls.begin() + r.startPrb + r.numPrbs,
+                          r.muted ? MUTED : POWER);
+            }
+            for (uint32_t n : cell.neighbourCellIds)
+            {
+                for (const auto& r : restrictions[n])
+                {
+                    for (uint32_t p = r.startPrb; p < r.startPrb + r.numPrbs; ++p)
+                    {
+                        cls[p] = (cls[p] == FREE) ? PROTECTED : cls[p];
+                    }
+                }
+            }
+
+            std::map<uint8_t, std::vector<PrbRange>> runs;
+            for (uint32_t p = 0; p < cls.size();)
+            {
+                uint32_t q = p;
+                while (q < cls.size() && cls[q] == cls[p])
+                {
+                    ++q;
+                }
+                runs[cls[p]].push_back(PrbRange{p, q - p});
+                p = q;
+            }
+
+            std::vector<uint32_t> edge = cell.edgeUeIds;
+            std::vector<uint32_t> centre;
+            for (uint32_t ueId : cell.ueIds)
+            {
+                if (!cell.IsEdgeUe(ueId))
+                {
+                    centre.push_back(ueId);
+                }
+            }
+
+            // Edge UEs: protected PRBs. Centre UEs: free and power-limited
+            // PRBs. A group left empty lends its PRBs to the other one;
+            // edge UEs never go on power-limited PRBs.
+            std::vector<PrbRange> edgeRanges = runs[PROTECTED];
+            std::vector<PrbRange> centreRanges = runs[FREE];
+            centreRanges.insert(centreRanges.end(), runs[POWER].begin(), runs[POWER].end());
+            if (edge.empty())
+            {
+                centreRanges.insert(centreRanges.end(), edgeRanges.begin(), edgeRanges.end());
+                edgeRanges.clear();
+            }
+            else if (centre.empty())
+            {
+                edgeRanges.insert(edgeRanges.end(), runs[FREE].begin(), runs[FREE].end());
+                centreRanges.clear();
+            }
+            else if (edgeRanges.empty())
+            {
+                // Nothing protected (colouring conflict): edge UEs share
+                // the free PRBs with the centre UEs
+                edgeRanges = runs[FREE];
+                edge.insert(edge.end(), centre.begin(), centre.end());
+                centreRanges = runs[POWER];
+            }
+
+            auto edgeMembers = DistributeUes(edgeRanges, edge);
+            for (size_t r = 0; r < edgeRanges.size(); ++r)
+            {
+                layout.emplace_back(edgeRanges[r], edgeMembers[r]);
+            }
+            auto centreMembers = DistributeUes(centreRanges, centre);
+            for (size_t r = 0; r < centreRanges.size(); ++r)
+            {
+                layout.emplace_back(centreRanges[r], centreMembers[r]);
+            }
+        }
+    }
+
+    // SLA classes share PRBs in proportion to their member count
+    std::vector<uint32_t> weights;
+    if (problem.aggregated)
+    {
+        for (const auto& cls : problem.classes)
+        {
+            weights.push_back(cls.ueIds.size());
+        }
+    }
+
+    // Coarse planning: the same per-slot shares, summed per block
+    uint32_t k = problem.planningGranularitySlots;
+    if (k > 1)
+    {
+        solution.granularitySlots = k;
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> blockPrbSlots;  // (block, UE)
+        std::vector<PrbAllocation> slotAllocations;
+        for (uint32_t slot = 0; slot < problem.totalSlots; slot++)
+        {
+            slotAllocations.clear();
+            for (const auto& [range, ues] : layout)
+            {
+                SplitPrbRange(range, ues, slot, slotAllocations, weights);
+            }
+            for (const auto& alloc : slotAllocations)
+            {
+                blockPrbSlots[{slot / k, alloc.ueId}] += alloc.numPrbs;
+            }
+        }
+        for (const auto& [key, prbSlots] : blockPrbSlots)
+        {
+            solution.budgets.emplace_back(key.second, key.first, prbSlots);
+        }
+        return solution;
+    }
+
+    for (uint32_t slot = 0; slot < problem.totalSlots; slot++)
+    {
+        for (const auto& [range, ues] : layout)
+        {
+            SplitPrbRange(range, ues, slot, solution.allocations, weights);
+        }
+    }
+
+    return solution;
+}
+
 } // namespace ns3
\ No newline at end of file
@@ -21,15 +21,21 @@
 #include "nr-traffic-manager.h"
 #include "nr-metrics-manager.h"
 #include "nr-output-manager.h"
+#include "nr-dormancy-manager.h"
 
 // MILP Integration
 #include "nr-bwp-manager.h"
 #include "nr-milp-interface.h"
 #include "nr-milp-executor-scheduler.h"
+#include "nr-slice-manager.h"
 
 #include "ns3/nr-helper.h"
 #include "ns3/cc-bwp-helper.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 namespace ns3
 {
 
@@ -67,6 +73,10 @@ class NrSimulationManager : public Object
 
     /**
      * @brief Initialize simulation (load config, create managers, deploy)
+     *
+     * With partition.enabled under MPI, main() must call
+     * MpiInterface::Enable() before this; each rank then initializes and
+     * runs only its own shard (see SelectPartition()).
      * 
      * Order of operations:
      * 1. Create all managers
@@ -93,6 +103,61 @@ class NrSimulationManager : public Object
      */
     bool IsInitialized() const;
 
+    // ================================================================
+    // FORKED SWEEPS
+    // ================================================================
+
+    /**
+     * @brief One point of a forked sweep
+     *
+     * Start from GetConfig()->traffic and change what the point varies.
+     */
+    struct SweepPoint
+    {
+        std::string name;                 ///< Label, also the output suffix
+        uint32_t rngRun = 1;              ///< RngSeedManager run number
+        NrSimConfig::TrafficParams traffic; ///< Traffic profile for this point
+        std::string outputFilePath;       ///< Empty = "<outputFilePath>.<name>"
+        bool headless = true;             ///< Disable periodic monitoring/telemetry
+    };
+
+    /**
+     * @brief Outcome of one forked sweep point
+     */
+    struct SweepResult
+    {
+        std::string name;
+        int32_t pid = -1;                 ///< Worker process id (-1 if fork failed)
+        int32_t exitCode = -1;            ///< 0 on success, 128+signal if killed
+        double wallSeconds = 0.0;         ///< Worker wall time (Run + Finalize)
+        std::string outputFilePath;       ///< Results file written by the worker
+        std::string logPath;              ///< Worker stdout/stderr
+    };
+
+    /**
+     * @brief Run many sweep points off a single initialization
+     *
+     * Call after Initialize() instead of Run(). The initialized process
+     * is fork()ed once per point (at most maxWorkers at a time); workers
+     * share the topology, devices, attachments and MILP plan copy-on-write.
+     * Each worker applies its traffic profile, RNG run number and output
+     * path, then runs Run() + Finalize() with stdout/stderr redirected to
+     * its log file.
+     *
+     * Random streams created during Initialize() (mobility, channel) were
+     * seeded before the fork and are identical across points; only
+     * streams created in Run() (traffic applications) follow rngRun.
+     *
+     * The parent's simulation is left untouched, so Run() may still be
+     * called afterwards for a baseline point.
+     *
+     * @param points Sweep points
+     * @param maxWorkers Concurrent workers (0 = online CPU count)
+     * @return One result per point, in input order
+     */
+    std::vector<SweepResult> RunForkedSweep(const std::vector<SweepPoint>& points,
+                                            uint32_t maxWorkers = 0);
+
     // Getter methods for sub-managers
     Ptr<NrTopologyManager> GetTopologyManager() const;
     Ptr<NrChannelManager> GetChannelManager() const;
@@ -104,6 +169,25 @@ class NrSimulationManager : public Object
     Ptr<NrSimConfig> GetConfig() const;
     Ptr<NrBwpManager> GetBwpManager() const;
 
+    /**
+     * @brief Get the MILP plan of one carrier
+     * @param bwpId BWP (= carrier) index
+     * @return BWP manager holding that carrier's plan, or nullptr
+     */
+    Ptr<NrBwpManager> GetBwpManager(uint16_t bwpId) const;
+
+    /**
+     * @brief Get the slice quota enforcer shared by all MILP schedulers
+     * @return Slice manager, or nullptr if scheduling.slicing is disabled
+     */
+    Ptr<NrSliceManager> GetSliceManager() const;
+
+    /**
+     * @brief Get the dormant-UE controller
+     * @return Dormancy manager, or nullptr if traffic.dormancy is disabled
+     */
+    Ptr<NrDormancyManager> GetDormancyManager() const;
+
     /**
      * @brief Get the NrHelper
      * @return Pointer to NrHelper (null if not initialized)
@@ -142,14 +226,106 @@ class NrSimulationManager : public Object
      * 2. Builds and solves the MILP problem
      * 3. Loads solution into BWP Manager
      * 4. Creates and installs MILP Executor Scheduler
+     *
+     * With several carriers, one plan is built per carrier over the UEs
+     * assigned to it, sized by that BWP's PRB count and numerology.
+     * With scheduling.coordination.enabled the plans are coordinated
+     * across cells (see AddCellCoordination()).
      * 
      * Called during Initialize() after network setup.
      */
     void SetupMilpScheduler();
+
+    /**
+     * @brief Turn a plan into a joint multi-cell (coordinated) problem
+     * @param problem Problem whose ues are already filled in
+     *
+     * Groups UEs by nearest site, marks cell-edge UEs by the distance
+     * ratio to their second-nearest site, links cells that share edge
+     * UEs and 3-colours that neighbour graph. The top edgeBandFraction
+     * of the PRBs is split into three sub-bands; each cell keeps the
+     * sub-band of its colour for its edge UEs and mutes (or power-limits)
+     * the other two. Leaves the problem uncoordinated if the band is too
+     * narrow for three sub-bands.
+     */
+    void AddCellCoordination(MilpProblem& problem) const;
+
+    /**
+     * @brief Stub solver: static equal-share plan for every slot
+     * @param problem Problem to plan
+     * @return Solution; per-cell and restriction-aware when coordinated,
+     *         per-block budgets when planningGranularitySlots > 1
+     */
+    MilpSolution BuildStubSolution(const MilpProblem& problem) const;
+
+    /**
+     * @brief Move a UE to its new serving cell in coordinated plans
+     * @param ueId UE index
+     * @param gnbIndex New serving gNB
+     *
+     * Connected to NrNetworkManager's ServingCellChanged trace when the
+     * plans are coordinated. The plans keep the cells AddCellCoordination()
+     * derived from t=0 geometry; the executors follow the serving cell.
+     */
+    void NotifyServingCellChanged(uint32_t ueId, uint32_t gnbIndex);
+
+    /**
+     * @brief PRBs of a BWP the plan may use
+     * @param bwp BWP index
+     * @return BWP size minus the HARQ retransmission pool (if enabled)
+     */
+    uint32_t GetPlannedPrbs(uint16_t bwp) const;
+
+    /**
+     * @brief Pick this MPI rank's spatial shard before deployment
+     *
+     * Independent spatial sharding, not a distributed simulation: the
+     * topology manager splits the sites into one spatial cluster per rank
+     * and creates nodes only for the local cluster. Each rank then builds
+     * and runs its own NR/EPC stack for its cluster with the default
+     * simulator; ranks exchange no packets and no events, so they need no
+     * lookahead. UEs hand over only between local cells; interference
+     * from other shards is approximated by partition.interferenceMarginDb.
+     * A single rank simulates the whole topology.
+     */
+    void SelectPartition();
+
+    /**
+     * @brief Rewrite the config for the deployed shard
+     *
+     * Maps waypoints to local UE ids and sets the local gNB/UE counts and
+     * the per-rank output path.
+     */
+    void ApplyPartition();
+
+    /**
+     * @brief Body of a forked sweep worker; never returns
+     * @param point Sweep point to apply
+     * @param outputFilePath Resolved results file
+     * @param logPath File receiving the worker's stdout/stderr
+     */
+    [[noreturn]] void RunSweepWorker(const SweepPoint& point,
+                                     const std::string& outputFilePath,
+                                     const std::string& logPath);
+
+    /**
+     * @brief Append this run's KPIs, profiling and SLA compliance to
+     *        the results store (config metrics.resultsStore)
+     * @param finalizeSeconds Wall time spent in Finalize()
+     */
+    void RecordRunInStore(double finalizeSeconds);
+
+    /**
+     * @brief Collect the container sizes of the managers and print the
+     *        memory footprint report (config metrics.memoryProfile)
+     */
+    void PrintMemoryFootprint();
     
     // Configuration
     std::string m_configPath;
     Ptr<NrSimConfig> m_config;
+    std::string m_configHash;       ///< Hash of the loaded config (results store key)
+    std::string m_sweepPointName;   ///< Sweep point of a forked worker ("" otherwise)
 
     // State flags
     bool m_isInitialized;
@@ -166,16 +342,27 @@ class NrSimulationManager : public Object
     Ptr<NrOutputManager> m_outputManager;
     
     // MILP Components
-    Ptr<NrBwpManager> m_bwpManager;
+    Ptr<NrBwpManager> m_bwpManager;                   ///< Plan of BWP 0
+    std::vector<Ptr<NrBwpManager>> m_bwpManagers;     ///< One plan per BWP
     Ptr<NrMilpInterface> m_milpInterface;
     Ptr<NrMilpExecutorScheduler> m_milpScheduler;
+    std::vector<Ptr<NrMilpExecutorScheduler>> m_milpSchedulers;  ///< Every linked executor
+    Ptr<NrSliceManager> m_sliceManager;               ///< Null unless slicing enabled
+    Ptr<NrDormancyManager> m_dormancyManager;         ///< Null unless dormancy enabled
+    std::map<uint32_t, UeSla> m_ueSlas;               ///< Planned SLA of each UE
     
     // NR infrastructure
     Ptr<NrHelper> m_nrHelper;
     OperationBandInfo m_operationBand;
 
+    // Spatial sharding (independent multi-process runs)
+    uint32_t m_partitionId;
+    uint32_t m_numPartitions;
+
     // Timing
     std::chrono::high_resolution_clock::time_point m_wallClockStart;
+    double m_initSeconds;
+    double m_runSeconds;
 };
 
 } // namespace ns3
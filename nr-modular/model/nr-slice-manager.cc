@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Slice Manager - Implementation File
+ */
+
+#include "nr-slice-manager.h"
+
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrSliceManager");
+NS_OBJECT_ENSURE_REGISTERED(NrSliceManager);
+
+// ============================================================================
+// TYPE ID
+// ============================================================================
+
+TypeId
+NrSliceManager::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrSliceManager")
+                            .SetParent<Object>()
+                            .SetGroupName("NrModular")
+                            .AddConstructor<NrSliceManager>();
+    return tid;
+}
+
+// ============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+// ============================================================================
+
+NrSliceManager::NrSliceManager()
+    : m_quotas(),
+      m_ueSlice(),
+      m_counters()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrSliceManager::~NrSliceManager()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrSliceManager::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_ueSlice.clear();
+    m_ueNeed.clear();
+    m_prbBusy.clear();
+    Object::DoDispose();
+}
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+void
+NrSliceManager::SetSliceQuota(SliceType slice, double guaranteedShare, double maxShare)
+{
+    NS_LOG_FUNCTION(this << SliceTypeToString(slice) << guaranteedShare << maxShare);
+
+    NS_ABORT_MSG_IF(guaranteedShare < 0.0 || maxShare > 1.0 || guaranteedShare > maxShare,
+                    "Slice " << SliceTypeToString(slice) << ": need 0 <= guaranteed ("
+                             << guaranteedShare << ") <= max (" << maxShare << ") <= 1");
+
+    m_quotas[static_cast<size_t>(slice)] = SliceQuota{guaranteedShare, maxShare};
+}
+
+void
+NrSliceManager::SetUeSlice(uint32_t ueId, SliceType slice)
+{
+    if (ueId >= m_ueSlice.size())
+    {
+        m_ueSlice.resize(ueId + 1, static_cast<uint8_t>(SliceType::eMBB));
+    }
+    m_ueSlice[ueId] = static_cast<uint8_t>(slice);
+}
+
+SliceType
+NrSliceManager::GetUeSlice(uint32_t ueId) const
+{
+    return (ueId < m_ueSlice.size()) ? static_cast<SliceType>(m_ueSlice[ueId])
+                                     : SliceType::eMBB;
+}
+
+bool
+NrSliceManager::Validate() const
+{
+    double guaranteed = 0.0;
+    for (const auto& quota : m_quotas)
+    {
+        guaranteed += quota.guaranteedShare;
+    }
+    if (guaranteed > 1.0 + 1e-9)
+    {
+        NS_LOG_ERROR("Sum of guaranteed slice shares is " << guaranteed << " > 1");
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// PER-SLOT ENFORCEMENT
+// ============================================================================
+
+void
+NrSliceManager::ApplySlotQuotas(std::vector<PrbAllocation>& allocations,
+                                const SlotResources& resources,
+                                bool downlink)
+{
+    uint32_t totalPrbs = resources.usablePrbs.size();
+    uint32_t rbgSize = std::max<uint32_t>(1, resources.rbgSize);
+
+    // ----- Demand: buffered data of the active UEs -----
+    std::array<uint32_t, NUM_SLICES> demand{};
+    for (const auto& d : resources.demand)
+    {
+        if (d.ueId >= m_ueNeed.size())
+        {
+            m_ueNeed.resize(d.ueId + 1, 0);
+        }
+        m_ueNeed[d.ueId] += d.prbs;
+        demand[static_cast<size_t>(GetUeSlice(d.ueId))] += d.prbs;
+    }
+    auto needOf = [this](uint32_t ueId) -> uint32_t {
+        return (ueId < m_ueNeed.size()) ? m_ueNeed[ueId] : 0;
+    };
+
+    m_prbBusy.resize(totalPrbs);
+    uint32_t capacity = 0;
+    for (uint32_t p = 0; p < totalPrbs; ++p)
+    {
+        m_prbBusy[p] = !resources.usablePrbs[p];
+        capacity += resources.usablePrbs[p] ? 1 : 0;
+    }
+
+    // ----- Grants: guarantee first, then share the pool -----
+    std::array<uint32_t, NUM_SLICES> guaranteed{};
+    std::array<uint32_t, NUM_SLICES> maximum{};
+    std::array<uint32_t, NUM_SLICES> grant{};
+    std::array<uint32_t, NUM_SLICES> want{};
+    uint32_t granted = 0;
+    for (size_t s = 0; s < NUM_SLICES; ++s)
+    {
+        guaranteed[s] = static_cast<uint32_t>(std::floor(m_quotas[s].guaranteedShare * totalPrbs));
+        maximum[s] = static_cast<uint32_t>(std::floor(m_quotas[s].maxShare * totalPrbs));
+        grant[s] = std::min(demand[s], guaranteed[s]);
+        granted += grant[s];
+    }
+
+    // Held PRBs shrink the slot: guarantees are cut in proportion
+    if (granted > capacity)
+    {
+        uint32_t scaled = 0;
+        for (size_t s = 0; s < NUM_SLICES; ++s)
+        {
+            grant[s] = static_cast<uint32_t>(static_cast<uint64_t>(grant[s]) * capacity / granted);
+            scaled += grant[s];
+        }
+        granted = scaled;
+    }
+    for (size_t s = 0; s < NUM_SLICES; ++s)
+    {
+        want[s] = std::min(demand[s], maximum[s]) - std::min(grant[s], maximum[s]);
+    }
+
+    // Work-conserving: unused guarantees and unreserved PRBs go to slices
+    // still wanting more, weighted by guaranteed share (floor 1%)
+    uint32_t pool = (granted < capacity) ? capacity - granted : 0;
+    while (pool > 0)
+    {
+        double weightSum = 0.0;
+        for (size_t s = 0; s < NUM_SLICES; ++s)
+        {
+            if (want[s] > 0)
+            {
+                weightSum += std::max(m_quotas[s].guaranteedShare, 0.01);
+            }
+        }
+        if (weightSum == 0.0)
+        {
+            break;
+        }
+
+        uint32_t given = 0;
+        for (size_t s = 0; s < NUM_SLICES && given < pool; ++s)
+        {
+            if (want[s] == 0)
+            {
+                continue;
+            }
+            double weight = std::max(m_quotas[s].guaranteedShare, 0.01);
+            uint32_t share = std::max<uint32_t>(1, pool * weight / weightSum);
+            uint32_t give = std::min({share, want[s], pool - given});
+            grant[s] += give;
+            want[s] -= give;
+            given += give;
+        }
+        pool -= given;
+    }
+
+    // ----- Planned PRBs: keep each UE's up to its need and the grant -----
+    std::array<uint32_t, NUM_SLICES> remaining = grant;
+    std::array<uint32_t, NUM_SLICES> given{};
+    std::array<uint32_t, NUM_SLICES> lent{};
+    bool dropped = false;
+    for (auto& alloc : allocations)
+    {
+        size_t s = static_cast<size_t>(GetUeSlice(alloc.ueId));
+        uint32_t take = std::min(needOf(alloc.ueId), remaining[s]);
+        uint32_t start = alloc.startPrb;
+        uint32_t end = std::min(alloc.startPrb + alloc.numPrbs, totalPrbs);
+        while (start < end && m_prbBusy[start])
+        {
+            ++start;
+        }
+        uint32_t kept = 0;
+        while (kept < take && start + kept < end && !m_prbBusy[start + kept])
+        {
+            m_prbBusy[start + kept] = true;
+            ++kept;
+        }
+        alloc.startPrb = start;
+        alloc.numPrbs = kept;
+        dropped |= (kept == 0);
+        if (kept > 0)
+        {
+            m_ueNeed[alloc.ueId] -= kept;
+        }
+        remaining[s] -= kept;
+        given[s] += kept;
+    }
+    if (dropped)
+    {
+        allocations.erase(std::remove_if(allocations.begin(),
+                                         allocations.end(),
+                                         [](const PrbAllocation& a) { return a.numPrbs == 0; }),
+                          allocations.end());
+    }
+
+    // ----- Lending: idle and freed RBGs to UEs below their slice's grant -----
+    uint32_t numRbgs = totalPrbs / rbgSize;
+    auto rbgFree = [&](uint32_t rbg) {
+        for (uint32_t p = rbg * rbgSize; p < (rbg + 1) * rbgSize; ++p)
+        {
+            if (m_prbBusy[p])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    uint32_t nextRbg = 0;
+    for (const auto& d : resources.demand)
+    {
+        size_t s = static_cast<size_t>(GetUeSlice(d.ueId));
+        uint32_t& need = m_ueNeed[d.ueId];
+        while (need > 0 && remaining[s] > 0)
+        {
+            while (nextRbg < numRbgs && !rbgFree(nextRbg))
+            {
+                ++nextRbg;
+            }
+            if (nextRbg >= numRbgs)
+            {
+                break;
+            }
+            uint32_t wantRbgs = (std::min(need, remaining[s]) + rbgSize - 1) / rbgSize;
+            uint32_t firstRbg = nextRbg;
+            while (nextRbg - firstRbg < wantRbgs && nextRbg < numRbgs && rbgFree(nextRbg))
+            {
+                std::fill(m_prbBusy.begin() + nextRbg * rbgSize,
+                          m_prbBusy.begin() + (nextRbg + 1) * rbgSize,
+                          true);
+                ++nextRbg;
+            }
+            uint32_t prbs = (nextRbg - firstRbg) * rbgSize;
+            allocations.emplace_back(d.ueId, resources.slot, firstRbg * rbgSize, prbs);
+            need -= std::min(need, prbs);
+            remaining[s] -= std::min(remaining[s], prbs);
+            given[s] += prbs;
+            lent[s] += prbs;
+        }
+    }
+    for (const auto& d : resources.demand)
+    {
+        m_ueNeed[d.ueId] = 0;
+    }
+
+    // ----- Counters -----
+    auto& counters = m_counters[downlink ? 1 : 0];
+    for (size_t s = 0; s < NUM_SLICES; ++s)
+    {
+        SliceCounters& c = counters[s];
+        c.slots++;
+        c.capacityPrbs += totalPrbs;
+        if (demand[s] == 0)
+        {
+            continue;
+        }
+        c.activeSlots++;
+        c.demandPrbs += demand[s];
+        c.grantedPrbs += given[s];
+        c.borrowedPrbs += (given[s] > guaranteed[s]) ? given[s] - guaranteed[s] : 0;
+        c.lentPrbs += lent[s];
+        c.trimmedPrbs += (demand[s] > given[s]) ? demand[s] - given[s] : 0;
+        c.guaranteeMisses += (given[s] < std::min(demand[s], guaranteed[s])) ? 1 : 0;
+        c.cappedSlots += (demand[s] > maximum[s]) ? 1 : 0;
+    }
+}
+
+// ============================================================================
+// COUNTERS AND KPIs
+// ============================================================================
+
+const NrSliceManager::SliceCounters&
+NrSliceManager::GetCounters(SliceType slice, bool downlink) const
+{
+    return m_counters[downlink ? 1 : 0][static_cast<size_t>(slice)];
+}
+
+std::vector<NrSliceManager::SliceKpi>
+NrSliceManager::GetSliceKpis(bool downlink) const
+{
+    std::vector<SliceKpi> kpis;
+    for (size_t s = 0; s < NUM_SLICES; ++s)
+    {
+        const SliceCounters& c = m_counters[downlink ? 1 : 0][s];
+
+        SliceKpi kpi;
+        kpi.slice = static_cast<SliceType>(s);
+        kpi.guaranteedShare = m_quotas[s].guaranteedShare;
+        kpi.maxShare = m_quotas[s].maxShare;
+        kpi.utilization =
+            c.capacityPrbs ? static_cast<double>(c.grantedPrbs) / c.capacityPrbs : 0.0;
+        kpi.demandSatisfaction =
+            c.demandPrbs ? static_cast<double>(c.grantedPrbs) / c.demandPrbs : 1.0;
+        kpi.borrowedFraction =
+            c.grantedPrbs ? static_cast<double>(c.borrowedPrbs) / c.grantedPrbs : 0.0;
+        kpi.guaranteeMet =
+            c.activeSlots ? 1.0 - static_cast<double>(c.guaranteeMisses) / c.activeSlots : 1.0;
+        kpi.trimmedPrbs = c.trimmedPrbs;
+        kpis.push_back(kpi);
+    }
+    return kpis;
+}
+
+void
+NrSliceManager::ResetCounters()
+{
+    NS_LOG_FUNCTION(this);
+    m_counters = {};
+}
+
+void
+NrSliceManager::SliceKpi::Print(std::ostream& os) const
+{
+    os << std::left << std::setw(7) << SliceTypeToString(slice) << std::right << std::fixed
+       << std::setprecision(2) << std::setw(7) << guaranteedShare << std::setw(7) << maxShare
+       << std::setprecision(1) << std::setw(8) << utilization * 100 << "%" << std::setw(8)
+       << demandSatisfaction * 100 << "%" << std::setw(8) << borrowedFraction * 100 << "%"
+       << std::setw(8) << guaranteeMet * 100 << "%" << std::setw(10) << trimmedPrbs;
+    os.unsetf(std::ios::floatfield);
+}
+
+void
+NrSliceManager::PrintSummary(std::ostream& os) const
+{
+    os << "\n========================================" << std::endl;
+    os << "RAN SLICING - PER-SLICE KPIs" << std::endl;
+    os << "========================================" << std::endl;
+
+    for (bool downlink : {true, false})
+    {
+        os << (downlink ? "Downlink" : "Uplink") << ":" << std::endl;
+        os << "  slice     guar    max     util   satisf   borrow   guarOK   trimmed" << std::endl;
+        for (const auto& kpi : GetSliceKpis(downlink))
+        {
+            os << "  ";
+            kpi.Print(os);
+            os << std::endl;
+        }
+    }
+    os << "========================================\n" << std::endl;
+}
+
+} // namespace ns3
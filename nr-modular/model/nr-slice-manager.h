@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Slice Manager - Header File
+ *
+ * Responsibilities:
+ * - Enforce per-slice PRB quotas on the MILP allocations of each slot
+ * - Share unused guaranteed PRBs across slices (work-conserving)
+ * - Keep per-slice utilization counters and derive KPIs
+ *
+ * Position in the data path:
+ *   NrBwpManager::GetAllocationForSlot()
+ *        → NrSliceManager::ApplySlotQuotas()   (grants, trim, lend)
+ *        → NrMilpExecutorScheduler (PRB → RBG)
+ *
+ * Demand is the data the active UEs have buffered, converted to PRBs by
+ * the executor, not the plan: the plan is fixed ahead of time, while
+ * buffers say what each slice needs in this slot.
+ *
+ * Quota model (per slot, N = PRBs the plan may use):
+ * - guaranteed: a slice with demand gets min(demand, g·N), scaled down
+ *               when PRBs of the slot are held (HARQ retransmissions,
+ *               muted PRBs); a slice left below it counts a miss
+ * - maximum:    a slice never gets more than m·N (rounded up to a
+ *               whole RBG when PRBs are lent)
+ * - sharing:    PRBs a slice does not use of its guarantee (and any
+ *               unreserved PRBs) go to slices with remaining demand,
+ *               weighted by their guaranteed share, up to their maximum
+ *
+ * Execution: each UE keeps its planned PRBs up to its demand and its
+ * slice's grant (allocations only shrink, never move). PRBs freed that
+ * way, and PRBs the plan left idle, are lent in whole RBGs to UEs whose
+ * slice is still below its grant. Neither step touches a PRB another
+ * allocation holds, so enforcement cannot create PRB overlaps.
+ *
+ * Performance:
+ * - ApplySlotQuotas: O(k + d + N) for k allocations, d active UEs;
+ *   reuses member scratch buffers, so no heap allocation once warm
+ */
+
+#ifndef NR_SLICE_MANAGER_H
+#define NR_SLICE_MANAGER_H
+
+#include "ns3/object.h"
+#include "utils/nr-milp-types.h"
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Per-slice PRB quotas between the MILP plan and the executor
+ */
+class NrSliceManager : public Object
+{
+  public:
+    /// Number of slice types (eMBB, uRLLC, mMTC)
+    static constexpr size_t NUM_SLICES = 3;
+
+    /**
+     * \brief Get the TypeId
+     * \return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Constructor
+     *
+     * Default policy: no guarantees, every slice may use the whole BWP
+     * (i.e. no isolation until quotas are configured).
+     */
+    NrSliceManager();
+
+    /**
+     * \brief Destructor
+     */
+    ~NrSliceManager() override;
+
+    // ========================================================================
+    // CONFIGURATION
+    // ========================================================================
+
+    /**
+     * \brief Set the PRB shares of one slice
+     * \param slice Slice type
+     * \param guaranteedShare Fraction of the BWP's PRBs guaranteed per slot
+     * \param maxShare Fraction of the BWP's PRBs the slice may never exceed
+     *
+     * Requires 0 <= guaranteedShare <= maxShare <= 1. The sum of all
+     * guaranteed shares must stay <= 1 (checked by Validate()).
+     */
+    void SetSliceQuota(SliceType slice, double guaranteedShare, double maxShare);
+
+    /**
+     * \brief Assign a UE to a slice
+     * \param ueId MILP UE identifier
+     * \param slice Slice type
+     *
+     * Unassigned UEs belong to eMBB.
+     */
+    void SetUeSlice(uint32_t ueId, SliceType slice);
+
+    /**
+     * \brief Get the slice of a UE
+     * \param ueId MILP UE identifier
+     * \return Slice type (eMBB if never assigned)
+     */
+    SliceType GetUeSlice(uint32_t ueId) const;
+
+    /**
+     * \brief Check the quota configuration
+     * \return true if all shares are consistent
+     */
+    bool Validate() const;
+
+    // ========================================================================
+    // PER-SLOT ENFORCEMENT (hot path)
+    // ========================================================================
+
+    /**
+     * \brief Buffered data of one active UE
+     */
+    struct UeDemand
+    {
+        uint32_t ueId = 0;  ///< MILP UE identifier
+        uint32_t prbs = 0;  ///< PRBs needed to drain its buffer in this slot
+    };
+
+    /**
+     * \brief What one slot has to give out
+     */
+    struct SlotResources
+    {
+        uint32_t slot = 0;             ///< Slot of the allocations (used for lent PRBs)
+        std::vector<bool> usablePrbs;  ///< One per PRB the plan may use; false = held
+        uint32_t rbgSize = 1;          ///< PRBs are lent in whole, aligned RBGs
+        std::vector<UeDemand> demand;  ///< Active UEs
+    };
+
+    /**
+     * \brief Enforce the slice grants on one slot's allocations
+     * \param allocations Allocations of one slot (modified in place)
+     * \param resources Usable PRBs and buffered demand of the slot
+     * \param downlink Selects the DL or UL counters
+     *
+     * Computes each slice's grant from its demand and quotas, shrinks
+     * planned allocations to the UEs' demand and the grants, lends idle
+     * and freed PRBs to slices below their grant (new allocations are
+     * appended), and updates the counters. Held PRBs are never granted.
+     */
+    void ApplySlotQuotas(std::vector<PrbAllocation>& allocations,
+                         const SlotResources& resources,
+                         bool downlink);
+
+    // ========================================================================
+    // COUNTERS AND KPIs
+    // ========================================================================
+
+    /**
+     * \brief Raw per-slice counters (one direction)
+     */
+    struct SliceCounters
+    {
+        uint64_t slots = 0;            ///< Slots enforced
+        uint64_t activeSlots = 0;      ///< Slots with demand from this slice
+        uint64_t capacityPrbs = 0;     ///< Sum of N over enforced slots
+        uint64_t demandPrbs = 0;       ///< PRBs needed by the slice's buffers
+        uint64_t grantedPrbs = 0;      ///< PRBs given after enforcement
+        uint64_t borrowedPrbs = 0;     ///< Granted beyond the guarantee
+        uint64_t lentPrbs = 0;         ///< Granted on PRBs the plan gave elsewhere or left idle
+        uint64_t trimmedPrbs = 0;      ///< Demand not granted
+        uint64_t guaranteeMisses = 0;  ///< Slots granted < min(demand, guarantee)
+        uint64_t cappedSlots = 0;      ///< Slots limited by the maximum share
+    };
+
+    /**
+     * \brief Derived per-slice KPIs (one direction)
+     */
+    struct SliceKpi
+    {
+        SliceType slice = SliceType::eMBB;  ///< Slice type
+        double guaranteedShare = 0.0;       ///< Configured guarantee
+        double maxShare = 1.0;              ///< Configured maximum
+        double utilization = 0.0;           ///< granted / capacity
+        double demandSatisfaction = 1.0;    ///< granted / demand
+        double borrowedFraction = 0.0;      ///< borrowed / granted
+        double guaranteeMet = 1.0;          ///< Active slots with guarantee honoured
+        uint64_t trimmedPrbs = 0;           ///< Demand cut by quotas
+
+        /**
+         * \brief Print KPIs to output stream
+         * \param os Output stream
+         */
+        void Print(std::ostream& os) const;
+    };
+
+    /**
+     * \brief Get raw counters of one slice
+     * \param slice Slice type
+     * \param downlink DL (true) or UL counters
+     * \return Counters since construction or the last ResetCounters()
+     */
+    const SliceCounters& GetCounters(SliceType slice, bool downlink = true) const;
+
+    /**
+     * \brief Get KPIs of all slices
+     * \param downlink DL (true) or UL
+     * \return One entry per slice type
+     */
+    std::vector<SliceKpi> GetSliceKpis(bool downlink = true) const;
+
+    /**
+     * \brief Reset all counters
+     */
+    void ResetCounters();
+
+    /**
+     * \brief Print a KPI table for both directions
+     * \param os Output stream
+     */
+    void PrintSummary(std::ostream& os) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Configured quota of one slice
+     */
+    struct SliceQuota
+    {
+        double guaranteedShare = 0.0;  ///< Guaranteed fraction of PRBs
+        double maxShare = 1.0;         ///< Maximum fraction of PRBs
+    };
+
+    std::array<SliceQuota, NUM_SLICES> m_quotas;              ///< Per-slice quotas
+    std::vector<uint8_t> m_ueSlice;                           ///< Slice per ueId
+    std::array<std::array<SliceCounters, NUM_SLICES>, 2> m_counters;  ///< [UL, DL]
+    std::vector<uint32_t> m_ueNeed;                           ///< Scratch: PRBs still needed per ueId
+    std::vector<bool> m_prbBusy;                              ///< Scratch: held or granted PRBs
+};
+
+} // namespace ns3
+
+#endif /* NR_SLICE_MANAGER_H */
@@ -22,8 +22,12 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
 
 namespace ns3
 {
@@ -43,7 +47,9 @@ NrTopologyManager::GetTypeId()
 
 NrTopologyManager::NrTopologyManager()
     : m_config(nullptr),
-      m_deployed(false)
+      m_deployed(false),
+      m_numPartitions(1),
+      m_partitionId(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -63,6 +69,8 @@ NrTopologyManager::DoDispose()
     m_ueNodes = NodeContainer();
     m_gnbPositions.clear();
     m_uePositions.clear();
+    m_globalGnbIds.clear();
+    m_globalUeIds.clear();
     Object::DoDispose();
 }
 
@@ -74,6 +82,19 @@ NrTopologyManager::SetConfig(const Ptr<NrSimConfig>& config)
     m_config = config;
 }
 
+void
+NrTopologyManager::SetPartition(uint32_t numPartitions, uint32_t partitionId)
+{
+    NS_LOG_FUNCTION(this << numPartitions << partitionId);
+
+    NS_ABORT_MSG_IF(m_deployed, "Partition must be set before deployment");
+    NS_ABORT_MSG_IF(numPartitions == 0 || partitionId >= numPartitions,
+                    "Partition id " << partitionId << " out of range (" << numPartitions
+                                    << " partitions)");
+    m_numPartitions = numPartitions;
+    m_partitionId = partitionId;
+}
+
 void
 NrTopologyManager::DeployTopology()
 {
@@ -92,9 +113,64 @@ NrTopologyManager::DeployTopology()
     std::cout << "Placement strategy: " << m_config->topology.uePlacementStrategy << std::endl;
     std::cout << "========================================" << std::endl;
 
+    // ====================================================================
+    // POSITIONS
+    // Computed for the whole deployment before any node exists, so a
+    // sharded run can pick its sites and UEs from them
+    // ====================================================================
+
+    std::cout << "\n [nr-topology-manager] topology.useFilePositions = "
+              << (m_config->topology.useFilePositions ? "true" : "false") << std::endl;
+    m_gnbPositions.clear();
+    m_uePositions.clear();
+    if (m_config->topology.useFilePositions)
+    {
+        DeployFromFile();
+    }
+    else
+    {
+        DeployHexagonal();
+    }
+
+    // IMPORTANT: Override initial positions for UEs with waypoints
+    // This ensures UEs start at the first waypoint of their path
+    SetInitialPositionsFromWaypoints();
+
+    // Sites and UEs to create: all of them, or this partition's only
+    m_globalGnbIds.clear();
+    m_globalUeIds.clear();
+    if (m_numPartitions > 1)
+    {
+        SpatialPartition partition = ComputeSpatialPartition(m_numPartitions);
+        for (uint32_t g = 0; g < numGnbs; ++g)
+        {
+            if (partition.gnbPartition[g] == m_partitionId)
+            {
+                m_globalGnbIds.push_back(g);
+            }
+        }
+        for (uint32_t u = 0; u < numUes; ++u)
+        {
+            if (partition.uePartition[u] == m_partitionId)
+            {
+                m_globalUeIds.push_back(u);
+            }
+        }
+        std::cout << "Partition " << m_partitionId << "/" << m_numPartitions << ": "
+                  << m_globalGnbIds.size() << " of " << numGnbs << " gNBs, "
+                  << m_globalUeIds.size() << " of " << numUes << " UEs" << std::endl;
+    }
+    else
+    {
+        m_globalGnbIds.resize(numGnbs);
+        std::iota(m_globalGnbIds.begin(), m_globalGnbIds.end(), 0);
+        m_globalUeIds.resize(numUes);
+        std::iota(m_globalUeIds.begin(), m_globalUeIds.end(), 0);
+    }
+
     // Create nodes
-    m_gnbNodes.Create(numGnbs);
-    m_ueNodes.Create(numUes);
+    m_gnbNodes.Create(m_globalGnbIds.size());
+    m_ueNodes.Create(m_globalUeIds.size());
 
     // ====================================================================
     // SMART MOBILITY INSTALLATION
@@ -104,54 +180,49 @@ NrTopologyManager::DeployTopology()
     MobilityHelper mobility;
     
     // gNBs: Always ConstantPosition (stationary)
-    std::cout << "\nInstalling ConstantPositionMobilityModel for " << numGnbs << " gNBs" << std::endl;
+    std::cout << "\nInstalling ConstantPositionMobilityModel for " << m_gnbNodes.GetN()
+              << " gNBs" << std::endl;
     mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
     mobility.Install(m_gnbNodes);
+
+    std::vector<Vector> gnbPositions;
+    for (uint32_t i = 0; i < m_gnbNodes.GetN(); ++i)
+    {
+        gnbPositions.push_back(m_gnbPositions[m_globalGnbIds[i]]);
+        m_gnbNodes.Get(i)->GetObject<MobilityModel>()->SetPosition(gnbPositions.back());
+    }
     
     // UEs: Install appropriate model based on config
-    std::cout << "Installing mobility models for " << numUes << " UEs:" << std::endl;
-    
-    // Get mobility parameters from config
-    double areaSize = m_config->topology.areaSize;
-    double bounds = areaSize / 2.0;
-    double speed = m_config->mobility.defaultSpeed;
-    std::string defaultModel = m_config->mobility.defaultModel;
+    std::cout << "Installing mobility models for " << m_ueNodes.GetN() << " UEs:" << std::endl;
     
     uint32_t waypointUes = 0;
     uint32_t randomWalkUes = 0;
     uint32_t staticUes = 0;
     
-    for (uint32_t ueId = 0; ueId < numUes; ++ueId)
+    std::vector<Vector> uePositions;
+    for (uint32_t i = 0; i < m_ueNodes.GetN(); ++i)
     {
-        Ptr<Node> ueNode = m_ueNodes.Get(ueId);
+        Ptr<Node> ueNode = m_ueNodes.Get(i);
+        uint32_t ueId = m_globalUeIds[i];
         
-        if (m_config->HasUeWaypoints(ueId))
+        SetUeMobilityModel(mobility, ueId);
+        std::string model = mobility.GetMobilityModelType();
+        if (model == "ns3::WaypointMobilityModel")
         {
-            // This UE has waypoints → WaypointMobilityModel
-            // Waypoints will be added later by MobilityManager
-            mobility.SetMobilityModel("ns3::WaypointMobilityModel");
-            mobility.Install(ueNode);
             waypointUes++;
         }
-        else if (defaultModel == "RandomWalk" || defaultModel == "RandomWalk2d")
+        else if (model == "ns3::RandomWalk2dMobilityModel")
         {
-            // RandomWalk → Configure and install
-            mobility.SetMobilityModel(
-                "ns3::RandomWalk2dMobilityModel",
-                "Bounds", RectangleValue(Rectangle(0.0, areaSize, 0.0, areaSize)),     
-                "Speed", StringValue("ns3::ConstantRandomVariable[Constant=" + std::to_string(speed) + "]"),
-                "Distance", DoubleValue(50.0)
-            );
-            mobility.Install(ueNode);
             randomWalkUes++;
         }
         else
         {
-            // Static or unknown → ConstantPosition
-            mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-            mobility.Install(ueNode);
             staticUes++;
         }
+        mobility.Install(ueNode);
+
+        uePositions.push_back(m_uePositions[ueId]);
+        ueNode->GetObject<MobilityModel>()->SetPosition(uePositions.back());
     }
     
     std::cout << "Mobility models installed:" << std::endl;
@@ -159,21 +230,9 @@ NrTopologyManager::DeployTopology()
     std::cout << "  RandomWalk: " << randomWalkUes << " UEs" << std::endl;
     std::cout << "  Static: " << staticUes << " UEs" << std::endl;
 
-    std::cout << "\n [nr-topology-manager] topology.useFilePositions = "
-              << (m_config->topology.useFilePositions ? "true" : "false") << std::endl;
-    // Deploy positions based on configuration
-    if (m_config->topology.useFilePositions)
-    {
-        DeployFromFile();
-    }
-    else
-    {
-        DeployHexagonal();
-    }
-
-    // IMPORTANT: Override initial positions for UEs with waypoints
-    // This ensures UEs start at the first waypoint of their path
-    SetInitialPositionsFromWaypoints();
+    // Positions of the created nodes only, in local id order
+    m_gnbPositions = gnbPositions;
+    m_uePositions = uePositions;
     
     m_deployed = true;
     
@@ -184,6 +243,35 @@ NrTopologyManager::DeployTopology()
     std::cout << "========================================\n" << std::endl;
 }
 
+void
+NrTopologyManager::SetUeMobilityModel(MobilityHelper& mobility, uint32_t ueId) const
+{
+    double areaSize = m_config->topology.areaSize;
+    double speed = m_config->mobility.defaultSpeed;
+    std::string defaultModel = m_config->mobility.defaultModel;
+
+    if (m_config->HasUeWaypoints(ueId))
+    {
+        // This UE has waypoints → WaypointMobilityModel
+        // Waypoints will be added later by MobilityManager
+        mobility.SetMobilityModel("ns3::WaypointMobilityModel");
+    }
+    else if (defaultModel == "RandomWalk" || defaultModel == "RandomWalk2d")
+    {
+        mobility.SetMobilityModel(
+            "ns3::RandomWalk2dMobilityModel",
+            "Bounds", RectangleValue(Rectangle(0.0, areaSize, 0.0, areaSize)),
+            "Speed", StringValue("ns3::ConstantRandomVariable[Constant=" + std::to_string(speed) + "]"),
+            "Distance", DoubleValue(50.0)
+        );
+    }
+    else
+    {
+        // Static or unknown → ConstantPosition
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    }
+}
+
 void
 NrTopologyManager::DeployFromFile()
 {
@@ -200,7 +288,7 @@ NrTopologyManager::DeployFromFile()
     }
     
     // Read gNB positions
-    uint32_t numGnbs = m_gnbNodes.GetN();
+    uint32_t numGnbs = m_config->topology.gnbCount;
     for (uint32_t i = 0; i < numGnbs; ++i)
     {
         double x, y, z;
@@ -212,15 +300,11 @@ NrTopologyManager::DeployFromFile()
         Vector pos(x, y, z);
         m_gnbPositions.push_back(pos);
         
-        Ptr<MobilityModel> mobility = m_gnbNodes.Get(i)->GetObject<MobilityModel>();
-        NS_ASSERT(mobility != nullptr);
-        mobility->SetPosition(pos);
-        
         std::cout << "  gNB " << i << ": (" << x << ", " << y << ", " << z << ")" << std::endl;
     }
     
     // Read UE positions
-    uint32_t numUes = m_ueNodes.GetN();
+    uint32_t numUes = m_config->topology.ueCount;
     for (uint32_t i = 0; i < numUes; ++i)
     {
         double x, y, z;
@@ -232,10 +316,6 @@ NrTopologyManager::DeployFromFile()
         Vector pos(x, y, z);
         m_uePositions.push_back(pos);
         
-        Ptr<MobilityModel> mobility = m_ueNodes.Get(i)->GetObject<MobilityModel>();
-        NS_ASSERT(mobility != nullptr);
-        mobility->SetPosition(pos);
-        
         std::cout << "  UE " << i << ": (" << x << ", " << y << ", " << z << ")" << std::endl;
     }
     
@@ -259,7 +339,7 @@ NrTopologyManager::DeployHexagonal()
     // Standard 3GPP hexagonal layout with ISD (Inter-Site Distance)
     // ====================================================================
     
-    uint32_t numGnbs = m_gnbNodes.GetN();
+    uint32_t numGnbs = m_config->topology.gnbCount;
     double centerX = areaSize / 2.0;
     double centerY = areaSize / 2.0;
     
@@ -281,10 +361,6 @@ NrTopologyManager::DeployHexagonal()
         Vector pos(centerX, centerY, gnbHeight);
         m_gnbPositions.push_back(pos);
         
-        Ptr<MobilityModel> mobility = m_gnbNodes.Get(0)->GetObject<MobilityModel>();
-        NS_ASSERT(mobility != nullptr);
-        mobility->SetPosition(pos);
-        
         std::cout << "  gNB 0: (" << pos.x << ", " << pos.y << ", " << pos.z 
                   << ") [center]" << std::endl;
     }
@@ -295,10 +371,6 @@ NrTopologyManager::DeployHexagonal()
         Vector centerPos(centerX, centerY, gnbHeight);
         m_gnbPositions.push_back(centerPos);
         
-        Ptr<MobilityModel> mobility = m_gnbNodes.Get(0)->GetObject<MobilityModel>();
-        NS_ASSERT(mobility != nullptr);
-        mobility->SetPosition(centerPos);
-        
         std::cout << "  gNB 0: (" << centerPos.x << ", " << centerPos.y << ", " 
                   << centerPos.z << ") [center]" << std::endl;
         
@@ -312,10 +384,6 @@ NrTopologyManager::DeployHexagonal()
             Vector pos(x, y, gnbHeight);
             m_gnbPositions.push_back(pos);
             
-            mobility = m_gnbNodes.Get(i)->GetObject<MobilityModel>();
-            NS_ASSERT(mobility != nullptr);
-            mobility->SetPosition(pos);
-            
             std::cout << "  gNB " << i << ": (" 
                       << std::fixed << std::setprecision(2)
                       << pos.x << ", " << pos.y << ", " << pos.z 
@@ -330,10 +398,6 @@ NrTopologyManager::DeployHexagonal()
         Vector centerPos(centerX, centerY, gnbHeight);
         m_gnbPositions.push_back(centerPos);
         
-        Ptr<MobilityModel> mobility = m_gnbNodes.Get(0)->GetObject<MobilityModel>();
-        NS_ASSERT(mobility != nullptr);
-        mobility->SetPosition(centerPos);
-        
         std::cout << "  gNB 0: (" << centerPos.x << ", " << centerPos.y << ", " 
                   << centerPos.z << ") [center]" << std::endl;
         
@@ -347,10 +411,6 @@ NrTopologyManager::DeployHexagonal()
             Vector pos(x, y, gnbHeight);
             m_gnbPositions.push_back(pos);
             
-            mobility = m_gnbNodes.Get(i)->GetObject<MobilityModel>();
-            NS_ASSERT(mobility != nullptr);
-            mobility->SetPosition(pos);
-            
             std::cout << "  gNB " << i << ": (" 
                       << std::fixed << std::setprecision(2)
                       << pos.x << ", " << pos.y << ", " << pos.z 
@@ -368,10 +428,6 @@ NrTopologyManager::DeployHexagonal()
             Vector pos(x, y, gnbHeight);
             m_gnbPositions.push_back(pos);
             
-            mobility = m_gnbNodes.Get(i)->GetObject<MobilityModel>();
-            NS_ASSERT(mobility != nullptr);
-            mobility->SetPosition(pos);
-            
             std::cout << "  gNB " << i << ": (" 
                       << std::fixed << std::setprecision(2)
                       << pos.x << ", " << pos.y << ", " << pos.z 
@@ -400,10 +456,6 @@ NrTopologyManager::DeployHexagonal()
                 Vector pos(x, y, gnbHeight);
                 m_gnbPositions.push_back(pos);
                 
-                Ptr<MobilityModel> mobility = m_gnbNodes.Get(idx)->GetObject<MobilityModel>();
-                NS_ASSERT(mobility != nullptr);
-                mobility->SetPosition(pos);
-                
                 std::cout << "  gNB " << idx << ": (" 
                           << std::fixed << std::setprecision(2)
                           << pos.x << ", " << pos.y << ", " << pos.z 
@@ -417,7 +469,7 @@ NrTopologyManager::DeployHexagonal()
     // UE DEPLOYMENT
     // ====================================================================
     
-    uint32_t numUes = m_ueNodes.GetN();
+    uint32_t numUes = m_config->topology.ueCount;
     std::string strategy = m_config->topology.uePlacementStrategy;
     
     std::cout << "\nUE deployment:" << std::endl;
@@ -442,10 +494,6 @@ NrTopologyManager::DeployHexagonal()
             Vector pos(randX->GetValue(), randY->GetValue(), ueHeight);
             m_uePositions.push_back(pos);
             
-            Ptr<MobilityModel> mobility = m_ueNodes.Get(i)->GetObject<MobilityModel>();
-            NS_ASSERT(mobility != nullptr);
-            mobility->SetPosition(pos);
-            
             if (i < 5 || i >= numUes - 2)  // Show first 5 and last 2 UEs
             {
                 std::cout << "  UE " << i << ": (" 
@@ -495,10 +543,6 @@ NrTopologyManager::DeployHexagonal()
                 Vector pos(col * spacing, row * spacing, ueHeight);
                 m_uePositions.push_back(pos);
                 
-                Ptr<MobilityModel> mobility = m_ueNodes.Get(idx)->GetObject<MobilityModel>();
-                NS_ASSERT(mobility != nullptr);
-                mobility->SetPosition(pos);
-                
                 if (idx < 3 || idx >= numUes - 2)
                 {
                     std::cout << "  UE " << idx << ": (" 
@@ -526,10 +570,6 @@ NrTopologyManager::DeployHexagonal()
                       ueHeight);
             m_uePositions.push_back(pos);
             
-            Ptr<MobilityModel> mobility = m_ueNodes.Get(i)->GetObject<MobilityModel>();
-            NS_ASSERT(mobility != nullptr);
-            mobility->SetPosition(pos);
-            
             if (i < 3 || i >= numUes - 2)
             {
                 std::cout << "  UE " << i << ": (" 
@@ -554,7 +594,7 @@ NrTopologyManager::SetInitialPositionsFromWaypoints()
     
     std::cout << "\n--- Setting initial positions from waypoints ---" << std::endl;
     
-    uint32_t numUes = m_ueNodes.GetN();
+    uint32_t numUes = m_config->topology.ueCount;
     uint32_t waypointOverrides = 0;
     
     for (uint32_t ueId = 0; ueId < numUes; ++ueId)
@@ -567,10 +607,6 @@ NrTopologyManager::SetInitialPositionsFromWaypoints()
             {
                 // Set UE position to first waypoint
                 Vector firstWaypoint = wpConfig.waypoints[0];
-                
-                Ptr<MobilityModel> mobility = m_ueNodes.Get(ueId)->GetObject<MobilityModel>();
-                NS_ASSERT(mobility != nullptr);
-                mobility->SetPosition(firstWaypoint);
                 std::cout << "  [nr-topology-manager] UE " << ueId 
                           << " position overridden to first waypoint." << std::endl;
                 
@@ -643,4 +679,170 @@ NrTopologyManager::GetUePositions() const
     return m_uePositions;
 }
 
-} // namespace ns3
\ No newline at end of file
+// ============================================================================
+// CELL GEOMETRY
+// ============================================================================
+
+std::vector<NrTopologyManager::UeCellGeometry>
+NrTopologyManager::ComputeCellGeometry() const
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(!m_deployed, "Topology must be deployed before classifying cells");
+
+    uint32_t numGnbs = m_gnbNodes.GetN();
+    std::vector<Vector> gnbPos(numGnbs);
+    for (uint32_t g = 0; g < numGnbs; ++g)
+    {
+        gnbPos[g] = m_gnbNodes.Get(g)->GetObject<MobilityModel>()->GetPosition();
+    }
+
+    std::vector<UeCellGeometry> geometry(m_ueNodes.GetN());
+    for (uint32_t u = 0; u < m_ueNodes.GetN(); ++u)
+    {
+        Vector pos = m_ueNodes.Get(u)->GetObject<MobilityModel>()->GetPosition();
+        double best = std::numeric_limits<double>::max();
+        double second = std::numeric_limits<double>::max();
+        for (uint32_t g = 0; g < numGnbs; ++g)
+        {
+            double d = CalculateDistance(pos, gnbPos[g]);
+            if (d < best)
+            {
+                second = best;
+                geometry[u].neighbourGnb = geometry[u].servingGnb;
+                best = d;
+                geometry[u].servingGnb = g;
+            }
+            else if (d < second)
+            {
+                second = d;
+                geometry[u].neighbourGnb = g;
+            }
+        }
+        if (numGnbs < 2)
+        {
+            geometry[u].neighbourGnb = geometry[u].servingGnb;
+        }
+        else if (second > 0.0)
+        {
+            geometry[u].distanceRatio = best / second;
+        }
+    }
+
+    return geometry;
+}
+
+// ============================================================================
+// SPATIAL PARTITIONING
+// ============================================================================
+
+NrTopologyManager::SpatialPartition
+NrTopologyManager::ComputeSpatialPartition(uint32_t numPartitions) const
+{
+    NS_LOG_FUNCTION(this << numPartitions);
+
+    uint32_t numGnbs = m_gnbPositions.size();
+    uint32_t numUes = m_uePositions.size();
+    NS_ABORT_MSG_IF(numPartitions == 0 || numPartitions > numGnbs,
+                    "Cannot split " << numGnbs << " gNBs into " << numPartitions
+                                    << " partitions");
+
+    const std::vector<Vector>& gnbPos = m_gnbPositions;
+
+    // Nearest-site association: a site's weight is itself plus its UEs
+    std::vector<uint32_t> nearest(numUes, 0);
+    std::vector<double> weight(numGnbs, 1.0);
+    for (uint32_t u = 0; u < numUes; ++u)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (uint32_t g = 0; g < numGnbs; ++g)
+        {
+            double d = CalculateDistance(m_uePositions[u], gnbPos[g]);
+            if (d < best)
+            {
+                best = d;
+                nearest[u] = g;
+            }
+        }
+        weight[nearest[u]] += 1.0;
+    }
+
+    SpatialPartition result;
+    result.numPartitions = numPartitions;
+    result.gnbPartition.assign(numGnbs, 0);
+    result.uePartition.assign(numUes, 0);
+
+    std::vector<uint32_t> sites(numGnbs);
+    std::iota(sites.begin(), sites.end(), 0);
+
+    using SiteIt = std::vector<uint32_t>::iterator;
+    std::function<void(SiteIt, SiteIt, uint32_t, uint32_t)> bisect =
+        [&](SiteIt first, SiteIt last, uint32_t parts, uint32_t firstId) {
+            if (parts == 1)
+            {
+                for (SiteIt it = first; it != last; ++it)
+                {
+                    result.gnbPartition[*it] = firstId;
+                }
+                return;
+            }
+
+            // Cut across the longer side of the bounding box
+            double minX = std::numeric_limits<double>::max(), maxX = -minX;
+            double minY = minX, maxY = -minX;
+            double total = 0.0;
+            for (SiteIt it = first; it != last; ++it)
+            {
+                minX = std::min(minX, gnbPos[*it].x);
+                maxX = std::max(maxX, gnbPos[*it].x);
+                minY = std::min(minY, gnbPos[*it].y);
+                maxY = std::max(maxY, gnbPos[*it].y);
+                total += weight[*it];
+            }
+            bool alongX = (maxX - minX) >= (maxY - minY);
+            std::sort(first, last, [&](uint32_t a, uint32_t b) {
+                return alongX ? gnbPos[a].x < gnbPos[b].x : gnbPos[a].y < gnbPos[b].y;
+            });
+
+            uint32_t leftParts = parts / 2;
+            uint32_t rightParts = parts - leftParts;
+            double target = total * leftParts / parts;
+
+            // Split at the weighted median, leaving every side at least one site per part
+            long count = std::distance(first, last);
+            long split = 0;
+            double acc = 0.0;
+            while (split < count && acc + weight[*(first + split)] / 2.0 < target)
+            {
+                acc += weight[*(first + split)];
+                ++split;
+            }
+            split = std::max<long>(split, leftParts);
+            split = std::min<long>(split, count - rightParts);
+
+            bisect(first, first + split, leftParts, firstId);
+            bisect(first + split, last, rightParts, firstId + leftParts);
+        };
+    bisect(sites.begin(), sites.end(), numPartitions, 0);
+
+    for (uint32_t u = 0; u < numUes; ++u)
+    {
+        result.uePartition[u] = result.gnbPartition[nearest[u]];
+    }
+
+    return result;
+}
+
+const std::vector<uint32_t>&
+NrTopologyManager::GetGlobalGnbIds() const
+{
+    return m_globalGnbIds;
+}
+
+const std::vector<uint32_t>&
+NrTopologyManager::GetGlobalUeIds() const
+{
+    return m_globalUeIds;
+}
+
+} // namespace ns3
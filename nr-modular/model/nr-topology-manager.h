@@ -19,6 +19,7 @@
 namespace ns3
 {
 
+class MobilityHelper;
 class NrSimConfig;
 
 /**
@@ -49,8 +50,8 @@ class NrTopologyManager : public Object
      * @brief Deploy network topology
      * 
      * Creates nodes and positions them according to configuration:
-     * - Creates gNB nodes
-     * - Creates UE nodes
+     * - Computes gNB and UE positions for the whole deployment
+     * - Creates gNB and UE nodes (only the local partition's, see SetPartition())
      * - Installs appropriate mobility models (Waypoint/RandomWalk/Static)
      * - Sets positions for gNBs and UEs
      */
@@ -98,6 +99,63 @@ class NrTopologyManager : public Object
      */
     const std::vector<Vector>& GetUePositions() const;
 
+    // ================================================================
+    // SPATIAL SHARDING (independent multi-process runs)
+    // ================================================================
+
+    /**
+     * @brief Deploy only one spatial partition of the topology
+     *
+     * Must be called before DeployTopology(). Positions are then computed
+     * for the whole deployment, the sites are split into numPartitions
+     * spatially compact clusters (recursive coordinate bisection,
+     * balanced by nearest-site UE load; a UE belongs to the cluster of
+     * its nearest site), and only the sites and UEs of partitionId get
+     * nodes. GetGnbNodes()/GetUeNodes() and the position vectors hold the
+     * local subset; GetGlobalGnbIds()/GetGlobalUeIds() map it back.
+     *
+     * @param numPartitions Number of partitions (1..gNB count)
+     * @param partitionId Partition to deploy
+     */
+    void SetPartition(uint32_t numPartitions, uint32_t partitionId);
+
+    /**
+     * @brief Deployment-wide index of each local gNB
+     * @return Global gNB ids, indexed by local gNB id
+     */
+    const std::vector<uint32_t>& GetGlobalGnbIds() const;
+
+    /**
+     * @brief Deployment-wide index of each local UE
+     * @return Global UE ids, indexed by local UE id
+     */
+    const std::vector<uint32_t>& GetGlobalUeIds() const;
+
+    // ================================================================
+    // CELL GEOMETRY (inter-cell coordination)
+    // ================================================================
+
+    /**
+     * @brief Serving and strongest-neighbour site of a UE
+     */
+    struct UeCellGeometry
+    {
+        uint32_t servingGnb = 0;    //!< Nearest gNB (local index)
+        uint32_t neighbourGnb = 0;  //!< Second-nearest gNB (= serving if only one)
+        double distanceRatio = 0.0; //!< d_serving / d_neighbour in [0, 1]; 0 if one gNB
+    };
+
+    /**
+     * @brief Classify UEs against their nearest and second-nearest sites
+     *
+     * A distance ratio close to 1 means the UE sits near the boundary of
+     * two cells, where the neighbour's signal is nearly as strong as the
+     * serving one. Uses current node positions.
+     *
+     * @return One entry per local UE
+     */
+    std::vector<UeCellGeometry> ComputeCellGeometry() const;
+
   protected:
     void DoDispose() override;
 
@@ -111,15 +169,39 @@ class NrTopologyManager : public Object
     std::vector<Vector> m_gnbPositions;  //!< gNB positions
     std::vector<Vector> m_uePositions;   //!< UE positions
 
+    std::vector<uint32_t> m_globalGnbIds; //!< Global id of each local gNB
+    std::vector<uint32_t> m_globalUeIds;  //!< Global id of each local UE
+
+    uint32_t m_numPartitions;  //!< Partitions of the deployment
+    uint32_t m_partitionId;    //!< Partition deployed by this instance
+
+    /**
+     * @brief Assignment of sites and UEs to spatial partitions
+     */
+    struct SpatialPartition
+    {
+        uint32_t numPartitions = 1;
+        std::vector<uint32_t> gnbPartition;  //!< Partition of each gNB (global id)
+        std::vector<uint32_t> uePartition;   //!< Partition of each UE (global id)
+    };
+
+    /**
+     * @brief Split the computed positions into spatially compact partitions
+     * @param numPartitions Number of partitions (1..gNB count)
+     * @return Partition id per gNB and per UE
+     */
+    SpatialPartition ComputeSpatialPartition(uint32_t numPartitions) const;
+
     /**
-     * @brief Deploy nodes from position file
+     * @brief Read positions from position file
      * 
-     * Reads gNB and UE positions from configured file
+     * Reads gNB and UE positions from configured file into
+     * m_gnbPositions / m_uePositions
      */
     void DeployFromFile();
 
     /**
-     * @brief Deploy nodes in hexagonal pattern
+     * @brief Compute positions in hexagonal pattern
      * 
      * Places gNBs at center and UEs based on placement strategy:
      * - uniform/random: Random distribution
@@ -132,9 +214,16 @@ class NrTopologyManager : public Object
      * @brief Set initial positions for waypoint UEs
      * 
      * For UEs with configured waypoints, override their initial
-     * position to be the first waypoint in their path
+     * position (in m_uePositions) to be the first waypoint in their path
      */
     void SetInitialPositionsFromWaypoints();
+
+    /**
+     * @brief Select the configured mobility model of a UE on a helper
+     * @param mobility Helper to configure
+     * @param ueId Global UE id (waypoints are keyed by it)
+     */
+    void SetUeMobilityModel(MobilityHelper& mobility, uint32_t ueId) const;
 };
 
 } // namespace ns3
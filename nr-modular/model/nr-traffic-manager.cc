@@ -20,6 +20,7 @@
 #include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/ipv4.h"
 #include "ns3/packet-sink.h"
+#include "ns3/string.h"
 
 #include <sstream>
 #include <iostream>
@@ -122,6 +123,23 @@ NrTrafficManager::NrTrafficManager()
       m_remoteHost(nullptr)
 {
     NS_LOG_FUNCTION(this);
+
+    NrMetricsRegistry& registry = NrMetricsRegistry::Get();
+    m_dlThroughputMetric = registry.GetGauge("nr_traffic_throughput_mbps",
+                                             "Total UE throughput", "direction=\"dl\"");
+    m_ulThroughputMetric = registry.GetGauge("nr_traffic_throughput_mbps",
+                                             "Total UE throughput", "direction=\"ul\"");
+    m_packetsSentMetric = registry.GetGauge("nr_traffic_packets",
+                                            "UE packets since traffic start", "state=\"sent\"");
+    m_packetsReceivedMetric = registry.GetGauge("nr_traffic_packets",
+                                                "UE packets since traffic start",
+                                                "state=\"received\"");
+    m_packetsLostMetric = registry.GetGauge("nr_traffic_packets",
+                                            "UE packets since traffic start", "state=\"lost\"");
+    m_delayMetric = registry.GetGauge("nr_traffic_avg_delay_ms",
+                                      "Packet-weighted mean delay over DL and UL");
+    m_simTimeMetric = registry.GetGauge("nr_simulation_time_seconds",
+                                        "Simulation time of the last traffic sample");
 }
 
 NrTrafficManager::~NrTrafficManager()
@@ -183,6 +201,19 @@ NrTrafficManager::InstallTraffic(const NodeContainer& gnbNodes,
     std::cout << "  DL: " << dlRate << " (" << dlPacketSize << " bytes)" << std::endl;
     std::cout << "  UL: " << ulRate << " (" << ulPacketSize << " bytes)" << std::endl;
 
+    // Sparse traffic: constant-rate bursts separated by exponential gaps
+    // (OnOff starts in its off state, so first bursts are spread too)
+    bool sparse = m_config->traffic.burstInterval > 0.0;
+    std::string onTime = "ns3::ConstantRandomVariable[Constant=" +
+                         std::to_string(m_config->traffic.burstDuration) + "]";
+    std::string offTime = "ns3::ExponentialRandomVariable[Mean=" +
+                          std::to_string(m_config->traffic.burstInterval) + "]";
+    if (sparse)
+    {
+        std::cout << "  Bursts of " << m_config->traffic.burstDuration << " s every ~"
+                  << m_config->traffic.burstInterval << " s per flow" << std::endl;
+    }
+
     // Get UE IP addresses
     Ipv4InterfaceContainer ueIpIfaces = m_networkManager->GetUeIpInterfaces();
     
@@ -249,8 +280,8 @@ NrTrafficManager::InstallTraffic(const NodeContainer& gnbNodes,
     // Install traffic applications
     std::cout << "\nInstalling traffic applications..." << std::endl;
     
-    uint16_t dlPort = 10000;
-    uint16_t ulPort = 20000;
+    uint16_t dlPort = DL_PORT_BASE;
+    uint16_t ulPort = UL_PORT_BASE;
     // Read startTime from config; fall back to 0.5s (safe minimum after RRC attach ~20ms)
     double startTime = (m_config->traffic.startTime > 0.0)
                         ? m_config->traffic.startTime
@@ -277,6 +308,11 @@ NrTrafficManager::InstallTraffic(const NodeContainer& gnbNodes,
 
         dlClient.SetConstantRate(DataRate(dlRate));
         dlClient.SetAttribute("PacketSize", UintegerValue(dlPacketSize));
+        if (sparse)
+        {
+            dlClient.SetAttribute("OnTime", StringValue(onTime));
+            dlClient.SetAttribute("OffTime", StringValue(offTime));
+        }
         
         m_dlClientApps.Add(dlClient.Install(remoteHost));
         
@@ -302,6 +338,11 @@ NrTrafficManager::InstallTraffic(const NodeContainer& gnbNodes,
                             
         ulClient.SetConstantRate(DataRate(ulRate));
         ulClient.SetAttribute("PacketSize", UintegerValue(ulPacketSize));
+        if (sparse)
+        {
+            ulClient.SetAttribute("OnTime", StringValue(onTime));
+            ulClient.SetAttribute("OffTime", StringValue(offTime));
+        }
         
         m_ulClientApps.Add(ulClient.Install(ueNodes.Get(i)));
         
@@ -824,6 +865,14 @@ NrTrafficManager::ComputeAggregateMetrics()
             static_cast<double>(m_aggregateMetrics.totalPacketsLost) / m_aggregateMetrics.totalPacketsSent;
     }
 
+    m_dlThroughputMetric->Set(m_aggregateMetrics.totalDlThroughputMbps);
+    m_ulThroughputMetric->Set(m_aggregateMetrics.totalUlThroughputMbps);
+    m_packetsSentMetric->Set(static_cast<double>(m_aggregateMetrics.totalPacketsSent));
+    m_packetsReceivedMetric->Set(static_cast<double>(m_aggregateMetrics.totalPacketsReceived));
+    m_packetsLostMetric->Set(static_cast<double>(m_aggregateMetrics.totalPacketsLost));
+    m_delayMetric->Set(m_aggregateMetrics.avgSystemDelayMs);
+    m_simTimeMetric->Set(Simulator::Now().GetSeconds());
+
     if (m_config->debug.enableDebugLogs)
     {
         std::cout << "  ✓ Aggregate metrics computed" << std::endl;
@@ -864,6 +913,32 @@ NrTrafficManager::GetAggregateMetrics() const
     return m_aggregateMetrics;
 }
 
+std::vector<NrMemoryItem>
+NrTrafficManager::GetMemoryUsage() const
+{
+    using Mem = NrMemoryProfiler;
+    std::vector<NrMemoryItem> items;
+
+    items.push_back({"ue_metrics",
+                     Mem::TreeBytes(m_ueMetrics) + Mem::TreeBytes(m_previousMetrics) +
+                         Mem::VectorBytes(m_lastDlRxBytes) + Mem::VectorBytes(m_lastUlRxBytes),
+                     m_ueMetrics.size(),
+                     "UEs"});
+
+    uint64_t apps = 0;
+    for (const ApplicationContainer* container : {&m_dlServerApps,
+                                                  &m_dlClientApps,
+                                                  &m_ulServerApps,
+                                                  &m_ulClientApps,
+                                                  &m_serverApps,
+                                                  &m_clientApps})
+    {
+        apps += container->GetN();
+    }
+    items.push_back({"app_containers", apps * sizeof(Ptr<Application>), apps, "apps"});
+    return items;
+}
+
 ApplicationContainer
 NrTrafficManager::GetServerApps() const
 {
@@ -900,6 +975,12 @@ NrTrafficManager::GetUlClientApps() const
     return m_ulClientApps;
 }
 
+double
+NrTrafficManager::GetTrafficStartTime() const
+{
+    return m_trafficStartTime;
+}
+
 bool
 NrTrafficManager::IsInstalled() const
 {
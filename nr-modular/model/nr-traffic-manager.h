@@ -15,6 +15,8 @@
 #include "ns3/flow-monitor.h"
 #include "ns3/ipv4-flow-classifier.h"
 #include "nr-network-manager.h"
+#include "utils/nr-metrics-registry.h"
+#include "utils/nr-memory-profiler.h"
 
 #include <map>
 #include <vector>
@@ -103,6 +105,11 @@ class NrTrafficManager : public Object
 public:
     static TypeId GetTypeId();
 
+    /// UE i receives DL traffic on DL_PORT_BASE + i
+    static constexpr uint16_t DL_PORT_BASE = 10000;
+    /// The remote host receives UE i's UL traffic on UL_PORT_BASE + i
+    static constexpr uint16_t UL_PORT_BASE = 20000;
+
     NrTrafficManager();
     ~NrTrafficManager() override;
 
@@ -172,6 +179,13 @@ public:
     PerUeMetrics GetUeMetrics(uint32_t ueId) const;
     std::map<uint32_t, PerUeMetrics> GetAllUeMetrics() const;
     AggregateMetrics GetAggregateMetrics() const;
+
+    /**
+     * @brief Estimate the memory held by per-UE metrics and app containers
+     * @return Per-container bytes (the application objects themselves are
+     *         charged to the "traffic" profiling scope)
+     */
+    std::vector<NrMemoryItem> GetMemoryUsage() const;
     
     ApplicationContainer GetDlClientApps() const;
     ApplicationContainer GetDlServerApps() const;
@@ -179,6 +193,12 @@ public:
     ApplicationContainer GetUlServerApps() const;
     ApplicationContainer GetServerApps() const;
     ApplicationContainer GetClientApps() const;
+
+    /**
+     * @brief Get the time the traffic sinks start
+     * @return Seconds (valid after InstallTraffic())
+     */
+    double GetTrafficStartTime() const;
     
     bool IsInstalled() const;
     bool IsCollected() const;
@@ -249,6 +269,15 @@ private:
     std::map<uint32_t, PerUeMetrics> m_previousMetrics;  // For calculating instantaneous rates
     AggregateMetrics m_aggregateMetrics;
     
+    // Registry gauges, refreshed with every aggregate computation
+    NrMetricGauge* m_dlThroughputMetric;
+    NrMetricGauge* m_ulThroughputMetric;
+    NrMetricGauge* m_packetsSentMetric;
+    NrMetricGauge* m_packetsReceivedMetric;
+    NrMetricGauge* m_packetsLostMetric;
+    NrMetricGauge* m_delayMetric;
+    NrMetricGauge* m_simTimeMetric;
+    
     // State
     bool m_installed;
     bool m_metricsCollected;
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Background Writer - Implementation File
+ */
+
+#include "nr-background-writer.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NrBackgroundWriter::NrBackgroundWriter(size_t maxPending)
+    : m_maxPending(std::max<size_t>(1, maxPending)),
+      m_busy(false),
+      m_stop(false)
+{
+    m_thread = std::thread(&NrBackgroundWriter::Loop, this);
+}
+
+NrBackgroundWriter::~NrBackgroundWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void
+NrBackgroundWriter::Post(Job job)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_jobs.size() < m_maxPending; });
+        m_jobs.push_back(std::move(job));
+    }
+    m_wake.notify_one();
+}
+
+void
+NrBackgroundWriter::Drain()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_jobs.empty() && !m_busy; });
+    if (m_error)
+    {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void
+NrBackgroundWriter::Loop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if (m_jobs.empty())
+        {
+            return;  // Stop requested and nothing left to run
+        }
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_busy = true;
+        lock.unlock();
+        m_idle.notify_all();
+
+        try
+        {
+            job();
+        }
+        catch (...)
+        {
+            lock.lock();
+            if (!m_error)
+            {
+                m_error = std::current_exception();
+            }
+            lock.unlock();
+        }
+
+        lock.lock();
+        m_busy = false;
+        m_idle.notify_all();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Background Writer - Header File
+ *
+ * One thread that runs posted jobs in order, so output encoding and file
+ * writes (compression, fwrite, fsync) stay off the simulator thread. The
+ * queue is bounded: Post() waits when the thread falls too far behind,
+ * which caps the memory held by pending output.
+ *
+ * Jobs must not touch ns-3 objects or the scheduler (see NrWorkerPool).
+ */
+
+#ifndef NR_BACKGROUND_WRITER_H
+#define NR_BACKGROUND_WRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ns3
+{
+
+/**
+ * \brief Single-thread ordered job queue for output
+ */
+class NrBackgroundWriter
+{
+  public:
+    /// Queued job
+    using Job = std::function<void()>;
+
+    /**
+     * \brief Start the thread
+     * \param maxPending Jobs queued before Post() waits
+     */
+    explicit NrBackgroundWriter(size_t maxPending = 4);
+
+    /**
+     * \brief Run the remaining jobs and join the thread
+     */
+    ~NrBackgroundWriter();
+
+    NrBackgroundWriter(const NrBackgroundWriter&) = delete;
+    NrBackgroundWriter& operator=(const NrBackgroundWriter&) = delete;
+
+    /**
+     * \brief Queue a job
+     * \param job Job (runs after all previously posted jobs)
+     */
+    void Post(Job job);
+
+    /**
+     * \brief Wait until every posted job has run
+     *
+     * Rethrows the first exception thrown by a job since the last Drain().
+     */
+    void Drain();
+
+  private:
+    /**
+     * \brief Thread loop
+     */
+    void Loop();
+
+    std::thread m_thread;            ///< Writer thread
+    std::mutex m_mutex;              ///< Guards the fields below
+    std::condition_variable m_wake;  ///< Signals a job (or stop) to the thread
+    std::condition_variable m_idle;  ///< Signals progress to waiting posters
+    std::deque<Job> m_jobs;          ///< Queued jobs
+    size_t m_maxPending;             ///< Queue bound
+    bool m_busy;                     ///< A job is running
+    bool m_stop;                     ///< Shutdown request
+    std::exception_ptr m_error;      ///< First exception of a job
+};
+
+} // namespace ns3
+
+#endif /* NR_BACKGROUND_WRITER_H */
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Binary Trace - Implementation File
+ */
+
+#include "nr-binary-trace.h"
+
+#include "ns3/log.h"
+
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrBinaryTrace");
+
+namespace
+{
+
+const char TRACE_MAGIC[8] = {'N', 'R', 'T', 'R', 'A', 'C', 'E', '\0'};
+
+/// Raw bytes collected before a block is compressed (about 20k-30k records)
+constexpr size_t TRACE_BLOCK_BYTES = 1 << 20;
+
+/**
+ * Record size of a kind in this build (0 for unknown kinds)
+ */
+size_t
+RecordBytes(NrTraceKind kind)
+{
+    switch (kind)
+    {
+    case NrTraceKind::DCI:
+        return sizeof(NrDciTraceRecord);
+    case NrTraceKind::TB:
+        return sizeof(NrTbTraceRecord);
+    case NrTraceKind::RLC:
+        return sizeof(NrRlcTraceRecord);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Copy a record out of a (possibly unaligned) block
+ */
+template <typename Record>
+Record
+Load(const uint8_t* bytes)
+{
+    Record record;
+    std::memcpy(&record, bytes, sizeof(Record));
+    return record;
+}
+
+const char*
+DirectionName(uint8_t direction)
+{
+    return direction == static_cast<uint8_t>(NrTraceDirection::UL) ? "UL" : "DL";
+}
+
+} // namespace
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+NrBinaryTraceWriter::NrBinaryTraceWriter()
+    : m_log()
+{
+}
+
+bool
+NrBinaryTraceWriter::Open(const std::string& path, NrTraceKind kind, uint16_t recordBytes)
+{
+    NS_LOG_FUNCTION(this << path << static_cast<uint16_t>(kind) << recordBytes);
+
+    if (!m_log.Open(path, TRACE_BLOCK_BYTES))
+    {
+        return false;
+    }
+    NrTraceFileHeader header;
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.kind = static_cast<uint16_t>(kind);
+    header.recordBytes = recordBytes;
+    header.byteOrder = BYTE_ORDER_MARK;
+    m_log.Append(&header, sizeof(header));
+    return true;
+}
+
+bool
+NrBinaryTraceWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    return m_log.Close();
+}
+
+// ============================================================================
+// CONVERTER
+// ============================================================================
+
+const char*
+NrBinaryTrace::GetKindName(NrTraceKind kind)
+{
+    switch (kind)
+    {
+    case NrTraceKind::DCI:
+        return "dci";
+    case NrTraceKind::TB:
+        return "tb";
+    case NrTraceKind::RLC:
+        return "rlc";
+    default:
+        return "unknown";
+    }
+}
+
+bool
+NrBinaryTrace::ConvertToText(const std::string& path, std::ostream& os, std::string* error)
+{
+    std::string reason;
+    bool haveHeader = false;
+    NrTraceKind kind = NrTraceKind::DCI;
+    size_t recordBytes = 0;
+    std::vector<uint8_t> pending;  // Bytes of a record split across blocks
+
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+
+    bool ok = NrCompressedLog::ForEachBlock(path, [&](const uint8_t* data, size_t size) {
+        pending.insert(pending.end(), data, data + size);
+        size_t at = 0;
+        if (!haveHeader)
+        {
+            if (pending.size() < sizeof(NrTraceFileHeader))
+            {
+                return true;
+            }
+            auto header = Load<NrTraceFileHeader>(pending.data());
+            kind = static_cast<NrTraceKind>(header.kind);
+            recordBytes = header.recordBytes;
+            if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0)
+            {
+                reason = "not a binary trace file";
+            }
+            else if (header.byteOrder != NrBinaryTraceWriter::BYTE_ORDER_MARK)
+            {
+                reason = "written with a different byte order";
+            }
+            else if (header.version != NrBinaryTraceWriter::VERSION ||
+                     RecordBytes(kind) == 0 || RecordBytes(kind) != recordBytes)
+            {
+                reason = "unsupported trace kind " + std::to_string(header.kind) +
+                         " / version " + std::to_string(header.version);
+            }
+            if (!reason.empty())
+            {
+                return false;
+            }
+            haveHeader = true;
+            at = sizeof(NrTraceFileHeader);
+            PrintColumns(kind, os);
+        }
+        for (; at + recordBytes <= pending.size(); at += recordBytes)
+        {
+            PrintRecord(kind, pending.data() + at, os);
+        }
+        pending.erase(pending.begin(), pending.begin() + at);
+        return true;
+    });
+
+    os.flags(flags);
+    os.precision(precision);
+    if (ok && !haveHeader)
+    {
+        reason = "empty trace file";
+        ok = false;
+    }
+    else if (ok && !pending.empty())
+    {
+        reason = "truncated last record";
+        ok = false;
+    }
+    else if (!ok && reason.empty())
+    {
+        reason = "unreadable or damaged file";
+    }
+    if (!ok && error != nullptr)
+    {
+        *error = reason;
+    }
+    return ok;
+}
+
+void
+NrBinaryTrace::PrintColumns(NrTraceKind kind, std::ostream& os)
+{
+    switch (kind)
+    {
+    case NrTraceKind::DCI:
+        os << "Time\tdir\tframe\tsubF\tslot\t1stSym\tnSymbol\tcellId\tbwpId\trnti\ttbSize\tmcs"
+              "\trank\tharqId\tndi\trv\n";
+        break;
+    case NrTraceKind::TB:
+        os << "Time\tdir\tframe\tsubF\tslot\t1stSym\tnSymbol\tcellId\tbwpId\trnti\ttbSize\tmcs"
+              "\trank\trv\tSINR(dB)\tminSINR(dB)\tCQI\tnRBs\tcorrupt\tTBler\n";
+        break;
+    case NrTraceKind::RLC:
+        os << "Time\tevent\tside\tnodeId\trnti\tlcid\tsize\tdelay(s)\n";
+        break;
+    }
+}
+
+void
+NrBinaryTrace::PrintRecord(NrTraceKind kind, const uint8_t* record, std::ostream& os)
+{
+    os << std::fixed;
+    switch (kind)
+    {
+    case NrTraceKind::DCI: {
+        auto r = Load<NrDciTraceRecord>(record);
+        os << std::setprecision(9) << r.time << '\t' << DirectionName(r.direction) << '\t'
+           << r.frame << '\t' << +r.subframe << '\t' << +r.slot << '\t' << +r.symStart << '\t'
+           << +r.numSym << '\t' << r.cellId << '\t' << +r.bwpId << '\t' << r.rnti << '\t'
+           << r.tbSize << '\t' << +r.mcs << '\t' << +r.rank << '\t' << +r.harqId << '\t'
+           << +r.ndi << '\t' << +r.rv << '\n';
+        break;
+    }
+    case NrTraceKind::TB: {
+        auto r = Load<NrTbTraceRecord>(record);
+        os << std::setprecision(9) << r.time << '\t' << DirectionName(r.direction) << '\t'
+           << r.frame << '\t' << +r.subframe << '\t' << +r.slot << '\t' << +r.symStart << '\t'
+           << +r.numSym << '\t' << r.cellId << '\t' << +r.bwpId << '\t' << r.rnti << '\t'
+           << r.tbSize << '\t' << +r.mcs << '\t' << +r.rank << '\t' << +r.rv << '\t'
+           << std::setprecision(2) << r.sinrDb << '\t' << r.sinrMinDb << '\t' << +r.cqi << '\t'
+           << r.rbs << '\t' << +r.corrupt << '\t' << std::setprecision(6) << r.tbler << '\n';
+        break;
+    }
+    case NrTraceKind::RLC: {
+        auto r = Load<NrRlcTraceRecord>(record);
+        os << std::setprecision(9) << r.time << '\t'
+           << (r.event == NrRlcTraceRecord::TX ? "TX" : "RX") << '\t'
+           << (r.atGnb ? "gNB" : "UE") << '\t' << r.nodeId << '\t' << r.rnti << '\t' << +r.lcid
+           << '\t' << r.size << '\t' << r.delayNs * 1e-9 << '\n';
+        break;
+    }
+    }
+}
+
+} // namespace ns3
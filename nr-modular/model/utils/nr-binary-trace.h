@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Binary Trace - Header File
+ *
+ * Fixed-size binary records for the common 5G-LENA traces, as a cheap
+ * replacement for the NrHelper text traces (metrics.binaryTraces):
+ *
+ *   DCI  gNB MAC DlScheduling / UlScheduling     (NrDciTraceRecord)
+ *   TB   SpectrumPhy RxPacketTraceUe / ...Gnb    (NrTbTraceRecord)
+ *   RLC  NrRlc TxPDU / RxPDU at UE and gNB       (NrRlcTraceRecord)
+ *
+ * Each trace kind goes to its own NrCompressedLog, so records are copied
+ * into a block on the simulator thread and compressed and written on a
+ * background thread. The first record of a file is an NrTraceFileHeader
+ * naming the kind and record size. Records are stored in host byte order;
+ * the header carries a byte-order mark the reader checks.
+ *
+ * NrBinaryTrace::ConvertToText() prints a file as tab-separated text with
+ * the column names of the 5G-LENA text traces (nr-trace-convert tool).
+ */
+
+#ifndef NR_BINARY_TRACE_H
+#define NR_BINARY_TRACE_H
+
+#include "nr-block-codec.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace ns3
+{
+
+/**
+ * \brief Trace kinds (one file each)
+ */
+enum class NrTraceKind : uint16_t
+{
+    DCI = 1,  ///< Scheduled DL/UL allocations
+    TB = 2,   ///< Received transport blocks (SINR, BLER)
+    RLC = 3   ///< RLC PDUs sent and received
+};
+
+/**
+ * \brief Link direction of a DCI or TB record
+ */
+enum class NrTraceDirection : uint8_t
+{
+    DL = 0,  ///< Downlink (TB received at the UE)
+    UL = 1   ///< Uplink (TB received at the gNB)
+};
+
+/**
+ * \brief First record of every trace file
+ */
+struct NrTraceFileHeader
+{
+    char magic[8];         ///< "NRTRACE\0"
+    uint16_t version;      ///< Record layout version
+    uint16_t kind;         ///< NrTraceKind
+    uint16_t recordBytes;  ///< Size of one record
+    uint16_t byteOrder;    ///< BYTE_ORDER_MARK as written
+};
+
+/**
+ * \brief One scheduled allocation (gNB MAC)
+ */
+struct NrDciTraceRecord
+{
+    static const NrTraceKind KIND = NrTraceKind::DCI;  ///< File kind
+
+    double time;         ///< Simulation time (s)
+    uint32_t tbSize;     ///< Transport block size (bytes)
+    uint32_t frame;      ///< Frame number
+    uint16_t cellId;     ///< Scheduling cell
+    uint16_t rnti;       ///< Scheduled UE
+    uint8_t subframe;    ///< Subframe number
+    uint8_t slot;        ///< Slot number
+    uint8_t symStart;    ///< First OFDM symbol
+    uint8_t numSym;      ///< OFDM symbols
+    uint8_t mcs;         ///< MCS index
+    uint8_t rank;        ///< MIMO rank
+    uint8_t bwpId;       ///< Bandwidth part
+    uint8_t harqId;      ///< HARQ process
+    uint8_t ndi;         ///< New data indicator
+    uint8_t rv;          ///< Redundancy version
+    uint8_t direction;   ///< NrTraceDirection
+    uint8_t reserved;    ///< Padding (zero)
+};
+
+/**
+ * \brief One received transport block (spectrum PHY)
+ */
+struct NrTbTraceRecord
+{
+    static const NrTraceKind KIND = NrTraceKind::TB;  ///< File kind
+
+    double time;         ///< Simulation time (s)
+    float sinrDb;        ///< Average SINR (dB)
+    float sinrMinDb;     ///< Minimum SINR over the TB (dB)
+    float tbler;         ///< Transport block error rate
+    uint32_t tbSize;     ///< Transport block size (bytes)
+    uint32_t frame;      ///< Frame number
+    uint16_t cellId;     ///< Serving cell
+    uint16_t rnti;       ///< UE
+    uint16_t rbs;        ///< Resource blocks assigned
+    uint8_t subframe;    ///< Subframe number
+    uint8_t slot;        ///< Slot number
+    uint8_t symStart;    ///< First OFDM symbol
+    uint8_t numSym;      ///< OFDM symbols
+    uint8_t mcs;         ///< MCS index
+    uint8_t rank;        ///< MIMO rank
+    uint8_t rv;          ///< Redundancy version
+    uint8_t bwpId;       ///< Bandwidth part
+    uint8_t corrupt;     ///< 1 if the TB was lost
+    uint8_t direction;   ///< NrTraceDirection
+    uint8_t cqi;         ///< CQI reported with the TB (DL only)
+    uint8_t reserved[3]; ///< Padding (zero)
+};
+
+/**
+ * \brief One RLC PDU sent or received
+ */
+struct NrRlcTraceRecord
+{
+    static const NrTraceKind KIND = NrTraceKind::RLC;  ///< File kind
+
+    /**
+     * \brief RLC event
+     */
+    enum Event : uint8_t
+    {
+        TX = 0,  ///< PDU handed to the MAC
+        RX = 1   ///< PDU received from the MAC
+    };
+
+    double time;         ///< Simulation time (s)
+    uint64_t delayNs;    ///< RLC delay of a received PDU (ns, 0 for TX)
+    uint32_t size;       ///< PDU size (bytes)
+    uint32_t nodeId;     ///< Node of the RLC entity
+    uint16_t rnti;       ///< UE
+    uint8_t lcid;        ///< Logical channel
+    uint8_t event;       ///< Event
+    uint8_t atGnb;       ///< 1 if the entity is on the gNB side
+    uint8_t reserved[3]; ///< Padding (zero)
+};
+
+static_assert(sizeof(NrTraceFileHeader) == 16, "trace header layout");
+static_assert(sizeof(NrDciTraceRecord) == 32, "DCI record layout");
+static_assert(sizeof(NrTbTraceRecord) == 48, "TB record layout");
+static_assert(sizeof(NrRlcTraceRecord) == 32, "RLC record layout");
+static_assert(std::is_trivially_copyable<NrTbTraceRecord>::value, "records are copied raw");
+
+/**
+ * \brief Writes one kind of trace record to a compressed file
+ */
+class NrBinaryTraceWriter
+{
+  public:
+    static const uint16_t VERSION = 1;               ///< Record layout version
+    static const uint16_t BYTE_ORDER_MARK = 0x0102;  ///< Reads 0x0201 if swapped
+
+    /**
+     * \brief Constructor
+     */
+    NrBinaryTraceWriter();
+
+    /**
+     * \brief Create the file and write its header
+     * \param path Output file
+     * \param kind Trace kind
+     * \param recordBytes Size of one record
+     * \return true if the file could be created
+     */
+    bool Open(const std::string& path, NrTraceKind kind, uint16_t recordBytes);
+
+    /**
+     * \brief Create the file for a record type
+     * \param path Output file
+     * \return true if the file could be created
+     */
+    template <typename Record>
+    bool Open(const std::string& path)
+    {
+        return Open(path, Record::KIND, sizeof(Record));
+    }
+
+    /**
+     * \brief Check whether the file is open
+     * \return true between Open() and Close()
+     */
+    bool IsOpen() const
+    {
+        return m_log.IsOpen();
+    }
+
+    /**
+     * \brief Append one record
+     * \param record Record of the type the file was opened for
+     */
+    template <typename Record>
+    void Write(const Record& record)
+    {
+        m_log.Append(&record, sizeof(Record));
+    }
+
+    /**
+     * \brief Flush the pending records and close the file
+     * \return true if everything was written
+     */
+    bool Close();
+
+    /**
+     * \brief Get the number of records written (excluding the header)
+     * \return Record count
+     */
+    uint64_t GetNumRecords() const
+    {
+        return m_log.GetNumRecords() > 0 ? m_log.GetNumRecords() - 1 : 0;
+    }
+
+    /**
+     * \brief Get the uncompressed size of the records
+     * \return Bytes
+     */
+    uint64_t GetRawBytes() const
+    {
+        return m_log.GetRawBytes();
+    }
+
+    /**
+     * \brief Get the bytes written to the file so far
+     * \return Bytes (complete after Close())
+     */
+    uint64_t GetStoredBytes() const
+    {
+        return m_log.GetStoredBytes();
+    }
+
+    /**
+     * \brief Get the file path
+     * \return Path given to Open()
+     */
+    const std::string& GetPath() const
+    {
+        return m_log.GetPath();
+    }
+
+  private:
+    NrCompressedLog m_log;  ///< Compressed, asynchronously written file
+};
+
+/**
+ * \brief Reading and conversion of binary trace files
+ */
+class NrBinaryTrace
+{
+  public:
+    /**
+     * \brief Get the name of a trace kind
+     * \param kind Trace kind
+     * \return "dci", "tb", "rlc" or "unknown"
+     */
+    static const char* GetKindName(NrTraceKind kind);
+
+    /**
+     * \brief Print a trace file as tab-separated text
+     * \param path Binary trace file
+     * \param os Output (a header line, then one line per record)
+     * \param error Reason on failure (may be null)
+     * \return false if the file is unreadable, not a trace of a known
+     *         kind and version, or damaged (lines before the damage are printed)
+     */
+    static bool ConvertToText(const std::string& path, std::ostream& os, std::string* error);
+
+  private:
+    /**
+     * \brief Print the column names of a kind
+     * \param kind Trace kind
+     * \param os Output
+     */
+    static void PrintColumns(NrTraceKind kind, std::ostream& os);
+
+    /**
+     * \brief Print one record
+     * \param kind Trace kind
+     * \param record Record bytes (the kind's record size)
+     * \param os Output
+     */
+    static void PrintRecord(NrTraceKind kind, const uint8_t* record, std::ostream& os);
+};
+
+} // namespace ns3
+
+#endif /* NR_BINARY_TRACE_H */
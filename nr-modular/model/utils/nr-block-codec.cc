@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Block Codec - Implementation File
+ */
+
+#include "nr-block-codec.h"
+
+#include "nr-background-writer.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrBlockCodec");
+
+namespace
+{
+
+constexpr size_t MIN_MATCH = 4;          ///< Shortest match worth a sequence
+constexpr size_t MAX_OFFSET = 65535;     ///< Match window (16-bit offsets)
+constexpr uint32_t HASH_BITS = 14;       ///< Match finder table size (log2)
+constexpr uint32_t STORED_RAW = 1u << 31; ///< Frame flag: payload not compressed
+constexpr size_t MAX_PENDING_BLOCKS = 4; ///< Blocks queued before Append() waits
+
+const char LOG_MAGIC[8] = {'N', 'R', 'Z', 'L', 'O', 'G', '\0', '\1'};
+
+uint32_t
+Read32(const uint8_t* p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void
+Append32(std::vector<uint8_t>& out, uint32_t value)
+{
+    size_t at = out.size();
+    out.resize(at + sizeof(value));
+    std::memcpy(out.data() + at, &value, sizeof(value));
+}
+
+/**
+ * Write a 4-bit length field's overflow as 255-runs
+ */
+void
+AppendLength(std::vector<uint8_t>& out, size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        out.push_back(255);
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+/**
+ * Read a 4-bit length field's overflow
+ */
+bool
+ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+{
+    uint8_t byte;
+    do
+    {
+        if (ip >= end)
+        {
+            return false;
+        }
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * Append one sequence: literals, then (unless matchLength is 0) a match
+ */
+void
+AppendSequence(std::vector<uint8_t>& out,
+               const uint8_t* literals,
+               size_t literalLength,
+               size_t offset,
+               size_t matchLength)
+{
+    size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) |
+                                         std::min<size_t>(matchCode, 15));
+    out.push_back(token);
+    if (literalLength >= 15)
+    {
+        AppendLength(out, literalLength - 15);
+    }
+    out.insert(out.end(), literals, literals + literalLength);
+    if (matchLength == 0)
+    {
+        return;
+    }
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15)
+    {
+        AppendLength(out, matchCode - 15);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// BLOCKS
+// ============================================================================
+
+void
+NrBlockCodec::Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out)
+{
+    // Greedy single-probe match finder; positions are stored + 1 so that
+    // 0 means "empty"
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+    size_t anchor = 0;
+    size_t i = 0;
+
+    while (i + MIN_MATCH <= size)
+    {
+        uint32_t sequence = Read32(src + i);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(i + 1);
+
+        if (candidate != 0 && i - (candidate - 1) <= MAX_OFFSET &&
+            Read32(src + candidate - 1) == sequence)
+        {
+            size_t ref = candidate - 1;
+            size_t length = MIN_MATCH;
+            while (i + length < size && src[ref + length] == src[i + length])
+            {
+                ++length;
+            }
+            AppendSequence(out, src + anchor, i - anchor, i - ref, length);
+            i += length;
+            anchor = i;
+        }
+        else
+        {
+            // Skip faster through incompressible stretches
+            i += 1 + ((i - anchor) >> 6);
+        }
+    }
+    AppendSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+bool
+NrBlockCodec::Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize)
+{
+    const uint8_t* ip = src;
+    const uint8_t* end = src + size;
+    uint8_t* op = dst;
+    uint8_t* outEnd = dst + rawSize;
+
+    while (ip < end)
+    {
+        uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(ip, end, literalLength))
+        {
+            return false;
+        }
+        if (literalLength > size_t(end - ip) || literalLength > size_t(outEnd - op))
+        {
+            return false;
+        }
+        if (literalLength > 0)
+        {
+            std::memcpy(op, ip, literalLength);
+        }
+        ip += literalLength;
+        op += literalLength;
+        if (ip == end)
+        {
+            break;  // Last sequence has no match
+        }
+
+        if (end - ip < 2)
+        {
+            return false;
+        }
+        size_t offset = ip[0] | (size_t(ip[1]) << 8);
+        ip += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(ip, end, matchLength))
+        {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > size_t(op - dst) || matchLength > size_t(outEnd - op))
+        {
+            return false;
+        }
+        const uint8_t* ref = op - offset;
+        if (offset >= matchLength)
+        {
+            std::memcpy(op, ref, matchLength);
+            op += matchLength;
+        }
+        else
+        {
+            for (size_t k = 0; k < matchLength; ++k)
+            {
+                *op++ = ref[k];  // Overlapping copy repeats the pattern
+            }
+        }
+    }
+    return op == outEnd;
+}
+
+uint32_t
+NrBlockCodec::Checksum(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// ============================================================================
+// FRAMES
+// ============================================================================
+
+void
+NrBlockCodec::AppendFrame(const uint8_t* raw, size_t size, std::vector<uint8_t>& out)
+{
+    size_t headerAt = out.size();
+    Append32(out, static_cast<uint32_t>(size));
+    Append32(out, 0);  // Stored size, patched below
+    Append32(out, Checksum(raw, size));
+
+    size_t payloadAt = out.size();
+    Compress(raw, size, out);
+    uint32_t stored = static_cast<uint32_t>(out.size() - payloadAt);
+    if (stored >= size)
+    {
+        // Incompressible: store as is
+        out.resize(payloadAt);
+        out.insert(out.end(), raw, raw + size);
+        stored = static_cast<uint32_t>(size) | STORED_RAW;
+    }
+    std::memcpy(out.data() + headerAt + 4, &stored, sizeof(stored));
+}
+
+bool
+NrBlockCodec::ReadFrame(const uint8_t*& cursor, const uint8_t* end, std::vector<uint8_t>& raw)
+{
+    if (size_t(end - cursor) < FRAME_HEADER_BYTES)
+    {
+        return false;
+    }
+    uint32_t rawSize = Read32(cursor);
+    uint32_t stored = Read32(cursor + 4);
+    uint32_t checksum = Read32(cursor + 8);
+    bool isRaw = (stored & STORED_RAW) != 0;
+    size_t payloadSize = stored & ~STORED_RAW;
+    const uint8_t* payload = cursor + FRAME_HEADER_BYTES;
+    if (rawSize > MAX_BLOCK_BYTES || payloadSize > size_t(end - payload) ||
+        (isRaw && payloadSize != rawSize))
+    {
+        return false;
+    }
+
+    raw.resize(rawSize);
+    if (isRaw)
+    {
+        std::copy(payload, payload + rawSize, raw.begin());
+    }
+    else if (!Decompress(payload, payloadSize, raw.data(), rawSize))
+    {
+        return false;
+    }
+    if (Checksum(raw.data(), rawSize) != checksum)
+    {
+        return false;
+    }
+    cursor = payload + payloadSize;
+    return true;
+}
+
+// ============================================================================
+// COMPRESSED LOG
+// ============================================================================
+
+NrCompressedLog::NrCompressedLog()
+    : m_path(),
+      m_file(nullptr),
+      m_writer(),
+      m_block(),
+      m_blockBytes(1 << 20),
+      m_records(0),
+      m_rawBytes(0),
+      m_storedBytes(0),
+      m_ok(true)
+{
+}
+
+NrCompressedLog::~NrCompressedLog()
+{
+    Close();
+}
+
+bool
+NrCompressedLog::Open(const std::string& path, size_t blockBytes)
+{
+    NS_LOG_FUNCTION(this << path << blockBytes);
+
+    Close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (m_file == nullptr)
+    {
+        NS_LOG_ERROR("Cannot create compressed log " << path);
+        return false;
+    }
+    m_path = path;
+    m_blockBytes =
+        std::min<size_t>(std::max<size_t>(1, blockBytes), NrBlockCodec::MAX_BLOCK_BYTES / 2);
+    m_block.clear();
+    m_block.reserve(m_blockBytes * 2);
+    m_records = 0;
+    m_rawBytes = 0;
+    m_ok = std::fwrite(LOG_MAGIC, 1, sizeof(LOG_MAGIC), m_file) == sizeof(LOG_MAGIC);
+    m_storedBytes = sizeof(LOG_MAGIC);
+    m_writer = std::make_unique<NrBackgroundWriter>(MAX_PENDING_BLOCKS);
+    return m_ok;
+}
+
+void
+NrCompressedLog::Append(const void* data, size_t size)
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_block.insert(m_block.end(), bytes, bytes + size);
+    ++m_records;
+    m_rawBytes += size;
+    if (m_block.size() >= m_blockBytes)
+    {
+        SubmitBlock();
+    }
+}
+
+void
+NrCompressedLog::SubmitBlock()
+{
+    if (m_block.empty())
+    {
+        return;
+    }
+    auto block = std::make_shared<std::vector<uint8_t>>();
+    block->swap(m_block);
+    m_block.reserve(m_blockBytes * 2);
+
+    std::FILE* file = m_file;
+    m_writer->Post([this, block, file]() {
+        std::vector<uint8_t> frame;
+        frame.reserve(block->size() / 2 + NrBlockCodec::FRAME_HEADER_BYTES);
+        NrBlockCodec::AppendFrame(block->data(), block->size(), frame);
+        if (std::fwrite(frame.data(), 1, frame.size(), file) != frame.size())
+        {
+            m_ok = false;
+        }
+        m_storedBytes += frame.size();
+    });
+}
+
+bool
+NrCompressedLog::Close()
+{
+    if (m_file == nullptr)
+    {
+        return m_ok;
+    }
+    NS_LOG_FUNCTION(this << m_path << m_records);
+
+    SubmitBlock();
+    m_writer->Drain();
+    m_writer.reset();
+    if (std::fclose(m_file) != 0)
+    {
+        m_ok = false;
+    }
+    m_file = nullptr;
+    m_block = std::vector<uint8_t>();
+
+    if (!m_ok)
+    {
+        NS_LOG_ERROR("Write error on compressed log " << m_path);
+    }
+    return m_ok;
+}
+
+bool
+NrCompressedLog::ReadAll(const std::string& path, std::string& records)
+{
+    records.clear();
+    return ForEachBlock(path, [&records](const uint8_t* data, size_t size) {
+        records.append(reinterpret_cast<const char*>(data), size);
+        return true;
+    });
+}
+
+bool
+NrCompressedLog::ForEachBlock(const std::string& path,
+                              const std::function<bool(const uint8_t*, size_t)>& onBlock)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    char magic[sizeof(LOG_MAGIC)];
+    bool ok = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              std::memcmp(magic, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0;
+
+    // Read each frame whole (header, then its payload) and decode it
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> block;
+    while (ok)
+    {
+        frame.resize(NrBlockCodec::FRAME_HEADER_BYTES);
+        size_t n = std::fread(frame.data(), 1, frame.size(), file);
+        if (n == 0)
+        {
+            break;  // Clean end of file
+        }
+        size_t payloadSize = Read32(frame.data() + 4) & ~STORED_RAW;
+        if (n != NrBlockCodec::FRAME_HEADER_BYTES || payloadSize > NrBlockCodec::MAX_BLOCK_BYTES)
+        {
+            ok = false;
+            break;
+        }
+        frame.resize(NrBlockCodec::FRAME_HEADER_BYTES + payloadSize);
+        const uint8_t* cursor = frame.data();
+        ok = std::fread(frame.data() + NrBlockCodec::FRAME_HEADER_BYTES, 1, payloadSize, file) ==
+                 payloadSize &&
+             NrBlockCodec::ReadFrame(cursor, frame.data() + frame.size(), block) &&
+             onBlock(block.data(), block.size());
+    }
+    std::fclose(file);
+    return ok;
+}
+
+} // namespace ns3
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Block Codec - Header File
+ *
+ * Fast byte-oriented LZ77 compression of independent blocks (LZ4-style
+ * sequences: token, literals, 16-bit offset, 64 KiB window) and the frame
+ * that stores one block on disk:
+ *
+ *   u32 raw size
+ *   u32 stored size            bit 31 set = payload stored uncompressed
+ *   u32 FNV-1a of the raw bytes
+ *   payload
+ *
+ * Every frame decodes on its own, so a reader can seek to any frame and a
+ * truncated file loses only its last frame. The codec favours speed over
+ * ratio; callers that know their data (counters, positions) should make it
+ * repetitive first (delta, quantization, byte planes).
+ *
+ * NrCompressedLog appends records (e.g. one JSON line per telemetry tick)
+ * to a file of frames:
+ *
+ *   "NRZLOG\0\1"               8-byte magic (format version 1)
+ *   frame...                   until end of file
+ *
+ * Blocks are cut on record boundaries, so each frame holds whole records.
+ * Compression and writing run on a background thread.
+ */
+
+#ifndef NR_BLOCK_CODEC_H
+#define NR_BLOCK_CODEC_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class NrBackgroundWriter;
+
+/**
+ * \brief LZ77 block compressor and on-disk frame format
+ */
+class NrBlockCodec
+{
+  public:
+    static const size_t FRAME_HEADER_BYTES = 12;  ///< Frame header size
+    static const size_t MAX_BLOCK_BYTES = 1u << 30;  ///< Largest raw block
+
+    /**
+     * \brief Compress one block
+     * \param src Raw bytes
+     * \param size Raw size
+     * \param out Compressed bytes are appended here
+     */
+    static void Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out);
+
+    /**
+     * \brief Decompress one block
+     * \param src Compressed bytes
+     * \param size Compressed size
+     * \param dst Output (rawSize bytes)
+     * \param rawSize Expected raw size
+     * \return false if the input is malformed or does not decode to rawSize bytes
+     */
+    static bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize);
+
+    /**
+     * \brief Compress a block and append it as a frame
+     * \param raw Raw bytes
+     * \param size Raw size (<= MAX_BLOCK_BYTES)
+     * \param out Frame is appended here
+     */
+    static void AppendFrame(const uint8_t* raw, size_t size, std::vector<uint8_t>& out);
+
+    /**
+     * \brief Decode the frame at cursor
+     * \param cursor Start of the frame; advanced past it on success
+     * \param end End of the available bytes
+     * \param raw Decoded block (replaced)
+     * \return false if the frame is truncated, malformed or fails its checksum
+     */
+    static bool ReadFrame(const uint8_t*& cursor, const uint8_t* end, std::vector<uint8_t>& raw);
+
+    /**
+     * \brief 32-bit FNV-1a checksum
+     * \param data Bytes
+     * \param size Byte count
+     * \return Checksum
+     */
+    static uint32_t Checksum(const uint8_t* data, size_t size);
+};
+
+/**
+ * \brief Append-only file of compressed records
+ */
+class NrCompressedLog
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrCompressedLog();
+
+    /**
+     * \brief Destructor (closes the file)
+     */
+    ~NrCompressedLog();
+
+    NrCompressedLog(const NrCompressedLog&) = delete;
+    NrCompressedLog& operator=(const NrCompressedLog&) = delete;
+
+    /**
+     * \brief Create the file and start the background writer
+     * \param path Output file
+     * \param blockBytes Raw bytes collected before a block is compressed
+     * \return true if the file could be created
+     */
+    bool Open(const std::string& path, size_t blockBytes = 1 << 20);
+
+    /**
+     * \brief Check whether the log is open
+     * \return true between Open() and Close()
+     */
+    bool IsOpen() const
+    {
+        return m_file != nullptr;
+    }
+
+    /**
+     * \brief Append one record (copied; include any separator)
+     * \param data Record bytes
+     * \param size Record size
+     *
+     * Blocks only when the background writer is several blocks behind.
+     */
+    void Append(const void* data, size_t size);
+
+    /**
+     * \brief Compress the pending records, wait for the writer and close
+     * \return true if everything was written
+     */
+    bool Close();
+
+    /**
+     * \brief Get the number of records appended
+     * \return Record count
+     */
+    uint64_t GetNumRecords() const
+    {
+        return m_records;
+    }
+
+    /**
+     * \brief Get the raw bytes appended
+     * \return Byte count
+     */
+    uint64_t GetRawBytes() const
+    {
+        return m_rawBytes;
+    }
+
+    /**
+     * \brief Get the bytes written to the file so far
+     * \return Byte count (complete after Close())
+     */
+    uint64_t GetStoredBytes() const
+    {
+        return m_storedBytes;
+    }
+
+    /**
+     * \brief Get the memory held by the current block
+     * \return Bytes (excludes blocks queued for the writer thread)
+     */
+    uint64_t GetBufferBytes() const
+    {
+        return m_block.capacity();
+    }
+
+    /**
+     * \brief Get the file path
+     * \return Path given to Open()
+     */
+    const std::string& GetPath() const
+    {
+        return m_path;
+    }
+
+    /**
+     * \brief Decode a whole log file
+     * \param path Log file
+     * \param records Concatenated records (replaced)
+     * \return false if the file is unreadable or a frame is damaged
+     *         (records holds everything before the damage)
+     */
+    static bool ReadAll(const std::string& path, std::string& records);
+
+    /**
+     * \brief Decode a log file one block at a time
+     * \param path Log file
+     * \param onBlock Called with each decoded block (whole records);
+     *        returning false stops the read
+     * \return false if the file is unreadable, a frame is damaged or
+     *         onBlock stopped the read
+     *
+     * Memory stays bounded by one block, so large logs can be streamed.
+     */
+    static bool ForEachBlock(const std::string& path,
+                             const std::function<bool(const uint8_t*, size_t)>& onBlock);
+
+  private:
+    /**
+     * \brief Hand the current block to the background writer
+     */
+    void SubmitBlock();
+
+    std::string m_path;                          ///< File path
+    std::FILE* m_file;                           ///< Output file
+    std::unique_ptr<NrBackgroundWriter> m_writer; ///< Compresses and writes blocks
+    std::vector<uint8_t> m_block;                ///< Records of the current block
+    size_t m_blockBytes;                         ///< Block cut threshold
+    uint64_t m_records;                          ///< Records appended
+    uint64_t m_rawBytes;                         ///< Raw bytes appended
+    std::atomic<uint64_t> m_storedBytes;         ///< Bytes written (writer thread)
+    std::atomic<bool> m_ok;                      ///< No write error so far
+};
+
+} // namespace ns3
+
+#endif /* NR_BLOCK_CODEC_H */
@@ -0,0 +1,783 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Columnar Results Writer - Implementation File
+ */
+
+#include "nr-columnar-writer.h"
+
+#include "nr-background-writer.h"
+#include "nr-block-codec.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <iomanip>
+#include <type_traits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrColumnarWriter");
+
+namespace
+{
+
+constexpr size_t FILE_BUFFER_BYTES = 1 << 20;  ///< stdio buffer of the binary file
+constexpr size_t CSV_FLUSH_BYTES = 1 << 20;    ///< CSV text batched per write
+
+constexpr size_t MAX_PENDING_GROUPS = 2;      ///< Compressed groups queued before a flush waits
+
+const char HEADER_MAGIC[8] = {'N', 'R', 'C', 'O', 'L', '\0', '\0', '\1'};
+const char HEADER_MAGIC_V2[8] = {'N', 'R', 'C', 'O', 'L', '\0', '\0', '\2'};
+const char FOOTER_MAGIC[8] = {'N', 'R', 'C', 'O', 'L', 'E', 'N', 'D'};
+
+template <typename T>
+T
+ZigZag(T delta)
+{
+    using S = typename std::make_signed<T>::type;
+    return (delta << 1) ^ static_cast<T>(static_cast<S>(delta) >> (sizeof(T) * 8 - 1));
+}
+
+template <typename T>
+T
+UnZigZag(T code)
+{
+    return (code >> 1) ^ (T(0) - (code & 1));
+}
+
+/**
+ * Read value i of a column as the 64-bit lane that gets delta-encoded
+ */
+uint64_t
+ReadLane(const NrColumnarWriter::Column& column, const uint8_t* values, size_t i)
+{
+    if (column.type == NrColumnarWriter::UINT32)
+    {
+        uint32_t value;
+        std::memcpy(&value, values + 4 * i, 4);
+        return value;
+    }
+    uint64_t lane;
+    std::memcpy(&lane, values + 8 * i, 8);
+    if (column.type == NrColumnarWriter::FLOAT64 && column.quantum > 0.0)
+    {
+        double value;
+        std::memcpy(&value, &lane, 8);
+        lane = static_cast<uint64_t>(std::llround(value / column.quantum));
+    }
+    return lane;
+}
+
+/**
+ * Map a lane to its code: delta (zigzag) or, for exact floats, XOR
+ */
+uint64_t
+EncodeLane(const NrColumnarWriter::Column& column, uint64_t lane, uint64_t previous)
+{
+    if (column.type == NrColumnarWriter::UINT32)
+    {
+        return ZigZag<uint32_t>(static_cast<uint32_t>(lane - previous));
+    }
+    if (column.type == NrColumnarWriter::FLOAT64 && column.quantum <= 0.0)
+    {
+        return lane ^ previous;
+    }
+    return ZigZag<uint64_t>(lane - previous);
+}
+
+/**
+ * Inverse of EncodeLane()
+ */
+uint64_t
+DecodeLane(const NrColumnarWriter::Column& column, uint64_t code, uint64_t previous)
+{
+    if (column.type == NrColumnarWriter::UINT32)
+    {
+        return static_cast<uint32_t>(previous + UnZigZag<uint32_t>(static_cast<uint32_t>(code)));
+    }
+    if (column.type == NrColumnarWriter::FLOAT64 && column.quantum <= 0.0)
+    {
+        return code ^ previous;
+    }
+    return previous + UnZigZag<uint64_t>(code);
+}
+
+} // namespace
+
+// ============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+// ============================================================================
+
+NrColumnarWriter::NrColumnarWriter()
+    : m_path(),
+      m_file(nullptr),
+      m_csv(nullptr),
+      m_fileBuffer(),
+      m_schema(),
+      m_columns(),
+      m_summaries(),
+      m_groupOffsets(),
+      m_csvBuffer(),
+      m_rowGroupRows(65536),
+      m_groupRows(0),
+      m_totalRows(0),
+      m_valueBytes(0),
+      m_offset(0),
+      m_cursor(0),
+      m_ok(true),
+      m_compress(false),
+      m_deltaStride(1),
+      m_writer()
+{
+}
+
+NrColumnarWriter::~NrColumnarWriter()
+{
+    Close();
+}
+
+// ============================================================================
+// OPEN / CLOSE
+// ============================================================================
+
+void
+NrColumnarWriter::SetCompression(bool enable, uint32_t deltaStride)
+{
+    m_compress = enable;
+    m_deltaStride = std::max<uint32_t>(1, deltaStride);
+}
+
+bool
+NrColumnarWriter::Open(const std::string& path,
+                       const std::string& table,
+                       const std::vector<Column>& schema,
+                       const std::string& csvPath,
+                       uint32_t rowGroupRows)
+{
+    NS_LOG_FUNCTION(this << path << table << schema.size());
+
+    Close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (m_file == nullptr)
+    {
+        NS_LOG_ERROR("Cannot create results file " << path);
+        return false;
+    }
+    m_fileBuffer.resize(FILE_BUFFER_BYTES);
+    std::setvbuf(m_file, m_fileBuffer.data(), _IOFBF, m_fileBuffer.size());
+
+    if (!csvPath.empty())
+    {
+        m_csv = std::fopen(csvPath.c_str(), "w");
+        if (m_csv == nullptr)
+        {
+            NS_LOG_ERROR("Cannot create CSV results file " << csvPath);
+            std::fclose(m_file);
+            m_file = nullptr;
+            return false;
+        }
+    }
+
+    m_path = path;
+    m_schema = schema;
+    m_columns.assign(schema.size(), {});
+    m_summaries.assign(schema.size(), ColumnSummary());
+    m_groupOffsets.clear();
+    m_csvBuffer.clear();
+    m_rowGroupRows = std::max<uint32_t>(1, rowGroupRows);
+    m_groupRows = 0;
+    m_totalRows = 0;
+    m_valueBytes = 0;
+    m_offset = 0;
+    m_cursor = 0;
+    m_ok = true;
+
+    for (size_t c = 0; c < m_schema.size(); ++c)
+    {
+        size_t width = (m_schema[c].type == UINT32) ? 4 : 8;
+        m_columns[c].reserve(width * m_rowGroupRows);
+    }
+
+    // ----- Schema header -----
+    Write(m_compress ? HEADER_MAGIC_V2 : HEADER_MAGIC, sizeof(HEADER_MAGIC));
+    WriteString(table);
+    uint32_t numColumns = static_cast<uint32_t>(m_schema.size());
+    Write(&numColumns, sizeof(numColumns));
+    for (const auto& column : m_schema)
+    {
+        uint8_t type = column.type;
+        Write(&type, sizeof(type));
+        WriteString(column.name);
+        if (m_compress)
+        {
+            double quantum = (column.type == FLOAT64) ? std::max(0.0, column.quantum) : 0.0;
+            Write(&quantum, sizeof(quantum));
+        }
+    }
+    if (m_compress)
+    {
+        Write(&m_deltaStride, sizeof(m_deltaStride));
+        m_writer = std::make_unique<NrBackgroundWriter>(MAX_PENDING_GROUPS);
+    }
+
+    if (m_csv)
+    {
+        for (size_t c = 0; c < m_schema.size(); ++c)
+        {
+            m_csvBuffer += (c ? "," : "") + m_schema[c].name;
+        }
+        m_csvBuffer += '\n';
+    }
+    return m_ok;
+}
+
+bool
+NrColumnarWriter::Close()
+{
+    if (m_file == nullptr)
+    {
+        return m_ok;
+    }
+    NS_LOG_FUNCTION(this << m_path << m_totalRows);
+
+    if (m_cursor > 0)
+    {
+        EndRow();  // Complete a half-written row rather than drop it
+    }
+    FlushRowGroup();
+    if (m_writer)
+    {
+        m_writer->Drain();
+        m_writer.reset();
+    }
+
+    // ----- Footer -----
+    uint64_t footerOffset = m_offset;
+    Write("FOOT", 4);
+    Write(&m_totalRows, sizeof(m_totalRows));
+    uint32_t numGroups = static_cast<uint32_t>(m_groupOffsets.size());
+    Write(&numGroups, sizeof(numGroups));
+    Write(m_groupOffsets.data(), m_groupOffsets.size() * sizeof(uint64_t));
+    for (const auto& summary : m_summaries)
+    {
+        Write(&summary.count, sizeof(summary.count));
+        Write(&summary.min, sizeof(summary.min));
+        Write(&summary.max, sizeof(summary.max));
+        Write(&summary.sum, sizeof(summary.sum));
+    }
+    Write(&footerOffset, sizeof(footerOffset));
+    Write(FOOTER_MAGIC, sizeof(FOOTER_MAGIC));
+
+    if (std::fclose(m_file) != 0)
+    {
+        m_ok = false;
+    }
+    m_file = nullptr;
+
+    if (m_csv)
+    {
+        FlushCsv();
+        if (std::fclose(m_csv) != 0)
+        {
+            m_ok = false;
+        }
+        m_csv = nullptr;
+    }
+
+    if (!m_ok)
+    {
+        NS_LOG_ERROR("Write error on results file " << m_path);
+    }
+    m_columns.clear();
+    return m_ok;
+}
+
+// ============================================================================
+// ROWS
+// ============================================================================
+
+void
+NrColumnarWriter::EndRow()
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+    if (m_cursor != m_schema.size())
+    {
+        NS_LOG_WARN("Row " << m_totalRows << " of " << m_path << " has " << m_cursor
+                    << " values for " << m_schema.size() << " columns");
+        while (m_cursor < m_schema.size())
+        {
+            Put(0);
+        }
+    }
+    m_cursor = 0;
+    ++m_groupRows;
+    ++m_totalRows;
+
+    if (m_csv && !m_csvBuffer.empty())
+    {
+        m_csvBuffer.back() = '\n';  // Replace the trailing separator
+        if (m_csvBuffer.size() >= CSV_FLUSH_BYTES)
+        {
+            FlushCsv();
+        }
+    }
+
+    if (m_groupRows >= m_rowGroupRows)
+    {
+        FlushRowGroup();
+    }
+}
+
+void
+NrColumnarWriter::Summarize(double value)
+{
+    ColumnSummary& summary = m_summaries[m_cursor];
+    if (summary.count == 0)
+    {
+        summary.min = value;
+        summary.max = value;
+    }
+    else
+    {
+        summary.min = std::min(summary.min, value);
+        summary.max = std::max(summary.max, value);
+    }
+    summary.sum += value;
+    ++summary.count;
+}
+
+bool
+NrColumnarWriter::FlushRowGroup()
+{
+    if (m_groupRows == 0)
+    {
+        return true;
+    }
+
+    for (const auto& column : m_columns)
+    {
+        m_valueBytes += column.size();
+    }
+
+    if (m_writer)
+    {
+        // Hand the buffers to the writer thread and start fresh ones
+        auto columns = std::make_shared<std::vector<std::vector<uint8_t>>>(std::move(m_columns));
+        uint32_t rows = m_groupRows;
+        m_writer->Post([this, columns, rows]() { WriteCompressedGroup(*columns, rows); });
+        m_columns.assign(m_schema.size(), {});
+        for (size_t c = 0; c < m_schema.size(); ++c)
+        {
+            m_columns[c].reserve((*columns)[c].capacity());
+        }
+        m_groupRows = 0;
+        return m_ok;
+    }
+
+    m_groupOffsets.push_back(m_offset);
+    Write("RGRP", 4);
+    Write(&m_groupRows, sizeof(m_groupRows));
+    for (auto& column : m_columns)
+    {
+        Write(column.data(), column.size());
+        column.clear();  // Keeps the capacity for the next group
+    }
+    m_groupRows = 0;
+    return m_ok;
+}
+
+// ============================================================================
+// COMPRESSION
+// ============================================================================
+
+void
+NrColumnarWriter::WriteCompressedGroup(const std::vector<std::vector<uint8_t>>& columns,
+                                       uint32_t rows)
+{
+    std::vector<uint8_t> planes;
+    std::vector<uint8_t> frame;
+
+    m_groupOffsets.push_back(m_offset);
+    Write("RGRZ", 4);
+    Write(&rows, sizeof(rows));
+    for (size_t c = 0; c < columns.size(); ++c)
+    {
+        EncodeColumn(m_schema[c], m_deltaStride, columns[c].data(), rows, planes);
+        frame.clear();
+        NrBlockCodec::AppendFrame(planes.data(), planes.size(), frame);
+        uint32_t frameBytes = static_cast<uint32_t>(frame.size());
+        Write(&frameBytes, sizeof(frameBytes));
+        Write(frame.data(), frame.size());
+    }
+}
+
+void
+NrColumnarWriter::EncodeColumn(const Column& column,
+                               uint32_t deltaStride,
+                               const uint8_t* values,
+                               uint32_t rows,
+                               std::vector<uint8_t>& planes)
+{
+    size_t width = (column.type == UINT32) ? 4 : 8;
+    planes.resize(width * rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        uint64_t lane = ReadLane(column, values, i);
+        uint64_t previous = (i >= deltaStride) ? ReadLane(column, values, i - deltaStride) : 0;
+        uint64_t code = EncodeLane(column, lane, previous);
+        for (size_t b = 0; b < width; ++b)
+        {
+            planes[b * rows + i] = static_cast<uint8_t>(code >> (8 * b));
+        }
+    }
+}
+
+bool
+NrColumnarWriter::DecodeColumn(const Column& column,
+                               uint32_t deltaStride,
+                               uint32_t rows,
+                               const uint8_t* frame,
+                               size_t size,
+                               std::vector<uint8_t>& values)
+{
+    size_t width = (column.type == UINT32) ? 4 : 8;
+    std::vector<uint8_t> planes;
+    const uint8_t* cursor = frame;
+    if (!NrBlockCodec::ReadFrame(cursor, frame + size, planes) || planes.size() != width * rows)
+    {
+        return false;
+    }
+
+    deltaStride = std::max<uint32_t>(1, deltaStride);
+    std::vector<uint64_t> lanes(rows);
+    values.resize(width * rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        uint64_t code = 0;
+        for (size_t b = 0; b < width; ++b)
+        {
+            code |= uint64_t(planes[b * rows + i]) << (8 * b);
+        }
+        uint64_t previous = (i >= deltaStride) ? lanes[i - deltaStride] : 0;
+        lanes[i] = DecodeLane(column, code, previous);
+
+        if (column.type == UINT32)
+        {
+            uint32_t value = static_cast<uint32_t>(lanes[i]);
+            std::memcpy(values.data() + 4 * i, &value, 4);
+        }
+        else if (column.type == FLOAT64 && column.quantum > 0.0)
+        {
+            double value = static_cast<int64_t>(lanes[i]) * column.quantum;
+            std::memcpy(values.data() + 8 * i, &value, 8);
+        }
+        else
+        {
+            std::memcpy(values.data() + 8 * i, &lanes[i], 8);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// CSV
+// ============================================================================
+
+void
+NrColumnarWriter::AppendCsv(uint32_t value)
+{
+    char text[16];
+    int n = std::snprintf(text, sizeof(text), "%" PRIu32 ",", value);
+    m_csvBuffer.append(text, n);
+}
+
+void
+NrColumnarWriter::AppendCsv(uint64_t value)
+{
+    char text[24];
+    int n = std::snprintf(text, sizeof(text), "%" PRIu64 ",", value);
+    m_csvBuffer.append(text, n);
+}
+
+void
+NrColumnarWriter::AppendCsv(double value)
+{
+    char text[32];
+    int n = std::snprintf(text, sizeof(text), "%.9g,", value);
+    m_csvBuffer.append(text, n);
+}
+
+void
+NrColumnarWriter::FlushCsv()
+{
+    if (m_csv && !m_csvBuffer.empty())
+    {
+        if (std::fwrite(m_csvBuffer.data(), 1, m_csvBuffer.size(), m_csv) != m_csvBuffer.size())
+        {
+            m_ok = false;
+        }
+        m_csvBuffer.clear();
+    }
+}
+
+// ============================================================================
+// LOW-LEVEL WRITES
+// ============================================================================
+
+void
+NrColumnarWriter::Write(const void* data, size_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    if (std::fwrite(data, 1, size, m_file) != size)
+    {
+        m_ok = false;
+    }
+    m_offset += size;
+}
+
+void
+NrColumnarWriter::WriteString(const std::string& text)
+{
+    uint16_t length = static_cast<uint16_t>(std::min<size_t>(text.size(), UINT16_MAX));
+    Write(&length, sizeof(length));
+    Write(text.data(), length);
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+NrColumnarReader::NrColumnarReader()
+    : m_file(nullptr),
+      m_version(0),
+      m_table(),
+      m_schema(),
+      m_deltaStride(1),
+      m_complete(false),
+      m_error(),
+      m_frame()
+{
+}
+
+NrColumnarReader::~NrColumnarReader()
+{
+    Close();
+}
+
+bool
+NrColumnarReader::Open(const std::string& path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    Close();
+    m_version = 0;
+    m_table.clear();
+    m_schema.clear();
+    m_deltaStride = 1;
+    m_complete = false;
+    m_error.clear();
+
+    m_file = std::fopen(path.c_str(), "rb");
+    if (m_file == nullptr)
+    {
+        m_error = "cannot open file";
+        return false;
+    }
+
+    char magic[sizeof(HEADER_MAGIC)];
+    if (Read(magic, sizeof(magic)))
+    {
+        m_version = (std::memcmp(magic, HEADER_MAGIC, sizeof(magic)) == 0)      ? 1
+                    : (std::memcmp(magic, HEADER_MAGIC_V2, sizeof(magic)) == 0) ? 2
+                                                                                : 0;
+    }
+    uint32_t numColumns = 0;
+    bool ok = m_version != 0 && ReadString(m_table) && Read(&numColumns, sizeof(numColumns));
+    for (uint32_t c = 0; ok && c < numColumns; ++c)
+    {
+        uint8_t type = 0;
+        NrColumnarWriter::Column column;
+        ok = Read(&type, sizeof(type)) && ReadString(column.name) &&
+             (m_version == 1 || Read(&column.quantum, sizeof(column.quantum))) &&
+             type >= NrColumnarWriter::UINT32 && type <= NrColumnarWriter::FLOAT64;
+        column.type = static_cast<NrColumnarWriter::ColumnType>(type);
+        m_schema.push_back(column);
+    }
+    if (ok && m_version == 2)
+    {
+        ok = Read(&m_deltaStride, sizeof(m_deltaStride));
+    }
+    if (!ok)
+    {
+        m_error = (m_version == 0) ? "not a columnar results file" : "damaged header";
+        Close();
+    }
+    return ok;
+}
+
+bool
+NrColumnarReader::ReadRowGroup(uint32_t& rows, std::vector<std::vector<uint8_t>>& columns)
+{
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+
+    char tag[4];
+    size_t n = std::fread(tag, 1, sizeof(tag), m_file);
+    if (n == 0)
+    {
+        return false;  // Unclosed file: ends after its last row group
+    }
+    if (n == sizeof(tag) && std::memcmp(tag, "FOOT", 4) == 0)
+    {
+        m_complete = true;
+        return false;
+    }
+    const char* groupTag = (m_version == 2) ? "RGRZ" : "RGRP";
+    if (n != sizeof(tag) || std::memcmp(tag, groupTag, 4) != 0 || !Read(&rows, sizeof(rows)) ||
+        rows > NrBlockCodec::MAX_BLOCK_BYTES / 8)
+    {
+        m_error = "damaged row group";
+        return false;
+    }
+
+    columns.resize(m_schema.size());
+    for (size_t c = 0; c < m_schema.size(); ++c)
+    {
+        size_t width = (m_schema[c].type == NrColumnarWriter::UINT32) ? 4 : 8;
+        bool ok;
+        if (m_version == 1)
+        {
+            columns[c].resize(width * rows);
+            ok = Read(columns[c].data(), columns[c].size());
+        }
+        else
+        {
+            uint32_t frameBytes = 0;
+            ok = Read(&frameBytes, sizeof(frameBytes)) &&
+                 frameBytes <= NrBlockCodec::FRAME_HEADER_BYTES + NrBlockCodec::MAX_BLOCK_BYTES;
+            if (ok)
+            {
+                m_frame.resize(frameBytes);
+                ok = Read(m_frame.data(), frameBytes) &&
+                     NrColumnarWriter::DecodeColumn(m_schema[c],
+                                                    m_deltaStride,
+                                                    rows,
+                                                    m_frame.data(),
+                                                    frameBytes,
+                                                    columns[c]);
+            }
+        }
+        if (!ok)
+        {
+            m_error = "damaged column " + m_schema[c].name;
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+NrColumnarReader::Close()
+{
+    if (m_file != nullptr)
+    {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool
+NrColumnarReader::Read(void* data, size_t size)
+{
+    return size == 0 || std::fread(data, 1, size, m_file) == size;
+}
+
+bool
+NrColumnarReader::ReadString(std::string& text)
+{
+    uint16_t length = 0;
+    if (!Read(&length, sizeof(length)))
+    {
+        return false;
+    }
+    text.resize(length);
+    return Read(&text[0], length);
+}
+
+bool
+NrColumnarReader::ConvertToText(const std::string& path, std::ostream& os, std::string* error)
+{
+    NrColumnarReader reader;
+    bool ok = reader.Open(path);
+    if (ok)
+    {
+        const auto& schema = reader.GetSchema();
+        for (size_t c = 0; c < schema.size(); ++c)
+        {
+            os << (c ? "\t" : "") << schema[c].name;
+        }
+        os << "\n";
+
+        std::ios::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        os << std::defaultfloat << std::setprecision(9);  // As the CSV output
+        uint32_t rows = 0;
+        std::vector<std::vector<uint8_t>> columns;
+        while (reader.ReadRowGroup(rows, columns))
+        {
+            for (uint32_t r = 0; r < rows; ++r)
+            {
+                for (size_t c = 0; c < schema.size(); ++c)
+                {
+                    os << (c ? "\t" : "");
+                    if (schema[c].type == NrColumnarWriter::UINT32)
+                    {
+                        uint32_t value;
+                        std::memcpy(&value, columns[c].data() + 4 * r, 4);
+                        os << value;
+                    }
+                    else if (schema[c].type == NrColumnarWriter::UINT64)
+                    {
+                        uint64_t value;
+                        std::memcpy(&value, columns[c].data() + 8 * r, 8);
+                        os << value;
+                    }
+                    else
+                    {
+                        double value;
+                        std::memcpy(&value, columns[c].data() + 8 * r, 8);
+                        os << value;
+                    }
+                }
+                os << "\n";
+            }
+        }
+        os.flags(flags);
+        os.precision(precision);
+        ok = reader.GetError().empty();
+    }
+    if (!ok && error != nullptr)
+    {
+        *error = reader.GetError();
+    }
+    return ok;
+}
+
+} // namespace ns3
@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Columnar Results Writer - Header File
+ *
+ * Streams rows of one table into a column-oriented binary file (and
+ * optionally a CSV file), so time-resolved results of large runs can be
+ * loaded column by column instead of parsing text.
+ *
+ * Binary layout (.nrcol, host byte order - little-endian on all
+ * supported platforms - no padding):
+ *
+ *   HEADER     "NRCOL\0\0\1"              8-byte magic (format version 1)
+ *              u16 len + bytes            table name
+ *              u32                        number of columns C
+ *              C x (u8 type, u16 len + bytes name)
+ *                                         type: 1 = u32, 2 = u64, 3 = f64
+ *   ROW GROUP  "RGRP"  u32 rows R         repeated; each column stored as
+ *              C x (R values of its type) one contiguous array
+ *   FOOTER     "FOOT"  u64 total rows
+ *              u32 groups G, G x u64      file offset of each row group
+ *              C x (u64 count, f64 min, f64 max, f64 sum)
+ *              u64                        file offset of "FOOT"
+ *              "NRCOLEND"                 8-byte trailing magic
+ *
+ * A reader seeks to end - 16, reads the footer offset, and from the
+ * row-group offsets can load any column without touching the others.
+ * A file without the trailing magic was not closed (crashed run); its
+ * row groups are still readable sequentially from the header.
+ *
+ * Compressed layout (SetCompression(), format version 2) differs in:
+ *
+ *   HEADER     "NRCOL\0\0\2"
+ *              C x (u8 type, u16 len + bytes name, f64 quantum)
+ *              u32                        delta stride S
+ *   ROW GROUP  "RGRZ"  u32 rows R
+ *              C x (u32 len + NrBlockCodec frame of the encoded column)
+ *
+ * Each column of a row group is encoded as: value i minus value i - S
+ * (zigzag; 0 before the first S rows) for integers and quantized floats
+ * (round(v / quantum), quantum > 0), XOR with value i - S for exact
+ * floats, then split into byte planes (all first bytes, all second
+ * bytes, ...) and compressed. With S = entities per sample, monotonic
+ * counters and slowly moving positions become runs of small values.
+ * Row groups stay independently decodable (DecodeColumn()); footer
+ * summaries hold the values before quantization.
+ *
+ * NrColumnarReader reads both versions back row group by row group
+ * (nr-trace-convert prints them as text).
+ *
+ * Performance:
+ * - Put(): one append to a per-column buffer, no formatting
+ * - Row groups (default 65536 rows) are written with one fwrite per
+ *   column through a 1 MiB stdio buffer; CSV text is batched likewise
+ * - Compressed row groups are encoded and written on a background thread
+ */
+
+#ifndef NR_COLUMNAR_WRITER_H
+#define NR_COLUMNAR_WRITER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+class NrBackgroundWriter;
+
+/**
+ * \brief Streaming writer of one column-oriented results table
+ */
+class NrColumnarWriter
+{
+  public:
+    /**
+     * \brief Column value types
+     */
+    enum ColumnType : uint8_t
+    {
+        UINT32 = 1,   ///< 4-byte unsigned integer
+        UINT64 = 2,   ///< 8-byte unsigned integer
+        FLOAT64 = 3   ///< 8-byte IEEE double
+    };
+
+    /**
+     * \brief Column declaration
+     */
+    struct Column
+    {
+        std::string name;         ///< Column name
+        ColumnType type;          ///< Value type
+        double quantum = 0.0;     ///< FLOAT64 step kept when compressed (0 = exact)
+    };
+
+    /**
+     * \brief Per-column summary written to the footer
+     */
+    struct ColumnSummary
+    {
+        uint64_t count = 0;   ///< Values written
+        double min = 0.0;     ///< Minimum (0 if empty)
+        double max = 0.0;     ///< Maximum (0 if empty)
+        double sum = 0.0;     ///< Sum (mean = sum / count)
+    };
+
+    /**
+     * \brief Constructor
+     */
+    NrColumnarWriter();
+
+    /**
+     * \brief Destructor (closes the files)
+     */
+    ~NrColumnarWriter();
+
+    NrColumnarWriter(const NrColumnarWriter&) = delete;
+    NrColumnarWriter& operator=(const NrColumnarWriter&) = delete;
+
+    /**
+     * \brief Select the compressed format for the next Open()
+     * \param enable Write compressed row groups (format version 2)
+     * \param deltaStride Rows between consecutive values of one entity
+     *        (e.g. the UE count when every sample writes one row per UE)
+     */
+    void SetCompression(bool enable, uint32_t deltaStride = 1);
+
+    /**
+     * \brief Create the output file(s) and write the schema header
+     * \param path Binary columnar file
+     * \param table Table name stored in the header
+     * \param schema Columns, in Put() order
+     * \param csvPath Also write a CSV file here ("" = binary only)
+     * \param rowGroupRows Rows buffered per row group
+     * \return true if the file(s) could be created
+     */
+    bool Open(const std::string& path,
+              const std::string& table,
+              const std::vector<Column>& schema,
+              const std::string& csvPath = "",
+              uint32_t rowGroupRows = 65536);
+
+    /**
+     * \brief Check whether the writer is open
+     * \return true between Open() and Close()
+     */
+    bool IsOpen() const
+    {
+        return m_file != nullptr;
+    }
+
+    /**
+     * \brief Append the next value of the current row
+     * \param value Value, converted to the type of the current column
+     *
+     * Values are given in schema order; EndRow() completes the row.
+     */
+    template <typename T>
+    void Put(T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Put() takes numbers");
+        if (m_cursor >= m_schema.size())
+        {
+            return;  // Extra values are dropped; EndRow() reports the mismatch
+        }
+        switch (m_schema[m_cursor].type)
+        {
+        case UINT32:
+            Store(static_cast<uint32_t>(value), static_cast<double>(value));
+            break;
+        case UINT64:
+            Store(static_cast<uint64_t>(value), static_cast<double>(value));
+            break;
+        default:
+            Store(static_cast<double>(value), static_cast<double>(value));
+            break;
+        }
+    }
+
+    /**
+     * \brief Complete the current row
+     *
+     * Missing trailing values are filled with 0. Flushes a row group
+     * when it is full.
+     */
+    void EndRow();
+
+    /**
+     * \brief Write buffered rows, the footer and close the file(s)
+     * \return true if everything was written
+     */
+    bool Close();
+
+    /**
+     * \brief Get the number of complete rows written so far
+     * \return Row count
+     */
+    uint64_t GetNumRows() const
+    {
+        return m_totalRows;
+    }
+
+    /**
+     * \brief Get the running summary of one column
+     * \param column Column index
+     * \return Summary (as it will appear in the footer)
+     */
+    const ColumnSummary& GetSummary(size_t column) const
+    {
+        return m_summaries[column];
+    }
+
+    /**
+     * \brief Get the binary file path
+     * \return Path given to Open()
+     */
+    const std::string& GetPath() const
+    {
+        return m_path;
+    }
+
+    /**
+     * \brief Get the column value bytes flushed so far (before compression)
+     * \return Byte count
+     */
+    uint64_t GetValueBytes() const
+    {
+        return m_valueBytes;
+    }
+
+    /**
+     * \brief Get the memory held by the row-group and CSV buffers
+     * \return Bytes (excludes row groups queued for the writer thread)
+     */
+    uint64_t GetBufferBytes() const
+    {
+        uint64_t bytes = m_csvBuffer.capacity() + m_fileBuffer.capacity();
+        for (const auto& column : m_columns)
+        {
+            bytes += column.capacity();
+        }
+        return bytes;
+    }
+
+    /**
+     * \brief Get the size of the binary file
+     * \return Byte count (complete after Close())
+     */
+    uint64_t GetFileBytes() const
+    {
+        return m_offset;
+    }
+
+    /**
+     * \brief Decode one column of a compressed row group
+     * \param column Column declaration from the header
+     * \param deltaStride Delta stride from the header
+     * \param rows Rows of the row group
+     * \param frame Frame of the column
+     * \param size Frame size
+     * \param values Decoded values (rows x u32/u64/f64, replaced)
+     * \return false if the frame is damaged or does not match rows
+     */
+    static bool DecodeColumn(const Column& column,
+                             uint32_t deltaStride,
+                             uint32_t rows,
+                             const uint8_t* frame,
+                             size_t size,
+                             std::vector<uint8_t>& values);
+
+  private:
+    /**
+     * \brief Append one raw value to the current column
+     * \param raw Value in the column's storage type
+     * \param asDouble Value for the summary
+     */
+    template <typename V>
+    void Store(V raw, double asDouble)
+    {
+        std::vector<uint8_t>& buffer = m_columns[m_cursor];
+        size_t at = buffer.size();
+        buffer.resize(at + sizeof(V));
+        std::memcpy(buffer.data() + at, &raw, sizeof(V));
+        Summarize(asDouble);
+        if (m_csv)
+        {
+            AppendCsv(raw);
+        }
+        ++m_cursor;
+    }
+
+    /**
+     * \brief Fold a value into the current column's summary
+     * \param value Value
+     */
+    void Summarize(double value);
+
+    /**
+     * \brief Append one value to the CSV buffer
+     * \param value Value
+     */
+    void AppendCsv(uint32_t value);
+    void AppendCsv(uint64_t value);
+    void AppendCsv(double value);
+
+    /**
+     * \brief Write the buffered rows as one row group
+     * \return true on success
+     */
+    bool FlushRowGroup();
+
+    /**
+     * \brief Encode and write one compressed row group (writer thread)
+     * \param columns Column buffers of the group
+     * \param rows Rows of the group
+     */
+    void WriteCompressedGroup(const std::vector<std::vector<uint8_t>>& columns, uint32_t rows);
+
+    /**
+     * \brief Delta-encode one column into byte planes
+     * \param column Column declaration
+     * \param deltaStride Delta stride
+     * \param values Raw values
+     * \param rows Value count
+     * \param planes Encoded bytes (replaced)
+     */
+    static void EncodeColumn(const Column& column,
+                             uint32_t deltaStride,
+                             const uint8_t* values,
+                             uint32_t rows,
+                             std::vector<uint8_t>& planes);
+
+    /**
+     * \brief Write the CSV buffer to the CSV file
+     */
+    void FlushCsv();
+
+    /**
+     * \brief Write bytes, recording failures
+     * \param data Bytes
+     * \param size Byte count
+     */
+    void Write(const void* data, size_t size);
+
+    /**
+     * \brief Write a u16-length-prefixed string
+     * \param text String
+     */
+    void WriteString(const std::string& text);
+
+    std::string m_path;                          ///< Binary file path
+    std::FILE* m_file;                           ///< Binary file
+    std::FILE* m_csv;                            ///< CSV file (nullptr if none)
+    std::vector<char> m_fileBuffer;              ///< stdio buffer of m_file
+    std::vector<Column> m_schema;                ///< Columns
+    std::vector<std::vector<uint8_t>> m_columns; ///< Current row group, per column
+    std::vector<ColumnSummary> m_summaries;      ///< Footer summaries
+    std::vector<uint64_t> m_groupOffsets;        ///< Row group file offsets
+    std::string m_csvBuffer;                     ///< Pending CSV text
+    uint32_t m_rowGroupRows;                     ///< Rows per row group
+    uint32_t m_groupRows;                        ///< Rows in the current group
+    uint64_t m_totalRows;                        ///< Complete rows
+    uint64_t m_valueBytes;                       ///< Column bytes flushed
+    std::atomic<uint64_t> m_offset;              ///< Bytes written to m_file
+    size_t m_cursor;                             ///< Column of the next Put()
+    std::atomic<bool> m_ok;                      ///< No write error so far
+    bool m_compress;                             ///< Compressed format selected
+    uint32_t m_deltaStride;                      ///< Delta stride (compressed)
+    std::unique_ptr<NrBackgroundWriter> m_writer; ///< Encodes row groups (compressed)
+};
+
+/**
+ * \brief Sequential reader of column-oriented results files
+ *
+ * Reads the header, then the row groups in file order until the footer,
+ * or until the end of a file that was never closed. Compressed row
+ * groups are decoded with NrColumnarWriter::DecodeColumn(), so quantized
+ * columns come back as multiples of their quantum.
+ */
+class NrColumnarReader
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrColumnarReader();
+
+    /**
+     * \brief Destructor (closes the file)
+     */
+    ~NrColumnarReader();
+
+    NrColumnarReader(const NrColumnarReader&) = delete;
+    NrColumnarReader& operator=(const NrColumnarReader&) = delete;
+
+    /**
+     * \brief Open a file and read its header
+     * \param path Binary columnar file (format version 1 or 2)
+     * \return false if the file is unreadable or not a columnar file
+     *         (GetError() says why)
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * \brief Read the next row group
+     * \param rows Rows of the group
+     * \param columns One buffer per column (rows x u32/u64/f64, replaced)
+     * \return false at the footer, at the end of an unclosed file, or on
+     *         damage (GetError() is then set)
+     */
+    bool ReadRowGroup(uint32_t& rows, std::vector<std::vector<uint8_t>>& columns);
+
+    /**
+     * \brief Close the file
+     */
+    void Close();
+
+    /**
+     * \brief Get the format version
+     * \return 1 (plain) or 2 (compressed)
+     */
+    uint32_t GetVersion() const
+    {
+        return m_version;
+    }
+
+    /**
+     * \brief Get the table name
+     * \return Name stored in the header
+     */
+    const std::string& GetTable() const
+    {
+        return m_table;
+    }
+
+    /**
+     * \brief Get the columns
+     * \return Schema, with the quantum of each column (version 2)
+     */
+    const std::vector<NrColumnarWriter::Column>& GetSchema() const
+    {
+        return m_schema;
+    }
+
+    /**
+     * \brief Get the delta stride
+     * \return Stride from the header (1 for version 1)
+     */
+    uint32_t GetDeltaStride() const
+    {
+        return m_deltaStride;
+    }
+
+    /**
+     * \brief Check whether the footer was reached
+     * \return true if the writer closed the file and every group was read
+     */
+    bool IsComplete() const
+    {
+        return m_complete;
+    }
+
+    /**
+     * \brief Get the reason the last Open() or ReadRowGroup() failed
+     * \return Reason, or "" if the file ended cleanly
+     */
+    const std::string& GetError() const
+    {
+        return m_error;
+    }
+
+    /**
+     * \brief Print a columnar file as tab-separated text
+     * \param path Binary columnar file
+     * \param os Output (a header line of column names, then one line per row)
+     * \param error Reason on failure (may be null)
+     * \return false if the file is unreadable, not a columnar file or
+     *         damaged (rows before the damage are printed)
+     */
+    static bool ConvertToText(const std::string& path, std::ostream& os, std::string* error);
+
+  private:
+    /**
+     * \brief Read bytes, failing on a short read
+     * \param data Destination
+     * \param size Byte count
+     * \return true if all bytes were read
+     */
+    bool Read(void* data, size_t size);
+
+    /**
+     * \brief Read a u16-length-prefixed string
+     * \param text Destination
+     * \return true on success
+     */
+    bool ReadString(std::string& text);
+
+    std::FILE* m_file;                             ///< Open file
+    uint32_t m_version;                            ///< Format version
+    std::string m_table;                           ///< Table name
+    std::vector<NrColumnarWriter::Column> m_schema; ///< Columns
+    uint32_t m_deltaStride;                        ///< Delta stride (version 2)
+    bool m_complete;                               ///< Footer reached
+    std::string m_error;                           ///< Last failure
+    std::vector<uint8_t> m_frame;                  ///< Scratch: one compressed column
+};
+
+} // namespace ns3
+
+#endif /* NR_COLUMNAR_WRITER_H */
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Event Log - Implementation File
+ */
+
+#include "nr-event-log.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace ns3
+{
+
+const char*
+NrEventTypeToString(NrEventType type)
+{
+    switch (type)
+    {
+    case NrEventType::ATTACHMENT:
+        return "attachment";
+    case NrEventType::HANDOVER:
+        return "handover";
+    case NrEventType::TELEMETRY_BUDGET:
+        return "telemetry_budget";
+    default:
+        return "event";
+    }
+}
+
+// ============================================================================
+// RING
+// ============================================================================
+
+NrEventLog::NrEventLog(size_t capacity)
+    : m_ring(capacity),
+      m_head(0),
+      m_size(0),
+      m_texts(1),
+      m_textIds()
+{
+}
+
+void
+NrEventLog::SetCapacity(size_t capacity)
+{
+    if (capacity == m_ring.size())
+    {
+        return;
+    }
+    std::vector<NrEventRecord> kept;
+    CopyTo(kept);
+    if (kept.size() > capacity)
+    {
+        kept.erase(kept.begin(), kept.end() - capacity);
+    }
+
+    m_size = kept.size();
+    kept.resize(capacity);
+    m_ring.swap(kept);
+    m_head = (capacity == 0) ? 0 : m_size % capacity;
+}
+
+void
+NrEventLog::CopyTo(std::vector<NrEventRecord>& out) const
+{
+    out.clear();
+    out.reserve(m_size);
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        out.push_back(At(i));
+    }
+}
+
+// ============================================================================
+// INTERNED TEXT
+// ============================================================================
+
+uint32_t
+NrEventLog::Intern(const std::string& text)
+{
+    auto it = m_textIds.find(text);
+    if (it != m_textIds.end())
+    {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(m_texts.size());
+    m_texts.push_back(text);
+    m_textIds.emplace(text, id);
+    return id;
+}
+
+const std::string&
+NrEventLog::GetText(uint32_t id) const
+{
+    return (id < m_texts.size()) ? m_texts[id] : m_texts[0];
+}
+
+// ============================================================================
+// FORMATTING
+// ============================================================================
+
+std::string
+NrEventLog::Describe(const NrEventRecord& event) const
+{
+    std::ostringstream desc;
+    switch (event.type)
+    {
+    case NrEventType::ATTACHMENT:
+        desc << "UE " << event.ueId << " attached to cell " << event.cellId;
+        break;
+    case NrEventType::HANDOVER:
+        desc << "UE " << event.ueId << " handover " << event.cellId << " → "
+             << event.targetCellId << (event.success ? " ✓" : " ✗");
+        break;
+    case NrEventType::TELEMETRY_BUDGET:
+        desc << "Telemetry tick " << std::fixed << std::setprecision(2) << event.value
+             << " ms > budget " << event.threshold << " ms, disabled " << GetText(event.textId);
+        break;
+    default:
+        desc << GetText(event.textId);
+        break;
+    }
+    return desc.str();
+}
+
+} // namespace ns3
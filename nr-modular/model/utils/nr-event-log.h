@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Event Log - Header File
+ *
+ * Fixed-capacity ring of typed simulation events (attachments, handovers,
+ * telemetry budget actions). Recording an event copies a 40-byte record
+ * into a preallocated slot; the human-readable description is only built
+ * when the log is published (Describe()).
+ *
+ * Free text that does not fit the typed payload (e.g. the name of a
+ * disabled telemetry field) is interned once and referenced by id, so
+ * repeated texts cost no allocation either. Intern only texts from a
+ * small set - the table is never pruned.
+ */
+
+#ifndef NR_EVENT_LOG_H
+#define NR_EVENT_LOG_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Kinds of logged simulation events
+ */
+enum class NrEventType : uint8_t
+{
+    ATTACHMENT,        ///< ueId attached to cellId
+    HANDOVER,          ///< ueId moved cellId → targetCellId (success flag)
+    TELEMETRY_BUDGET,  ///< Tick of value ms over threshold ms disabled text
+    GENERIC            ///< Free text only
+};
+
+/**
+ * \brief Get the wire name of an event type
+ * \param type Event type
+ * \return "attachment", "handover", "telemetry_budget" or "event"
+ */
+const char* NrEventTypeToString(NrEventType type);
+
+/**
+ * \brief One logged event (trivially copyable)
+ */
+struct NrEventRecord
+{
+    double timestamp = 0.0;         ///< Simulation time (s)
+    double value = 0.0;             ///< Type-specific measurement
+    double threshold = 0.0;         ///< Type-specific limit
+    uint32_t ueId = 0;              ///< UE involved
+    uint32_t textId = 0;            ///< Interned text (0 = none)
+    uint16_t cellId = 0;            ///< (Source) cell
+    uint16_t targetCellId = 0;      ///< Target cell (handover)
+    NrEventType type = NrEventType::GENERIC;  ///< Event type
+    bool success = false;           ///< Outcome (handover)
+};
+
+/**
+ * \brief Preallocated ring of NrEventRecord with a string intern table
+ */
+class NrEventLog
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param capacity Events kept (oldest are overwritten)
+     */
+    explicit NrEventLog(size_t capacity = 100);
+
+    /**
+     * \brief Change the capacity, keeping the newest events
+     * \param capacity Events kept
+     */
+    void SetCapacity(size_t capacity);
+
+    /**
+     * \brief Get the capacity
+     * \return Events kept
+     */
+    size_t GetCapacity() const
+    {
+        return m_ring.size();
+    }
+
+    /**
+     * \brief Record an event, overwriting the oldest when full
+     * \param event Event
+     */
+    void Record(const NrEventRecord& event)
+    {
+        if (m_ring.empty())
+        {
+            return;
+        }
+        m_ring[m_head] = event;
+        m_head = (m_head + 1 == m_ring.size()) ? 0 : m_head + 1;
+        m_size += (m_size < m_ring.size()) ? 1 : 0;
+    }
+
+    /**
+     * \brief Get the number of events held
+     * \return Event count (<= capacity)
+     */
+    size_t GetSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * \brief Get an event, oldest first
+     * \param i Index in [0, GetSize())
+     * \return Event
+     */
+    const NrEventRecord& At(size_t i) const
+    {
+        size_t start = (m_head + m_ring.size() - m_size) % m_ring.size();
+        return m_ring[(start + i) % m_ring.size()];
+    }
+
+    /**
+     * \brief Copy the held events, oldest first
+     * \param out Destination (its capacity is reused)
+     */
+    void CopyTo(std::vector<NrEventRecord>& out) const;
+
+    /**
+     * \brief Drop all events (interned strings are kept)
+     */
+    void Clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    /**
+     * \brief Intern a text
+     * \param text Text
+     * \return Id (> 0), the same for equal texts
+     */
+    uint32_t Intern(const std::string& text);
+
+    /**
+     * \brief Look up an interned text
+     * \param id Id from Intern()
+     * \return Text ("" for 0 or unknown ids)
+     */
+    const std::string& GetText(uint32_t id) const;
+
+    /**
+     * \brief Format the human-readable description of an event
+     * \param event Event
+     * \return Description, e.g. "UE 3 handover 1 → 2 ✓"
+     */
+    std::string Describe(const NrEventRecord& event) const;
+
+  private:
+    std::vector<NrEventRecord> m_ring;                    ///< Preallocated slots
+    size_t m_head;                                        ///< Next slot to write
+    size_t m_size;                                        ///< Events held
+    std::vector<std::string> m_texts;                     ///< Id → text (id 0 = "")
+    std::unordered_map<std::string, uint32_t> m_textIds;  ///< Text → id
+};
+
+} // namespace ns3
+
+#endif /* NR_EVENT_LOG_H */
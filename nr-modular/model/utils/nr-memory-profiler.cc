@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Memory Profiler - Implementation File
+ */
+
+#include "nr-memory-profiler.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iomanip>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMemoryProfiler");
+
+namespace
+{
+
+constexpr double MIB = 1024.0 * 1024.0;
+
+/**
+ * Resident set size from /proc/self/statm (0 if unavailable)
+ */
+uint64_t
+GetRssBytes()
+{
+    std::FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr)
+    {
+        return 0;
+    }
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    int fields = std::fscanf(statm, "%llu %llu", &size, &resident);
+    std::fclose(statm);
+    return fields == 2 ? resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) : 0;
+}
+
+/**
+ * Metric name fragment: lower case, [a-z0-9_] only
+ */
+std::string
+MetricName(const std::string& text)
+{
+    std::string name;
+    for (char c : text)
+    {
+        name += std::isalnum(static_cast<unsigned char>(c))
+                    ? static_cast<char>(std::tolower(static_cast<unsigned char>(c)))
+                    : '_';
+    }
+    return name;
+}
+
+} // namespace
+
+// ============================================================================
+// SCOPE
+// ============================================================================
+
+NrMemoryProfiler::Scope::Scope(const char* tag)
+    : m_active(NrMemoryProfiler::Get().IsEnabled())
+{
+    if (m_active)
+    {
+        NrMemoryProfiler::Get().Begin(tag);
+    }
+}
+
+NrMemoryProfiler::Scope::~Scope()
+{
+    if (m_active)
+    {
+        NrMemoryProfiler::Get().End();
+    }
+}
+
+// ============================================================================
+// PROFILER
+// ============================================================================
+
+NrMemoryProfiler&
+NrMemoryProfiler::Get()
+{
+    static NrMemoryProfiler profiler;
+    return profiler;
+}
+
+NrMemoryProfiler::NrMemoryProfiler()
+    : m_enabled(false),
+      m_baselineHeap(0)
+{
+}
+
+void
+NrMemoryProfiler::Enable(bool enable)
+{
+    if (enable && !m_enabled)
+    {
+        m_baselineHeap = GetHeapBytes();
+        NS_LOG_INFO("Memory profiling on, heap baseline " << m_baselineHeap << " bytes");
+    }
+    m_enabled = enable;
+}
+
+void
+NrMemoryProfiler::Begin(const char* tag)
+{
+    m_stack.push_back({tag, GetHeapBytes(), 0});
+}
+
+void
+NrMemoryProfiler::End()
+{
+    if (m_stack.empty())
+    {
+        return;  // Enabled while the scope was open
+    }
+    Frame frame = m_stack.back();
+    m_stack.pop_back();
+
+    int64_t inclusive =
+        static_cast<int64_t>(GetHeapBytes()) - static_cast<int64_t>(frame.startHeap);
+    auto it = std::find_if(m_scopes.begin(), m_scopes.end(), [&](const auto& entry) {
+        return entry.first == frame.tag;
+    });
+    if (it == m_scopes.end())
+    {
+        m_scopes.emplace_back(frame.tag, ScopeTotal());
+        it = m_scopes.end() - 1;
+    }
+    it->second.bytes += inclusive - frame.childBytes;
+    it->second.calls++;
+
+    if (!m_stack.empty())
+    {
+        m_stack.back().childBytes += inclusive;
+    }
+}
+
+void
+NrMemoryProfiler::SetContainers(const std::string& component,
+                                const std::vector<NrMemoryItem>& items)
+{
+    for (auto& entry : m_containers)
+    {
+        if (entry.first == component)
+        {
+            entry.second = items;
+            return;
+        }
+    }
+    m_containers.emplace_back(component, items);
+}
+
+// ============================================================================
+// HEAP QUERIES
+// ============================================================================
+
+uint64_t
+NrMemoryProfiler::GetHeapBytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();  // int fields, wrap above 2 GiB
+    return static_cast<uint32_t>(info.uordblks) + static_cast<uint32_t>(info.hblkhd);
+#else
+    return GetRssBytes();
+#endif
+}
+
+uint64_t
+NrMemoryProfiler::GetPeakRssBytes()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return usage.ru_maxrss;  // bytes on macOS
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // KiB on Linux
+#endif
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+void
+NrMemoryProfiler::Print(std::ostream& os, uint32_t numUes) const
+{
+    uint64_t heap = GetHeapBytes();
+    int64_t growth = static_cast<int64_t>(heap) - static_cast<int64_t>(m_baselineHeap);
+    double perUe = numUes ? 1.0 / numUes : 0.0;
+
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+    os << "\n========================================\n";
+    os << "MEMORY FOOTPRINT\n";
+    os << "========================================\n";
+    os << "  Heap in use: " << heap / MIB << " MiB (+" << growth / MIB
+       << " MiB while profiling), RSS " << GetRssBytes() / MIB << " MiB (peak "
+       << GetPeakRssBytes() / MIB << " MiB), " << numUes << " UEs\n\n";
+
+    os << "  Phase                    Heap MiB  Scopes     KiB/UE\n";
+    int64_t tagged = 0;
+    for (const auto& [tag, total] : m_scopes)
+    {
+        tagged += total.bytes;
+        os << "  " << std::left << std::setw(22) << tag << std::right << std::setw(10)
+           << total.bytes / MIB << std::setw(8) << total.calls << std::setw(11)
+           << total.bytes / 1024.0 * perUe << "\n";
+    }
+    os << "  " << std::left << std::setw(22) << "(outside scopes)" << std::right << std::setw(10)
+       << (growth - tagged) / MIB << std::setw(8) << "-" << std::setw(11)
+       << (growth - tagged) / 1024.0 * perUe << "\n";
+
+    if (!m_containers.empty())
+    {
+        os << "\n  Container                         MiB          Items   Bytes/item\n";
+        for (const auto& [component, items] : m_containers)
+        {
+            for (const auto& item : items)
+            {
+                std::string count = std::to_string(item.count) + " " + item.unit;
+                os << "  " << std::left << std::setw(30) << (component + "." + item.name)
+                   << std::right << std::setw(7) << item.bytes / MIB << std::setw(15) << count
+                   << std::setw(13)
+                   << (item.count ? static_cast<double>(item.bytes) / item.count : 0.0) << "\n";
+            }
+        }
+    }
+    os << "========================================\n" << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void
+NrMemoryProfiler::AddMetrics(std::map<std::string, double>& metrics, uint32_t numUes) const
+{
+    uint64_t heap = GetHeapBytes();
+    metrics["mem_heap_mib"] = heap / MIB;
+    metrics["mem_peak_rss_mib"] = GetPeakRssBytes() / MIB;
+    if (numUes > 0)
+    {
+        double growth = static_cast<double>(heap) - static_cast<double>(m_baselineHeap);
+        metrics["mem_per_ue_kib"] = growth / 1024.0 / numUes;
+    }
+    for (const auto& [tag, total] : m_scopes)
+    {
+        metrics["mem_scope_" + MetricName(tag) + "_mib"] = total.bytes / MIB;
+    }
+
+    // Per-item cost of each container kind, summed over components
+    // (e.g. plan bytes per slot across all BWPs)
+    std::map<std::string, std::pair<uint64_t, uint64_t>> byItem;
+    for (const auto& [component, items] : m_containers)
+    {
+        for (const auto& item : items)
+        {
+            std::string name = MetricName(item.name);
+            metrics["mem_" + MetricName(component) + "_" + name + "_mib"] = item.bytes / MIB;
+            byItem[name].first += item.bytes;
+            byItem[name].second += item.count;
+        }
+    }
+    for (const auto& [name, sum] : byItem)
+    {
+        if (sum.second > 0)
+        {
+            metrics["mem_" + name + "_bytes_per_item"] =
+                static_cast<double>(sum.first) / sum.second;
+        }
+    }
+}
+
+} // namespace ns3
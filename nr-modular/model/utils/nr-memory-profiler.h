@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Memory Profiler - Header File
+ *
+ * Attributes heap usage to subsystems for capacity planning
+ * (metrics.memoryProfile). Two sources:
+ *
+ * - Scopes: an NrMemoryProfiler::Scope around a phase (topology,
+ *   NR devices, MILP plans, traffic apps, the simulation run) charges
+ *   the phase with the growth of the process heap while it was open.
+ *   This sees everything ns-3 allocates in the phase (nodes, devices,
+ *   PHYs, applications, trace sinks), which container accounting cannot.
+ *   Nested scopes are exclusive: a parent is only charged for what its
+ *   children did not allocate.
+ * - Containers: managers report the bytes held by their major
+ *   containers (GetMemoryUsage()) with an item count, so the report
+ *   shows the cost per slot, per state or per UE.
+ *
+ * Heap figures are the allocator's bytes in use (glibc mallinfo2(),
+ * mallinfo() before 2.33), process-wide - background threads count too.
+ * Without glibc the resident set size is used instead. Container sizes
+ * are estimates: element storage plus the usual node overhead of the
+ * standard containers.
+ *
+ * Disabled by default; a Scope then costs one branch. Scopes are only
+ * opened on the simulator thread.
+ */
+
+#ifndef NR_MEMORY_PROFILER_H
+#define NR_MEMORY_PROFILER_H
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Size of one container, as reported by a manager
+ */
+struct NrMemoryItem
+{
+    std::string name;    ///< Container
+    uint64_t bytes = 0;  ///< Estimated bytes held
+    uint64_t count = 0;  ///< Items held
+    std::string unit;    ///< What an item is ("slots", "states", "UEs", ...)
+};
+
+/**
+ * \brief Process-wide heap attribution by phase and container
+ */
+class NrMemoryProfiler
+{
+  public:
+    /**
+     * \brief Charges heap growth to a tag while in scope
+     */
+    class Scope
+    {
+      public:
+        /**
+         * \brief Open the scope
+         * \param tag Subsystem charged (repeated tags accumulate)
+         */
+        explicit Scope(const char* tag);
+
+        /**
+         * \brief Close the scope and charge the growth
+         */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        bool m_active;  ///< Profiler was enabled at open
+    };
+
+    /**
+     * \brief Get the process-wide profiler
+     * \return Profiler instance
+     */
+    static NrMemoryProfiler& Get();
+
+    /**
+     * \brief Switch profiling on or off
+     * \param enable true to record scopes
+     *
+     * Enabling takes the heap baseline the report compares against.
+     */
+    void Enable(bool enable);
+
+    /**
+     * \brief Check whether profiling is on
+     * \return true if scopes are recorded
+     */
+    bool IsEnabled() const
+    {
+        return m_enabled;
+    }
+
+    /**
+     * \brief Record the containers of one component (replaces earlier ones)
+     * \param component Component name, e.g. "bwp0" or "output"
+     * \param items Container sizes
+     */
+    void SetContainers(const std::string& component, const std::vector<NrMemoryItem>& items);
+
+    /**
+     * \brief Print the scope and container tables
+     * \param os Output stream
+     * \param numUes UEs of the run (for the per-UE column)
+     */
+    void Print(std::ostream& os, uint32_t numUes) const;
+
+    /**
+     * \brief Add mem_* profiling metrics (for the results store)
+     * \param metrics Destination
+     * \param numUes UEs of the run
+     */
+    void AddMetrics(std::map<std::string, double>& metrics, uint32_t numUes) const;
+
+    /**
+     * \brief Get the heap bytes in use
+     * \return Allocator bytes in use (RSS without glibc)
+     */
+    static uint64_t GetHeapBytes();
+
+    /**
+     * \brief Get the peak resident set size of the process
+     * \return Bytes
+     */
+    static uint64_t GetPeakRssBytes();
+
+    // ========================================================================
+    // CONTAINER SIZE ESTIMATES
+    // ========================================================================
+
+    /**
+     * \brief Estimate the storage of a vector
+     * \param v Vector
+     * \return Capacity x element size
+     */
+    template <typename T>
+    static uint64_t VectorBytes(const std::vector<T>& v)
+    {
+        return v.capacity() * sizeof(T);
+    }
+
+    /**
+     * \brief Estimate the storage of a std::map / std::set
+     * \param m Container
+     * \return Size x (element + tree node overhead)
+     */
+    template <typename M>
+    static uint64_t TreeBytes(const M& m)
+    {
+        return m.size() * (sizeof(typename M::value_type) + TREE_NODE_BYTES);
+    }
+
+    /**
+     * \brief Estimate the storage of a std::unordered_map / unordered_set
+     * \param m Container
+     * \return Size x (element + hash node overhead) + bucket array
+     */
+    template <typename M>
+    static uint64_t HashBytes(const M& m)
+    {
+        return m.size() * (sizeof(typename M::value_type) + HASH_NODE_BYTES) +
+               m.bucket_count() * sizeof(void*);
+    }
+
+  private:
+    static const uint64_t TREE_NODE_BYTES = 32;  ///< Colour + 3 links (libstdc++)
+    static const uint64_t HASH_NODE_BYTES = 16;  ///< Next link + cached hash
+
+    /**
+     * \brief Private constructor (use Get())
+     */
+    NrMemoryProfiler();
+
+    /**
+     * \brief Push a scope
+     * \param tag Subsystem
+     */
+    void Begin(const char* tag);
+
+    /**
+     * \brief Pop the innermost scope and charge its growth
+     */
+    void End();
+
+    /**
+     * \brief One open scope
+     */
+    struct Frame
+    {
+        std::string tag;      ///< Subsystem
+        uint64_t startHeap;   ///< Heap at open
+        int64_t childBytes;   ///< Growth charged to nested scopes
+    };
+
+    /**
+     * \brief Accumulated growth of one tag
+     */
+    struct ScopeTotal
+    {
+        int64_t bytes = 0;   ///< Exclusive heap growth
+        uint32_t calls = 0;  ///< Scopes closed
+    };
+
+    bool m_enabled;                                  ///< Scopes are recorded
+    uint64_t m_baselineHeap;                         ///< Heap when enabled
+    std::vector<Frame> m_stack;                      ///< Open scopes
+    std::vector<std::pair<std::string, ScopeTotal>> m_scopes; ///< By first use
+    std::vector<std::pair<std::string, std::vector<NrMemoryItem>>> m_containers; ///< By component
+};
+
+} // namespace ns3
+
+#endif /* NR_MEMORY_PROFILER_H */
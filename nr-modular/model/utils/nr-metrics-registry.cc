@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Metrics Registry - Implementation File
+ */
+
+#include "nr-metrics-registry.h"
+
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMetricsRegistry");
+
+namespace
+{
+
+bool
+IsValidMetricName(const std::string& name)
+{
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+    {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == ':';
+    });
+}
+
+/// Prometheus float, with +Inf/-Inf/NaN spelled out
+std::string
+FormatValue(double value)
+{
+    if (std::isnan(value))
+    {
+        return "NaN";
+    }
+    if (std::isinf(value))
+    {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    std::ostringstream oss;
+    oss << std::setprecision(15) << value;
+    return oss.str();
+}
+
+/// name{labels} with an optional extra label appended
+std::string
+Series(const std::string& name, const std::string& labels, const std::string& extra = "")
+{
+    std::string all = labels;
+    if (!extra.empty())
+    {
+        all += (all.empty() ? "" : ",") + extra;
+    }
+    return all.empty() ? name : name + "{" + all + "}";
+}
+
+/// Atomic add for doubles (no fetch_add before C++20)
+void
+AtomicAdd(std::atomic<double>& target, double delta)
+{
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current,
+                                         current + delta,
+                                         std::memory_order_relaxed,
+                                         std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// METRIC TYPES
+// ============================================================================
+
+void
+NrMetricGauge::Add(double delta)
+{
+    AtomicAdd(m_value, delta);
+}
+
+NrMetricHistogram::NrMetricHistogram(const std::vector<double>& bounds)
+    : m_bounds(bounds),
+      m_buckets(new std::atomic<uint64_t>[bounds.size() + 1])
+{
+    NS_ABORT_MSG_IF(!std::is_sorted(m_bounds.begin(), m_bounds.end()) ||
+                        std::adjacent_find(m_bounds.begin(), m_bounds.end()) != m_bounds.end(),
+                    "Histogram bucket bounds must be strictly increasing");
+    for (size_t i = 0; i <= m_bounds.size(); ++i)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void
+NrMetricHistogram::Observe(double value)
+{
+    // Bucket i counts values in (bounds[i-1], bounds[i]]
+    size_t i = std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin();
+    m_buckets[i].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    AtomicAdd(m_sum, value);
+}
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+NrMetricsRegistry&
+NrMetricsRegistry::Get()
+{
+    static NrMetricsRegistry registry;
+    return registry;
+}
+
+NrMetricsRegistry::NrMetricsRegistry()
+    : m_families()
+{
+}
+
+NrMetricsRegistry::~NrMetricsRegistry()
+{
+    StopExporters();
+}
+
+NrMetricsRegistry::Family&
+NrMetricsRegistry::GetFamily(const std::string& name, const std::string& help, Type type)
+{
+    NS_ABORT_MSG_IF(!IsValidMetricName(name), "Invalid metric name '" << name << "'");
+
+    auto it = m_families.find(name);
+    if (it == m_families.end())
+    {
+        Family family;
+        family.type = type;
+        family.help = help;
+        it = m_families.emplace(name, std::move(family)).first;
+    }
+    NS_ABORT_MSG_IF(it->second.type != type,
+                    "Metric '" << name << "' already registered with another type");
+    return it->second;
+}
+
+NrMetricCounter*
+NrMetricsRegistry::GetCounter(const std::string& name,
+                              const std::string& help,
+                              const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& slot = GetFamily(name, help, COUNTER).counters[labels];
+    if (!slot)
+    {
+        slot = std::make_unique<NrMetricCounter>();
+    }
+    return slot.get();
+}
+
+NrMetricGauge*
+NrMetricsRegistry::GetGauge(const std::string& name,
+                            const std::string& help,
+                            const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& slot = GetFamily(name, help, GAUGE).gauges[labels];
+    if (!slot)
+    {
+        slot = std::make_unique<NrMetricGauge>();
+    }
+    return slot.get();
+}
+
+NrMetricHistogram*
+NrMetricsRegistry::GetHistogram(const std::string& name,
+                                const std::string& help,
+                                const std::vector<double>& bounds,
+                                const std::string& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& slot = GetFamily(name, help, HISTOGRAM).histograms[labels];
+    if (!slot)
+    {
+        slot = std::make_unique<NrMetricHistogram>(bounds);
+    }
+    return slot.get();
+}
+
+size_t
+NrMetricsRegistry::GetNumSeries() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t n = 0;
+    for (const auto& [name, family] : m_families)
+    {
+        n += family.counters.size() + family.gauges.size() + family.histograms.size();
+    }
+    return n;
+}
+
+// ============================================================================
+// EXPOSITION
+// ============================================================================
+
+void
+NrMetricsRegistry::WriteExposition(std::ostream& os) const
+{
+    static const char* TYPE_NAMES[] = {"counter", "gauge", "histogram"};
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [name, family] : m_families)
+    {
+        os << "# HELP " << name << " " << family.help << "\n";
+        os << "# TYPE " << name << " " << TYPE_NAMES[family.type] << "\n";
+
+        for (const auto& [labels, counter] : family.counters)
+        {
+            os << Series(name, labels) << " " << counter->Get() << "\n";
+        }
+        for (const auto& [labels, gauge] : family.gauges)
+        {
+            os << Series(name, labels) << " " << FormatValue(gauge->Get()) << "\n";
+        }
+        for (const auto& [labels, histogram] : family.histograms)
+        {
+            const std::vector<double>& bounds = histogram->GetBounds();
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i <= bounds.size(); ++i)
+            {
+                cumulative += histogram->GetBucketCount(i);
+                std::string le = (i < bounds.size()) ? FormatValue(bounds[i]) : "+Inf";
+                os << Series(name + "_bucket", labels, "le=\"" + le + "\"") << " " << cumulative
+                   << "\n";
+            }
+            // Count matches the +Inf bucket even while observations race in
+            os << Series(name + "_sum", labels) << " " << FormatValue(histogram->GetSum())
+               << "\n";
+            os << Series(name + "_count", labels) << " " << cumulative << "\n";
+        }
+    }
+}
+
+std::string
+NrMetricsRegistry::GetExposition() const
+{
+    std::ostringstream oss;
+    WriteExposition(oss);
+    return oss.str();
+}
+
+// ============================================================================
+// EXPORTERS
+// ============================================================================
+
+bool
+NrMetricsRegistry::StartHttpServer(uint16_t port)
+{
+    std::lock_guard<std::mutex> lock(m_exportMutex);
+    NS_ABORT_MSG_IF(m_httpThread.joinable(), "Metrics HTTP server already running");
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        NS_LOG_ERROR("Metrics server socket failed: " << std::strerror(errno));
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(fd, 8) < 0)
+    {
+        NS_LOG_ERROR("Metrics server cannot listen on 127.0.0.1:" << port << ": "
+                     << std::strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    m_httpThread = std::thread(&NrMetricsRegistry::HttpLoop, this, fd);
+    NS_LOG_INFO("Serving metrics on http://127.0.0.1:" << port << "/metrics");
+    return true;
+}
+
+bool
+NrMetricsRegistry::StartFileWriter(const std::string& path, double intervalSeconds)
+{
+    std::lock_guard<std::mutex> lock(m_exportMutex);
+    NS_ABORT_MSG_IF(m_fileThread.joinable(), "Metrics file writer already running");
+    NS_ABORT_MSG_IF(intervalSeconds <= 0.0,
+                    "Metrics file interval must be > 0, got " << intervalSeconds);
+
+    if (!WriteFile(path))
+    {
+        return false;
+    }
+    m_fileThread = std::thread(&NrMetricsRegistry::FileLoop, this, path, intervalSeconds);
+    NS_LOG_INFO("Writing metrics to " << path << " every " << intervalSeconds << " s");
+    return true;
+}
+
+void
+NrMetricsRegistry::StopExporters()
+{
+    std::lock_guard<std::mutex> lock(m_exportMutex);
+    {
+        std::lock_guard<std::mutex> wakeLock(m_wakeupMutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+
+    if (m_httpThread.joinable())
+    {
+        m_httpThread.join();
+    }
+    if (m_fileThread.joinable())
+    {
+        m_fileThread.join();
+    }
+    m_stop = false;
+}
+
+bool
+NrMetricsRegistry::IsExporting() const
+{
+    return m_httpThread.joinable() || m_fileThread.joinable();
+}
+
+void
+NrMetricsRegistry::HttpLoop(int listenFd)
+{
+    struct pollfd pfd;
+    pfd.fd = listenFd;
+    pfd.events = POLLIN;
+
+    while (!m_stop)
+    {
+        // Short poll so a stop request is seen promptly
+        if (poll(&pfd, 1, 200) <= 0)
+        {
+            continue;
+        }
+        int client = accept(listenFd, nullptr, nullptr);
+        if (client < 0)
+        {
+            continue;
+        }
+
+        struct timeval tv;
+        tv.tv_sec = 1;
+        tv.tv_usec = 0;
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+        // Only the request line matters: "GET <path> HTTP/1.x"
+        char buffer[2048];
+        ssize_t n = recv(client, buffer, sizeof(buffer) - 1, 0);
+        std::string request(buffer, n > 0 ? static_cast<size_t>(n) : 0);
+        std::string path;
+        if (request.compare(0, 4, "GET ") == 0)
+        {
+            path = request.substr(4, request.find(' ', 4) - 4);
+        }
+
+        std::string status = "200 OK";
+        std::string body;
+        if (path == "/metrics" || path == "/")
+        {
+            body = GetExposition();
+        }
+        else
+        {
+            status = path.empty() ? "405 Method Not Allowed" : "404 Not Found";
+            body = status + "\n";
+        }
+
+        std::ostringstream response;
+        response << "HTTP/1.1 " << status << "\r\n"
+                 << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                 << "Content-Length: " << body.size() << "\r\n"
+                 << "Connection: close\r\n\r\n"
+                 << body;
+        std::string out = response.str();
+        size_t sent = 0;
+        while (sent < out.size())
+        {
+            ssize_t w = send(client, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+            if (w <= 0)
+            {
+                break;
+            }
+            sent += static_cast<size_t>(w);
+        }
+        close(client);
+    }
+    close(listenFd);
+}
+
+void
+NrMetricsRegistry::FileLoop(std::string path, double intervalSeconds)
+{
+    auto period = std::chrono::duration<double>(intervalSeconds);
+    std::unique_lock<std::mutex> lock(m_wakeupMutex);
+    while (!m_wakeup.wait_for(lock, period, [this] { return m_stop.load(); }))
+    {
+        lock.unlock();
+        WriteFile(path);
+        lock.lock();
+    }
+    lock.unlock();
+
+    // Final snapshot with the end-of-run values
+    WriteFile(path);
+}
+
+bool
+NrMetricsRegistry::WriteFile(const std::string& path) const
+{
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream file(tmp);
+        if (!file.is_open())
+        {
+            NS_LOG_ERROR("Cannot open metrics file " << tmp);
+            return false;
+        }
+        WriteExposition(file);
+        if (!file)
+        {
+            NS_LOG_ERROR("Failed writing metrics file " << tmp);
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        NS_LOG_ERROR("Cannot rename " << tmp << " to " << path << ": " << std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Metrics Registry - Header File
+ *
+ * Module-wide registry of operational metrics (counters, gauges,
+ * histograms) in the Prometheus data model, so long runs can be watched
+ * with standard tooling instead of waiting for the end-of-run prints.
+ *
+ * Threading model:
+ * - Registration (GetCounter/GetGauge/GetHistogram) takes a mutex and is
+ *   done once, typically in a manager's constructor. The returned pointer
+ *   stays valid for the lifetime of the process.
+ * - Updates (Inc/Set/Add/Observe) are relaxed atomics: the simulator
+ *   thread never blocks on an exporter.
+ * - Exporters run on background threads and only read the atomics.
+ *
+ * Exporters:
+ * - StartHttpServer(port): serves GET /metrics on 127.0.0.1:port in the
+ *   Prometheus text exposition format (version 0.0.4)
+ * - StartFileWriter(path, interval): rewrites path atomically (write to
+ *   path.tmp, then rename) every interval seconds and once on stop, for
+ *   the node_exporter textfile collector or plain tail/watch
+ *
+ * Usage:
+ *   NrMetricCounter* solves = NrMetricsRegistry::Get().GetCounter(
+ *       "nr_milp_solutions_total", "MILP solutions received");
+ *   solves->Inc();
+ *
+ * Registering the same name and labels twice returns the same metric, so
+ * several instances of a manager share (and add up into) one series.
+ */
+
+#ifndef NR_METRICS_REGISTRY_H
+#define NR_METRICS_REGISTRY_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+// ============================================================================
+// METRIC TYPES
+// ============================================================================
+
+/**
+ * \brief Monotonic counter
+ */
+class NrMetricCounter
+{
+  public:
+    /**
+     * \brief Increment the counter
+     * \param n Amount to add
+     */
+    void Inc(uint64_t n = 1)
+    {
+        m_value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Get the current value
+     * \return Counter value
+     */
+    uint64_t Get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<uint64_t> m_value{0};  ///< Counter value
+};
+
+/**
+ * \brief Gauge (value that can go up and down)
+ */
+class NrMetricGauge
+{
+  public:
+    /**
+     * \brief Set the gauge
+     * \param value New value
+     */
+    void Set(double value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Add to the gauge
+     * \param delta Amount to add (may be negative)
+     */
+    void Add(double delta);
+
+    /**
+     * \brief Get the current value
+     * \return Gauge value
+     */
+    double Get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<double> m_value{0.0};  ///< Gauge value
+};
+
+/**
+ * \brief Histogram with fixed bucket upper bounds
+ *
+ * Buckets are stored non-cumulatively and accumulated at exposition, so
+ * Observe() is one bucket search plus three relaxed atomic updates.
+ */
+class NrMetricHistogram
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param bounds Strictly increasing bucket upper bounds (+Inf implied)
+     */
+    explicit NrMetricHistogram(const std::vector<double>& bounds);
+
+    /**
+     * \brief Record one observation
+     * \param value Observed value
+     */
+    void Observe(double value);
+
+    /**
+     * \brief Get the bucket upper bounds
+     * \return Bounds (without the implied +Inf)
+     */
+    const std::vector<double>& GetBounds() const
+    {
+        return m_bounds;
+    }
+
+    /**
+     * \brief Get the number of observations in one bucket
+     * \param i Bucket index, GetBounds().size() is the +Inf bucket
+     * \return Non-cumulative count
+     */
+    uint64_t GetBucketCount(size_t i) const
+    {
+        return m_buckets[i].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Get the number of observations
+     * \return Count
+     */
+    uint64_t GetCount() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Get the sum of observations
+     * \return Sum
+     */
+    double GetSum() const
+    {
+        return m_sum.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::vector<double> m_bounds;                        ///< Bucket upper bounds
+    std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;  ///< bounds.size() + 1 buckets
+    std::atomic<uint64_t> m_count{0};                    ///< Observations
+    std::atomic<double> m_sum{0.0};                      ///< Sum of observations
+};
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+/**
+ * \brief Process-wide registry and exporter of operational metrics
+ */
+class NrMetricsRegistry
+{
+  public:
+    /**
+     * \brief Get the process-wide registry
+     * \return Registry instance
+     */
+    static NrMetricsRegistry& Get();
+
+    /**
+     * \brief Destructor (stops the exporters)
+     */
+    ~NrMetricsRegistry();
+
+    NrMetricsRegistry(const NrMetricsRegistry&) = delete;
+    NrMetricsRegistry& operator=(const NrMetricsRegistry&) = delete;
+
+    // ========================================================================
+    // REGISTRATION
+    // ========================================================================
+
+    /**
+     * \brief Register (or look up) a counter
+     * \param name Metric name, [a-zA-Z_:][a-zA-Z0-9_:]*, "_total" suffix by convention
+     * \param help One-line description
+     * \param labels Label set as written in the exposition, e.g. result="ok"
+     * \return Counter, valid for the lifetime of the process
+     *
+     * Aborts if the name is already registered with another type.
+     */
+    NrMetricCounter* GetCounter(const std::string& name,
+                                const std::string& help,
+                                const std::string& labels = "");
+
+    /**
+     * \brief Register (or look up) a gauge
+     * \param name Metric name
+     * \param help One-line description
+     * \param labels Label set, e.g. direction="dl"
+     * \return Gauge, valid for the lifetime of the process
+     */
+    NrMetricGauge* GetGauge(const std::string& name,
+                            const std::string& help,
+                            const std::string& labels = "");
+
+    /**
+     * \brief Register (or look up) a histogram
+     * \param name Metric name
+     * \param help One-line description
+     * \param bounds Bucket upper bounds (ignored if the series exists)
+     * \param labels Label set
+     * \return Histogram, valid for the lifetime of the process
+     */
+    NrMetricHistogram* GetHistogram(const std::string& name,
+                                    const std::string& help,
+                                    const std::vector<double>& bounds,
+                                    const std::string& labels = "");
+
+    /**
+     * \brief Get the number of registered series
+     * \return Series count over all metric names
+     */
+    size_t GetNumSeries() const;
+
+    // ========================================================================
+    // EXPOSITION
+    // ========================================================================
+
+    /**
+     * \brief Write all metrics in the Prometheus text format
+     * \param os Output stream
+     */
+    void WriteExposition(std::ostream& os) const;
+
+    /**
+     * \brief Get all metrics in the Prometheus text format
+     * \return Exposition text
+     */
+    std::string GetExposition() const;
+
+    // ========================================================================
+    // EXPORTERS (background threads)
+    // ========================================================================
+
+    /**
+     * \brief Serve GET /metrics on 127.0.0.1
+     * \param port TCP port
+     * \return true if the server is listening
+     */
+    bool StartHttpServer(uint16_t port);
+
+    /**
+     * \brief Periodically write the exposition to a file
+     * \param path Output file (replaced atomically)
+     * \param intervalSeconds Write period
+     * \return true if the writer was started
+     */
+    bool StartFileWriter(const std::string& path, double intervalSeconds);
+
+    /**
+     * \brief Stop all exporters and write a final file snapshot
+     */
+    void StopExporters();
+
+    /**
+     * \brief Check whether an exporter is running
+     * \return true if the HTTP server or file writer is active
+     */
+    bool IsExporting() const;
+
+  private:
+    NrMetricsRegistry();
+
+    /// Metric type of a family
+    enum Type
+    {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    /**
+     * \brief All series sharing one metric name
+     */
+    struct Family
+    {
+        Type type = COUNTER;  ///< Metric type
+        std::string help;     ///< HELP text
+        std::map<std::string, std::unique_ptr<NrMetricCounter>> counters;      ///< By labels
+        std::map<std::string, std::unique_ptr<NrMetricGauge>> gauges;          ///< By labels
+        std::map<std::string, std::unique_ptr<NrMetricHistogram>> histograms;  ///< By labels
+    };
+
+    /**
+     * \brief Find or create a family, checking its type
+     * \param name Metric name
+     * \param help HELP text (kept from the first registration)
+     * \param type Metric type
+     * \return Family (m_mutex must be held)
+     */
+    Family& GetFamily(const std::string& name, const std::string& help, Type type);
+
+    /**
+     * \brief HTTP server loop
+     * \param listenFd Listening socket
+     */
+    void HttpLoop(int listenFd);
+
+    /**
+     * \brief File writer loop
+     * \param path Output file
+     * \param intervalSeconds Write period
+     */
+    void FileLoop(std::string path, double intervalSeconds);
+
+    /**
+     * \brief Write one snapshot to a file via path.tmp + rename
+     * \param path Output file
+     * \return true on success
+     */
+    bool WriteFile(const std::string& path) const;
+
+    mutable std::mutex m_mutex;               ///< Guards m_families (not the values)
+    std::map<std::string, Family> m_families;  ///< Metric name → family
+
+    std::mutex m_exportMutex;          ///< Guards exporter start/stop
+    std::mutex m_wakeupMutex;          ///< Pairs with m_wakeup
+    std::condition_variable m_wakeup;  ///< Wakes the file writer on stop
+    std::atomic<bool> m_stop{false};   ///< Exporter stop request
+    std::thread m_httpThread;          ///< HTTP server thread
+    std::thread m_fileThread;          ///< File writer thread
+};
+
+} // namespace ns3
+
+#endif /* NR_METRICS_REGISTRY_H */
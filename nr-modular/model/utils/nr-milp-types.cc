@@ -13,7 +13,10 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <map>
 #include <set>
+#include <tuple>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -204,6 +207,68 @@ UeSla::Print(std::ostream& os) const
     os << "}";
 }
 
+// ============================================================================
+// MilpCell / PrbRestriction IMPLEMENTATION
+// ============================================================================
+
+MilpCell::MilpCell()
+    : cellId(0),
+      ueIds(),
+      edgeUeIds(),
+      neighbourCellIds()
+{
+}
+
+bool
+MilpCell::IsEdgeUe(uint32_t ueId) const
+{
+    return std::find(edgeUeIds.begin(), edgeUeIds.end(), ueId) != edgeUeIds.end();
+}
+
+PrbRestriction::PrbRestriction()
+    : cellId(0),
+      startPrb(0),
+      numPrbs(0),
+      muted(true),
+      powerBackoffDb(0.0)
+{
+}
+
+bool
+PrbRestriction::Overlaps(uint32_t start, uint32_t num) const
+{
+    return (startPrb < start + num) && (start < startPrb + numPrbs);
+}
+
+bool
+PrbRestriction::IsValid(uint32_t maxPrbs) const
+{
+    if (numPrbs == 0 || startPrb + numPrbs > maxPrbs)
+    {
+        std::cerr << "Invalid PrbRestriction: cell " << cellId << " PRBs [" << startPrb
+                  << ", " << (startPrb + numPrbs) << ") outside [0, " << maxPrbs << ")"
+                  << std::endl;
+        return false;
+    }
+    if (!muted && powerBackoffDb < 0.0)
+    {
+        std::cerr << "Invalid PrbRestriction: powerBackoffDb must be >= 0, got "
+                  << powerBackoffDb << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// SlaClass IMPLEMENTATION
+// ============================================================================
+
+SlaClass::SlaClass()
+    : classId(0),
+      ueIds()
+{
+}
+
 // ============================================================================
 // MilpProblem IMPLEMENTATION
 // ============================================================================
@@ -216,8 +281,34 @@ MilpProblem::MilpProblem()
       numerology(1),
       slotDuration(0.0),
       totalSlots(0),
-      ues()
+      ues(),
+      coordinated(false),
+      cells(),
+      prbRestrictions(),
+      aggregated(false),
+      classes(),
+      planningGranularitySlots(1)
+{
+}
+
+const MilpCell*
+MilpProblem::FindUeCell(uint32_t ueId) const
 {
+    for (const auto& cell : cells)
+    {
+        if (std::find(cell.ueIds.begin(), cell.ueIds.end(), ueId) != cell.ueIds.end())
+        {
+            return &cell;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t
+MilpProblem::GetNumBlocks() const
+{
+    uint32_t k = std::max<uint32_t>(1, planningGranularitySlots);
+    return (totalSlots + k - 1) / k;
 }
 
 bool
@@ -254,10 +345,10 @@ MilpProblem::IsValid() const
         return false;
     }
     
-    // Check numerology is fixed at 1
-    if (numerology != 1)
+    // Check numerology (each carrier may use its own, 0-4)
+    if (numerology > 4)
     {
-        std::cerr << "Invalid MilpProblem: numerology must be 1 (fixed), got " 
+        std::cerr << "Invalid MilpProblem: numerology must be 0-4, got " 
                   << static_cast<int>(numerology) << std::endl;
         return false;
     }
@@ -312,6 +403,75 @@ MilpProblem::IsValid() const
         }
     }
     
+    // Check planning granularity
+    if (planningGranularitySlots == 0)
+    {
+        std::cerr << "Invalid MilpProblem: planningGranularitySlots must be >= 1" << std::endl;
+        return false;
+    }
+    
+    // Aggregated mode: every entry of ues is a class
+    if (aggregated && classes.size() != numUEs)
+    {
+        std::cerr << "Invalid MilpProblem: " << classes.size() << " SLA classes for "
+                  << numUEs << " class SLAs" << std::endl;
+        return false;
+    }
+    
+    // Coordinated mode: per-cell UE sets and neighbour restrictions
+    if (coordinated)
+    {
+        if (cells.empty())
+        {
+            std::cerr << "Invalid MilpProblem: coordinated but no cells" << std::endl;
+            return false;
+        }
+        
+        std::set<uint32_t> cellIds;
+        std::map<uint32_t, uint32_t> ueCellCount;
+        for (const auto& cell : cells)
+        {
+            cellIds.insert(cell.cellId);
+            for (uint32_t ueId : cell.ueIds)
+            {
+                ueCellCount[ueId]++;
+            }
+            for (uint32_t ueId : cell.edgeUeIds)
+            {
+                if (std::find(cell.ueIds.begin(), cell.ueIds.end(), ueId) == cell.ueIds.end())
+                {
+                    std::cerr << "Invalid MilpProblem: edge UE " << ueId 
+                              << " not served by cell " << cell.cellId << std::endl;
+                    return false;
+                }
+            }
+        }
+        
+        for (const auto& ue : ues)
+        {
+            if (ueCellCount[ue.ueId] != 1)
+            {
+                std::cerr << "Invalid MilpProblem: UE " << ue.ueId << " is in " 
+                          << ueCellCount[ue.ueId] << " cells (expected 1)" << std::endl;
+                return false;
+            }
+        }
+        
+        for (const auto& restriction : prbRestrictions)
+        {
+            if (cellIds.count(restriction.cellId) == 0)
+            {
+                std::cerr << "Invalid MilpProblem: restriction for unknown cell " 
+                          << restriction.cellId << std::endl;
+                return false;
+            }
+            if (!restriction.IsValid(totalBandwidthPrbs))
+            {
+                return false;
+            }
+        }
+    }
+    
     return true;
 }
 
@@ -326,6 +486,31 @@ MilpProblem::Print(std::ostream& os) const
     os << "  numerology: " << static_cast<int>(numerology) << std::endl;
     os << "  slotDuration: " << (slotDuration * 1000) << " ms" << std::endl;
     os << "  totalSlots: " << totalSlots << std::endl;
+    if (planningGranularitySlots > 1)
+    {
+        os << "  planningGranularitySlots: " << planningGranularitySlots << " ("
+           << GetNumBlocks() << " blocks)" << std::endl;
+    }
+    if (coordinated)
+    {
+        os << "  cells:" << std::endl;
+        for (const auto& cell : cells)
+        {
+            os << "    cell " << cell.cellId << ": " << cell.ueIds.size() << " UEs ("
+               << cell.edgeUeIds.size() << " edge), " << cell.neighbourCellIds.size()
+               << " neighbours" << std::endl;
+        }
+        os << "  prbRestrictions: " << prbRestrictions.size() << std::endl;
+    }
+    if (aggregated)
+    {
+        size_t members = 0;
+        for (const auto& cls : classes)
+        {
+            members += cls.ueIds.size();
+        }
+        os << "  slaClasses: " << classes.size() << " (" << members << " UEs)" << std::endl;
+    }
     os << "  UE SLAs:" << std::endl;
     for (const auto& ue : ues)
     {
@@ -390,6 +575,24 @@ PrbAllocation::Print(std::ostream& os) const
        << ", count=" << numPrbs << "}";
 }
 
+// ============================================================================
+// PrbBudget IMPLEMENTATION
+// ============================================================================
+
+PrbBudget::PrbBudget()
+    : ueId(0),
+      blockId(0),
+      prbSlots(0)
+{
+}
+
+PrbBudget::PrbBudget(uint32_t ueId, uint32_t blockId, uint32_t prbSlots)
+    : ueId(ueId),
+      blockId(blockId),
+      prbSlots(prbSlots)
+{
+}
+
 // ============================================================================
 // MilpSolution::UeSummary IMPLEMENTATION
 // ============================================================================
@@ -422,7 +625,10 @@ MilpSolution::MilpSolution()
       objectiveValue(0.0),
       solveTimeSeconds(0.0),
       allocations(),
-      summary()
+      summary(),
+      granularitySlots(1),
+      budgets(),
+      mipGap(-1.0)
 {
 }
 
@@ -435,7 +641,13 @@ MilpSolution::IsOptimal() const
 bool
 MilpSolution::IsFeasible() const
 {
-    return (status == "optimal") || (!allocations.empty());
+    return (status == "optimal") || (!allocations.empty()) || (!budgets.empty());
+}
+
+bool
+MilpSolution::IsIncumbent() const
+{
+    return status == "feasible";
 }
 
 uint32_t
@@ -502,6 +714,23 @@ MilpSolution::IsValid(const MilpProblem& problem) const
         slotAllocations[alloc.slotId].push_back(alloc);
     }
     
+    // Cell of each UE; without coordination everything is one cell
+    std::map<uint32_t, const MilpCell*> ueCell;
+    if (problem.coordinated)
+    {
+        for (const auto& cell : problem.cells)
+        {
+            for (uint32_t ueId : cell.ueIds)
+            {
+                ueCell[ueId] = &cell;
+            }
+        }
+    }
+    auto cellOf = [&ueCell](uint32_t ueId) -> const MilpCell* {
+        auto it = ueCell.find(ueId);
+        return (it != ueCell.end()) ? it->second : nullptr;
+    };
+    
     // Check each slot for overlaps
     for (const auto& [slotId, allocs] : slotAllocations)
     {
@@ -512,6 +741,12 @@ MilpSolution::IsValid(const MilpProblem& problem) const
                 const auto& a1 = allocs[i];
                 const auto& a2 = allocs[j];
                 
+                // Coordinated plans reuse PRBs across cells
+                if (cellOf(a1.ueId) != cellOf(a2.ueId))
+                {
+                    continue;
+                }
+                
                 // Check if PRB ranges overlap
                 uint32_t a1_end = a1.startPrb + a1.numPrbs;
                 uint32_t a2_end = a2.startPrb + a2.numPrbs;
@@ -534,6 +769,63 @@ MilpSolution::IsValid(const MilpProblem& problem) const
         }
     }
     
+    // Check neighbour-protection restrictions
+    if (problem.coordinated)
+    {
+        for (const auto& alloc : allocations)
+        {
+            const MilpCell* cell = cellOf(alloc.ueId);
+            if (cell == nullptr)
+            {
+                continue;
+            }
+            for (const auto& restriction : problem.prbRestrictions)
+            {
+                if (restriction.cellId != cell->cellId ||
+                    !restriction.Overlaps(alloc.startPrb, alloc.numPrbs))
+                {
+                    continue;
+                }
+                if (restriction.muted || cell->IsEdgeUe(alloc.ueId))
+                {
+                    std::cerr << "Invalid MilpSolution: UE " << alloc.ueId << " of cell "
+                              << cell->cellId << " uses restricted PRBs at slot "
+                              << alloc.slotId << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    
+    // Coarse plans: budgets must fit their block (per cell when coordinated)
+    if (!budgets.empty())
+    {
+        uint32_t k = std::max<uint32_t>(1, granularitySlots);
+        uint32_t numBlocks = (problem.totalSlots + k - 1) / k;
+        std::map<std::pair<uint32_t, const MilpCell*>, uint64_t> blockUse;
+        for (const auto& budget : budgets)
+        {
+            if (budget.ueId >= problem.numUEs || budget.blockId >= numBlocks)
+            {
+                std::cerr << "Invalid MilpSolution: budget for UE " << budget.ueId
+                          << " in block " << budget.blockId << " out of range ("
+                          << problem.numUEs << " UEs, " << numBlocks << " blocks)" << std::endl;
+                return false;
+            }
+            blockUse[{budget.blockId, cellOf(budget.ueId)}] += budget.prbSlots;
+        }
+        for (const auto& [block, prbSlots] : blockUse)
+        {
+            if (prbSlots > static_cast<uint64_t>(k) * problem.totalBandwidthPrbs)
+            {
+                std::cerr << "Invalid MilpSolution: block " << block.first << " budgets "
+                          << prbSlots << " PRB-slots > " << k << " x "
+                          << problem.totalBandwidthPrbs << std::endl;
+                return false;
+            }
+        }
+    }
+    
     // Validate summary entries
     for (const auto& [ueId, sum] : summary)
     {
@@ -556,7 +848,16 @@ MilpSolution::Print(std::ostream& os) const
     os << "  status: " << status << std::endl;
     os << "  objectiveValue: " << objectiveValue << " Mbps" << std::endl;
     os << "  solveTimeSeconds: " << solveTimeSeconds << " s" << std::endl;
+    if (mipGap >= 0.0)
+    {
+        os << "  mipGap: " << mipGap * 100 << " %" << std::endl;
+    }
     os << "  numAllocations: " << allocations.size() << std::endl;
+    if (!budgets.empty())
+    {
+        os << "  numBudgets: " << budgets.size() << " (" << granularitySlots
+           << "-slot blocks)" << std::endl;
+    }
     
     if (!summary.empty())
     {
@@ -698,4 +999,188 @@ SchedulingConfig::Print(std::ostream& os) const
     os << "}";
 }
 
+// ============================================================================
+// SLA CLASS AGGREGATION
+// ============================================================================
+
+MilpProblem
+AggregateSlaClasses(const MilpProblem& problem, uint16_t mcsBandWidth)
+{
+    uint16_t band = std::max<uint16_t>(1, mcsBandWidth);
+    
+    // Classes never span cells or edge status (coordinated mode)
+    std::unordered_map<uint32_t, std::pair<uint32_t, bool>> ueCell;
+    for (const auto& cell : problem.cells)
+    {
+        for (uint32_t ueId : cell.ueIds)
+        {
+            ueCell[ueId] = {cell.cellId, cell.IsEdgeUe(ueId)};
+        }
+    }
+    
+    MilpProblem classProblem = problem;
+    classProblem.ues.clear();
+    classProblem.cells.clear();
+    classProblem.classes.clear();
+    classProblem.aggregated = true;
+    
+    // slice, throughput, latency, MCS band, cell, edge
+    using Key = std::tuple<uint8_t, double, double, uint16_t, uint32_t, bool>;
+    std::map<Key, uint32_t> classOf;
+    std::unordered_map<uint32_t, uint32_t> ueClass;
+    for (const auto& ue : problem.ues)
+    {
+        auto cellIt = ueCell.find(ue.ueId);
+        std::pair<uint32_t, bool> cell =
+            (cellIt != ueCell.end()) ? cellIt->second : std::make_pair(0u, false);
+        Key key{static_cast<uint8_t>(ue.sliceType),
+                ue.throughputMbps,
+                ue.latencyMs,
+                static_cast<uint16_t>(ue.mcs / band),
+                cell.first,
+                cell.second};
+        
+        auto [it, inserted] = classOf.emplace(key, classProblem.classes.size());
+        uint32_t classId = it->second;
+        if (inserted)
+        {
+            SlaClass cls;
+            cls.classId = classId;
+            classProblem.classes.push_back(cls);
+            UeSla sla = ue;
+            sla.ueId = classId;
+            sla.throughputMbps = 0.0;
+            classProblem.ues.push_back(sla);
+        }
+        
+        UeSla& sla = classProblem.ues[classId];
+        sla.throughputMbps += ue.throughputMbps;
+        sla.mcs = std::min(sla.mcs, ue.mcs);
+        sla.tbs = std::min(sla.tbs, ue.tbs);
+        classProblem.classes[classId].ueIds.push_back(ue.ueId);
+        ueClass[ue.ueId] = classId;
+    }
+    classProblem.numUEs = static_cast<uint32_t>(classProblem.ues.size());
+    
+    for (const auto& cell : problem.cells)
+    {
+        MilpCell classCell = cell;
+        classCell.ueIds.clear();
+        classCell.edgeUeIds.clear();
+        std::set<uint32_t> seen;
+        for (uint32_t ueId : cell.ueIds)
+        {
+            uint32_t classId = ueClass[ueId];
+            if (seen.insert(classId).second)
+            {
+                classCell.ueIds.push_back(classId);
+                if (cell.IsEdgeUe(ueId))
+                {
+                    classCell.edgeUeIds.push_back(classId);
+                }
+            }
+        }
+        classProblem.cells.push_back(classCell);
+    }
+    
+    return classProblem;
+}
+
+MilpSolution
+ExpandClassSolution(const MilpProblem& classProblem, const MilpSolution& classSolution)
+{
+    const auto& classes = classProblem.classes;
+    
+    MilpSolution solution;
+    solution.status = classSolution.status;
+    solution.objectiveValue = classSolution.objectiveValue;
+    solution.solveTimeSeconds = classSolution.solveTimeSeconds;
+    solution.granularitySlots = classSolution.granularitySlots;
+    solution.mipGap = classSolution.mipGap;
+    
+    std::vector<PrbAllocation> order = classSolution.allocations;
+    std::stable_sort(order.begin(), order.end(), [](const PrbAllocation& a, const PrbAllocation& b) {
+        return std::tie(a.slotId, a.startPrb) < std::tie(b.slotId, b.startPrb);
+    });
+    
+    std::vector<size_t> cursor(classes.size(), 0);
+    std::vector<uint64_t> classPrbs(classes.size(), 0);
+    std::unordered_map<uint32_t, uint64_t> uePrbs;
+    solution.allocations.reserve(order.size());
+    
+    for (const auto& alloc : order)
+    {
+        if (alloc.ueId >= classes.size() || alloc.numPrbs == 0 ||
+            classes[alloc.ueId].ueIds.empty())
+        {
+            continue;
+        }
+        const auto& members = classes[alloc.ueId].ueIds;
+        size_t& next = cursor[alloc.ueId];
+        
+        uint32_t n = std::min<uint32_t>(members.size(), alloc.numPrbs);
+        uint32_t share = alloc.numPrbs / n;
+        uint32_t startPrb = alloc.startPrb;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            uint32_t num = (i == n - 1) ? (alloc.startPrb + alloc.numPrbs - startPrb) : share;
+            uint32_t ueId = members[next];
+            next = (next + 1) % members.size();
+            solution.allocations.emplace_back(ueId, alloc.slotId, startPrb, num);
+            uePrbs[ueId] += num;
+            startPrb += num;
+        }
+        classPrbs[alloc.ueId] += alloc.numPrbs;
+    }
+    
+    // Coarse plans: split each class budget evenly, the remainder
+    // PRB-slots go to the next members in rotation
+    for (const auto& budget : classSolution.budgets)
+    {
+        if (budget.ueId >= classes.size() || budget.prbSlots == 0 ||
+            classes[budget.ueId].ueIds.empty())
+        {
+            continue;
+        }
+        const auto& members = classes[budget.ueId].ueIds;
+        size_t& next = cursor[budget.ueId];
+        
+        uint32_t share = budget.prbSlots / members.size();
+        uint32_t extra = budget.prbSlots % members.size();
+        for (size_t i = 0; i < members.size(); ++i)
+        {
+            uint32_t ueId = members[(next + i) % members.size()];
+            uint32_t prbSlots = share + ((i < extra) ? 1 : 0);
+            if (prbSlots == 0)
+            {
+                break;
+            }
+            solution.budgets.emplace_back(ueId, budget.blockId, prbSlots);
+            uePrbs[ueId] += prbSlots;
+        }
+        next = (next + extra) % members.size();
+        classPrbs[budget.ueId] += budget.prbSlots;
+    }
+    
+    for (const auto& [classId, classSummary] : classSolution.summary)
+    {
+        if (classId >= classes.size())
+        {
+            continue;
+        }
+        for (uint32_t ueId : classes[classId].ueIds)
+        {
+            MilpSolution::UeSummary summary = classSummary;
+            summary.totalPrbsAllocated = static_cast<uint32_t>(uePrbs[ueId]);
+            summary.expectedThroughputMbps =
+                classPrbs[classId] ? classSummary.expectedThroughputMbps * uePrbs[ueId] /
+                                         classPrbs[classId]
+                                   : 0.0;
+            solution.summary[ueId] = summary;
+        }
+    }
+    
+    return solution;
+}
+
 } // namespace ns3
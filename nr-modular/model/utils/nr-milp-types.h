@@ -196,6 +196,111 @@ struct UeSla
     void Print(std::ostream& os) const;
 };
 
+// ============================================================================
+// INTER-CELL COORDINATION STRUCTURES
+// ============================================================================
+
+/**
+ * \brief One cell of a coordinated (multi-cell) MILP problem
+ * 
+ * Fields:
+ * - cellId: gNB index the cell belongs to
+ * - ueIds: UEs served by this cell (nearest-site association)
+ * - edgeUeIds: Subset of ueIds classified as cell-edge from geometry
+ * - neighbourCellIds: Cells whose transmissions hit this cell's edge UEs
+ * 
+ * Within a cell PRBs are exclusive; different cells may reuse the same
+ * PRBs, subject to the problem's PrbRestriction list.
+ */
+struct MilpCell
+{
+    uint32_t cellId;                         ///< gNB index
+    std::vector<uint32_t> ueIds;             ///< UEs served by this cell
+    std::vector<uint32_t> edgeUeIds;         ///< Cell-edge subset of ueIds
+    std::vector<uint32_t> neighbourCellIds;  ///< Interfering neighbour cells
+    
+    /**
+     * \brief Default constructor
+     */
+    MilpCell();
+    
+    /**
+     * \brief Check whether a UE is classified as cell-edge
+     * \param ueId UE identifier
+     * \return true if ueId is in edgeUeIds
+     */
+    bool IsEdgeUe(uint32_t ueId) const;
+};
+
+/**
+ * \brief PRB range a cell may only use under a constraint
+ * 
+ * Protects a neighbour's cell-edge sub-band:
+ * - muted = true: the cell must not schedule these PRBs at all
+ * - muted = false: the cell transmits with powerBackoffDb less power, so
+ *   only its cell-centre UEs may be scheduled there
+ * 
+ * Example (reuse-3 edge band, 273 PRBs, 30% edge band):
+ *   cellId = 4, startPrb = 191, numPrbs = 27, muted = true
+ */
+struct PrbRestriction
+{
+    uint32_t cellId;        ///< Restricted cell
+    uint32_t startPrb;      ///< First restricted PRB
+    uint32_t numPrbs;       ///< Number of contiguous restricted PRBs
+    bool muted;             ///< true: PRBs unused by this cell
+    double powerBackoffDb;  ///< Power reduction when not muted (dB)
+    
+    /**
+     * \brief Default constructor
+     */
+    PrbRestriction();
+    
+    /**
+     * \brief Check whether a PRB range intersects this restriction
+     * \param start First PRB of the range
+     * \param num Number of PRBs in the range
+     * \return true if the ranges overlap
+     */
+    bool Overlaps(uint32_t start, uint32_t num) const;
+    
+    /**
+     * \brief Validate restriction parameters
+     * \param maxPrbs Maximum number of PRBs available
+     * \return true if numPrbs > 0 and the range fits the carrier
+     */
+    bool IsValid(uint32_t maxPrbs) const;
+};
+
+// ============================================================================
+// SLA CLASS AGGREGATION
+// ============================================================================
+
+/**
+ * \brief Equivalence class of UEs with interchangeable SLAs
+ * 
+ * UEs with the same slice, throughput and latency requirement, MCS band
+ * and (coordinated mode) cell and edge status are planned as one entity.
+ * The class-level problem has one UeSla per class (ueId = classId) asking
+ * for the members' summed throughput; ExpandClassSolution() hands the
+ * class's PRBs back to its members.
+ * 
+ * Example (100 eMBB UEs at 10 Mbps, MCS 16-19, band width 4):
+ *   classId = 0
+ *   ueIds = [0, 3, 6, ..., 297]
+ *   class SLA: eMBB, 1000 Mbps, 10 ms, mcs = 16 (lowest of the band)
+ */
+struct SlaClass
+{
+    uint32_t classId;             ///< Class index (= ueId in the class problem)
+    std::vector<uint32_t> ueIds;  ///< Member UEs, in problem order
+    
+    /**
+     * \brief Default constructor
+     */
+    SlaClass();
+};
+
 // ============================================================================
 // MILP PROBLEM STRUCTURE
 // ============================================================================
@@ -212,7 +317,7 @@ struct UeSla
  * - bandwidth: Total available bandwidth in Hz (e.g., 100 MHz = 100e6)
  * - totalBandwidthPrbs: Total number of PRBs in bandwidth
  * - timeWindow: Optimization time window in seconds (e.g., 1.0s)
- * - numerology: Fixed numerology (μ = 1 for 30 kHz SCS)
+ * - numerology: Numerology of the planned carrier (μ = 1 for 30 kHz SCS)
  * - slotDuration: Duration of one slot in seconds (0.5ms for μ=1)
  * - totalSlots: Total number of slots in time window (timeWindow / slotDuration)
  * - ues: Vector of UE SLA specifications
@@ -234,6 +339,15 @@ struct UeSla
  *     - Each UE meets latency SLA
  *     - PRBs don't overlap in time-frequency
  *     - Total PRBs per slot <= totalBandwidthPrbs
+ * 
+ * Coarse planning (planningGranularitySlots = K > 1): the solver plans
+ * per-UE PRB budgets for blocks of K slots instead of per-slot PRB
+ * positions (see PrbBudget); NrBwpManager expands each block to slots.
+ * 
+ * Coordinated mode (coordinated = true): the problem is planned jointly
+ * over several cells. "PRBs don't overlap" then holds per cell only, and
+ * each cell additionally honours its entries in prbRestrictions (muted
+ * PRBs unused; power-limited PRBs for cell-centre UEs only).
  */
 struct MilpProblem
 {
@@ -241,16 +355,35 @@ struct MilpProblem
     double bandwidth;               ///< Total bandwidth (Hz)
     uint32_t totalBandwidthPrbs;    ///< Total PRBs available
     double timeWindow;              ///< Optimization window (seconds)
-    uint8_t numerology;             ///< Fixed numerology (μ = 1)
+    uint8_t numerology;             ///< Carrier numerology (0-4)
     double slotDuration;            ///< Slot duration (seconds)
     uint32_t totalSlots;            ///< Total slots in time window
     std::vector<UeSla> ues;         ///< UE SLA specifications
+    bool coordinated;               ///< Joint multi-cell planning
+    std::vector<MilpCell> cells;    ///< Per-cell UE sets (coordinated)
+    std::vector<PrbRestriction> prbRestrictions;  ///< Neighbour protection
+    bool aggregated;                ///< ues (and cells) hold SLA classes
+    std::vector<SlaClass> classes;  ///< Members of each class (aggregated)
+    uint32_t planningGranularitySlots;  ///< Slots per planned block (1 = per slot)
     
     /**
      * \brief Default constructor
      */
     MilpProblem();
     
+    /**
+     * \brief Find the cell serving a UE (coordinated mode)
+     * \param ueId UE identifier
+     * \return Pointer into cells, or nullptr if not found
+     */
+    const MilpCell* FindUeCell(uint32_t ueId) const;
+    
+    /**
+     * \brief Get the number of planned blocks
+     * \return ceil(totalSlots / planningGranularitySlots)
+     */
+    uint32_t GetNumBlocks() const;
+    
     /**
      * \brief Validate problem parameters
      * \return true if problem is valid, false otherwise
@@ -260,10 +393,14 @@ struct MilpProblem
      * - bandwidth > 0
      * - totalBandwidthPrbs > 0
      * - timeWindow > 0
-     * - numerology == 1 (fixed)
+     * - numerology <= 4
      * - slotDuration > 0
      * - totalSlots > 0
      * - All UE SLAs are valid
+     * - Coordinated: every UE in exactly one cell, edge UEs belong to
+     *   their cell, restrictions name known cells and fit the carrier
+     * - Aggregated: one entry of classes per entry of ues
+     * - planningGranularitySlots >= 1
      */
     bool IsValid() const;
     
@@ -345,6 +482,41 @@ struct PrbAllocation
     void Print(std::ostream& os) const;
 };
 
+// ============================================================================
+// PRB BUDGET STRUCTURE (COARSE PLANNING)
+// ============================================================================
+
+/**
+ * \brief PRB budget of one UE over one K-slot block
+ * 
+ * Returned instead of PrbAllocation when the problem is planned with
+ * planningGranularitySlots = K > 1. The budget counts PRB-slots: a UE
+ * with prbSlots = 80 in a block of K = 8 slots gets 10 PRBs per slot on
+ * average. Where and when inside the block is decided by NrBwpManager.
+ * 
+ * Example:
+ *   ueId = 2, blockId = 3 (slots 24-31 for K = 8), prbSlots = 80
+ */
+struct PrbBudget
+{
+    uint32_t ueId;      ///< UE identifier
+    uint32_t blockId;   ///< Block index (slots blockId*K ... blockId*K + K - 1)
+    uint32_t prbSlots;  ///< PRBs summed over the block's slots
+    
+    /**
+     * \brief Default constructor
+     */
+    PrbBudget();
+    
+    /**
+     * \brief Parameterized constructor
+     * \param ueId UE identifier
+     * \param blockId Block index
+     * \param prbSlots PRB-slots of the block
+     */
+    PrbBudget(uint32_t ueId, uint32_t blockId, uint32_t prbSlots);
+};
+
 // ============================================================================
 // MILP SOLUTION STRUCTURE
 // ============================================================================
@@ -374,9 +546,10 @@ struct PrbAllocation
  *   }
  * 
  * Status Meanings:
- * - "optimal": MILP found optimal solution
+ * - "optimal": MILP found optimal solution (within the gap target)
+ * - "feasible": Deadline reached; best incumbent returned, see mipGap
  * - "infeasible": Problem has no feasible solution (SLAs too strict)
- * - "timeout": Solver exceeded time limit
+ * - "timeout": No answer within the time limit (no incumbent)
  * - "error": Solver encountered error
  * 
  * The allocations vector contains ALL per-slot allocations for the entire
@@ -422,6 +595,9 @@ struct MilpSolution
     double solveTimeSeconds;                    ///< Solve time (seconds)
     std::vector<PrbAllocation> allocations;     ///< All PRB allocations
     std::map<uint32_t, UeSummary> summary;      ///< Per-UE summaries
+    uint32_t granularitySlots;                  ///< Slots per block of budgets
+    std::vector<PrbBudget> budgets;             ///< Per-block budgets (coarse plans)
+    double mipGap;                              ///< Relative optimality gap (< 0 = not reported)
     
     /**
      * \brief Default constructor
@@ -436,10 +612,16 @@ struct MilpSolution
     
     /**
      * \brief Check if solution is feasible
-     * \return true if status == "optimal" or has allocations
+     * \return true if status == "optimal" or has allocations or budgets
      */
     bool IsFeasible() const;
     
+    /**
+     * \brief Check if solution is an incumbent returned at the deadline
+     * \return true if status == "feasible" (usable, not proven optimal)
+     */
+    bool IsIncumbent() const;
+    
     /**
      * \brief Get number of allocations
      * \return Total number of PRB allocations
@@ -453,9 +635,13 @@ struct MilpSolution
      * 
      * Checks:
      * - All allocations are valid
-     * - No PRB overlaps in time-frequency
+     * - No PRB overlaps in time-frequency (per cell when coordinated)
      * - All UE IDs exist in problem
      * - Slot IDs are within bounds
+     * - Coordinated: no allocation on a muted PRB, and no edge UE on a
+     *   power-limited PRB of its cell
+     * - Budgets: known UEs and blocks, and per block (and cell) no more
+     *   than K * totalBandwidthPrbs PRB-slots
      */
     bool IsValid(const MilpProblem& problem) const;
     
@@ -466,6 +652,38 @@ struct MilpSolution
     void Print(std::ostream& os) const;
 };
 
+/**
+ * \brief Group UEs with identical SLAs into classes
+ * \param problem Per-UE problem
+ * \param mcsBandWidth MCS values per band; UEs whose MCS fall in the same
+ *        band are grouped (1 = exact MCS match)
+ * \return Class-level problem (aggregated = true); carrier, slots and
+ *         PRB restrictions are unchanged
+ * 
+ * The class SLA uses the lowest MCS and TBS of its members, so a class
+ * budget never assumes a better channel than its worst member has. The
+ * problem size then grows with the number of distinct SLAs instead of
+ * the number of UEs.
+ */
+MilpProblem AggregateSlaClasses(const MilpProblem& problem, uint16_t mcsBandWidth);
+
+/**
+ * \brief Expand a class-level solution to individual UEs
+ * \param classProblem Problem returned by AggregateSlaClasses()
+ * \param classSolution Solution of classProblem (ueId = classId)
+ * \return Per-UE solution
+ * 
+ * Deterministic: class allocations are visited in (slot, startPrb) order
+ * and each is split into contiguous equal shares for min(members, PRBs)
+ * members, starting at a per-class round-robin cursor that advances by
+ * the members served. Over the window every member of a class gets the
+ * same PRBs to within one share. Class budgets of coarse plans are split
+ * the same way (remainder PRB-slots rotate across members). Members
+ * inherit the class summary, with throughput prorated by their PRBs.
+ */
+MilpSolution ExpandClassSolution(const MilpProblem& classProblem,
+                                 const MilpSolution& classSolution);
+
 // ============================================================================
 // SCHEDULING CONFIGURATION STRUCTURE
 // ============================================================================
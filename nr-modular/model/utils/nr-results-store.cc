@@ -0,0 +1,612 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Results Store - Implementation File
+ */
+
+#include "nr-results-store.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrResultsStore");
+
+namespace
+{
+
+constexpr uint64_t DEFAULT_SEGMENT_LIMIT = 64ull << 20;  ///< 64 MiB
+
+/**
+ * \brief write() all bytes, retrying on EINTR and short writes
+ * \return true on success
+ */
+bool
+WriteAll(int fd, const std::string& data)
+{
+    size_t done = 0;
+    while (done < data.size())
+    {
+        ssize_t n = write(fd, data.data() + done, data.size() - done);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * \brief Split on a single-character separator
+ */
+std::vector<std::string>
+Split(const std::string& text, char separator)
+{
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (true)
+    {
+        size_t end = text.find(separator, start);
+        parts.push_back(text.substr(start, end - start));
+        if (end == std::string::npos)
+        {
+            return parts;
+        }
+        start = end + 1;
+    }
+}
+
+/**
+ * \brief Scoped exclusive flock() on a file
+ */
+class FileLock
+{
+  public:
+    explicit FileLock(const std::string& path)
+        : m_fd(open(path.c_str(), O_RDWR | O_CREAT, 0644))
+    {
+        while (m_fd >= 0 && flock(m_fd, LOCK_EX) != 0)
+        {
+            if (errno != EINTR)
+            {
+                close(m_fd);
+                m_fd = -1;
+            }
+        }
+    }
+
+    ~FileLock()
+    {
+        if (m_fd >= 0)
+        {
+            flock(m_fd, LOCK_UN);
+            close(m_fd);
+        }
+    }
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    bool IsLocked() const
+    {
+        return m_fd >= 0;
+    }
+
+  private:
+    int m_fd;
+};
+
+} // namespace
+
+// ============================================================================
+// QUERY / AGGREGATE
+// ============================================================================
+
+bool
+NrResultsStore::Query::Matches(const RunRecord& record) const
+{
+    if (!configHash.empty() && record.configHash != configHash)
+    {
+        return false;
+    }
+    if (seed >= 0 && record.seed != static_cast<uint64_t>(seed))
+    {
+        return false;
+    }
+    if (run >= 0 && record.run != static_cast<uint64_t>(run))
+    {
+        return false;
+    }
+    for (const auto& [key, value] : params)
+    {
+        auto it = record.params.find(key);
+        if (it == record.params.end() || it->second != value)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+NrResultsStore::Aggregate::Print(std::ostream& os) const
+{
+    os << "n=" << count << " mean=" << mean << " sd=" << stddev << " [" << min << ", " << max
+       << "]";
+}
+
+// ============================================================================
+// CONSTRUCTOR / OPEN
+// ============================================================================
+
+NrResultsStore::NrResultsStore()
+    : m_directory(),
+      m_segmentLimit(DEFAULT_SEGMENT_LIMIT),
+      m_indexOffset(0),
+      m_runs()
+{
+}
+
+bool
+NrResultsStore::Open(const std::string& directory, bool create)
+{
+    NS_LOG_FUNCTION(this << directory << create);
+
+    m_directory.clear();
+    m_indexOffset = 0;
+    m_runs.clear();
+
+    if (create && mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+        NS_LOG_ERROR("Cannot create results store " << directory << ": "
+                                                    << std::strerror(errno));
+        return false;
+    }
+    struct stat st;
+    if (stat(directory.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+    {
+        NS_LOG_ERROR("Results store " << directory << " is not a directory");
+        return false;
+    }
+
+    m_directory = directory;
+    Refresh();
+    NS_LOG_INFO("Results store " << directory << ": " << m_runs.size() << " runs");
+    return true;
+}
+
+void
+NrResultsStore::SetSegmentLimit(uint64_t bytes)
+{
+    m_segmentLimit = std::max<uint64_t>(1, bytes);
+}
+
+std::string
+NrResultsStore::SegmentPath(uint32_t segment) const
+{
+    char name[16];
+    std::snprintf(name, sizeof(name), "seg-%06" PRIu32, segment);
+    return m_directory + "/" + name;
+}
+
+// ============================================================================
+// WRITING
+// ============================================================================
+
+bool
+NrResultsStore::Append(RunRecord& record)
+{
+    NS_LOG_FUNCTION(this << record.configHash << record.seed << record.run);
+
+    if (!IsOpen())
+    {
+        NS_LOG_ERROR("Results store not open");
+        return false;
+    }
+
+    FileLock lock(m_directory + "/LOCK");
+    if (!lock.IsLocked())
+    {
+        NS_LOG_ERROR("Cannot lock results store " << m_directory << ": "
+                                                  << std::strerror(errno));
+        return false;
+    }
+
+    // Runs appended by other writers decide the run id and segment
+    Refresh();
+
+    std::string indexPath = m_directory + "/index";
+    int indexFd = open(indexPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (indexFd < 0)
+    {
+        NS_LOG_ERROR("Cannot open " << indexPath << ": " << std::strerror(errno));
+        return false;
+    }
+    struct stat st;
+    if (fstat(indexFd, &st) == 0 && static_cast<uint64_t>(st.st_size) > m_indexOffset)
+    {
+        NS_LOG_WARN("Dropping torn index line of a crashed writer in " << indexPath);
+        if (ftruncate(indexFd, static_cast<off_t>(m_indexOffset)) != 0)
+        {
+            close(indexFd);
+            return false;
+        }
+    }
+
+    // ----- Payload -----
+    std::string payload;
+    char value[32];
+    for (const auto& [name, metric] : record.metrics)
+    {
+        std::snprintf(value, sizeof(value), "%.17g", metric);
+        payload += Escape(name) + '\t' + value + '\n';
+    }
+
+    uint32_t segment = m_runs.empty() ? 1 : m_runs.back().segment;
+    int segmentFd = open(SegmentPath(segment).c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (segmentFd >= 0 && fstat(segmentFd, &st) == 0 && st.st_size > 0 &&
+        static_cast<uint64_t>(st.st_size) + payload.size() > m_segmentLimit)
+    {
+        close(segmentFd);
+        ++segment;
+        segmentFd = open(SegmentPath(segment).c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    }
+    if (segmentFd < 0 || fstat(segmentFd, &st) != 0)
+    {
+        NS_LOG_ERROR("Cannot open " << SegmentPath(segment) << ": " << std::strerror(errno));
+        if (segmentFd >= 0)
+        {
+            close(segmentFd);
+        }
+        close(indexFd);
+        return false;
+    }
+
+    record.segment = segment;
+    record.offset = static_cast<uint64_t>(st.st_size);
+    record.length = payload.size();
+    bool ok = WriteAll(segmentFd, payload) && fsync(segmentFd) == 0;
+    close(segmentFd);
+
+    // ----- Index line (only once the payload is durable) -----
+    record.runId = m_runs.size();
+    record.timestamp = static_cast<int64_t>(std::time(nullptr));
+    std::string line = FormatIndexLine(record);
+    ok = ok && WriteAll(indexFd, line);
+    close(indexFd);
+
+    if (!ok)
+    {
+        NS_LOG_ERROR("Write error in results store " << m_directory << ": "
+                                                     << std::strerror(errno));
+        return false;
+    }
+
+    RunRecord indexed = record;
+    indexed.metrics.clear();
+    m_runs.push_back(std::move(indexed));
+    m_indexOffset += line.size();
+    return true;
+}
+
+// ============================================================================
+// INDEX
+// ============================================================================
+
+size_t
+NrResultsStore::Refresh()
+{
+    if (!IsOpen())
+    {
+        return 0;
+    }
+
+    std::ifstream index(m_directory + "/index", std::ios::binary);
+    if (!index)
+    {
+        return m_runs.size();
+    }
+    index.seekg(static_cast<std::streamoff>(m_indexOffset));
+    std::string tail((std::istreambuf_iterator<char>(index)), std::istreambuf_iterator<char>());
+
+    // Only complete lines: a writer may be between write() calls
+    size_t start = 0;
+    size_t end;
+    while ((end = tail.find('\n', start)) != std::string::npos)
+    {
+        RunRecord record;
+        if (ParseIndexLine(tail.substr(start, end - start), record))
+        {
+            m_runs.push_back(std::move(record));
+        }
+        else
+        {
+            NS_LOG_WARN("Skipping malformed index line at byte " << m_indexOffset + start
+                                                                 << " of " << m_directory);
+        }
+        start = end + 1;
+    }
+    m_indexOffset += start;
+    return m_runs.size();
+}
+
+std::string
+NrResultsStore::FormatIndexLine(const RunRecord& record)
+{
+    std::ostringstream line;
+    line << record.runId << '\t' << record.configHash << '\t' << record.seed << '\t'
+         << record.run << '\t' << record.timestamp << '\t' << record.segment << '\t'
+         << record.offset << '\t' << record.length << '\t';
+    bool first = true;
+    for (const auto& [key, value] : record.params)
+    {
+        line << (first ? "" : ";") << Escape(key) << '=' << Escape(value);
+        first = false;
+    }
+    line << '\n';
+    return line.str();
+}
+
+bool
+NrResultsStore::ParseIndexLine(const std::string& line, RunRecord& record)
+{
+    std::vector<std::string> fields = Split(line, '\t');
+    if (fields.size() != 9)
+    {
+        return false;
+    }
+
+    char* end = nullptr;
+    auto number = [&end](const std::string& text) {
+        errno = 0;
+        unsigned long long v = std::strtoull(text.c_str(), &end, 10);
+        return (errno == 0 && !text.empty() && *end == '\0') ? v : ~0ull;
+    };
+
+    record.runId = number(fields[0]);
+    record.configHash = fields[1];
+    record.seed = number(fields[2]);
+    record.run = number(fields[3]);
+    record.timestamp = static_cast<int64_t>(std::strtoll(fields[4].c_str(), nullptr, 10));
+    uint64_t segment = number(fields[5]);
+    record.offset = number(fields[6]);
+    record.length = number(fields[7]);
+    if (record.runId == ~0ull || segment == 0 || segment > UINT32_MAX ||
+        record.offset == ~0ull || record.length == ~0ull)
+    {
+        return false;
+    }
+    record.segment = static_cast<uint32_t>(segment);
+
+    if (!fields[8].empty())
+    {
+        for (const auto& pair : Split(fields[8], ';'))
+        {
+            size_t eq = pair.find('=');
+            if (eq == std::string::npos)
+            {
+                return false;
+            }
+            record.params[Unescape(pair.substr(0, eq))] = Unescape(pair.substr(eq + 1));
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+std::vector<NrResultsStore::RunRecord>
+NrResultsStore::Find(const Query& query)
+{
+    Refresh();
+    std::vector<RunRecord> matches;
+    for (const auto& record : m_runs)
+    {
+        if (query.Matches(record))
+        {
+            matches.push_back(record);
+        }
+    }
+    return matches;
+}
+
+std::vector<NrResultsStore::RunRecord>
+NrResultsStore::Load(const Query& query)
+{
+    std::vector<RunRecord> matches = Find(query);
+    LoadMetrics(matches);
+    return matches;
+}
+
+void
+NrResultsStore::LoadMetrics(std::vector<RunRecord>& records) const
+{
+    std::map<uint32_t, int> segments;  // Each segment opened once
+    std::string payload;
+
+    for (auto& record : records)
+    {
+        auto it = segments.find(record.segment);
+        if (it == segments.end())
+        {
+            it = segments.emplace(record.segment,
+                                  open(SegmentPath(record.segment).c_str(), O_RDONLY))
+                     .first;
+        }
+
+        payload.resize(record.length);
+        if (it->second < 0 ||
+            pread(it->second, &payload[0], record.length, static_cast<off_t>(record.offset)) !=
+                static_cast<ssize_t>(record.length))
+        {
+            NS_LOG_WARN("Run " << record.runId << ": payload missing in "
+                               << SegmentPath(record.segment));
+            continue;
+        }
+
+        size_t start = 0;
+        size_t end;
+        while ((end = payload.find('\n', start)) != std::string::npos)
+        {
+            size_t tab = payload.find('\t', start);
+            if (tab != std::string::npos && tab < end)
+            {
+                record.metrics[Unescape(payload.substr(start, tab - start))] =
+                    std::strtod(payload.c_str() + tab + 1, nullptr);
+            }
+            start = end + 1;
+        }
+    }
+
+    for (const auto& [segment, fd] : segments)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
+
+NrResultsStore::Aggregate
+NrResultsStore::Summarize(const Query& query, const std::string& metric)
+{
+    std::map<std::string, Aggregate> groups = GroupBy(query, "", metric);
+    return groups.empty() ? Aggregate() : groups.begin()->second;
+}
+
+std::map<std::string, NrResultsStore::Aggregate>
+NrResultsStore::GroupBy(const Query& query, const std::string& param, const std::string& metric)
+{
+    std::map<std::string, std::vector<double>> values;
+    for (const auto& record : Load(query))
+    {
+        auto value = record.metrics.find(metric);
+        if (value == record.metrics.end())
+        {
+            continue;
+        }
+        if (param.empty())
+        {
+            values[""].push_back(value->second);
+            continue;
+        }
+        auto group = record.params.find(param);
+        if (group != record.params.end())
+        {
+            values[group->second].push_back(value->second);
+        }
+    }
+
+    std::map<std::string, Aggregate> result;
+    for (const auto& [group, samples] : values)
+    {
+        Aggregate& a = result[group];
+        a.count = samples.size();
+        a.min = *std::min_element(samples.begin(), samples.end());
+        a.max = *std::max_element(samples.begin(), samples.end());
+        for (double v : samples)
+        {
+            a.sum += v;
+        }
+        a.mean = a.sum / a.count;
+        if (a.count > 1)
+        {
+            double squares = 0.0;
+            for (double v : samples)
+            {
+                squares += (v - a.mean) * (v - a.mean);
+            }
+            a.stddev = std::sqrt(squares / (a.count - 1));
+        }
+    }
+    return result;
+}
+
+// ============================================================================
+// HASHING / ESCAPING
+// ============================================================================
+
+std::string
+NrResultsStore::HashConfig(const std::string& text)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016" PRIx64, hash);
+    return hex;
+}
+
+std::string
+NrResultsStore::Escape(const std::string& text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (unsigned char c : text)
+    {
+        if (c == '%' || c == '\t' || c == '\n' || c == '\r' || c == ';' || c == '=')
+        {
+            char code[4];
+            std::snprintf(code, sizeof(code), "%%%02X", c);
+            escaped += code;
+        }
+        else
+        {
+            escaped += static_cast<char>(c);
+        }
+    }
+    return escaped;
+}
+
+std::string
+NrResultsStore::Unescape(const std::string& text)
+{
+    std::string raw;
+    raw.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] == '%' && i + 2 < text.size())
+        {
+            raw += static_cast<char>(std::strtol(text.substr(i + 1, 2).c_str(), nullptr, 16));
+            i += 2;
+        }
+        else
+        {
+            raw += text[i];
+        }
+    }
+    return raw;
+}
+
+} // namespace ns3
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Results Store - Header File
+ *
+ * Append-only store of per-run results, shared by every run of a sweep
+ * (forked workers, MPI ranks, separate invocations), with an index to
+ * filter and aggregate across runs without opening each results file.
+ *
+ * Directory layout:
+ *   LOCK           flock() target serializing appends
+ *   index          one line per run (tab separated):
+ *                    runId configHash seed run timestamp segment offset length params
+ *                  params = key=value;key=value (%-escaped)
+ *   seg-000001...  record payloads, one "metric<TAB>value" line per metric;
+ *                  a new segment starts when the current one exceeds the
+ *                  segment limit (default 64 MiB)
+ *
+ * Concurrency:
+ * - Append() holds an exclusive flock() on LOCK while it writes the
+ *   payload (fsync'ed) and then the index line, so concurrent writers
+ *   on one host need no server. The index never points to unwritten data.
+ * - Readers take no lock: Refresh() only consumes complete index lines.
+ * - A torn index line left by a crashed writer is truncated by the next
+ *   Append().
+ * - flock() is not reliable on some network file systems; keep the store
+ *   on a local disk when writers run in parallel.
+ *
+ * Usage:
+ *   NrResultsStore store;
+ *   store.Open("results.store");
+ *   NrResultsStore::Query q;
+ *   q.configHash = hash;
+ *   q.params["traffic.udpRateDl"] = "50";
+ *   auto tput = store.Summarize(q, "dl_throughput_mbps");
+ */
+
+#ifndef NR_RESULTS_STORE_H
+#define NR_RESULTS_STORE_H
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Indexed, append-only store of per-run results
+ */
+class NrResultsStore
+{
+  public:
+    /**
+     * \brief Results of one run
+     */
+    struct RunRecord
+    {
+        uint64_t runId = 0;                         ///< Index position (assigned by Append)
+        std::string configHash;                     ///< Hash of the base configuration
+        uint64_t seed = 0;                          ///< RNG seed
+        uint64_t run = 0;                           ///< RNG run number
+        int64_t timestamp = 0;                      ///< Unix time of the append
+        std::map<std::string, std::string> params;  ///< Varied parameters
+        std::map<std::string, double> metrics;      ///< KPIs, profiling, SLA compliance
+
+        /// Location of the payload (index only)
+        uint32_t segment = 0;
+        uint64_t offset = 0;
+        uint64_t length = 0;
+    };
+
+    /**
+     * \brief Run filter on the indexed fields
+     */
+    struct Query
+    {
+        std::string configHash;                     ///< "" = any
+        int64_t seed = -1;                          ///< -1 = any
+        int64_t run = -1;                           ///< -1 = any
+        std::map<std::string, std::string> params;  ///< All must be equal
+
+        /**
+         * \brief Check a run against the filter
+         * \param record Run (index fields)
+         * \return true if it matches
+         */
+        bool Matches(const RunRecord& record) const;
+    };
+
+    /**
+     * \brief Statistics of one metric over the matching runs
+     */
+    struct Aggregate
+    {
+        uint64_t count = 0;   ///< Runs that have the metric
+        double sum = 0.0;     ///< Sum
+        double mean = 0.0;    ///< Mean
+        double stddev = 0.0;  ///< Sample standard deviation (0 if count < 2)
+        double min = 0.0;     ///< Minimum
+        double max = 0.0;     ///< Maximum
+
+        /**
+         * \brief Print "n=.. mean=.. sd=.. [min, max]"
+         * \param os Output stream
+         */
+        void Print(std::ostream& os) const;
+    };
+
+    /**
+     * \brief Constructor
+     */
+    NrResultsStore();
+
+    /**
+     * \brief Open a store directory
+     * \param directory Store directory
+     * \param create Create the directory if it does not exist
+     * \return true if the store is usable
+     */
+    bool Open(const std::string& directory, bool create = true);
+
+    /**
+     * \brief Check whether a store is open
+     * \return true after a successful Open()
+     */
+    bool IsOpen() const
+    {
+        return !m_directory.empty();
+    }
+
+    /**
+     * \brief Get the store directory
+     * \return Directory given to Open()
+     */
+    const std::string& GetDirectory() const
+    {
+        return m_directory;
+    }
+
+    /**
+     * \brief Set the size at which a new segment is started
+     * \param bytes Segment size limit
+     */
+    void SetSegmentLimit(uint64_t bytes);
+
+    // ========================================================================
+    // WRITING
+    // ========================================================================
+
+    /**
+     * \brief Append one run (safe against concurrent writers)
+     * \param record Run; runId, timestamp and location are filled in
+     * \return true if the run was stored
+     */
+    bool Append(RunRecord& record);
+
+    // ========================================================================
+    // QUERIES
+    // ========================================================================
+
+    /**
+     * \brief Pick up runs appended since the last call
+     * \return Number of runs in the index
+     */
+    size_t Refresh();
+
+    /**
+     * \brief Get the number of indexed runs
+     * \return Run count (as of the last Refresh)
+     */
+    size_t GetNumRuns() const
+    {
+        return m_runs.size();
+    }
+
+    /**
+     * \brief Find runs without loading their metrics
+     * \param query Filter
+     * \return Matching runs, in append order, with empty metrics
+     */
+    std::vector<RunRecord> Find(const Query& query);
+
+    /**
+     * \brief Find runs and load their metrics
+     * \param query Filter
+     * \return Matching runs, in append order
+     */
+    std::vector<RunRecord> Load(const Query& query);
+
+    /**
+     * \brief Aggregate one metric over the matching runs
+     * \param query Filter
+     * \param metric Metric name
+     * \return Statistics (count = 0 if no run has the metric)
+     */
+    Aggregate Summarize(const Query& query, const std::string& metric);
+
+    /**
+     * \brief Aggregate one metric per value of a parameter
+     * \param query Filter
+     * \param param Parameter to group by (runs without it are skipped)
+     * \param metric Metric name
+     * \return Parameter value → statistics
+     */
+    std::map<std::string, Aggregate> GroupBy(const Query& query,
+                                             const std::string& param,
+                                             const std::string& metric);
+
+    // ========================================================================
+    // HASHING
+    // ========================================================================
+
+    /**
+     * \brief Hash a configuration text (64-bit FNV-1a)
+     * \param text Configuration, e.g. NrSimConfig::Print() output
+     * \return 16 hex digits
+     */
+    static std::string HashConfig(const std::string& text);
+
+  private:
+    /**
+     * \brief Parse one index line
+     * \param line Line without the newline
+     * \param record Output
+     * \return true if the line is well-formed
+     */
+    static bool ParseIndexLine(const std::string& line, RunRecord& record);
+
+    /**
+     * \brief Format the index line of a run
+     * \param record Run
+     * \return Line including the newline
+     */
+    static std::string FormatIndexLine(const RunRecord& record);
+
+    /**
+     * \brief Read the metrics of runs from their segments
+     * \param records Runs whose metrics are loaded in place
+     */
+    void LoadMetrics(std::vector<RunRecord>& records) const;
+
+    /**
+     * \brief Get the path of a segment
+     * \param segment Segment number
+     * \return Path inside the store
+     */
+    std::string SegmentPath(uint32_t segment) const;
+
+    /**
+     * \brief %-escape tabs, newlines and the params separators
+     * \param text Raw text
+     * \return Escaped text
+     */
+    static std::string Escape(const std::string& text);
+
+    /**
+     * \brief Undo Escape()
+     * \param text Escaped text
+     * \return Raw text
+     */
+    static std::string Unescape(const std::string& text);
+
+    std::string m_directory;          ///< Store directory ("" = not open)
+    uint64_t m_segmentLimit;          ///< Segment size that starts a new one
+    uint64_t m_indexOffset;           ///< Bytes of the index already parsed
+    std::vector<RunRecord> m_runs;    ///< Index (metrics not loaded)
+};
+
+} // namespace ns3
+
+#endif /* NR_RESULTS_STORE_H */
@@ -13,6 +13,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <set>
 
 // Include nlohmann/json (header-only library)
 #include "nlohmann/json.hpp"
@@ -99,6 +100,16 @@ NrSimConfig::LoadFromJson(const std::string& filename)
             ParseTraffic(j["traffic"]);
         }
 
+        if (j.contains("scheduling"))
+        {
+            ParseScheduling(j["scheduling"]);
+        }
+
+        if (j.contains("partition"))
+        {
+            ParsePartition(j["partition"]);
+        }
+
         if (j.contains("simulation"))
         {
             ParseSimulation(j["simulation"]);
@@ -253,8 +264,49 @@ NrSimConfig::ParseChannel(const json& j)
     if (j.contains("bandwidth"))
         channel.bandwidth = j["bandwidth"].get<double>();
 
+    if (j.contains("carriers"))
+    {
+        channel.carriers.clear();
+        for (const auto& c : j["carriers"])
+        {
+            ChannelParams::CarrierParams carrier;
+            if (c.contains("frequency"))
+                carrier.frequency = c["frequency"].get<double>();
+            if (c.contains("bandwidth"))
+                carrier.bandwidth = c["bandwidth"].get<double>();
+            if (c.contains("numerology"))
+                carrier.numerology = c["numerology"].get<uint16_t>();
+            channel.carriers.push_back(carrier);
+        }
+    }
+
+    if (j.contains("beamforming"))
+    {
+        const auto& bf = j["beamforming"];
+        auto& beamforming = channel.beamforming;
+        if (bf.contains("gnbRows"))
+            beamforming.gnbRows = bf["gnbRows"].get<uint32_t>();
+        if (bf.contains("gnbColumns"))
+            beamforming.gnbColumns = bf["gnbColumns"].get<uint32_t>();
+        if (bf.contains("ueRows"))
+            beamforming.ueRows = bf["ueRows"].get<uint32_t>();
+        if (bf.contains("ueColumns"))
+            beamforming.ueColumns = bf["ueColumns"].get<uint32_t>();
+        if (bf.contains("updatePeriod"))
+            beamforming.updatePeriod = bf["updatePeriod"].get<double>();
+        if (bf.contains("cache"))
+            beamforming.cache = bf["cache"].get<bool>();
+        if (bf.contains("cacheAngleStep"))
+            beamforming.cacheAngleStep = bf["cacheAngleStep"].get<double>();
+        if (bf.contains("cacheDistanceStep"))
+            beamforming.cacheDistanceStep = bf["cacheDistanceStep"].get<double>();
+        if (bf.contains("cacheMoveThreshold"))
+            beamforming.cacheMoveThreshold = bf["cacheMoveThreshold"].get<double>();
+    }
+
     NS_LOG_INFO("Channel config parsed: " << channel.propagationModel << ", "
-                                           << channel.frequency / 1e9 << " GHz");
+                                           << channel.frequency / 1e9 << " GHz, "
+                                           << GetCarriers().size() << " carrier(s)");
 }
 
 void
@@ -359,6 +411,19 @@ NrSimConfig::ParseTraffic(const json& j)
         traffic.startTime = j["startTime"].get<double>();
     if (j.contains("duration"))
         traffic.duration = j["duration"].get<double>();
+    if (j.contains("burstInterval"))
+        traffic.burstInterval = j["burstInterval"].get<double>();
+    if (j.contains("burstDuration"))
+        traffic.burstDuration = j["burstDuration"].get<double>();
+
+    if (j.contains("dormancy"))
+    {
+        const json& d = j["dormancy"];
+        if (d.contains("enabled"))
+            traffic.dormancy.enabled = d["enabled"].get<bool>();
+        if (d.contains("inactivityTimer"))
+            traffic.dormancy.inactivityTimer = d["inactivityTimer"].get<double>();
+    }
 
     NS_LOG_INFO("Traffic config parsed: DL=" << traffic.udpRateDl << " Mbps, UL="
                                               << traffic.udpRateUl << " Mbps");
@@ -387,10 +452,122 @@ NrSimConfig::ParseMonitoring(const json& j)
         monitoring.monitorInterval = j["monitorInterval"].get<double>();
     if (j.contains("enableExternalControl"))
         monitoring.enableExternalControl = j["enableExternalControl"].get<bool>();
+    if (j.contains("metricsPort"))
+        monitoring.metricsPort = j["metricsPort"].get<uint16_t>();
+    if (j.contains("metricsFile"))
+        monitoring.metricsFile = j["metricsFile"].get<std::string>();
+    if (j.contains("metricsInterval"))
+        monitoring.metricsInterval = j["metricsInterval"].get<double>();
     NS_LOG_INFO("Monitoring config parsed: interval=" << monitoring.monitorInterval << " seconds"
                  << ", enableExternalControl=" << (monitoring.enableExternalControl ? "true" : "false") << ")");
 }
 
+void
+NrSimConfig::ParseScheduling(const json& j)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (j.contains("schedulerType"))
+        scheduling.schedulerType = j["schedulerType"].get<std::string>();
+    if (j.contains("planningGranularitySlots"))
+        scheduling.planningGranularitySlots = j["planningGranularitySlots"].get<uint32_t>();
+
+    if (j.contains("coordination"))
+    {
+        const json& c = j["coordination"];
+        auto& coord = scheduling.coordination;
+        if (c.contains("enabled"))
+            coord.enabled = c["enabled"].get<bool>();
+        if (c.contains("edgeDistanceRatio"))
+            coord.edgeDistanceRatio = c["edgeDistanceRatio"].get<double>();
+        if (c.contains("edgeBandFraction"))
+            coord.edgeBandFraction = c["edgeBandFraction"].get<double>();
+        if (c.contains("restriction"))
+            coord.restriction = c["restriction"].get<std::string>();
+        if (c.contains("powerBackoffDb"))
+            coord.powerBackoffDb = c["powerBackoffDb"].get<double>();
+    }
+
+    if (j.contains("slicing"))
+    {
+        const json& sl = j["slicing"];
+        auto& slicing = scheduling.slicing;
+        if (sl.contains("enabled"))
+            slicing.enabled = sl["enabled"].get<bool>();
+        if (sl.contains("slices"))
+        {
+            for (const auto& [name, q] : sl["slices"].items())
+            {
+                auto& quota = slicing.quotas[name];
+                if (q.contains("guaranteedShare"))
+                    quota.guaranteedShare = q["guaranteedShare"].get<double>();
+                if (q.contains("maxShare"))
+                    quota.maxShare = q["maxShare"].get<double>();
+            }
+        }
+        if (sl.contains("ueSlices"))
+        {
+            for (const auto& [ueId, name] : sl["ueSlices"].items())
+            {
+                slicing.ueSlices[std::stoul(ueId)] = name.get<std::string>();
+            }
+        }
+    }
+
+    if (j.contains("preemption"))
+    {
+        const json& pr = j["preemption"];
+        auto& preemption = scheduling.preemption;
+        if (pr.contains("enabled"))
+            preemption.enabled = pr["enabled"].get<bool>();
+        if (pr.contains("miniSlotSymbols"))
+            preemption.miniSlotSymbols = pr["miniSlotSymbols"].get<uint32_t>();
+        if (pr.contains("maxPreemptedFraction"))
+            preemption.maxPreemptedFraction = pr["maxPreemptedFraction"].get<double>();
+        if (pr.contains("urllcLatencyMs"))
+            preemption.urllcLatencyMs = pr["urllcLatencyMs"].get<double>();
+    }
+
+    if (j.contains("harq"))
+    {
+        const json& h = j["harq"];
+        if (h.contains("enabled"))
+            scheduling.harq.enabled = h["enabled"].get<bool>();
+        if (h.contains("reservedPrbFraction"))
+            scheduling.harq.reservedPrbFraction = h["reservedPrbFraction"].get<double>();
+    }
+
+    if (j.contains("aggregation"))
+    {
+        const json& a = j["aggregation"];
+        if (a.contains("enabled"))
+            scheduling.aggregation.enabled = a["enabled"].get<bool>();
+        if (a.contains("mcsBandWidth"))
+            scheduling.aggregation.mcsBandWidth = a["mcsBandWidth"].get<uint16_t>();
+    }
+
+    NS_LOG_INFO("Scheduling config parsed: schedulerType=" << scheduling.schedulerType
+                 << ", coordination=" << (scheduling.coordination.enabled ? "true" : "false")
+                 << ", slicing=" << (scheduling.slicing.enabled ? "true" : "false")
+                 << ", preemption=" << (scheduling.preemption.enabled ? "true" : "false")
+                 << ", harq=" << (scheduling.harq.enabled ? "true" : "false")
+                 << ", aggregation=" << (scheduling.aggregation.enabled ? "true" : "false"));
+}
+
+void
+NrSimConfig::ParsePartition(const json& j)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (j.contains("enabled"))
+        partition.enabled = j["enabled"].get<bool>();
+    if (j.contains("interferenceMarginDb"))
+        partition.interferenceMarginDb = j["interferenceMarginDb"].get<double>();
+
+    NS_LOG_INFO("Partition config parsed: enabled=" << (partition.enabled ? "true" : "false")
+                 << ", interferenceMarginDb=" << partition.interferenceMarginDb);
+}
+
 void
 NrSimConfig::ParseDebug(const json& j)
 {
@@ -414,9 +591,24 @@ NrSimConfig::ParseMetrics(const json& j)
         enableFlowMonitor = j["enableFlowMonitor"].get<bool>();
     if (j.contains("outputFilePath"))
         outputFilePath = j["outputFilePath"].get<std::string>();
+    if (j.contains("resultsInterval"))
+        resultsInterval = j["resultsInterval"].get<double>();
+    if (j.contains("resultsCsv"))
+        resultsCsv = j["resultsCsv"].get<bool>();
+    if (j.contains("resultsCompress"))
+        resultsCompress = j["resultsCompress"].get<bool>();
+    if (j.contains("recordTelemetry"))
+        recordTelemetry = j["recordTelemetry"].get<bool>();
+    if (j.contains("binaryTraces"))
+        binaryTraces = j["binaryTraces"].get<bool>();
+    if (j.contains("resultsStore"))
+        resultsStore = j["resultsStore"].get<std::string>();
+    if (j.contains("memoryProfile"))
+        memoryProfile = j["memoryProfile"].get<bool>();
 
     NS_LOG_INFO("Metrics config parsed: FlowMonitor=" << (enableFlowMonitor ? "enabled" : "disabled")
-                                                       << ", outputFilePath=" << outputFilePath);
+                                                       << ", outputFilePath=" << outputFilePath
+                                                       << ", resultsInterval=" << resultsInterval);
 }
 
 // ========================================================================
@@ -456,6 +648,172 @@ NrSimConfig::Validate() const
         std::cout << "bandwidth must be > 0, got " << channel.bandwidth << std::endl;
         isValid = false;
     }
+    for (size_t i = 0; i < channel.carriers.size(); ++i)
+    {
+        const auto& carrier = channel.carriers[i];
+        if (carrier.frequency <= 0 || carrier.bandwidth <= 0 || carrier.numerology > 4)
+        {
+            NS_LOG_ERROR("carrier " << i << " invalid: frequency and bandwidth must be > 0, "
+                         "numerology in [0, 4]");
+            std::cout << "carrier " << i << " invalid: frequency and bandwidth must be > 0, "
+                      << "numerology in [0, 4]" << std::endl;
+            isValid = false;
+        }
+    }
+    const auto& beamforming = channel.beamforming;
+    if (beamforming.gnbRows == 0 || beamforming.gnbColumns == 0 || beamforming.ueRows == 0 ||
+        beamforming.ueColumns == 0)
+    {
+        NS_LOG_ERROR("beamforming antenna rows and columns must be > 0");
+        std::cout << "beamforming antenna rows and columns must be > 0" << std::endl;
+        isValid = false;
+    }
+    if (beamforming.updatePeriod <= 0)
+    {
+        NS_LOG_ERROR("beamforming.updatePeriod must be > 0, got " << beamforming.updatePeriod);
+        std::cout << "beamforming.updatePeriod must be > 0, got " << beamforming.updatePeriod
+                  << std::endl;
+        isValid = false;
+    }
+    if (beamforming.cache &&
+        (beamforming.cacheAngleStep <= 0 || beamforming.cacheAngleStep > 90 ||
+         beamforming.cacheDistanceStep <= 0 || beamforming.cacheMoveThreshold < 0))
+    {
+        NS_LOG_ERROR("beamforming cache: cacheAngleStep must be in (0, 90], "
+                     "cacheDistanceStep > 0, cacheMoveThreshold >= 0");
+        std::cout << "beamforming cache: cacheAngleStep must be in (0, 90], "
+                  << "cacheDistanceStep > 0, cacheMoveThreshold >= 0" << std::endl;
+        isValid = false;
+    }
+
+    // Scheduling validation
+    const auto& coord = scheduling.coordination;
+    if (coord.enabled)
+    {
+        if (coord.edgeDistanceRatio <= 0.0 || coord.edgeDistanceRatio > 1.0)
+        {
+            NS_LOG_ERROR("coordination.edgeDistanceRatio must be in (0, 1]");
+            std::cout << "coordination.edgeDistanceRatio must be in (0, 1], got "
+                      << coord.edgeDistanceRatio << std::endl;
+            isValid = false;
+        }
+        if (coord.edgeBandFraction <= 0.0 || coord.edgeBandFraction >= 1.0)
+        {
+            NS_LOG_ERROR("coordination.edgeBandFraction must be in (0, 1)");
+            std::cout << "coordination.edgeBandFraction must be in (0, 1), got "
+                      << coord.edgeBandFraction << std::endl;
+            isValid = false;
+        }
+        if (coord.restriction != "muting" && coord.restriction != "power")
+        {
+            NS_LOG_ERROR("coordination.restriction must be 'muting' or 'power'");
+            std::cout << "coordination.restriction must be 'muting' or 'power', got '"
+                      << coord.restriction << "'" << std::endl;
+            isValid = false;
+        }
+    }
+
+    const auto& slicing = scheduling.slicing;
+    if (slicing.enabled)
+    {
+        static const std::set<std::string> sliceNames = {"eMBB", "uRLLC", "mMTC"};
+        double guaranteed = 0.0;
+        for (const auto& [name, quota] : slicing.quotas)
+        {
+            if (!sliceNames.count(name))
+            {
+                NS_LOG_ERROR("slicing: unknown slice '" << name << "'");
+                std::cout << "slicing: unknown slice '" << name
+                          << "' (expected eMBB, uRLLC or mMTC)" << std::endl;
+                isValid = false;
+            }
+            if (quota.guaranteedShare < 0.0 || quota.maxShare > 1.0 ||
+                quota.guaranteedShare > quota.maxShare)
+            {
+                NS_LOG_ERROR("slicing: slice '" << name << "' needs 0 <= guaranteedShare <= "
+                             "maxShare <= 1");
+                std::cout << "slicing: slice '" << name << "' needs 0 <= guaranteedShare ("
+                          << quota.guaranteedShare << ") <= maxShare (" << quota.maxShare
+                          << ") <= 1" << std::endl;
+                isValid = false;
+            }
+            guaranteed += quota.guaranteedShare;
+        }
+        if (guaranteed > 1.0 + 1e-9)
+        {
+            NS_LOG_ERROR("slicing: guaranteed shares sum to " << guaranteed << " > 1");
+            std::cout << "slicing: guaranteed shares sum to " << guaranteed << " > 1"
+                      << std::endl;
+            isValid = false;
+        }
+        for (const auto& [ueId, name] : slicing.ueSlices)
+        {
+            if (!sliceNames.count(name))
+            {
+                NS_LOG_ERROR("slicing: UE " << ueId << " has unknown slice '" << name << "'");
+                std::cout << "slicing: UE " << ueId << " has unknown slice '" << name << "'"
+                          << std::endl;
+                isValid = false;
+            }
+        }
+    }
+
+    const auto& preemption = scheduling.preemption;
+    if (preemption.enabled)
+    {
+        if (!slicing.enabled)
+        {
+            NS_LOG_ERROR("preemption requires slicing (uRLLC UEs come from slicing.ueSlices)");
+            std::cout << "preemption requires slicing.enabled (uRLLC UEs come from "
+                      << "slicing.ueSlices)" << std::endl;
+            isValid = false;
+        }
+        if (preemption.miniSlotSymbols < 1 || preemption.miniSlotSymbols > 13)
+        {
+            NS_LOG_ERROR("preemption.miniSlotSymbols must be in [1, 13]");
+            std::cout << "preemption.miniSlotSymbols must be in [1, 13], got "
+                      << preemption.miniSlotSymbols << std::endl;
+            isValid = false;
+        }
+        if (preemption.maxPreemptedFraction <= 0.0 || preemption.maxPreemptedFraction > 1.0)
+        {
+            NS_LOG_ERROR("preemption.maxPreemptedFraction must be in (0, 1]");
+            std::cout << "preemption.maxPreemptedFraction must be in (0, 1], got "
+                      << preemption.maxPreemptedFraction << std::endl;
+            isValid = false;
+        }
+        if (preemption.urllcLatencyMs <= 0.0)
+        {
+            NS_LOG_ERROR("preemption.urllcLatencyMs must be > 0");
+            std::cout << "preemption.urllcLatencyMs must be > 0, got "
+                      << preemption.urllcLatencyMs << std::endl;
+            isValid = false;
+        }
+    }
+
+    if (scheduling.harq.reservedPrbFraction < 0.0 || scheduling.harq.reservedPrbFraction > 0.5)
+    {
+        NS_LOG_ERROR("harq.reservedPrbFraction must be in [0, 0.5]");
+        std::cout << "harq.reservedPrbFraction must be in [0, 0.5], got "
+                  << scheduling.harq.reservedPrbFraction << std::endl;
+        isValid = false;
+    }
+
+    if (scheduling.planningGranularitySlots < 1)
+    {
+        NS_LOG_ERROR("planningGranularitySlots must be >= 1");
+        std::cout << "planningGranularitySlots must be >= 1, got "
+                  << scheduling.planningGranularitySlots << std::endl;
+        isValid = false;
+    }
+
+    if (scheduling.aggregation.mcsBandWidth < 1 || scheduling.aggregation.mcsBandWidth > 29)
+    {
+        NS_LOG_ERROR("aggregation.mcsBandWidth must be in [1, 29]");
+        std::cout << "aggregation.mcsBandWidth must be in [1, 29], got "
+                  << scheduling.aggregation.mcsBandWidth << std::endl;
+        isValid = false;
+    }
 
     // Mobility validation
     if (mobility.defaultSpeed < 0)
@@ -498,6 +856,22 @@ NrSimConfig::Validate() const
         std::cout << "udpRateDl must be > 0, got " << traffic.udpRateDl << std::endl;
         isValid = false;
     }
+    if (traffic.burstInterval < 0 || (traffic.burstInterval > 0 && traffic.burstDuration <= 0))
+    {
+        NS_LOG_ERROR("burstInterval must be >= 0 and burstDuration > 0, got "
+                     << traffic.burstInterval << " / " << traffic.burstDuration);
+        std::cout << "burstInterval must be >= 0 and burstDuration > 0, got "
+                  << traffic.burstInterval << " / " << traffic.burstDuration << std::endl;
+        isValid = false;
+    }
+    if (traffic.dormancy.enabled && traffic.dormancy.inactivityTimer <= 0)
+    {
+        NS_LOG_ERROR("dormancy.inactivityTimer must be > 0, got "
+                     << traffic.dormancy.inactivityTimer);
+        std::cout << "dormancy.inactivityTimer must be > 0, got "
+                  << traffic.dormancy.inactivityTimer << std::endl;
+        isValid = false;
+    }
 
     // Simulation validation
     if (simDuration <= 0)
@@ -507,6 +881,22 @@ NrSimConfig::Validate() const
         isValid = false;
     }
 
+    // Monitoring validation
+    if (!monitoring.metricsFile.empty() && monitoring.metricsInterval <= 0)
+    {
+        NS_LOG_ERROR("metricsInterval must be > 0, got " << monitoring.metricsInterval);
+        std::cout << "metricsInterval must be > 0, got " << monitoring.metricsInterval
+                  << std::endl;
+        isValid = false;
+    }
+
+    if (resultsInterval < 0)
+    {
+        NS_LOG_ERROR("resultsInterval must be >= 0, got " << resultsInterval);
+        std::cout << "resultsInterval must be >= 0, got " << resultsInterval << std::endl;
+        isValid = false;
+    }
+
     return isValid;
 }
 
@@ -520,6 +910,21 @@ NrSimConfig::HasUeWaypoints(uint32_t ueId) const
     return mobility.ueWaypoints.find(ueId) != mobility.ueWaypoints.end();
 }
 
+std::vector<NrSimConfig::ChannelParams::CarrierParams>
+NrSimConfig::GetCarriers() const
+{
+    if (!channel.carriers.empty())
+    {
+        return channel.carriers;
+    }
+
+    ChannelParams::CarrierParams single;
+    single.frequency = channel.frequency;
+    single.bandwidth = channel.bandwidth;
+    single.numerology = 1;
+    return {single};
+}
+
 UeWaypointConfig
 NrSimConfig::GetUeWaypoints(uint32_t ueId) const
 {
@@ -571,8 +976,28 @@ NrSimConfig::Print(std::ostream& os) const
        << "┌─ CHANNEL ──────────────────────────────────────────────────────┐\n"
        << "│ Propagation Model:  " << channel.propagationModel << "\n"
        << "│ Frequency:          " << channel.frequency / 1e9 << " GHz\n"
-       << "│ Bandwidth:          " << channel.bandwidth / 1e6 << " MHz\n"
-       << "└────────────────────────────────────────────────────────────────┘\n"
+       << "│ Bandwidth:          " << channel.bandwidth / 1e6 << " MHz\n";
+    if (!channel.carriers.empty())
+    {
+        for (size_t i = 0; i < channel.carriers.size(); ++i)
+        {
+            os << "│ Carrier " << i << ":          " << channel.carriers[i].frequency / 1e9
+               << " GHz, " << channel.carriers[i].bandwidth / 1e6 << " MHz, mu="
+               << channel.carriers[i].numerology << "\n";
+        }
+    }
+    const auto& beamforming = channel.beamforming;
+    os << "│ Antennas:           gNB " << beamforming.gnbRows << "x" << beamforming.gnbColumns
+       << ", UE " << beamforming.ueRows << "x" << beamforming.ueColumns << "\n"
+       << "│ Beam Updates:       every " << beamforming.updatePeriod * 1e3 << " ms";
+    if (beamforming.cache)
+    {
+        os << ", cached (" << beamforming.cacheAngleStep << " deg, "
+           << beamforming.cacheDistanceStep * 100 << "% distance, "
+           << beamforming.cacheMoveThreshold << " m)";
+    }
+    os << "\n";
+    os << "└────────────────────────────────────────────────────────────────┘\n"
        << "\n"
        << "┌─ MOBILITY ─────────────────────────────────────────────────────┐\n"
        << "│ Default Model:      " << mobility.defaultModel << "\n"
@@ -598,6 +1023,64 @@ NrSimConfig::Print(std::ostream& os) const
        << "│ DL Packet Size:     " << traffic.packetSizeDl << " bytes\n"
        << "│ UL Rate:            " << traffic.udpRateUl << " Mbps\n"
        << "│ UL Packet Size:     " << traffic.packetSizeUl << " bytes\n"
+       << "│ Pattern:            ";
+    if (traffic.burstInterval > 0)
+        os << traffic.burstDuration << " s bursts every ~" << traffic.burstInterval << " s\n";
+    else
+        os << "Continuous\n";
+    os << "│ Dormant UEs:        ";
+    if (traffic.dormancy.enabled)
+        os << "after " << traffic.dormancy.inactivityTimer << " s idle\n";
+    else
+        os << "Disabled\n";
+    os << "└────────────────────────────────────────────────────────────────┘\n"
+       << "\n"
+       << "┌─ SCHEDULING ───────────────────────────────────────────────────┐\n"
+       << "│ Scheduler:          " << scheduling.schedulerType << "\n"
+       << "│ Plan Granularity:   "
+       << (scheduling.planningGranularitySlots > 1
+               ? std::to_string(scheduling.planningGranularitySlots) + "-slot blocks"
+               : std::string("Per slot"))
+       << "\n"
+       << "│ Coordination:       "
+       << (scheduling.coordination.enabled
+               ? scheduling.coordination.restriction + ", edge ratio " +
+                     std::to_string(scheduling.coordination.edgeDistanceRatio)
+               : std::string("Disabled"))
+       << "\n"
+       << "│ Slicing:            "
+       << (scheduling.slicing.enabled
+               ? std::to_string(scheduling.slicing.quotas.size()) + " quota(s), " +
+                     std::to_string(scheduling.slicing.ueSlices.size()) + " UE assignment(s)"
+               : std::string("Disabled"))
+       << "\n";
+    for (const auto& [name, quota] : scheduling.slicing.quotas)
+    {
+        os << "│   " << name << ": guaranteed " << quota.guaranteedShare << ", max "
+           << quota.maxShare << "\n";
+    }
+    os << "│ URLLC Preemption:   "
+       << (scheduling.preemption.enabled
+               ? std::to_string(scheduling.preemption.miniSlotSymbols) + "-symbol mini-slots, " +
+                     std::to_string(scheduling.preemption.urllcLatencyMs) + " ms budget"
+               : std::string("Disabled"))
+       << "\n"
+       << "│ HARQ-Aware:         "
+       << (scheduling.harq.enabled
+               ? std::to_string(static_cast<int>(scheduling.harq.reservedPrbFraction * 100)) +
+                     "% PRBs reserved for retx"
+               : std::string("Disabled"))
+       << "\n"
+       << "│ SLA Aggregation:    "
+       << (scheduling.aggregation.enabled
+               ? "MCS bands of " + std::to_string(scheduling.aggregation.mcsBandWidth)
+               : std::string("Disabled"))
+       << "\n"
+       << "└────────────────────────────────────────────────────────────────┘\n"
+       << "\n"
+       << "┌─ SPATIAL SHARDING ─────────────────────────────────────────────┐\n"
+       << "│ Enabled:            " << (partition.enabled ? "Yes" : "No") << "\n"
+       << "│ Interf. Margin:     " << partition.interferenceMarginDb << " dB\n"
        << "└────────────────────────────────────────────────────────────────┘\n"
        << "\n"
        << "┌─ SIMULATION ───────────────────────────────────────────────────┐\n"
@@ -607,7 +1090,27 @@ NrSimConfig::Print(std::ostream& os) const
        << "┌─ METRICS ──────────────────────────────────────────────────────┐\n"
        << "│ Flow Monitor:       " << (enableFlowMonitor ? "Enabled" : "Disabled") << "\n"
        << "│ Output Path:        " << outputFilePath << "\n"
-       << "└────────────────────────────────────────────────────────────────┘\n"
+       << "│ Result Streams:     ";
+    if (resultsInterval > 0)
+        os << "every " << resultsInterval << " s" << (resultsCompress ? " (compressed)" : "")
+           << (resultsCsv ? " (+ CSV)" : "") << "\n";
+    else
+        os << "Disabled\n";
+    os << "│ Telemetry Record:   " << (recordTelemetry ? "Enabled (compressed)" : "Disabled") << "\n"
+       << "│ Binary Traces:      " << (binaryTraces ? "DCI, TB, RLC" : "Disabled") << "\n"
+       << "│ Results Store:      " << (resultsStore.empty() ? "Disabled" : resultsStore) << "\n"
+       << "│ Memory Profile:     " << (memoryProfile ? "Enabled" : "Disabled") << "\n"
+       << "│ Prometheus HTTP:    ";
+    if (monitoring.metricsPort)
+        os << "127.0.0.1:" << monitoring.metricsPort << "/metrics\n";
+    else
+        os << "Disabled\n";
+    os << "│ Prometheus File:    ";
+    if (!monitoring.metricsFile.empty())
+        os << monitoring.metricsFile << " (every " << monitoring.metricsInterval << " s)\n";
+    else
+        os << "Disabled\n";
+    os << "└────────────────────────────────────────────────────────────────┘\n"
        << "\n";
 }
 
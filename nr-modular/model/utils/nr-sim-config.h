@@ -118,8 +118,38 @@ class NrSimConfig : public Object
         std::string propagationModel = "UMa";
         double frequency = 3.5e9;  // Hz
         double bandwidth = 20e6;   // Hz
+
+        // Component carriers, one BWP each. Empty = a single carrier at
+        // frequency/bandwidth with numerology 1.
+        struct CarrierParams
+        {
+            double frequency = 3.5e9;  // Hz
+            double bandwidth = 20e6;   // Hz
+            uint16_t numerology = 1;   // SCS = 15 kHz * 2^numerology
+        };
+        std::vector<CarrierParams> carriers;
+
+        // Antenna arrays and ideal (direct-path) beamforming
+        struct BeamformingParams
+        {
+            uint32_t gnbRows = 2;             // gNB UPA rows
+            uint32_t gnbColumns = 4;          // gNB UPA columns
+            uint32_t ueRows = 1;              // UE UPA rows
+            uint32_t ueColumns = 2;           // UE UPA columns
+            double updatePeriod = 0.1;        // s between beam updates
+            bool cache = false;               // Reuse beams while the geometry holds
+            double cacheAngleStep = 2.0;      // degrees per angle bucket
+            double cacheDistanceStep = 0.25;  // relative width of a distance bucket
+            double cacheMoveThreshold = 1.0;  // m moved before the geometry is re-checked
+        } beamforming;
     } channel;
 
+    /**
+     * @brief Get the effective component carriers
+     * @return channel.carriers, or the single legacy carrier if empty
+     */
+    std::vector<ChannelParams::CarrierParams> GetCarriers() const;
+
     // Mobility parameters
     struct MobilityParams
     {
@@ -153,7 +183,20 @@ class NrSimConfig : public Object
         bool enableFlowMonitoring = true;
         double startTime = 0.0;        // seconds
         double duration = 10.0;        // seconds
-        
+
+        // Sparse (mMTC-style) traffic: every flow sends bursts of
+        // burstDuration at its rate, separated by exponential gaps with
+        // mean burstInterval (0 = continuous traffic)
+        double burstInterval = 0.0;    // seconds
+        double burstDuration = 0.05;   // seconds
+
+        // Dormant UEs: a UE without packets for inactivityTimer leaves the
+        // PHY (no DL reception, SINR or CQI) until its next packet
+        struct DormancyParams
+        {
+            bool enabled = false;
+            double inactivityTimer = 1.0;  // seconds
+        } dormancy;
     } traffic;
 
     // Simulation parameters
@@ -165,8 +208,96 @@ class NrSimConfig : public Object
     {
         double monitorInterval = 0.051; // seconds
         bool enableExternalControl = true;
+
+        // Prometheus exposition of NrMetricsRegistry from a background
+        // thread: HTTP on 127.0.0.1:metricsPort (0 = off) and/or a file
+        // rewritten every metricsInterval seconds ("" = off)
+        uint16_t metricsPort = 0;
+        std::string metricsFile;
+        double metricsInterval = 5.0;  // seconds
     } monitoring;
 
+    // Scheduling parameters
+    struct SchedulingParams
+    {
+        // MAC scheduler installed on every gNB (any NrMacScheduler TypeId name,
+        // e.g. "ns3::NrMacSchedulerTdmaRR", "ns3::NrMacSchedulerOfdmaPF")
+        std::string schedulerType = "ns3::NrMilpExecutorScheduler";
+
+        // Coarse MILP planning: the plan holds per-UE PRB budgets for blocks
+        // of this many slots, expanded to slots by the BWP manager (1 = the
+        // solver places PRBs per slot).
+        uint32_t planningGranularitySlots = 1;
+
+        // Joint multi-cell MILP planning. UEs whose serving/neighbour site
+        // distance ratio exceeds edgeDistanceRatio are cell-edge; they get a
+        // reuse-3 sub-band of the edge band that neighbouring cells mute
+        // ("muting") or transmit on with reduced power ("power").
+        struct CoordinationParams
+        {
+            bool enabled = false;
+            double edgeDistanceRatio = 0.8;     // d_serving / d_neighbour, (0, 1]
+            double edgeBandFraction = 0.3;      // Share of PRBs in the edge band
+            std::string restriction = "muting"; // "muting" or "power"
+            double powerBackoffDb = 6.0;        // Backoff on protected PRBs ("power")
+        } coordination;
+
+        // RAN slicing: per-slot PRB quotas per slice, enforced between the
+        // MILP plan and the executor. Shares are fractions of a BWP's PRBs;
+        // unused guaranteed PRBs are lent to slices with remaining demand.
+        struct SlicingParams
+        {
+            struct SliceQuota
+            {
+                double guaranteedShare = 0.0;  // Always available to the slice
+                double maxShare = 1.0;         // Never exceeded
+            };
+
+            bool enabled = false;
+            std::map<std::string, SliceQuota> quotas;   // "eMBB" / "uRLLC" / "mMTC"
+            std::map<uint32_t, std::string> ueSlices;   // ueId → slice (default eMBB)
+        } slicing;
+
+        // URLLC mini-slot preemption (DL). uRLLC-slice UEs whose backlog the
+        // plan cannot serve within urllcLatencyMs get the first
+        // miniSlotSymbols symbols of a slot, taken from idle RBGs and then
+        // from eMBB allocations. Requires slicing (to know the uRLLC UEs).
+        struct PreemptionParams
+        {
+            bool enabled = false;
+            uint32_t miniSlotSymbols = 2;       // 1 - 13
+            double maxPreemptedFraction = 0.5;  // Max share of RBGs per slot
+            double urllcLatencyMs = 1.0;        // UeSla::latencyMs of uRLLC UEs
+        } preemption;
+
+        // HARQ-aware plan execution. The top reservedPrbFraction of every
+        // BWP is left out of the plan as a retransmission pool; DL retx are
+        // placed on the data symbols (pool first, then planned RBGs)
+        // instead of in front of the planned data.
+        struct HarqParams
+        {
+            bool enabled = false;
+            double reservedPrbFraction = 0.0;  // 0 - 0.5 of the BWP
+        } harq;
+
+        // SLA-class aggregation. UEs with the same slice, throughput and
+        // latency, MCS band and cell/edge status are planned as one class;
+        // the class plan is expanded round-robin to the member UEs.
+        struct AggregationParams
+        {
+            bool enabled = false;
+            uint16_t mcsBandWidth = 4;  // MCS values per band, 1 - 29
+        } aggregation;
+    } scheduling;
+
+    // Spatial sharding (independent runs, one shard per MPI rank, no cross-rank links)
+    struct PartitionParams
+    {
+        bool enabled = false;
+        // Out-of-shard interference, added to the UE noise figure
+        double interferenceMarginDb = 0.0;
+    } partition;
+
     // Debug parameters
     struct DebugParams
     {
@@ -178,6 +309,20 @@ class NrSimConfig : public Object
     // Metrics parameters
     bool enableFlowMonitor = true;
     std::string outputFilePath = "output/results.txt";
+    // Per-UE / per-cell time series streamed to <outputFilePath>.{ue,cell}.nrcol
+    double resultsInterval = 0.0;  // seconds (0 = final summary only)
+    bool resultsCsv = false;       // Also write <outputFilePath>.{ue,cell}.csv
+    bool resultsCompress = false;  // Delta-encode and compress the .nrcol row groups
+    // Every published telemetry state, compressed, to <outputFilePath>.telemetry.nrz
+    bool recordTelemetry = false;
+    // DCI, TB reception and RLC PDU traces as binary records to
+    // <outputFilePath>.{dci,tb,rlc}.nrtrace (text via nr-trace-convert)
+    bool binaryTraces = false;
+    // Cross-run results store directory appended to by Finalize() ("" = off)
+    std::string resultsStore;
+    // Attribute heap usage to setup phases and manager containers, printed
+    // after Initialize() and Finalize() (and stored as mem_* metrics)
+    bool memoryProfile = false;
 
   protected:
     void DoDispose() override;
@@ -218,6 +363,19 @@ class NrSimConfig : public Object
      * @param j JSON object
      */
     void ParseMonitoring(const nlohmann::json& j);
+
+    /**
+     * @brief Parse scheduling section from JSON
+     * @param j JSON object
+     */
+    void ParseScheduling(const nlohmann::json& j);
+
+    /**
+     * @brief Parse partition section from JSON
+     * @param j JSON object
+     */
+    void ParsePartition(const nlohmann::json& j);
+
     /**
      * @brief Parse debug section from JSON
      * @param j JSON object
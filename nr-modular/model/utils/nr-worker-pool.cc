@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Worker Pool - Implementation File
+ */
+
+#include "nr-worker-pool.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrWorkerPool");
+
+NrWorkerPool::NrWorkerPool(uint32_t numThreads)
+    : m_body(nullptr),
+      m_n(0),
+      m_ranges(0),
+      m_pending(0),
+      m_generation(0),
+      m_stop(false)
+{
+    if (numThreads == 0)
+    {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    NS_LOG_FUNCTION(this << numThreads);
+
+    for (uint32_t i = 0; i + 1 < numThreads; ++i)
+    {
+        m_threads.emplace_back(&NrWorkerPool::WorkerLoop, this, i);
+    }
+}
+
+NrWorkerPool::~NrWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void
+NrWorkerPool::ParallelFor(size_t n, const RangeFunction& body, size_t minRange)
+{
+    if (n == 0)
+    {
+        return;
+    }
+    minRange = std::max<size_t>(1, minRange);
+    size_t ranges = std::min<size_t>(GetNumThreads(), (n + minRange - 1) / minRange);
+    if (ranges <= 1)
+    {
+        body(0, n);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_body = &body;
+        m_n = n;
+        m_ranges = static_cast<uint32_t>(ranges);
+        m_pending = m_ranges - 1;
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_start.notify_all();
+
+    RunRange(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    m_body = nullptr;
+    if (m_error)
+    {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void
+NrWorkerPool::RunRange(uint32_t range)
+{
+    size_t begin = m_n * range / m_ranges;
+    size_t end = m_n * (range + 1) / m_ranges;
+    try
+    {
+        (*m_body)(begin, end);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_error)
+        {
+            m_error = std::current_exception();
+        }
+    }
+}
+
+void
+NrWorkerPool::WorkerLoop(uint32_t index)
+{
+    uint64_t seen = 0;
+    while (true)
+    {
+        uint32_t range = index + 1;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop)
+            {
+                return;
+            }
+            seen = m_generation;
+            if (range >= m_ranges)
+            {
+                continue;  // Job too small to need this worker
+            }
+        }
+
+        RunRange(range);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0)
+        {
+            m_done.notify_one();
+        }
+    }
+}
+
+} // namespace ns3
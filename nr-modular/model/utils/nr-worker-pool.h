@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Worker Pool - Header File
+ *
+ * Small persistent thread pool for fork-join loops run while the
+ * simulator thread waits (e.g. telemetry collection). ParallelFor()
+ * splits [0, n) into contiguous ranges, runs the first range on the
+ * calling thread and the others on the pool, and returns when all are
+ * done.
+ *
+ * The body must only read shared state and write to its own range:
+ * ns-3 objects are not thread-safe (Ptr reference counts, GetObject()
+ * aggregate caching, the scheduler), so anything that copies a Ptr to a
+ * shared object or schedules an event belongs on the simulator thread.
+ */
+
+#ifndef NR_WORKER_POOL_H
+#define NR_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Persistent fork-join thread pool
+ */
+class NrWorkerPool
+{
+  public:
+    /// Loop body over the range [begin, end)
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    /**
+     * \brief Start the pool
+     * \param numThreads Threads including the caller (0 = hardware threads)
+     */
+    explicit NrWorkerPool(uint32_t numThreads = 0);
+
+    /**
+     * \brief Stop and join the workers
+     */
+    ~NrWorkerPool();
+
+    NrWorkerPool(const NrWorkerPool&) = delete;
+    NrWorkerPool& operator=(const NrWorkerPool&) = delete;
+
+    /**
+     * \brief Get the number of threads a loop is split across
+     * \return Pool threads + the caller
+     */
+    uint32_t GetNumThreads() const
+    {
+        return static_cast<uint32_t>(m_threads.size()) + 1;
+    }
+
+    /**
+     * \brief Run body over [0, n) in contiguous ranges and wait
+     * \param n Iteration count
+     * \param body Called once per range
+     * \param minRange Smallest range worth a thread
+     *
+     * Rethrows the first exception thrown by a range.
+     */
+    void ParallelFor(size_t n, const RangeFunction& body, size_t minRange = 1);
+
+  private:
+    /**
+     * \brief Worker thread loop
+     * \param index Worker index (range index - 1)
+     */
+    void WorkerLoop(uint32_t index);
+
+    /**
+     * \brief Run one range, capturing exceptions
+     * \param range Range index
+     */
+    void RunRange(uint32_t range);
+
+    std::vector<std::thread> m_threads;  ///< Pool threads
+    std::mutex m_mutex;                  ///< Guards the job fields below
+    std::condition_variable m_start;     ///< Signals a new job (or stop)
+    std::condition_variable m_done;      ///< Signals the last range finished
+    const RangeFunction* m_body;         ///< Current loop body
+    size_t m_n;                          ///< Current iteration count
+    uint32_t m_ranges;                   ///< Ranges of the current job
+    uint32_t m_pending;                  ///< Pool ranges not finished
+    uint64_t m_generation;               ///< Job counter (wakes workers once per job)
+    bool m_stop;                         ///< Shutdown request
+    std::exception_ptr m_error;          ///< First exception of the job
+};
+
+} // namespace ns3
+
+#endif /* NR_WORKER_POOL_H */
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Beam Cache Benchmark
+ *
+ * Replays the beam updates IdealBeamformingHelper performs (every pair,
+ * every update period) for one gNB and a population of UEs moving in
+ * straight lines, and compares
+ * - exact:  direct-path beams computed on every update
+ * - cached: NrBeamCache at each angle step of the sweep
+ * for every antenna array pair and UE speed. For the cached runs it
+ * reports the beam cost per update, the hit rate and the fidelity loss:
+ * the array gain towards the true direction that a reused beam gives up
+ * against the exact beam (gNB + UE side, dB).
+ *
+ * Only the beamforming vectors are measured; the channel-matrix work an
+ * unchanged beam also saves in the 3GPP spectrum model is not included.
+ * Results are written as JSON.
+ *
+ * Run with:
+ *   ./ns3 run "nr-beam-cache-benchmark"
+ *   ./ns3 run "nr-beam-cache-benchmark --arrays=4x8/2x4,8x8/2x4 --speeds=3 --angleSteps=1,2"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/isotropic-antenna-model.h"
+#include "ns3/mobility-module.h"
+#include "ns3/uniform-planar-array.h"
+
+// NR Modular
+#include "ns3/nr-modular-module.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("NrBeamCacheBenchmark");
+
+namespace
+{
+
+std::vector<std::string>
+SplitList(const std::string& csv)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(csv);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * \brief gNB and UE array sizes, parsed from "RxC/RxC"
+ */
+struct ArrayPair
+{
+    std::string name;
+    uint32_t gnbRows;
+    uint32_t gnbColumns;
+    uint32_t ueRows;
+    uint32_t ueColumns;
+};
+
+ArrayPair
+ParseArrayPair(const std::string& text)
+{
+    ArrayPair a;
+    a.name = text;
+    char x1;
+    char slash;
+    char x2;
+    std::istringstream is(text);
+    is >> a.gnbRows >> x1 >> a.gnbColumns >> slash >> a.ueRows >> x2 >> a.ueColumns;
+    NS_ABORT_MSG_IF(is.fail() || x1 != 'x' || slash != '/' || x2 != 'x',
+                    "Array pair '" << text << "' must look like 4x8/2x4");
+    return a;
+}
+
+Ptr<UniformPlanarArray>
+CreateArray(uint32_t rows, uint32_t columns)
+{
+    Ptr<UniformPlanarArray> array = CreateObject<UniformPlanarArray>();
+    array->SetAttribute("NumRows", UintegerValue(rows));
+    array->SetAttribute("NumColumns", UintegerValue(columns));
+    array->SetAttribute("AntennaElement", PointerValue(CreateObject<IsotropicAntennaModel>()));
+    return array;
+}
+
+/**
+ * \brief Power gain of a beam towards a direction (ns-3 convention: the
+ *        beam is applied to the steering vector without conjugation)
+ */
+double
+ArrayGain(const PhasedArrayModel::ComplexVector& beam,
+          const PhasedArrayModel::ComplexVector& steering)
+{
+    std::complex<double> sum = 0.0;
+    for (size_t i = 0; i < beam.GetSize(); ++i)
+    {
+        sum += beam[i] * steering[i];
+    }
+    return std::norm(sum);
+}
+
+/**
+ * \brief One gNB and its UEs moving at constant velocity
+ */
+struct Deployment
+{
+    Ptr<MobilityModel> gnb;
+    std::vector<Ptr<MobilityModel>> ues;
+    std::vector<Vector> start;
+    std::vector<Vector> velocity;
+
+    void MoveTo(double t)
+    {
+        for (size_t i = 0; i < ues.size(); ++i)
+        {
+            ues[i]->SetPosition(Vector(start[i].x + velocity[i].x * t,
+                                       start[i].y + velocity[i].y * t,
+                                       start[i].z));
+        }
+    }
+};
+
+Deployment
+Deploy(uint32_t numUes, double speed, double radius)
+{
+    Deployment d;
+    d.gnb = CreateObject<ConstantPositionMobilityModel>();
+    d.gnb->SetPosition(Vector(0.0, 0.0, 25.0));
+
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    for (uint32_t i = 0; i < numUes; ++i)
+    {
+        double r = uniform->GetValue(20.0, radius);
+        double phi = uniform->GetValue(0.0, 2 * M_PI);
+        double heading = uniform->GetValue(0.0, 2 * M_PI);
+        Ptr<MobilityModel> ue = CreateObject<ConstantPositionMobilityModel>();
+        d.ues.push_back(ue);
+        d.start.emplace_back(r * std::cos(phi), r * std::sin(phi), 1.5);
+        d.velocity.emplace_back(speed * std::cos(heading), speed * std::sin(heading), 0.0);
+    }
+    d.MoveTo(0.0);
+    return d;
+}
+
+double
+Percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    size_t k = static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+} // namespace
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int
+main(int argc, char* argv[])
+{
+    std::string arraysArg = "2x4/1x2,4x8/2x4,8x8/2x4";
+    std::string speedsArg = "0,3,30";
+    std::string angleStepsArg = "1,2,5";
+    uint32_t numUes = 200;
+    double radius = 300.0;
+    double duration = 10.0;
+    double period = 0.1;
+    double distanceStep = 0.25;
+    double moveThreshold = 1.0;
+    std::string outputPath = "nr-beam-cache-benchmark.json";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("arrays", "Comma-separated gNB/UE array pairs (e.g. 4x8/2x4)", arraysArg);
+    cmd.AddValue("speeds", "Comma-separated UE speeds (m/s)", speedsArg);
+    cmd.AddValue("angleSteps", "Comma-separated cache angle steps (degrees)", angleStepsArg);
+    cmd.AddValue("ues", "UEs around the gNB", numUes);
+    cmd.AddValue("radius", "Deployment radius (m)", radius);
+    cmd.AddValue("duration", "Replayed time (s)", duration);
+    cmd.AddValue("period", "Beam update period (s)", period);
+    cmd.AddValue("distanceStep", "Relative width of a distance bucket", distanceStep);
+    cmd.AddValue("moveThreshold", "Movement before the geometry is re-checked (m)",
+                 moveThreshold);
+    cmd.AddValue("output", "JSON results file", outputPath);
+    cmd.Parse(argc, argv);
+
+    uint32_t updates = static_cast<uint32_t>(std::round(duration / period));
+
+    std::cout << "\n╔═══════════════════════════════════════════════════╗\n";
+    std::cout << "║       NR BEAM CACHE BENCHMARK                     ║\n";
+    std::cout << "╚═══════════════════════════════════════════════════╝\n";
+    std::cout << numUes << " UEs, " << updates << " updates every " << period * 1e3 << " ms\n";
+
+    json results = json::array();
+    for (const auto& arrayArg : SplitList(arraysArg))
+    {
+        ArrayPair arrays = ParseArrayPair(arrayArg);
+        Ptr<UniformPlanarArray> gnbAntenna = CreateArray(arrays.gnbRows, arrays.gnbColumns);
+        Ptr<UniformPlanarArray> ueAntenna = CreateArray(arrays.ueRows, arrays.ueColumns);
+
+        std::cout << "\ngNB " << arrays.gnbRows << "x" << arrays.gnbColumns << ", UE "
+                  << arrays.ueRows << "x" << arrays.ueColumns << "\n";
+        std::cout << "  " << std::left << std::setw(8) << "speed" << std::setw(10) << "mode"
+                  << std::right << std::setw(14) << "us/update" << std::setw(10) << "speedup"
+                  << std::setw(10) << "hits %" << std::setw(12) << "loss dB"
+                  << std::setw(10) << "p95 dB" << std::setw(10) << "max dB" << "\n";
+
+        for (const auto& speedArg : SplitList(speedsArg))
+        {
+            double speed = std::stod(speedArg);
+            Deployment d = Deploy(numUes, speed, radius);
+
+            // ----- Exact: every pair recomputed on every update -----
+            double exactSeconds = 0.0;
+            for (uint32_t u = 0; u < updates; ++u)
+            {
+                d.MoveTo(u * period);
+                auto start = std::chrono::steady_clock::now();
+                for (const auto& ue : d.ues)
+                {
+                    BeamformingVectorPair beams =
+                        NrBeamCache::ComputeBeams(d.gnb, ue, gnbAntenna, ueAntenna);
+                    (void)beams;
+                }
+                exactSeconds +=
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                        .count();
+            }
+            double exactUs = exactSeconds * 1e6 / updates;
+
+            std::cout << "  " << std::left << std::setw(8) << speed << std::setw(10) << "exact"
+                      << std::right << std::fixed << std::setprecision(1) << std::setw(14)
+                      << exactUs << std::setw(10) << "1.00" << std::setw(10) << "-"
+                      << std::setw(12) << "0.000" << std::setw(10) << "0.000" << std::setw(10)
+                      << "0.000" << "\n";
+            std::cout.unsetf(std::ios::floatfield);
+
+            // ----- Cached, one run per angle step -----
+            for (const auto& stepArg : SplitList(angleStepsArg))
+            {
+                double angleStep = std::stod(stepArg);
+                Ptr<NrBeamCache> cache = CreateObject<NrBeamCache>();
+                cache->SetQuantization(angleStep, distanceStep, moveThreshold);
+
+                double cachedSeconds = 0.0;
+                std::vector<double> lossDb;
+                lossDb.reserve(static_cast<size_t>(updates) * numUes);
+                for (uint32_t u = 0; u < updates; ++u)
+                {
+                    d.MoveTo(u * period);
+                    std::vector<BeamformingVectorPair> served;
+                    served.reserve(d.ues.size());
+                    auto start = std::chrono::steady_clock::now();
+                    for (const auto& ue : d.ues)
+                    {
+                        served.push_back(cache->GetBeams(d.gnb, ue, gnbAntenna, ueAntenna));
+                    }
+                    cachedSeconds +=
+                        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                            .count();
+
+                    // Fidelity (untimed): gain towards the true directions
+                    Vector gnbPos = d.gnb->GetPosition();
+                    for (size_t i = 0; i < d.ues.size(); ++i)
+                    {
+                        Vector uePos = d.ues[i]->GetPosition();
+                        BeamformingVectorPair exact =
+                            NrBeamCache::ComputeBeams(d.gnb, d.ues[i], gnbAntenna, ueAntenna);
+                        auto gnbSteering = gnbAntenna->GetSteeringVector(Angles(uePos, gnbPos));
+                        auto ueSteering = ueAntenna->GetSteeringVector(Angles(gnbPos, uePos));
+                        double exactGain = ArrayGain(exact.first.first, gnbSteering) *
+                                           ArrayGain(exact.second.first, ueSteering);
+                        double servedGain = ArrayGain(served[i].first.first, gnbSteering) *
+                                            ArrayGain(served[i].second.first, ueSteering);
+                        lossDb.push_back(
+                            10.0 * std::log10(exactGain / std::max(servedGain, 1e-12)));
+                    }
+                }
+
+                double cachedUs = cachedSeconds * 1e6 / updates;
+                double meanLoss = 0.0;
+                for (double l : lossDb)
+                {
+                    meanLoss += l;
+                }
+                meanLoss /= std::max<size_t>(1, lossDb.size());
+                double p95Loss = Percentile(lossDb, 0.95);
+                double maxLoss = lossDb.empty() ? 0.0
+                                                : *std::max_element(lossDb.begin(), lossDb.end());
+                NrBeamCache::Statistics stats = cache->GetStatistics();
+                double speedup = cachedUs > 0 ? exactUs / cachedUs : 0.0;
+
+                std::ostringstream mode;
+                mode << "cache " << angleStep;
+                std::cout << "  " << std::left << std::setw(8) << speed << std::setw(10)
+                          << mode.str() << std::right << std::fixed << std::setprecision(1)
+                          << std::setw(14) << cachedUs << std::setprecision(2) << std::setw(10)
+                          << speedup << std::setprecision(1) << std::setw(10)
+                          << stats.GetHitRate() * 100.0 << std::setprecision(3)
+                          << std::setw(12) << meanLoss << std::setw(10) << p95Loss
+                          << std::setw(10) << maxLoss << "\n";
+                std::cout.unsetf(std::ios::floatfield);
+
+                json r;
+                r["arrays"] = arrays.name;
+                r["gnb_elements"] = arrays.gnbRows * arrays.gnbColumns;
+                r["ue_elements"] = arrays.ueRows * arrays.ueColumns;
+                r["speed_mps"] = speed;
+                r["angle_step_deg"] = angleStep;
+                r["distance_step"] = distanceStep;
+                r["move_threshold_m"] = moveThreshold;
+                r["exact_us_per_update"] = exactUs;
+                r["cached_us_per_update"] = cachedUs;
+                r["speedup"] = speedup;
+                r["hit_rate"] = stats.GetHitRate();
+                r["still_hits"] = stats.stillHits;
+                r["geometry_hits"] = stats.geometryHits;
+                r["recomputes"] = stats.recomputes;
+                r["loss_db_mean"] = meanLoss;
+                r["loss_db_p95"] = p95Loss;
+                r["loss_db_max"] = maxLoss;
+                results.push_back(r);
+            }
+        }
+    }
+
+    json out;
+    out["benchmark"] = "nr-beam-cache";
+    out["schema_version"] = 1;
+    out["ues"] = numUes;
+    out["updates"] = updates;
+    out["period_s"] = period;
+    out["results"] = results;
+
+    std::ofstream file(outputPath);
+    if (!file.is_open())
+    {
+        std::cerr << "✗ Failed to open " << outputPath << std::endl;
+        return 1;
+    }
+    file << out.dump(2) << std::endl;
+    std::cout << "\n✓ Results written to " << outputPath << std::endl;
+    return 0;
+}
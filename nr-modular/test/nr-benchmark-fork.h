@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Benchmark Process Isolation
+ *
+ * Shared by the benchmarks that run each scenario in its own process
+ * (nr-scaling-benchmark, nr-scheduler-benchmark): the ns-3 simulator and
+ * its singletons are process-wide, so a fresh process gives every run a
+ * clean Simulator, clean RNG streams and an independent peak RSS. The
+ * child serializes its result as JSON over a pipe.
+ */
+
+#ifndef NR_BENCHMARK_FORK_H
+#define NR_BENCHMARK_FORK_H
+
+#include "ns3/abort.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3
+{
+namespace NrBenchmark
+{
+
+/**
+ * \brief Run a benchmark case in a forked child and read back its JSON
+ * \param run Case to run in the child; its result is sent to the parent
+ * \param verbose Keep the child's stdout (otherwise sent to /dev/null)
+ * \return The child's result, or {"ok": false, "exit_status": status}
+ *         if it crashed, exited non-zero or sent nothing
+ */
+inline nlohmann::json
+RunForked(const std::function<nlohmann::json()>& run, bool verbose)
+{
+    int fds[2];
+    NS_ABORT_MSG_IF(pipe(fds) != 0, "pipe() failed");
+
+    pid_t pid = fork();
+    NS_ABORT_MSG_IF(pid < 0, "fork() failed");
+
+    if (pid == 0)
+    {
+        close(fds[0]);
+        if (!verbose)
+        {
+            int devNull = open("/dev/null", O_WRONLY);
+            dup2(devNull, STDOUT_FILENO);
+            close(devNull);
+        }
+
+        std::string payload = run().dump();
+        size_t written = 0;
+        while (written < payload.size())
+        {
+            ssize_t n = write(fds[1], payload.data() + written, payload.size() - written);
+            if (n <= 0)
+            {
+                break;
+            }
+            written += static_cast<size_t>(n);
+        }
+        close(fds[1]);
+        std::fflush(nullptr);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    std::string payload;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+    {
+        payload.append(buf, n);
+    }
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || payload.empty())
+    {
+        nlohmann::json r;
+        r["ok"] = false;
+        r["exit_status"] = status;
+        return r;
+    }
+    return nlohmann::json::parse(payload);
+}
+
+} // namespace NrBenchmark
+} // namespace ns3
+
+#endif /* NR_BENCHMARK_FORK_H */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Columnar Writer Test
+ *
+ * Round trips of the binary results formats through their readers:
+ * - .nrcol, plain and compressed: integers and exact floats come back
+ *   bit-identical, quantized floats within half a quantum
+ * - compressed logs (.telemetry.nrz): records come back byte for byte
+ */
+
+#include "ns3/nr-block-codec.h"
+#include "ns3/nr-columnar-writer.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace ns3;
+
+namespace
+{
+
+constexpr uint32_t kEntities = 3;  ///< Rows per sample (delta stride)
+constexpr uint32_t kSamples = 400;
+
+/**
+ * \brief Value of a column in row r (counters, a position, a noisy SINR)
+ */
+double
+RowValue(size_t column, uint32_t r)
+{
+    uint32_t entity = r % kEntities;
+    uint32_t sample = r / kEntities;
+    switch (column)
+    {
+    case 0:
+        return entity;
+    case 1:
+        return 1500.0 * sample * (entity + 1);
+    case 2:
+        return 10.0 * entity + 0.37 * sample;
+    default:
+        return std::sin(0.1 * r) * 20.0;
+    }
+}
+
+template <typename T>
+T
+Load(const std::vector<uint8_t>& column, uint32_t r)
+{
+    T value;
+    std::memcpy(&value, column.data() + sizeof(T) * r, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+/**
+ * \brief Write a table, read it back with NrColumnarReader
+ */
+class NrColumnarRoundTripTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param compress Write format version 2
+     */
+    NrColumnarRoundTripTestCase(bool compress)
+        : TestCase(compress ? "Compressed .nrcol round trip" : "Plain .nrcol round trip"),
+          m_compress(compress)
+    {
+    }
+
+    void DoRun() override
+    {
+        const double quantum = 0.01;
+        std::vector<NrColumnarWriter::Column> schema = {
+            {"ue", NrColumnarWriter::UINT32},
+            {"bytes", NrColumnarWriter::UINT64},
+            {"x", NrColumnarWriter::FLOAT64, quantum},
+            {"sinr", NrColumnarWriter::FLOAT64},
+        };
+        std::string path = CreateTempDirFilename("round-trip.nrcol");
+
+        NrColumnarWriter writer;
+        writer.SetCompression(m_compress, kEntities);
+        NS_TEST_ASSERT_MSG_EQ(writer.Open(path, "ue", schema, "", 256), true, "Open failed");
+        for (uint32_t r = 0; r < kEntities * kSamples; ++r)
+        {
+            for (size_t c = 0; c < schema.size(); ++c)
+            {
+                writer.Put(RowValue(c, r));
+            }
+            writer.EndRow();
+        }
+        NS_TEST_ASSERT_MSG_EQ(writer.Close(), true, "Close failed");
+
+        NrColumnarReader reader;
+        NS_TEST_ASSERT_MSG_EQ(reader.Open(path), true, reader.GetError());
+        NS_TEST_ASSERT_MSG_EQ(reader.GetVersion(), m_compress ? 2 : 1, "Wrong format version");
+        NS_TEST_ASSERT_MSG_EQ(reader.GetTable(), "ue", "Wrong table name");
+        NS_TEST_ASSERT_MSG_EQ(reader.GetSchema().size(), schema.size(), "Wrong column count");
+        NS_TEST_ASSERT_MSG_EQ(reader.GetSchema()[2].quantum,
+                              m_compress ? quantum : 0.0,
+                              "Quantum not stored");
+
+        uint32_t total = 0;
+        uint32_t rows = 0;
+        std::vector<std::vector<uint8_t>> columns;
+        while (reader.ReadRowGroup(rows, columns))
+        {
+            for (uint32_t r = 0; r < rows; ++r, ++total)
+            {
+                NS_TEST_ASSERT_MSG_EQ(Load<uint32_t>(columns[0], r),
+                                      static_cast<uint32_t>(RowValue(0, total)),
+                                      "u32 column changed at row " << total);
+                NS_TEST_ASSERT_MSG_EQ(Load<uint64_t>(columns[1], r),
+                                      static_cast<uint64_t>(RowValue(1, total)),
+                                      "u64 column changed at row " << total);
+                NS_TEST_ASSERT_MSG_EQ_TOL(Load<double>(columns[2], r),
+                                          RowValue(2, total),
+                                          quantum / 2 + 1e-9,
+                                          "Quantized column off at row " << total);
+                double sinr = RowValue(3, total);
+                NS_TEST_ASSERT_MSG_EQ(std::memcmp(columns[3].data() + 8 * r, &sinr, 8),
+                                      0,
+                                      "Exact float changed at row " << total);
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(reader.GetError(), "", "Read failed");
+        NS_TEST_ASSERT_MSG_EQ(reader.IsComplete(), true, "Footer not reached");
+        NS_TEST_ASSERT_MSG_EQ(total, kEntities * kSamples, "Rows lost");
+    }
+
+  private:
+    bool m_compress;  ///< Format version 2
+};
+
+/**
+ * \brief Append records to a compressed log, read them back
+ */
+class NrCompressedLogRoundTripTestCase : public TestCase
+{
+  public:
+    NrCompressedLogRoundTripTestCase()
+        : TestCase("Compressed log round trip")
+    {
+    }
+
+    void DoRun() override
+    {
+        std::string path = CreateTempDirFilename("round-trip.telemetry.nrz");
+        std::string expected;
+
+        NrCompressedLog log;
+        NS_TEST_ASSERT_MSG_EQ(log.Open(path, 4096), true, "Open failed");
+        for (uint32_t tick = 0; tick < 2000; ++tick)
+        {
+            std::string record = "{\"tick\":" + std::to_string(tick) + ",\"ues\":[" +
+                                 std::to_string(tick * 7 % 13) + "]}\n";
+            log.Append(record.data(), record.size());
+            expected += record;
+        }
+        NS_TEST_ASSERT_MSG_EQ(log.Close(), true, "Close failed");
+        NS_TEST_ASSERT_MSG_LT(log.GetStoredBytes(), expected.size(), "Nothing compressed");
+
+        std::string records;
+        NS_TEST_ASSERT_MSG_EQ(NrCompressedLog::ReadAll(path, records), true, "Read failed");
+        NS_TEST_ASSERT_MSG_EQ((records == expected), true, "Records changed");
+    }
+};
+
+/**
+ * \brief Columnar writer test suite
+ */
+class NrColumnarWriterTestSuite : public TestSuite
+{
+  public:
+    NrColumnarWriterTestSuite()
+        : TestSuite("nr-columnar-writer", Type::UNIT)
+    {
+        AddTestCase(new NrColumnarRoundTripTestCase(false), TestCase::Duration::QUICK);
+        AddTestCase(new NrColumnarRoundTripTestCase(true), TestCase::Duration::QUICK);
+        AddTestCase(new NrCompressedLogRoundTripTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static NrColumnarWriterTestSuite g_nrColumnarWriterTestSuite;
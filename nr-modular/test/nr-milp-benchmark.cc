@@ -0,0 +1,678 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * MILP Data-Path Microbenchmark
+ *
+ * Measures the hot paths between the MILP solver and the MAC scheduler:
+ * - NrBwpManager::LoadMilpSolution       (index + validate + statistics)
+ * - NrBwpManager::GetAllocationForSlot    (per-slot plan lookup)
+ * - NrBwpManager::GetUeAllocationForSlot  (per-UE plan lookup)
+ * - NrMilpExecutorScheduler::ConvertPrbToRbgBitmask
+ * - NrMilpInterface::SerializeProblem / DeserializeSolution
+ * - NrSliceManager::ApplySlotQuotas       (per-slot slice enforcement)
+ * - AggregateSlaClasses / ExpandClassSolution (SLA-class planning)
+ * - Coarse plans: per-slot lookups expanded from 8-slot block budgets
+ *
+ * Every case is run over a parameter grid (UEs x slots x allocations/slot)
+ * and reports ns/op, heap allocations/op, bytes/op and peak heap usage.
+ * Results are written as JSON so runs can be diffed against each other.
+ *
+ * Build ns-3 in optimized mode before benchmarking; NS_LOG calls are
+ * compiled in for debug builds and dominate the timings.
+ *
+ * Run with:
+ *   ./ns3 run "nr-milp-benchmark --ues=10,100 --slots=2000,20000 --allocsPerSlot=1,10"
+ *   ./ns3 run "nr-milp-benchmark --full --output=bench.json"
+ */
+
+#include "ns3/core-module.h"
+
+// NR Modular
+#include "ns3/nr-modular-module.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <malloc.h>
+#include <sys/resource.h>
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("NrMilpBenchmark");
+
+// ============================================================================
+// HEAP ACCOUNTING
+// ============================================================================
+//
+// Global operator new/delete are replaced so every case can report how many
+// heap allocations it performs and how much live heap it peaks at.
+// malloc_usable_size() keeps the bookkeeping header-free.
+
+namespace
+{
+
+std::atomic<uint64_t> g_allocCount{0};
+std::atomic<uint64_t> g_allocBytes{0};
+std::atomic<int64_t> g_liveBytes{0};
+std::atomic<int64_t> g_peakLiveBytes{0};
+
+void*
+CountedAlloc(std::size_t size)
+{
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    int64_t usable = static_cast<int64_t>(malloc_usable_size(p));
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(usable, std::memory_order_relaxed);
+
+    int64_t live = g_liveBytes.fetch_add(usable, std::memory_order_relaxed) + usable;
+    int64_t peak = g_peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !g_peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+    return p;
+}
+
+void
+CountedFree(void* p)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    g_liveBytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(p)),
+                          std::memory_order_relaxed);
+    std::free(p);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { CountedFree(p); }
+void operator delete[](void* p) noexcept { CountedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { CountedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { CountedFree(p); }
+
+namespace
+{
+
+// ============================================================================
+// BENCHMARK RESULT
+// ============================================================================
+
+/**
+ * \brief One row of benchmark output (one case at one grid point)
+ */
+struct BenchResult
+{
+    std::string name;           ///< Case name, e.g. "bwp.get_allocation_for_slot"
+    uint32_t numUes;            ///< Grid: number of UEs
+    uint32_t numSlots;          ///< Grid: number of slots in the plan
+    uint32_t allocsPerSlot;     ///< Grid: allocations per slot
+    uint64_t planAllocations;   ///< Total allocations in the plan
+    uint64_t iterations;        ///< Operations measured
+    double nsPerOp;             ///< Wall time per operation (ns)
+    double allocsPerOp;         ///< Heap allocations per operation
+    double bytesPerOp;          ///< Heap bytes requested per operation
+    int64_t peakHeapBytes;      ///< Peak live heap during the case (above baseline)
+    long peakRssKb;             ///< Process peak RSS after the case (KiB)
+
+    json ToJson() const
+    {
+        json j;
+        j["name"] = name;
+        j["params"]["ues"] = numUes;
+        j["params"]["slots"] = numSlots;
+        j["params"]["allocs_per_slot"] = allocsPerSlot;
+        j["params"]["plan_allocations"] = planAllocations;
+        j["iterations"] = iterations;
+        j["ns_per_op"] = nsPerOp;
+        j["allocs_per_op"] = allocsPerOp;
+        j["bytes_per_op"] = bytesPerOp;
+        j["peak_heap_bytes"] = peakHeapBytes;
+        j["peak_rss_kb"] = peakRssKb;
+        return j;
+    }
+};
+
+/**
+ * \brief Scoped measurement window around a benchmark body
+ */
+class Measurement
+{
+  public:
+    Measurement()
+        : m_allocs(g_allocCount.load()),
+          m_bytes(g_allocBytes.load()),
+          m_baseLive(g_liveBytes.load())
+    {
+        g_peakLiveBytes.store(m_baseLive);
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    void Finish(BenchResult& r, uint64_t iterations)
+    {
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - m_start).count();
+        double ops = static_cast<double>(std::max<uint64_t>(iterations, 1));
+
+        r.iterations = iterations;
+        r.nsPerOp = ns / ops;
+        r.allocsPerOp = static_cast<double>(g_allocCount.load() - m_allocs) / ops;
+        r.bytesPerOp = static_cast<double>(g_allocBytes.load() - m_bytes) / ops;
+        r.peakHeapBytes = g_peakLiveBytes.load() - m_baseLive;
+
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        r.peakRssKb = usage.ru_maxrss;
+    }
+
+  private:
+    uint64_t m_allocs;
+    uint64_t m_bytes;
+    int64_t m_baseLive;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+const uint32_t kTotalPrbs = 273;    ///< 100 MHz @ 30 kHz SCS
+const uint32_t kRbgSize = 16;       ///< Matches 273 PRB / 18 RBG configuration
+
+/**
+ * \brief Parse "10,100,1000" into a vector of integers
+ */
+std::vector<uint32_t>
+ParseList(const std::string& csv)
+{
+    std::vector<uint32_t> values;
+    std::stringstream ss(csv);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            values.push_back(static_cast<uint32_t>(std::stoul(item)));
+        }
+    }
+    return values;
+}
+
+/**
+ * \brief Deterministic xorshift generator so every run probes the same slots
+ */
+struct XorShift
+{
+    uint64_t state;
+
+    explicit XorShift(uint64_t seed)
+        : state(seed ? seed : 0x9E3779B97F4A7C15ULL)
+    {
+    }
+
+    uint32_t Next(uint32_t bound)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<uint32_t>(state % bound);
+    }
+};
+
+/**
+ * \brief Build a non-overlapping plan: k UEs per slot, equal PRB shares,
+ *        UEs rotated round-robin across slots
+ */
+MilpSolution
+BuildPlan(uint32_t numUes, uint32_t numSlots, uint32_t allocsPerSlot)
+{
+    MilpSolution solution;
+    solution.status = "optimal";
+    solution.objectiveValue = 0.0;
+    solution.solveTimeSeconds = 0.0;
+    solution.allocations.reserve(static_cast<size_t>(numSlots) * allocsPerSlot);
+
+    uint32_t prbsPerAlloc = kTotalPrbs / allocsPerSlot;
+    uint32_t nextUe = 0;
+
+    for (uint32_t slot = 0; slot < numSlots; ++slot)
+    {
+        for (uint32_t k = 0; k < allocsPerSlot; ++k)
+        {
+            solution.allocations.emplace_back(nextUe, slot, k * prbsPerAlloc, prbsPerAlloc);
+            nextUe = (nextUe + 1) % numUes;
+        }
+    }
+    return solution;
+}
+
+MilpProblem
+BuildProblem(uint32_t numUes, uint32_t numSlots)
+{
+    MilpProblem problem;
+    problem.numUEs = numUes;
+    problem.bandwidth = 100e6;
+    problem.totalBandwidthPrbs = kTotalPrbs;
+    problem.numerology = 1;
+    problem.slotDuration = 0.0005;
+    problem.totalSlots = numSlots;
+    problem.timeWindow = numSlots * problem.slotDuration;
+
+    problem.ues.reserve(numUes);
+    for (uint32_t i = 0; i < numUes; ++i)
+    {
+        SliceType slice = static_cast<SliceType>(i % 3);
+        problem.ues.emplace_back(i, slice, 10.0, 10.0, 20, 500);
+    }
+    return problem;
+}
+
+/**
+ * \brief Solution JSON in the wire format DeserializeSolution() expects
+ */
+std::string
+SolutionToJson(const MilpSolution& solution)
+{
+    json j;
+    j["status"] = solution.status;
+    j["objectiveValue"] = solution.objectiveValue;
+    j["solveTimeSeconds"] = solution.solveTimeSeconds;
+    j["allocations"] = json::array();
+    for (const auto& a : solution.allocations)
+    {
+        j["allocations"].push_back(
+            {{"ueId", a.ueId}, {"slotId", a.slotId}, {"startPrb", a.startPrb}, {"numPrbs", a.numPrbs}});
+    }
+    return j.dump();
+}
+
+void
+PrintRow(const BenchResult& r)
+{
+    std::cout << "  " << std::left << std::setw(34) << r.name << std::right
+              << " ues=" << std::setw(6) << r.numUes
+              << " slots=" << std::setw(8) << r.numSlots
+              << " k=" << std::setw(4) << r.allocsPerSlot
+              << std::fixed << std::setprecision(1)
+              << std::setw(14) << r.nsPerOp << " ns/op"
+              << std::setprecision(2)
+              << std::setw(10) << r.allocsPerOp << " allocs/op"
+              << std::setw(12) << (r.peakHeapBytes / 1024) << " KiB peak"
+              << std::endl;
+}
+
+} // namespace
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int
+main(int argc, char* argv[])
+{
+    std::string uesArg = "10,100,1000";
+    std::string slotsArg = "2000,20000";
+    std::string allocsArg = "1,10,50";
+    uint64_t lookups = 1000000;
+    uint64_t maxPlanAllocations = 20000000;
+    uint64_t maxSerializedAllocations = 2000000;
+    uint32_t loadRepeats = 3;
+    bool full = false;
+    std::string outputPath = "nr-milp-benchmark.json";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("ues", "Comma-separated UE counts", uesArg);
+    cmd.AddValue("slots", "Comma-separated plan lengths (slots)", slotsArg);
+    cmd.AddValue("allocsPerSlot", "Comma-separated allocations per slot", allocsArg);
+    cmd.AddValue("lookups", "Lookups per query benchmark", lookups);
+    cmd.AddValue("loadRepeats", "LoadMilpSolution repetitions per grid point", loadRepeats);
+    cmd.AddValue("maxPlanAllocations", "Skip grid points with larger plans", maxPlanAllocations);
+    cmd.AddValue("maxSerializedAllocations",
+                 "Skip JSON round-trips for larger plans",
+                 maxSerializedAllocations);
+    cmd.AddValue("full", "Use the full grid (UEs 10-10k, slots 2k-2M, k 1-200)", full);
+    cmd.AddValue("output", "JSON results file", outputPath);
+    cmd.Parse(argc, argv);
+
+    if (full)
+    {
+        uesArg = "10,100,1000,10000";
+        slotsArg = "2000,20000,200000,2000000";
+        allocsArg = "1,10,50,200";
+    }
+
+    std::vector<uint32_t> ueGrid = ParseList(uesArg);
+    std::vector<uint32_t> slotGrid = ParseList(slotsArg);
+    std::vector<uint32_t> allocGrid = ParseList(allocsArg);
+
+    std::cout << "\n╔═══════════════════════════════════════════════════╗\n";
+    std::cout << "║       NR MILP DATA-PATH BENCHMARK                 ║\n";
+    std::cout << "╚═══════════════════════════════════════════════════╝\n\n";
+
+    std::vector<BenchResult> results;
+    json skipped = json::array();  // Requested grid points that were not run
+    Ptr<NrMilpInterface> milpInterface = CreateObject<NrMilpInterface>();
+
+    // ================================================================
+    // 1. PRB → RBG conversion (independent of plan size)
+    // ================================================================
+    std::cout << "PRB → RBG conversion:\n";
+    uint32_t totalRbgs = (kTotalPrbs + kRbgSize - 1) / kRbgSize;
+    for (uint32_t k : allocGrid)
+    {
+        k = std::min(k, kTotalPrbs);
+        uint32_t prbsPerAlloc = kTotalPrbs / k;
+
+        BenchResult r{"scheduler.convert_prb_to_rbg", 0, 0, k, 0};
+        uint64_t sink = 0;
+        Measurement m;
+        for (uint64_t i = 0; i < lookups; ++i)
+        {
+            uint32_t startPrb = static_cast<uint32_t>(i % k) * prbsPerAlloc;
+            std::vector<bool> mask = NrMilpExecutorScheduler::ConvertPrbToRbgBitmask(
+                startPrb, prbsPerAlloc, kRbgSize, totalRbgs);
+            sink += mask[startPrb / kRbgSize];
+        }
+        m.Finish(r, lookups);
+        NS_LOG_DEBUG("sink=" << sink);
+        PrintRow(r);
+        results.push_back(r);
+    }
+
+    // ================================================================
+    // 2. Plan store and JSON round-trips across the grid
+    // ================================================================
+    for (uint32_t numUes : ueGrid)
+    {
+        for (uint32_t numSlots : slotGrid)
+        {
+            for (uint32_t allocsPerSlot : allocGrid)
+            {
+                // A UE appears at most once per slot and needs >= 1 PRB
+                uint32_t k = std::min({allocsPerSlot, numUes, kTotalPrbs});
+                uint64_t planSize = static_cast<uint64_t>(numSlots) * k;
+
+                std::string reason;
+                if (k != allocsPerSlot)
+                {
+                    // Capping would duplicate the k point of the grid
+                    reason = "allocsPerSlot > min(ues, totalPrbs)";
+                }
+                else if (planSize > maxPlanAllocations)
+                {
+                    reason = std::to_string(planSize) + " allocations > " +
+                             std::to_string(maxPlanAllocations);
+                }
+                if (!reason.empty())
+                {
+                    std::cout << "  (skipping ues=" << numUes << " slots=" << numSlots
+                              << " allocsPerSlot=" << allocsPerSlot << ": " << reason << ")\n";
+                    skipped.push_back({{"ues", numUes},
+                                       {"slots", numSlots},
+                                       {"allocs_per_slot", allocsPerSlot},
+                                       {"reason", reason}});
+                    continue;
+                }
+
+                std::cout << "\nGrid point: ues=" << numUes << " slots=" << numSlots
+                          << " allocsPerSlot=" << k << " (" << planSize << " allocations)\n";
+
+                MilpSolution plan = BuildPlan(numUes, numSlots, k);
+
+                // ----- LoadMilpSolution -----
+                {
+                    BenchResult r{"bwp.load_milp_solution", numUes, numSlots, k, planSize};
+                    Measurement m;
+                    for (uint32_t rep = 0; rep < loadRepeats; ++rep)
+                    {
+                        Ptr<NrBwpManager> bwp = CreateObject<NrBwpManager>();
+                        bool ok = bwp->LoadMilpSolution(plan);
+                        NS_ABORT_MSG_IF(!ok, "Benchmark plan failed to load");
+                        bwp->Dispose();
+                    }
+                    m.Finish(r, loadRepeats);
+                    PrintRow(r);
+                    results.push_back(r);
+                }
+
+                Ptr<NrBwpManager> bwp = CreateObject<NrBwpManager>();
+                bwp->LoadMilpSolution(plan);
+
+                // ----- GetAllocationForSlot -----
+                {
+                    BenchResult r{"bwp.get_allocation_for_slot", numUes, numSlots, k, planSize};
+                    XorShift rng(42);
+                    uint64_t sink = 0;
+                    Measurement m;
+                    for (uint64_t i = 0; i < lookups; ++i)
+                    {
+                        sink += bwp->GetAllocationForSlot(rng.Next(numSlots)).size();
+                    }
+                    m.Finish(r, lookups);
+                    NS_LOG_DEBUG("sink=" << sink);
+                    PrintRow(r);
+                    results.push_back(r);
+                }
+
+                // ----- GetUeAllocationForSlot -----
+                {
+                    BenchResult r{"bwp.get_ue_allocation_for_slot", numUes, numSlots, k, planSize};
+                    XorShift rng(7);
+                    uint64_t sink = 0;
+                    Measurement m;
+                    for (uint64_t i = 0; i < lookups; ++i)
+                    {
+                        auto alloc = bwp->GetUeAllocationForSlot(rng.Next(numSlots), rng.Next(numUes));
+                        sink += alloc.has_value() ? alloc->numPrbs : 0;
+                    }
+                    m.Finish(r, lookups);
+                    NS_LOG_DEBUG("sink=" << sink);
+                    PrintRow(r);
+                    results.push_back(r);
+                }
+
+                bwp->Dispose();
+
+                // ----- Coarse plan (8-slot budgets), slots walked in order -----
+                {
+                    const uint32_t blockSlots = 8;
+                    MilpProblem problem = BuildProblem(numUes, numSlots);
+                    problem.planningGranularitySlots = blockSlots;
+                    std::map<std::pair<uint32_t, uint32_t>, uint32_t> prbSlots;
+                    for (const auto& a : plan.allocations)
+                    {
+                        prbSlots[{a.slotId / blockSlots, a.ueId}] += a.numPrbs;
+                    }
+                    MilpSolution coarse;
+                    coarse.status = "optimal";
+                    coarse.granularitySlots = blockSlots;
+                    for (const auto& [key, budget] : prbSlots)
+                    {
+                        coarse.budgets.emplace_back(key.second, key.first, budget);
+                    }
+
+                    Ptr<NrBwpManager> coarseBwp = CreateObject<NrBwpManager>();
+                    coarseBwp->SetBlockPlanning(problem);
+                    bool ok = coarseBwp->LoadMilpSolution(coarse);
+                    NS_ABORT_MSG_IF(!ok, "Coarse benchmark plan failed to load");
+
+                    BenchResult r{"bwp.coarse_get_allocation_for_slot", numUes, numSlots, k,
+                                  coarse.budgets.size()};
+                    uint64_t sink = 0;
+                    Measurement m;
+                    for (uint64_t i = 0; i < lookups; ++i)
+                    {
+                        sink += coarseBwp->GetAllocationForSlot(i % numSlots).size();
+                    }
+                    m.Finish(r, lookups);
+                    NS_LOG_DEBUG("sink=" << sink);
+                    PrintRow(r);
+                    results.push_back(r);
+                    coarseBwp->Dispose();
+                }
+
+                // ----- ApplySlotQuotas (3 slices, UEs round-robin) -----
+                {
+                    Ptr<NrSliceManager> slices = CreateObject<NrSliceManager>();
+                    slices->SetSliceQuota(SliceType::eMBB, 0.5, 1.0);
+                    slices->SetSliceQuota(SliceType::uRLLC, 0.2, 0.3);
+                    slices->SetSliceQuota(SliceType::mMTC, 0.1, 0.2);
+                    for (uint32_t ueId = 0; ueId < numUes; ++ueId)
+                    {
+                        slices->SetUeSlice(ueId, static_cast<SliceType>(ueId % 3));
+                    }
+
+                    BenchResult r{"slice.apply_slot_quotas", numUes, numSlots, k, planSize};
+                    std::vector<PrbAllocation> scratch;
+                    scratch.reserve(2 * k);
+                    NrSliceManager::SlotResources slot;
+                    slot.usablePrbs.assign(kTotalPrbs, true);
+                    slot.demand.reserve(k);
+                    XorShift rng(11);
+                    uint64_t sink = 0;
+                    Measurement m;
+                    for (uint64_t i = 0; i < lookups; ++i)
+                    {
+                        auto first = plan.allocations.begin() + rng.Next(numSlots) * k;
+                        scratch.assign(first, first + k);
+                        // Buffers twice the plan: trimming and lending both run
+                        slot.demand.clear();
+                        for (const auto& alloc : scratch)
+                        {
+                            slot.demand.push_back({alloc.ueId, 2 * alloc.numPrbs});
+                        }
+                        slices->ApplySlotQuotas(scratch, slot, true);
+                        sink += scratch.size();
+                    }
+                    m.Finish(r, lookups);
+                    NS_LOG_DEBUG("sink=" << sink);
+                    PrintRow(r);
+                    results.push_back(r);
+                    slices->Dispose();
+                }
+
+                // ----- SerializeProblem -----
+                {
+                    MilpProblem problem = BuildProblem(numUes, numSlots);
+                    uint64_t reps = std::max<uint64_t>(1, 100000 / numUes);
+                    BenchResult r{"milp.serialize_problem", numUes, numSlots, k, planSize};
+                    size_t bytes = 0;
+                    Measurement m;
+                    for (uint64_t i = 0; i < reps; ++i)
+                    {
+                        bytes += milpInterface->SerializeProblem(problem).size();
+                    }
+                    m.Finish(r, reps);
+                    NS_LOG_DEBUG("bytes=" << bytes);
+                    PrintRow(r);
+                    results.push_back(r);
+                }
+
+                // ----- AggregateSlaClasses + SerializeProblem (class level) -----
+                MilpProblem classProblem;
+                {
+                    MilpProblem problem = BuildProblem(numUes, numSlots);
+                    uint64_t reps = std::max<uint64_t>(1, 100000 / numUes);
+                    BenchResult r{"milp.aggregate_serialize_problem", numUes, numSlots, k,
+                                  planSize};
+                    size_t bytes = 0;
+                    Measurement m;
+                    for (uint64_t i = 0; i < reps; ++i)
+                    {
+                        classProblem = AggregateSlaClasses(problem, 4);
+                        bytes += milpInterface->SerializeProblem(classProblem).size();
+                    }
+                    m.Finish(r, reps);
+                    NS_LOG_DEBUG("bytes=" << bytes);
+                    PrintRow(r);
+                    results.push_back(r);
+                }
+
+                // ----- ExpandClassSolution -----
+                if (planSize <= maxSerializedAllocations)
+                {
+                    uint32_t numClasses = classProblem.classes.size();
+                    MilpSolution classPlan =
+                        BuildPlan(numClasses, numSlots, std::min(k, numClasses));
+                    BenchResult r{"milp.expand_class_solution", numUes, numSlots, k, planSize};
+                    Measurement m;
+                    MilpSolution expanded = ExpandClassSolution(classProblem, classPlan);
+                    m.Finish(r, 1);
+                    NS_ABORT_MSG_IF(expanded.allocations.size() < classPlan.allocations.size(),
+                                    "Expansion lost allocations");
+                    PrintRow(r);
+                    results.push_back(r);
+                }
+
+                // ----- DeserializeSolution -----
+                if (planSize <= maxSerializedAllocations)
+                {
+                    std::string wire = SolutionToJson(plan);
+                    BenchResult r{"milp.deserialize_solution", numUes, numSlots, k, planSize};
+                    Measurement m;
+                    MilpSolution decoded = milpInterface->DeserializeSolution(wire);
+                    m.Finish(r, 1);
+                    NS_ABORT_MSG_IF(decoded.allocations.size() != planSize,
+                                    "Round-trip lost allocations");
+                    PrintRow(r);
+                    results.push_back(r);
+                }
+            }
+        }
+    }
+
+    // ================================================================
+    // 3. Machine-readable output
+    // ================================================================
+    json out;
+    out["benchmark"] = "nr-milp-data-path";
+    out["schema_version"] = 1;
+    out["config"]["total_prbs"] = kTotalPrbs;
+    out["config"]["rbg_size"] = kRbgSize;
+    out["config"]["lookups"] = lookups;
+    out["config"]["load_repeats"] = loadRepeats;
+    out["results"] = json::array();
+    for (const auto& r : results)
+    {
+        out["results"].push_back(r.ToJson());
+    }
+    out["skipped"] = skipped;
+
+    std::ofstream file(outputPath);
+    if (!file.is_open())
+    {
+        std::cerr << "✗ Failed to open " << outputPath << std::endl;
+        return 1;
+    }
+    file << out.dump(2) << std::endl;
+
+    std::cout << "\n✓ " << results.size() << " results written to " << outputPath << std::endl;
+
+    milpInterface->Dispose();
+    return 0;
+}
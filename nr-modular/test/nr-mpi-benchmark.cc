@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Independent-Shard (MPI) Scaling Benchmark
+ *
+ * Runs one scenario with partition.enabled: one spatial shard of sites +
+ * attached UEs per MPI rank. Each rank creates only its own shard's
+ * nodes. Shards are independent simulations on the default simulator
+ * (no cross-rank links, no lookahead, no handover or interference
+ * exchange between ranks); MPI only provides the rank and gathers the
+ * results.
+ * Rank 0 appends one JSON record per invocation (ranks, wall times,
+ * total events) to a JSON-lines file and reports speedup against the
+ * 1-rank record of the same scenario, so a rank sweep is just:
+ *
+ *   for k in 1 2 4 8; do
+ *     mpirun -np $k ./ns3 run "nr-mpi-benchmark --configFile=config/city.json"
+ *   done
+ *
+ * Requires ns-3 configured with --enable-mpi.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mpi-interface.h"
+
+// NR Modular
+#include "ns3/nr-modular-module.h"
+
+#include <mpi.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("NrMpiBenchmark");
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int
+main(int argc, char* argv[])
+{
+    MpiInterface::Enable(&argc, &argv);
+
+    std::string configFile = "config/test-waypoint-traffic-config.json";
+    double interferenceMarginDb = 0.0;
+    std::string outputPath = "nr-mpi-benchmark.jsonl";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("configFile", "Scenario JSON configuration", configFile);
+    cmd.AddValue("interferenceMarginDb",
+                 "Out-of-partition interference margin (overrides config if > 0)",
+                 interferenceMarginDb);
+    cmd.AddValue("output", "JSON-lines results file (appended by rank 0)", outputPath);
+    cmd.Parse(argc, argv);
+
+    uint32_t rank = MpiInterface::GetSystemId();
+    uint32_t numRanks = MpiInterface::GetSize();
+
+    // Per-rank chatter goes to a log; rank 0 prints the summary
+    std::string logPath = outputPath + ".rank" + std::to_string(rank) + ".log";
+    std::ofstream log(logPath);
+    std::streambuf* saved = std::cout.rdbuf();
+    std::cout.rdbuf(log.rdbuf());
+
+    Ptr<NrConfigManager> configManager = CreateObject<NrConfigManager>();
+    Ptr<NrSimConfig> config = configManager->LoadFromFile(configFile);
+    uint32_t totalUes = config->topology.ueCount;
+    uint32_t totalGnbs = config->topology.gnbCount;
+    config->partition.enabled = true;
+    if (interferenceMarginDb > 0.0)
+    {
+        config->partition.interferenceMarginDb = interferenceMarginDb;
+    }
+    config->monitoring.monitorInterval = 0.0;
+
+    Ptr<NrSimulationManager> simManager = CreateObject<NrSimulationManager>();
+    simManager->SetConfig(config);
+
+    auto t0 = std::chrono::steady_clock::now();
+    simManager->Initialize();
+    auto t1 = std::chrono::steady_clock::now();
+    simManager->Run();
+    auto t2 = std::chrono::steady_clock::now();
+    uint64_t localEvents = Simulator::GetEventCount();
+    uint32_t localUes = config->topology.ueCount;
+    simManager->Finalize();
+
+    std::cout.rdbuf(saved);
+
+    // ----- Reduce: slowest rank sets the wall time, events add up -----
+    double local[2] = {std::chrono::duration<double>(t1 - t0).count(),
+                       std::chrono::duration<double>(t2 - t1).count()};
+    double slowest[2] = {0.0, 0.0};
+    MPI_Reduce(local, slowest, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    unsigned long long events = 0;
+    unsigned long long localEventsUll = localEvents;
+    MPI_Reduce(&localEventsUll, &events, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    unsigned int minUes = 0;
+    unsigned int maxUes = 0;
+    MPI_Reduce(&localUes, &minUes, 1, MPI_UNSIGNED, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&localUes, &maxUes, 1, MPI_UNSIGNED, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0)
+    {
+        double initS = slowest[0];
+        double runS = slowest[1];
+
+        // Speedup against the 1-rank record of the same scenario, if any
+        double baselineRunS = 0.0;
+        std::ifstream previous(outputPath);
+        std::string line;
+        while (std::getline(previous, line))
+        {
+            json rec = json::parse(line, nullptr, false);
+            if (!rec.is_discarded() && rec.value("ranks", 0u) == 1 &&
+                rec.value("config_file", std::string()) == configFile &&
+                rec.value("ues", 0u) == totalUes)
+            {
+                baselineRunS = rec.value("run_s", 0.0);
+            }
+        }
+        if (numRanks == 1)
+        {
+            baselineRunS = runS;
+        }
+        double speedup = (baselineRunS > 0.0 && runS > 0.0) ? baselineRunS / runS : 0.0;
+
+        json rec;
+        rec["benchmark"] = "nr-mpi-independent-shards";
+        rec["schema_version"] = 1;
+        rec["config_file"] = configFile;
+        rec["ranks"] = numRanks;
+        rec["ues"] = totalUes;
+        rec["gnbs"] = totalGnbs;
+        rec["ues_per_rank_min"] = minUes;
+        rec["ues_per_rank_max"] = maxUes;
+        rec["init_s"] = initS;
+        rec["run_s"] = runS;
+        rec["events"] = events;
+        rec["events_per_sec"] = (runS > 0.0) ? events / runS : 0.0;
+        rec["speedup_vs_1_rank"] = speedup;
+
+        std::ofstream out(outputPath, std::ios::app);
+        if (!out.is_open())
+        {
+            std::cerr << "✗ Failed to open " << outputPath << std::endl;
+        }
+        else
+        {
+            out << rec.dump() << std::endl;
+        }
+
+        std::cout << "\n╔═══════════════════════════════════════════════════╗\n";
+        std::cout << "║       NR INDEPENDENT SHARDS (MPI) BENCHMARK       ║\n";
+        std::cout << "╚═══════════════════════════════════════════════════╝\n";
+        std::cout << "Ranks:          " << numRanks << "\n";
+        std::cout << "UEs per rank:   " << minUes << " - " << maxUes << " (of " << totalUes
+                  << ")\n";
+        std::cout << "Init (slowest): " << initS << " s\n";
+        std::cout << "Run (slowest):  " << runS << " s\n";
+        std::cout << "Events:         " << events << "\n";
+        if (speedup > 0.0)
+        {
+            std::cout << "Speedup:        " << speedup << "x vs 1 rank\n";
+        }
+        else
+        {
+            std::cout << "Speedup:        n/a (no 1-rank record yet)\n";
+        }
+        std::cout << "\n✓ Record appended to " << outputPath << std::endl;
+    }
+
+    MpiInterface::Disable();
+    return 0;
+}
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * End-to-End Scaling Benchmark
+ *
+ * Generates NrSimConfig scenarios over a grid of
+ *   UEs x gNBs x simulated duration x telemetry interval x dormancy
+ * and runs each one through NrSimulationManager (Initialize/Run/Finalize).
+ * --burstInterval switches every scenario to sparse traffic; with
+ * --dormancy=off,on the run time of each pair gives the dormant-UE speedup.
+ *
+ * For every scenario it records:
+ * - initialization wall time
+ * - run wall time
+ * - executed events and events/sec
+ * - sim-time / wall-time ratio
+ * - peak RSS
+ *
+ * Each scenario runs in a forked child so peak RSS and ns-3 global state
+ * are per-scenario. Results are written as JSON; passing --baseline compares
+ * against a previous results file and exits non-zero when any metric
+ * regresses by more than --threshold.
+ *
+ * Runs headless: the MILP plan is generated locally (no solver), and a
+ * telemetry interval of 0 disables periodic monitoring and publishing.
+ *
+ * Run with:
+ *   ./ns3 run "nr-scaling-benchmark --ues=10,50 --gnbs=1,3 --durations=1 --telemetry=0,0.1"
+ *   ./ns3 run "nr-scaling-benchmark --baseline=scaling-baseline.json --threshold=0.15"
+ *   ./ns3 run "nr-scaling-benchmark --ues=1000,5000 --burstInterval=30 --dormancy=off,on"
+ */
+
+#include "ns3/core-module.h"
+
+// NR Modular
+#include "ns3/nr-modular-module.h"
+
+#include "nr-benchmark-fork.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("NrScalingBenchmark");
+
+namespace
+{
+
+/**
+ * \brief One point of the scenario grid
+ */
+struct Scenario
+{
+    uint32_t numUes;
+    uint32_t numGnbs;
+    double simDuration;         ///< seconds
+    double telemetryInterval;   ///< seconds, 0 = headless
+    double burstInterval;       ///< seconds between bursts, 0 = continuous
+    bool dormancy;              ///< Dormant-UE mode
+
+    /// Identity without the dormancy flag (pairs off/on runs)
+    std::string TrafficId() const
+    {
+        std::ostringstream oss;
+        oss << "ues=" << numUes << ",gnbs=" << numGnbs << ",dur=" << simDuration
+            << ",telemetry=" << telemetryInterval;
+        if (burstInterval > 0)
+        {
+            oss << ",burst=" << burstInterval;
+        }
+        return oss.str();
+    }
+
+    std::string Id() const
+    {
+        return TrafficId() + (dormancy ? ",dormant" : "");
+    }
+};
+
+std::vector<std::string>
+SplitList(const std::string& csv)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(csv);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * \brief Build a self-contained configuration for one scenario
+ *
+ * gNBs are spread over an area that grows with the cell count so the
+ * per-cell UE density stays comparable across grid points.
+ */
+Ptr<NrSimConfig>
+BuildConfig(const Scenario& s, const std::string& outputDir)
+{
+    Ptr<NrSimConfig> config = CreateObject<NrSimConfig>();
+
+    config->topology.gnbCount = s.numGnbs;
+    config->topology.ueCount = s.numUes;
+    config->topology.areaSize = 500.0 * std::sqrt(static_cast<double>(s.numGnbs));
+    config->topology.uePlacementStrategy = "uniform";
+
+    config->channel.propagationModel = "UMa";
+    config->channel.frequency = 3.5e9;
+    config->channel.bandwidth = 20e6;
+
+    config->mobility.defaultModel = "RandomWalk";
+    config->mobility.defaultSpeed = 3.0;
+
+    config->traffic.startTime = 0.1;
+    config->traffic.duration = s.simDuration;
+    config->traffic.burstInterval = s.burstInterval;
+    config->traffic.dormancy.enabled = s.dormancy;
+
+    config->simDuration = s.simDuration;
+    config->monitoring.monitorInterval = s.telemetryInterval;
+    config->monitoring.enableExternalControl = false;
+
+    config->debug.enableDebugLogs = false;
+    config->debug.enableVerboseHandoverLogs = false;
+
+    config->outputFilePath = outputDir + "/scaling-" + std::to_string(getpid()) + ".txt";
+    return config;
+}
+
+/**
+ * \brief Child side: run one scenario and return its measurements
+ */
+json
+RunScenario(const Scenario& s, const std::string& outputDir)
+{
+    using clock = std::chrono::steady_clock;
+
+    Ptr<NrSimConfig> config = BuildConfig(s, outputDir);
+    Ptr<NrSimulationManager> sim = CreateObject<NrSimulationManager>();
+    sim->SetConfig(config);
+
+    auto t0 = clock::now();
+    sim->Initialize();
+    auto t1 = clock::now();
+    sim->Run();
+    auto t2 = clock::now();
+    uint64_t events = Simulator::GetEventCount();
+    sim->Finalize();
+    auto t3 = clock::now();
+
+    double initSec = std::chrono::duration<double>(t1 - t0).count();
+    double runSec = std::chrono::duration<double>(t2 - t1).count();
+    double finalizeSec = std::chrono::duration<double>(t3 - t2).count();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    json r;
+    r["id"] = s.Id();
+    r["params"]["ues"] = s.numUes;
+    r["params"]["gnbs"] = s.numGnbs;
+    r["params"]["sim_duration_s"] = s.simDuration;
+    r["params"]["telemetry_interval_s"] = s.telemetryInterval;
+    r["params"]["burst_interval_s"] = s.burstInterval;
+    r["params"]["dormancy"] = s.dormancy;
+    r["init_s"] = initSec;
+    r["run_s"] = runSec;
+    r["finalize_s"] = finalizeSec;
+    r["events"] = events;
+    r["events_per_sec"] = runSec > 0 ? events / runSec : 0.0;
+    r["sim_wall_ratio"] = runSec > 0 ? s.simDuration / runSec : 0.0;
+    r["peak_rss_kb"] = usage.ru_maxrss;
+    if (Ptr<NrDormancyManager> dormancy = sim->GetDormancyManager())
+    {
+        NrDormancyManager::Statistics stats = dormancy->GetStatistics();
+        r["dormant_fraction"] = stats.GetDormantFraction();
+        r["ue_promotions"] = stats.promotions;
+        r["ue_demotions"] = stats.demotions;
+    }
+    r["ok"] = true;
+    return r;
+}
+
+/**
+ * \brief Run the scenario in a child process
+ */
+json
+RunIsolated(const Scenario& s, const std::string& outputDir, bool verbose)
+{
+    json r = NrBenchmark::RunForked([&]() { return RunScenario(s, outputDir); }, verbose);
+    r["id"] = s.Id();
+    return r;
+}
+
+/**
+ * \brief Compare results against a baseline file
+ * \return number of regressions beyond threshold
+ */
+uint32_t
+CompareToBaseline(const json& results, const std::string& baselinePath, double threshold)
+{
+    std::ifstream file(baselinePath);
+    if (!file.is_open())
+    {
+        std::cerr << "✗ Cannot open baseline " << baselinePath << std::endl;
+        return 1;
+    }
+    json baseline;
+    file >> baseline;
+
+    std::map<std::string, json> byId;
+    for (const auto& r : baseline["results"])
+    {
+        byId[r["id"].get<std::string>()] = r;
+    }
+
+    // metric, higher-is-worse
+    const std::vector<std::pair<std::string, bool>> metrics = {
+        {"init_s", true},
+        {"run_s", true},
+        {"peak_rss_kb", true},
+        {"events_per_sec", false},
+    };
+
+    uint32_t regressions = 0;
+    std::cout << "\nBaseline comparison (threshold " << threshold * 100 << "%):\n";
+
+    for (const auto& r : results)
+    {
+        std::string id = r["id"].get<std::string>();
+        auto it = byId.find(id);
+        if (it == byId.end() || !r.value("ok", false) || !it->second.value("ok", false))
+        {
+            std::cout << "  " << id << ": no comparable baseline\n";
+            continue;
+        }
+
+        for (const auto& [metric, higherIsWorse] : metrics)
+        {
+            double base = it->second[metric].get<double>();
+            double now = r[metric].get<double>();
+            if (base <= 0)
+            {
+                continue;
+            }
+            double change = (now - base) / base;
+            bool regressed = higherIsWorse ? change > threshold : change < -threshold;
+            if (regressed)
+            {
+                regressions++;
+                std::cout << "  ✗ " << id << " " << metric << ": " << base << " → " << now
+                          << " (" << std::showpos << std::fixed << std::setprecision(1)
+                          << change * 100 << "%" << std::noshowpos << ")\n";
+                std::cout.unsetf(std::ios::floatfield);
+            }
+        }
+    }
+
+    if (regressions == 0)
+    {
+        std::cout << "  ✓ No regressions\n";
+    }
+    return regressions;
+}
+
+} // namespace
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int
+main(int argc, char* argv[])
+{
+    std::string uesArg = "10,50,100";
+    std::string gnbsArg = "1,3";
+    std::string durationsArg = "1";
+    std::string telemetryArg = "0,0.1";
+    std::string dormancyArg = "off";
+    double burstInterval = 0.0;
+    std::string outputPath = "nr-scaling-benchmark.json";
+    std::string outputDir = "/tmp";
+    std::string baselinePath;
+    double threshold = 0.10;
+    bool verbose = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("ues", "Comma-separated UE counts", uesArg);
+    cmd.AddValue("gnbs", "Comma-separated gNB counts", gnbsArg);
+    cmd.AddValue("durations", "Comma-separated simulated durations (s)", durationsArg);
+    cmd.AddValue("telemetry", "Comma-separated telemetry intervals (s, 0 = off)", telemetryArg);
+    cmd.AddValue("burstInterval",
+                 "Mean seconds between traffic bursts (0 = continuous)",
+                 burstInterval);
+    cmd.AddValue("dormancy", "Comma-separated dormant-UE modes (off,on)", dormancyArg);
+    cmd.AddValue("output", "JSON results file", outputPath);
+    cmd.AddValue("outputDir", "Directory for per-scenario result files", outputDir);
+    cmd.AddValue("baseline", "Baseline results file to compare against", baselinePath);
+    cmd.AddValue("threshold", "Relative regression threshold (0.10 = 10%)", threshold);
+    cmd.AddValue("verbose", "Show simulation output", verbose);
+    cmd.Parse(argc, argv);
+
+    std::vector<Scenario> scenarios;
+    for (const auto& ue : SplitList(uesArg))
+    {
+        for (const auto& gnb : SplitList(gnbsArg))
+        {
+            for (const auto& dur : SplitList(durationsArg))
+            {
+                for (const auto& tel : SplitList(telemetryArg))
+                {
+                    for (const auto& dormancy : SplitList(dormancyArg))
+                    {
+                        scenarios.push_back({static_cast<uint32_t>(std::stoul(ue)),
+                                             static_cast<uint32_t>(std::stoul(gnb)),
+                                             std::stod(dur),
+                                             std::stod(tel),
+                                             burstInterval,
+                                             dormancy == "on"});
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << "\n╔═══════════════════════════════════════════════════╗\n";
+    std::cout << "║       NR END-TO-END SCALING BENCHMARK             ║\n";
+    std::cout << "╚═══════════════════════════════════════════════════╝\n\n";
+    std::cout << scenarios.size() << " scenarios\n\n";
+
+    json results = json::array();
+    std::map<std::string, double> alwaysOnRun; // TrafficId -> run_s without dormancy
+    for (const auto& s : scenarios)
+    {
+        std::cout << "  " << std::left << std::setw(48) << s.Id() << std::flush;
+        json r = RunIsolated(s, outputDir, verbose);
+
+        if (r.value("ok", false))
+        {
+            std::cout << std::fixed << std::setprecision(2)
+                      << " init " << std::setw(7) << r["init_s"].get<double>() << "s"
+                      << " run " << std::setw(8) << r["run_s"].get<double>() << "s"
+                      << " " << std::setw(10) << std::setprecision(0)
+                      << r["events_per_sec"].get<double>() << " ev/s"
+                      << " ratio " << std::setprecision(3) << r["sim_wall_ratio"].get<double>()
+                      << " rss " << (r["peak_rss_kb"].get<long>() / 1024) << " MiB" << std::endl;
+
+            double runS = r["run_s"].get<double>();
+            if (!s.dormancy)
+            {
+                alwaysOnRun[s.TrafficId()] = runS;
+            }
+            else if (alwaysOnRun.count(s.TrafficId()) && runS > 0)
+            {
+                r["dormancy_speedup"] = alwaysOnRun[s.TrafficId()] / runS;
+                std::cout << "  " << std::setw(48) << "" << " dormant "
+                          << std::setprecision(1) << r.value("dormant_fraction", 0.0) * 100.0
+                          << "% of UE-time, speedup " << std::setprecision(2)
+                          << r["dormancy_speedup"].get<double>() << "x" << std::endl;
+            }
+        }
+        else
+        {
+            std::cout << " ✗ failed (status " << r["exit_status"] << ")" << std::endl;
+        }
+        std::cout.unsetf(std::ios::floatfield);
+        results.push_back(r);
+    }
+
+    json out;
+    out["benchmark"] = "nr-e2e-scaling";
+    out["schema_version"] = 1;
+    out["results"] = results;
+
+    std::ofstream file(outputPath);
+    if (!file.is_open())
+    {
+        std::cerr << "✗ Failed to open " << outputPath << std::endl;
+        return 1;
+    }
+    file << out.dump(2) << std::endl;
+    std::cout << "\n✓ Results written to " << outputPath << std::endl;
+
+    if (!baselinePath.empty())
+    {
+        uint32_t regressions = CompareToBaseline(results, baselinePath, threshold);
+        if (regressions > 0)
+        {
+            return 2;
+        }
+    }
+    return 0;
+}
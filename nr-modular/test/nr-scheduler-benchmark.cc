@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Scheduler Cost Benchmark
+ *
+ * Runs the same scenario (topology, traffic, PHY and RNG seed held fixed)
+ * under each MAC scheduler and measures what the scheduler itself costs:
+ * - DL / UL wall time per slot (DoSchedDl/UlTriggerReq)
+ * - time spent in AssignDLRBG / AssignULRBG per slot
+ * - DCIs per slot and RBGs per DCI
+ * - UEs offered to the scheduler per slot
+ *
+ * Each scheduler is wrapped in a thin "cost probe" subclass that times the
+ * inherited entry points and counts the DCIs they return, so the numbers
+ * come from the real code path inside a running simulation. Each scheduler
+ * runs in its own forked child.
+ *
+ * Compared by default:
+ *   NrMilpExecutorScheduler, NrMacSchedulerTdmaRR, NrMacSchedulerTdmaPF,
+ *   NrMacSchedulerOfdmaRR, NrMacSchedulerOfdmaPF
+ *
+ * Run with:
+ *   ./ns3 run "nr-scheduler-benchmark --ues=20 --duration=1"
+ *   ./ns3 run "nr-scheduler-benchmark --schedulers=milp,tdma-rr --output=sched.json"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/nr-mac-scheduler-tdma-rr.h"
+#include "ns3/nr-mac-scheduler-tdma-pf.h"
+#include "ns3/nr-mac-scheduler-ofdma-rr.h"
+#include "ns3/nr-mac-scheduler-ofdma-pf.h"
+
+// NR Modular
+#include "ns3/nr-modular-module.h"
+
+#include "nr-benchmark-fork.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("NrSchedulerBenchmark");
+
+namespace
+{
+
+// ============================================================================
+// COST ACCOUNTING
+// ============================================================================
+
+/**
+ * \brief Scheduler cost counters, accumulated over all gNBs in the process
+ */
+struct SchedulerCost
+{
+    uint64_t dlSlots = 0;
+    uint64_t ulSlots = 0;
+    double dlNs = 0.0;          ///< Total DoSchedDlTriggerReq time
+    double ulNs = 0.0;          ///< Total DoSchedUlTriggerReq time
+    double dlAssignNs = 0.0;    ///< Total AssignDLRBG time
+    double ulAssignNs = 0.0;    ///< Total AssignULRBG time
+    uint64_t dlAssignCalls = 0;
+    uint64_t ulAssignCalls = 0;
+    uint64_t dlActiveUes = 0;   ///< UEs offered in AssignDLRBG
+    uint64_t ulActiveUes = 0;   ///< UEs offered in AssignULRBG
+    uint64_t dlDcis = 0;
+    uint64_t ulDcis = 0;
+    uint64_t dlRbgs = 0;        ///< RBGs covered by DL DCIs
+    uint64_t ulRbgs = 0;        ///< RBGs covered by UL DCIs
+};
+
+SchedulerCost g_cost;
+
+using Clock = std::chrono::steady_clock;
+
+double
+ElapsedNs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+uint64_t
+CountUes(const NrMacSchedulerNs3::ActiveUeMap& active)
+{
+    uint64_t n = 0;
+    for (const auto& [beam, ues] : active)
+    {
+        n += ues.size();
+    }
+    return n;
+}
+
+uint64_t
+CountRbgs(const std::shared_ptr<DciInfoElementTdma>& dci)
+{
+    return static_cast<uint64_t>(
+        std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), true));
+}
+
+} // namespace
+
+// ============================================================================
+// COST PROBE
+// ============================================================================
+
+/**
+ * \brief Times the scheduler entry points of Base and counts emitted DCIs
+ *
+ * Only forwards to Base; scheduling decisions are unchanged.
+ */
+template <class Base>
+class NrSchedulerCostProbe : public Base
+{
+  public:
+    void DoSchedDlTriggerReq(
+        const NrMacSchedSapProvider::SchedDlTriggerReqParameters& params) override
+    {
+        auto start = Clock::now();
+        Base::DoSchedDlTriggerReq(params);
+        g_cost.dlNs += ElapsedNs(start);
+        g_cost.dlSlots++;
+    }
+
+    void DoSchedUlTriggerReq(
+        const NrMacSchedSapProvider::SchedUlTriggerReqParameters& params) override
+    {
+        auto start = Clock::now();
+        Base::DoSchedUlTriggerReq(params);
+        g_cost.ulNs += ElapsedNs(start);
+        g_cost.ulSlots++;
+    }
+
+  protected:
+    NrMacSchedulerNs3::BeamSymbolMap AssignDLRBG(
+        uint32_t symAvail,
+        const NrMacSchedulerNs3::ActiveUeMap& activeDl) const override
+    {
+        auto start = Clock::now();
+        auto result = Base::AssignDLRBG(symAvail, activeDl);
+        g_cost.dlAssignNs += ElapsedNs(start);
+        g_cost.dlAssignCalls++;
+        g_cost.dlActiveUes += CountUes(activeDl);
+        return result;
+    }
+
+    NrMacSchedulerNs3::BeamSymbolMap AssignULRBG(
+        uint32_t symAvail,
+        const NrMacSchedulerNs3::ActiveUeMap& activeUl) const override
+    {
+        auto start = Clock::now();
+        auto result = Base::AssignULRBG(symAvail, activeUl);
+        g_cost.ulAssignNs += ElapsedNs(start);
+        g_cost.ulAssignCalls++;
+        g_cost.ulActiveUes += CountUes(activeUl);
+        return result;
+    }
+
+    std::shared_ptr<DciInfoElementTdma> CreateDlDci(
+        NrMacSchedulerNs3::PointInFTPlane* spoint,
+        const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
+        uint32_t maxSym) const override
+    {
+        auto dci = Base::CreateDlDci(spoint, ueInfo, maxSym);
+        if (dci != nullptr)
+        {
+            g_cost.dlDcis++;
+            g_cost.dlRbgs += CountRbgs(dci);
+        }
+        return dci;
+    }
+
+    std::shared_ptr<DciInfoElementTdma> CreateUlDci(
+        NrMacSchedulerNs3::PointInFTPlane* spoint,
+        const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
+        uint32_t maxSym) const override
+    {
+        auto dci = Base::CreateUlDci(spoint, ueInfo, maxSym);
+        if (dci != nullptr)
+        {
+            g_cost.ulDcis++;
+            g_cost.ulRbgs += CountRbgs(dci);
+        }
+        return dci;
+    }
+};
+
+// One registered TypeId per probed scheduler so NrHelper can install it
+#define NR_SCHEDULER_COST_PROBE(ProbeName, BaseClass)                                  \
+    class ProbeName : public NrSchedulerCostProbe<BaseClass>                           \
+    {                                                                                  \
+      public:                                                                          \
+        static TypeId GetTypeId()                                                      \
+        {                                                                              \
+            static TypeId tid = TypeId("ns3::" #ProbeName)                             \
+                                    .SetParent<BaseClass>()                            \
+                                    .SetGroupName("NrModular")                         \
+                                    .AddConstructor<ProbeName>();                      \
+            return tid;                                                                \
+        }                                                                              \
+    };                                                                                 \
+    NS_OBJECT_ENSURE_REGISTERED(ProbeName)
+
+NR_SCHEDULER_COST_PROBE(NrCostProbeMilpExecutor, NrMilpExecutorScheduler);
+NR_SCHEDULER_COST_PROBE(NrCostProbeTdmaRR, NrMacSchedulerTdmaRR);
+NR_SCHEDULER_COST_PROBE(NrCostProbeTdmaPF, NrMacSchedulerTdmaPF);
+NR_SCHEDULER_COST_PROBE(NrCostProbeOfdmaRR, NrMacSchedulerOfdmaRR);
+NR_SCHEDULER_COST_PROBE(NrCostProbeOfdmaPF, NrMacSchedulerOfdmaPF);
+
+namespace
+{
+
+/// Short benchmark name → probe TypeId name
+const std::map<std::string, std::string> kSchedulers = {
+    {"milp", "ns3::NrCostProbeMilpExecutor"},
+    {"tdma-rr", "ns3::NrCostProbeTdmaRR"},
+    {"tdma-pf", "ns3::NrCostProbeTdmaPF"},
+    {"ofdma-rr", "ns3::NrCostProbeOfdmaRR"},
+    {"ofdma-pf", "ns3::NrCostProbeOfdmaPF"},
+};
+
+/**
+ * \brief Child side: run the fixed scenario under one scheduler
+ */
+json
+RunScheduler(const std::string& name, uint32_t numUes, uint32_t numGnbs, double duration)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    Ptr<NrSimConfig> config = CreateObject<NrSimConfig>();
+    config->topology.gnbCount = numGnbs;
+    config->topology.ueCount = numUes;
+    config->topology.areaSize = 500.0;
+    config->mobility.defaultModel = "RandomWalk";
+    config->traffic.startTime = 0.1;
+    config->traffic.duration = duration;
+    config->simDuration = duration;
+    config->monitoring.monitorInterval = 0.0;   // headless
+    config->scheduling.schedulerType = kSchedulers.at(name);
+    config->outputFilePath = "/tmp/nr-scheduler-benchmark-" + name + ".txt";
+
+    Ptr<NrSimulationManager> sim = CreateObject<NrSimulationManager>();
+    sim->SetConfig(config);
+    sim->Initialize();
+
+    g_cost = SchedulerCost();
+    sim->Run();
+    SchedulerCost cost = g_cost;
+    sim->Finalize();
+
+    auto perSlot = [](double total, uint64_t slots) {
+        return slots > 0 ? total / static_cast<double>(slots) : 0.0;
+    };
+
+    json r;
+    r["scheduler"] = name;
+    r["type_id"] = kSchedulers.at(name);
+    r["dl"]["slots"] = cost.dlSlots;
+    r["dl"]["ns_per_slot"] = perSlot(cost.dlNs, cost.dlSlots);
+    r["dl"]["assign_ns_per_call"] = perSlot(cost.dlAssignNs, cost.dlAssignCalls);
+    r["dl"]["active_ues_per_call"] = perSlot(cost.dlActiveUes, cost.dlAssignCalls);
+    r["dl"]["dcis"] = cost.dlDcis;
+    r["dl"]["dcis_per_slot"] = perSlot(cost.dlDcis, cost.dlSlots);
+    r["dl"]["rbgs_per_dci"] = perSlot(cost.dlRbgs, cost.dlDcis);
+    r["ul"]["slots"] = cost.ulSlots;
+    r["ul"]["ns_per_slot"] = perSlot(cost.ulNs, cost.ulSlots);
+    r["ul"]["assign_ns_per_call"] = perSlot(cost.ulAssignNs, cost.ulAssignCalls);
+    r["ul"]["active_ues_per_call"] = perSlot(cost.ulActiveUes, cost.ulAssignCalls);
+    r["ul"]["dcis"] = cost.ulDcis;
+    r["ul"]["dcis_per_slot"] = perSlot(cost.ulDcis, cost.ulSlots);
+    r["ul"]["rbgs_per_dci"] = perSlot(cost.ulRbgs, cost.ulDcis);
+    r["ok"] = true;
+    return r;
+}
+
+/**
+ * \brief Run one scheduler in a child process
+ */
+json
+RunIsolated(const std::string& name,
+            uint32_t numUes,
+            uint32_t numGnbs,
+            double duration,
+            bool verbose)
+{
+    json r = NrBenchmark::RunForked(
+        [&]() { return RunScheduler(name, numUes, numGnbs, duration); },
+        verbose);
+    r["scheduler"] = name;
+    return r;
+}
+
+} // namespace
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int
+main(int argc, char* argv[])
+{
+    std::string schedulersArg = "milp,tdma-rr,tdma-pf,ofdma-rr,ofdma-pf";
+    uint32_t numUes = 20;
+    uint32_t numGnbs = 1;
+    double duration = 1.0;
+    std::string outputPath = "nr-scheduler-benchmark.json";
+    bool verbose = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("schedulers",
+                 "Comma-separated list of: milp, tdma-rr, tdma-pf, ofdma-rr, ofdma-pf",
+                 schedulersArg);
+    cmd.AddValue("ues", "Number of UEs", numUes);
+    cmd.AddValue("gnbs", "Number of gNBs", numGnbs);
+    cmd.AddValue("duration", "Simulated duration (s)", duration);
+    cmd.AddValue("output", "JSON results file", outputPath);
+    cmd.AddValue("verbose", "Show simulation output", verbose);
+    cmd.Parse(argc, argv);
+
+    std::vector<std::string> schedulers;
+    std::stringstream ss(schedulersArg);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        NS_ABORT_MSG_IF(kSchedulers.find(item) == kSchedulers.end(),
+                        "Unknown scheduler '" << item << "'");
+        schedulers.push_back(item);
+    }
+
+    std::cout << "\n╔═══════════════════════════════════════════════════╗\n";
+    std::cout << "║       NR SCHEDULER COST BENCHMARK                 ║\n";
+    std::cout << "╚═══════════════════════════════════════════════════╝\n\n";
+    std::cout << "Scenario: " << numGnbs << " gNB(s), " << numUes << " UEs, " << duration
+              << " s\n\n";
+    std::cout << "  " << std::left << std::setw(10) << "scheduler" << std::right
+              << std::setw(12) << "DL ns/slot" << std::setw(12) << "UL ns/slot"
+              << std::setw(12) << "DL DCI/slot" << std::setw(12) << "UL DCI/slot"
+              << std::setw(12) << "DL RBG/DCI" << std::setw(12) << "UL RBG/DCI" << "\n";
+
+    json results = json::array();
+    for (const auto& name : schedulers)
+    {
+        json r = RunIsolated(name, numUes, numGnbs, duration, verbose);
+        std::cout << "  " << std::left << std::setw(10) << name << std::right;
+        if (r.value("ok", false))
+        {
+            std::cout << std::fixed << std::setprecision(0)
+                      << std::setw(12) << r["dl"]["ns_per_slot"].get<double>()
+                      << std::setw(12) << r["ul"]["ns_per_slot"].get<double>()
+                      << std::setprecision(2)
+                      << std::setw(12) << r["dl"]["dcis_per_slot"].get<double>()
+                      << std::setw(12) << r["ul"]["dcis_per_slot"].get<double>()
+                      << std::setw(12) << r["dl"]["rbgs_per_dci"].get<double>()
+                      << std::setw(12) << r["ul"]["rbgs_per_dci"].get<double>() << "\n";
+            std::cout.unsetf(std::ios::floatfield);
+        }
+        else
+        {
+            std::cout << "  ✗ failed (status " << r["exit_status"] << ")\n";
+        }
+        results.push_back(r);
+    }
+
+    json out;
+    out["benchmark"] = "nr-scheduler-cost";
+    out["schema_version"] = 1;
+    out["scenario"]["ues"] = numUes;
+    out["scenario"]["gnbs"] = numGnbs;
+    out["scenario"]["duration_s"] = duration;
+    out["results"] = results;
+
+    std::ofstream file(outputPath);
+    if (!file.is_open())
+    {
+        std::cerr << "✗ Failed to open " << outputPath << std::endl;
+        return 1;
+    }
+    file << out.dump(2) << std::endl;
+    std::cout << "\n✓ Results written to " << outputPath << std::endl;
+    return 0;
+}
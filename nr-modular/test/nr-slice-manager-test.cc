@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Slice Manager Test
+ *
+ * Drives NrSliceManager::ApplySlotQuotas with hand-built slots (20 PRBs,
+ * 1-PRB RBGs, UE 0 eMBB, UE 1 uRLLC, UE 2 mMTC) and checks the grants
+ * follow the buffers rather than the plan:
+ * - an idle slice's guarantee is borrowed, and the PRBs it was planned
+ *   are lent to the busy slice
+ * - PRBs trimmed by a slice's maximum are lent to another slice
+ * - PRBs held by retransmissions shrink the guarantees: a miss
+ */
+
+#include "ns3/nr-slice-manager.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+namespace
+{
+
+constexpr uint32_t kPrbs = 20;
+
+Ptr<NrSliceManager>
+CreateSlices()
+{
+    Ptr<NrSliceManager> slices = CreateObject<NrSliceManager>();
+    slices->SetSliceQuota(SliceType::eMBB, 0.5, 1.0);
+    slices->SetSliceQuota(SliceType::uRLLC, 0.3, 0.3);
+    slices->SetSliceQuota(SliceType::mMTC, 0.2, 0.5);
+    slices->SetUeSlice(0, SliceType::eMBB);
+    slices->SetUeSlice(1, SliceType::uRLLC);
+    slices->SetUeSlice(2, SliceType::mMTC);
+    return slices;
+}
+
+NrSliceManager::SlotResources
+CreateSlot(std::vector<NrSliceManager::UeDemand> demand)
+{
+    NrSliceManager::SlotResources slot;
+    slot.usablePrbs.assign(kPrbs, true);
+    slot.rbgSize = 1;
+    slot.demand = std::move(demand);
+    return slot;
+}
+
+uint32_t
+PrbsOf(const std::vector<PrbAllocation>& allocations, uint32_t ueId)
+{
+    uint32_t prbs = 0;
+    for (const auto& a : allocations)
+    {
+        prbs += (a.ueId == ueId) ? a.numPrbs : 0;
+    }
+    return prbs;
+}
+
+bool
+Holds(const std::vector<PrbAllocation>& allocations, uint32_t ueId, uint32_t prb)
+{
+    for (const auto& a : allocations)
+    {
+        if (a.ueId == ueId && prb >= a.startPrb && prb < a.startPrb + a.numPrbs)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+/**
+ * \brief uRLLC is idle: eMBB borrows its guarantee and is lent its PRBs
+ */
+class NrSliceBorrowTestCase : public TestCase
+{
+  public:
+    NrSliceBorrowTestCase()
+        : TestCase("Idle slice's guarantee and PRBs go to a busy slice")
+    {
+    }
+
+    void DoRun() override
+    {
+        Ptr<NrSliceManager> slices = CreateSlices();
+        std::vector<PrbAllocation> allocations{{0, 0, 0, 10}, {1, 0, 10, 6}, {2, 0, 16, 4}};
+        slices->ApplySlotQuotas(allocations, CreateSlot({{0, 18}, {1, 0}, {2, 2}}), true);
+
+        NS_TEST_ASSERT_MSG_EQ(PrbsOf(allocations, 0), 18, "eMBB should get its whole buffer");
+        NS_TEST_ASSERT_MSG_EQ(PrbsOf(allocations, 1), 0, "Idle uRLLC UE should keep nothing");
+        NS_TEST_ASSERT_MSG_EQ(PrbsOf(allocations, 2), 2, "mMTC should keep only its buffer");
+        NS_TEST_ASSERT_MSG_EQ(Holds(allocations, 0, 12), true, "uRLLC's planned PRBs not lent");
+
+        const auto& embb = slices->GetCounters(SliceType::eMBB);
+        NS_TEST_ASSERT_MSG_EQ(embb.grantedPrbs, 18, "Wrong eMBB grant");
+        NS_TEST_ASSERT_MSG_EQ(embb.borrowedPrbs, 8, "eMBB should borrow 8 PRBs");
+        NS_TEST_ASSERT_MSG_EQ(embb.lentPrbs, 8, "eMBB should be lent 8 PRBs");
+        NS_TEST_ASSERT_MSG_EQ(embb.guaranteeMisses, 0, "No guarantee should be missed");
+        NS_TEST_ASSERT_MSG_EQ(slices->GetCounters(SliceType::uRLLC).activeSlots,
+                              0,
+                              "uRLLC has no buffered data");
+        slices->Dispose();
+    }
+};
+
+/**
+ * \brief uRLLC exceeds its maximum: the trimmed PRBs are lent to eMBB
+ */
+class NrSliceCapLendTestCase : public TestCase
+{
+  public:
+    NrSliceCapLendTestCase()
+        : TestCase("PRBs trimmed by a maximum are lent")
+    {
+    }
+
+    void DoRun() override
+    {
+        Ptr<NrSliceManager> slices = CreateSlices();
+        std::vector<PrbAllocation> allocations{{1, 0, 0, 12}, {0, 0, 12, 2}};
+        slices->ApplySlotQuotas(allocations, CreateSlot({{0, 14}, {1, 12}}), true);
+
+        NS_TEST_ASSERT_MSG_EQ(PrbsOf(allocations, 1), 6, "uRLLC should be capped at 6 PRBs");
+        NS_TEST_ASSERT_MSG_EQ(PrbsOf(allocations, 0), 14, "eMBB should get its whole buffer");
+        NS_TEST_ASSERT_MSG_EQ(Holds(allocations, 0, 6), true, "Capped PRBs not lent");
+
+        const auto& urllc = slices->GetCounters(SliceType::uRLLC);
+        NS_TEST_ASSERT_MSG_EQ(urllc.cappedSlots, 1, "uRLLC should be capped");
+        NS_TEST_ASSERT_MSG_EQ(urllc.trimmedPrbs, 6, "Wrong uRLLC trim");
+        NS_TEST_ASSERT_MSG_EQ(slices->GetCounters(SliceType::eMBB).lentPrbs,
+                              12,
+                              "eMBB should be lent 12 PRBs");
+        slices->Dispose();
+    }
+};
+
+/**
+ * \brief Retransmissions hold 8 PRBs: the guarantees no longer fit
+ */
+class NrSliceGuaranteeMissTestCase : public TestCase
+{
+  public:
+    NrSliceGuaranteeMissTestCase()
+        : TestCase("Held PRBs cause guarantee misses")
+    {
+    }
+
+    void DoRun() override
+    {
+        Ptr<NrSliceManager> slices = CreateSlices();
+        std::vector<PrbAllocation> allocations{{0, 0, 0, 10}, {1, 0, 10, 6}, {2, 0, 16, 4}};
+        NrSliceManager::SlotResources slot = CreateSlot({{0, 10}, {1, 6}, {2, 4}});
+        std::fill(slot.usablePrbs.begin(), slot.usablePrbs.begin() + 8, false);
+        slices->ApplySlotQuotas(allocations, slot, true);
+
+        uint32_t total = 0;
+        for (const auto& a : allocations)
+        {
+            NS_TEST_ASSERT_MSG_GT_OR_EQ(a.startPrb, 8, "A held PRB was granted");
+            total += a.numPrbs;
+        }
+        NS_TEST_ASSERT_MSG_EQ(total, 12, "All usable PRBs should be granted");
+        NS_TEST_ASSERT_MSG_EQ(PrbsOf(allocations, 1), 3, "uRLLC guarantee should be scaled");
+
+        const auto& urllc = slices->GetCounters(SliceType::uRLLC);
+        NS_TEST_ASSERT_MSG_EQ(urllc.guaranteeMisses, 1, "uRLLC guarantee miss not counted");
+        NS_TEST_ASSERT_MSG_EQ(urllc.trimmedPrbs, 3, "Wrong uRLLC trim");
+        NS_TEST_ASSERT_MSG_EQ(slices->GetCounters(SliceType::eMBB).guaranteeMisses,
+                              1,
+                              "eMBB guarantee miss not counted");
+        NS_TEST_ASSERT_MSG_EQ(slices->GetCounters(SliceType::uRLLC, false).slots,
+                              0,
+                              "UL counters should be untouched");
+        slices->Dispose();
+    }
+};
+
+/**
+ * \brief Slice manager test suite
+ */
+class NrSliceManagerTestSuite : public TestSuite
+{
+  public:
+    NrSliceManagerTestSuite()
+        : TestSuite("nr-slice-manager", Type::UNIT)
+    {
+        AddTestCase(new NrSliceBorrowTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new NrSliceCapLendTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new NrSliceGuaranteeMissTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static NrSliceManagerTestSuite g_nrSliceManagerTestSuite;
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Forked Sweep Benchmark
+ *
+ * Initializes one scenario, then fans out a traffic-rate x RNG-run sweep
+ * with NrSimulationManager::RunForkedSweep(). Reports the measured sweep
+ * wall time against the sequential equivalent (one Initialize() per
+ * point, points run back to back) and writes the results as JSON.
+ *
+ * Run with:
+ *   ./ns3 run "nr-sweep-benchmark --configFile=config/test-waypoint-traffic-config.json --dlRates=5,10,20 --runs=1,2,3"
+ *   ./ns3 run "nr-sweep-benchmark --configFile=config/test-waypoint-traffic-config.json --workers=4"
+ */
+
+#include "ns3/core-module.h"
+
+// NR Modular
+#include "ns3/nr-modular-module.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("NrSweepBenchmark");
+
+namespace
+{
+
+std::vector<std::string>
+SplitList(const std::string& csv)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(csv);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+} // namespace
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int
+main(int argc, char* argv[])
+{
+    std::string configFile = "config/test-waypoint-traffic-config.json";
+    std::string dlRatesArg = "5,10,20";
+    std::string runsArg = "1,2";
+    uint32_t workers = 0;
+    std::string outputPath = "nr-sweep-benchmark.json";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("configFile", "Scenario JSON configuration", configFile);
+    cmd.AddValue("dlRates", "Comma-separated downlink UDP rates (Mbps)", dlRatesArg);
+    cmd.AddValue("runs", "Comma-separated RNG run numbers", runsArg);
+    cmd.AddValue("workers", "Concurrent workers (0 = online CPU count)", workers);
+    cmd.AddValue("output", "JSON results file", outputPath);
+    cmd.Parse(argc, argv);
+
+    std::cout << "\n╔═══════════════════════════════════════════════════╗\n";
+    std::cout << "║       NR FORKED SWEEP BENCHMARK                   ║\n";
+    std::cout << "╚═══════════════════════════════════════════════════╝\n";
+
+    // ----- Initialize once -----
+    Ptr<NrSimulationManager> simManager = CreateObject<NrSimulationManager>();
+    simManager->SetConfigFile(configFile);
+
+    auto initStart = std::chrono::steady_clock::now();
+    simManager->Initialize();
+    double initSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - initStart).count();
+
+    // ----- Build the sweep -----
+    std::vector<NrSimulationManager::SweepPoint> points;
+    for (const auto& rate : SplitList(dlRatesArg))
+    {
+        for (const auto& run : SplitList(runsArg))
+        {
+            NrSimulationManager::SweepPoint point;
+            point.name = "dl" + rate + "_run" + run;
+            point.rngRun = static_cast<uint32_t>(std::stoul(run));
+            point.traffic = simManager->GetConfig()->traffic;
+            point.traffic.udpRateDl = std::stod(rate);
+            points.push_back(point);
+        }
+    }
+
+    auto sweepStart = std::chrono::steady_clock::now();
+    std::vector<NrSimulationManager::SweepResult> results =
+        simManager->RunForkedSweep(points, workers);
+    double sweepSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - sweepStart).count();
+
+    // ----- Compare against one Initialize() per point, run sequentially -----
+    double workerSeconds = 0.0;
+    uint32_t failures = 0;
+    json pointsJson = json::array();
+    for (const auto& r : results)
+    {
+        workerSeconds += r.wallSeconds;
+        failures += (r.exitCode != 0) ? 1 : 0;
+
+        json p;
+        p["name"] = r.name;
+        p["exit_code"] = r.exitCode;
+        p["wall_s"] = r.wallSeconds;
+        p["output"] = r.outputFilePath;
+        p["log"] = r.logPath;
+        pointsJson.push_back(p);
+    }
+
+    double forkedSeconds = initSeconds + sweepSeconds;
+    double sequentialSeconds = results.size() * initSeconds + workerSeconds;
+    double speedup = (forkedSeconds > 0.0) ? sequentialSeconds / forkedSeconds : 0.0;
+
+    std::cout << "\nInitialization:        " << initSeconds << " s (once)\n";
+    std::cout << "Sweep wall time:       " << sweepSeconds << " s for " << results.size()
+              << " point(s)\n";
+    std::cout << "Sequential equivalent: " << sequentialSeconds << " s\n";
+    std::cout << "Speedup:               " << speedup << "x\n";
+
+    json out;
+    out["benchmark"] = "nr-forked-sweep";
+    out["schema_version"] = 1;
+    out["config_file"] = configFile;
+    out["init_s"] = initSeconds;
+    out["sweep_s"] = sweepSeconds;
+    out["sequential_equivalent_s"] = sequentialSeconds;
+    out["speedup"] = speedup;
+    out["failures"] = failures;
+    out["points"] = pointsJson;
+
+    std::ofstream file(outputPath);
+    if (!file.is_open())
+    {
+        std::cerr << "✗ Failed to open " << outputPath << std::endl;
+        return 1;
+    }
+    file << out.dump(2) << std::endl;
+    std::cout << "\n✓ Results written to " << outputPath << std::endl;
+
+    Simulator::Destroy();
+    return (failures == 0) ? 0 : 1;
+}
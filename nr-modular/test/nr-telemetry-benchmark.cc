@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026 ARTPARK
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * Telemetry Overhead Benchmark
+ *
+ * Drives NrOutputManager over synthetic deployments (10 - 50k UEs) and
+ * splits the per-tick cost into:
+ * - collection  (CollectCurrentState)
+ * - encoding    (StateToJson)
+ * - sending     (FILE / UDP / TCP / PIPE publish method)
+ *
+ * For every UE count it runs the default TelemetryConfig, the same with
+ * single-threaded UE collection ("serial"), and an ablation with each
+ * optional field group switched off, for every publish method.
+ * With --budgetMs it also runs the fully-enabled config under a per-tick
+ * budget and reports which field groups the budget disabled.
+ *
+ * Nodes are deployed by NrTopologyManager with static mobility; no NR
+ * devices are installed, so radio/attachment lookups take their
+ * "unavailable" paths. Results are written as JSON.
+ *
+ * Run with:
+ *   ./ns3 run "nr-telemetry-benchmark --ues=10,1000,10000,50000"
+ *   ./ns3 run "nr-telemetry-benchmark --ues=10000 --methods=file --budgetMs=20"
+ */
+
+#include "ns3/core-module.h"
+
+// NR Modular
+#include "ns3/nr-modular-module.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("NrTelemetryBenchmark");
+
+namespace
+{
+
+/**
+ * \brief A named TelemetryConfig variant
+ */
+struct Preset
+{
+    std::string name;
+    std::function<void(NrOutputManager::TelemetryConfig&)> apply;
+};
+
+std::vector<Preset>
+BuildPresets()
+{
+    using Cfg = NrOutputManager::TelemetryConfig;
+    return {
+        {"default", [](Cfg&) {}},
+        {"serial", [](Cfg& c) { c.collectionThreads = 1; }},
+        {"all_on", [](Cfg& c) {
+             c.includeRadioMetrics = true;
+             c.includeBufferMetrics = true;
+             c.includeSchedulerMetrics = true;
+         }},
+        {"no_positions", [](Cfg& c) { c.includePositions = false; }},
+        {"no_velocities", [](Cfg& c) { c.includeVelocities = false; }},
+        {"no_attachments", [](Cfg& c) { c.includeAttachments = false; }},
+        {"no_traffic", [](Cfg& c) { c.includeTrafficStats = false; }},
+        {"no_handovers", [](Cfg& c) { c.includeHandovers = false; }},
+        {"no_event_log", [](Cfg& c) { c.includeEventLog = false; }},
+        {"no_history", [](Cfg& c) { c.maxHistorySize = 0; }},
+        {"minimal", [](Cfg& c) {
+             c.includeVelocities = false;
+             c.includeAttachments = false;
+             c.includeTrafficStats = false;
+             c.includeHandovers = false;
+             c.includeEventLog = false;
+             c.maxHistorySize = 0;
+         }},
+    };
+}
+
+std::vector<std::string>
+SplitList(const std::string& csv)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(csv);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+NrOutputManager::PublishMethod
+ParseMethod(const std::string& name)
+{
+    if (name == "file")
+        return NrOutputManager::PUBLISH_FILE;
+    if (name == "udp")
+        return NrOutputManager::PUBLISH_UDP;
+    if (name == "tcp")
+        return NrOutputManager::PUBLISH_TCP;
+    if (name == "pipe")
+        return NrOutputManager::PUBLISH_PIPE;
+    NS_FATAL_ERROR("Unknown publish method '" << name << "'");
+}
+
+/**
+ * \brief Synthetic deployment: topology + bare managers + output manager
+ */
+struct Deployment
+{
+    Ptr<NrSimConfig> config;
+    Ptr<NrTopologyManager> topology;
+    Ptr<NrNetworkManager> network;
+    Ptr<NrTrafficManager> traffic;
+    Ptr<NrOutputManager> output;
+};
+
+Deployment
+Deploy(uint32_t numUes, uint32_t uesPerGnb)
+{
+    Deployment d;
+    d.config = CreateObject<NrSimConfig>();
+    d.config->topology.ueCount = numUes;
+    d.config->topology.gnbCount = std::max<uint32_t>(1, numUes / uesPerGnb);
+    d.config->topology.areaSize = 1000.0 * std::sqrt(d.config->topology.gnbCount);
+    d.config->mobility.defaultModel = "ConstantPosition";
+    d.config->simDuration = 10.0;
+
+    // Deployment chatter scales with node count; keep the report readable
+    std::streambuf* saved = std::cout.rdbuf();
+    std::ostringstream sink;
+    std::cout.rdbuf(sink.rdbuf());
+
+    d.topology = CreateObject<NrTopologyManager>();
+    d.topology->SetConfig(d.config);
+    d.topology->DeployTopology();
+
+    d.network = CreateObject<NrNetworkManager>();
+    d.network->SetConfig(d.config);
+    d.traffic = CreateObject<NrTrafficManager>();
+    d.traffic->SetConfig(d.config);
+
+    d.output = CreateObject<NrOutputManager>();
+    d.output->SetConfig(d.config);
+    d.output->SetManagers(d.topology, d.network, d.traffic, nullptr);
+    d.output->InitializeTelemetry();
+
+    std::cout.rdbuf(saved);
+    return d;
+}
+
+} // namespace
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int
+main(int argc, char* argv[])
+{
+    std::string uesArg = "10,100,1000,10000";
+    std::string methodsArg = "file,udp,tcp,pipe";
+    uint32_t uesPerGnb = 50;
+    uint32_t ticks = 10;
+    double budgetMs = 0.0;
+    std::string outputPath = "nr-telemetry-benchmark.json";
+    std::string publishFile = "/tmp/nr-telemetry-benchmark-state.json";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("ues", "Comma-separated UE counts (10 - 50000)", uesArg);
+    cmd.AddValue("methods", "Comma-separated publish methods: file,udp,tcp,pipe", methodsArg);
+    cmd.AddValue("uesPerGnb", "UEs per gNB when sizing the deployment", uesPerGnb);
+    cmd.AddValue("ticks", "Publications per measurement", ticks);
+    cmd.AddValue("budgetMs", "Also run a budgeted pass with this per-tick budget (0 = skip)",
+                 budgetMs);
+    cmd.AddValue("output", "JSON results file", outputPath);
+    cmd.AddValue("publishFile", "Target file for the FILE/PIPE methods", publishFile);
+    cmd.Parse(argc, argv);
+
+    std::vector<Preset> presets = BuildPresets();
+    std::vector<std::string> methods = SplitList(methodsArg);
+
+    std::cout << "\n╔═══════════════════════════════════════════════════╗\n";
+    std::cout << "║       NR TELEMETRY OVERHEAD BENCHMARK             ║\n";
+    std::cout << "╚═══════════════════════════════════════════════════╝\n";
+
+    json results = json::array();
+    json budgetRuns = json::array();
+
+    for (const auto& ueStr : SplitList(uesArg))
+    {
+        uint32_t numUes = static_cast<uint32_t>(std::stoul(ueStr));
+        Deployment d = Deploy(numUes, uesPerGnb);
+
+        std::cout << "\n" << numUes << " UEs, " << d.config->topology.gnbCount << " gNBs\n";
+        std::cout << "  " << std::left << std::setw(16) << "preset" << std::setw(6) << "method"
+                  << std::right << std::setw(12) << "collect ms" << std::setw(12) << "encode ms"
+                  << std::setw(12) << "send ms" << std::setw(12) << "JSON KiB"
+                  << std::setw(8) << "fails" << "\n";
+
+        for (const auto& preset : presets)
+        {
+            NrOutputManager::TelemetryConfig cfg;
+            preset.apply(cfg);
+            d.output->SetTelemetryConfig(cfg);
+
+            // Encoded size does not depend on the publish method
+            size_t jsonBytes = d.output->StateToJson(d.output->CollectCurrentState()).size();
+
+            for (const auto& methodName : methods)
+            {
+                d.output->ConfigurePublishing(ParseMethod(methodName), "127.0.0.1", 5599,
+                                              publishFile);
+
+                NrOutputManager::TelemetryCost before = d.output->GetTelemetryCost();
+                uint64_t failsBefore = d.output->GetFailedPublishCount();
+
+                for (uint32_t t = 0; t < ticks; ++t)
+                {
+                    d.output->PublishStateNow("benchmark");
+                }
+
+                NrOutputManager::TelemetryCost after = d.output->GetTelemetryCost();
+                uint64_t n = std::max<uint64_t>(1, after.ticks - before.ticks);
+                double collectMs = (after.totalCollectMs - before.totalCollectMs) / n;
+                double encodeMs = (after.totalEncodeMs - before.totalEncodeMs) / n;
+                double sendMs = (after.totalSendMs - before.totalSendMs) / n;
+                uint64_t fails = d.output->GetFailedPublishCount() - failsBefore;
+
+                std::cout << "  " << std::left << std::setw(16) << preset.name << std::setw(6)
+                          << methodName << std::right << std::fixed << std::setprecision(3)
+                          << std::setw(12) << collectMs << std::setw(12) << encodeMs
+                          << std::setw(12) << sendMs << std::setprecision(1) << std::setw(12)
+                          << jsonBytes / 1024.0 << std::setw(8) << fails << "\n";
+                std::cout.unsetf(std::ios::floatfield);
+
+                json r;
+                r["ues"] = numUes;
+                r["gnbs"] = d.config->topology.gnbCount;
+                r["preset"] = preset.name;
+                r["method"] = methodName;
+                r["ticks"] = after.ticks - before.ticks;
+                r["collect_ms"] = collectMs;
+                r["encode_ms"] = encodeMs;
+                r["send_ms"] = sendMs;
+                r["tick_ms"] = collectMs + encodeMs + sendMs;
+                r["json_bytes"] = jsonBytes;
+                r["failed_publishes"] = fails;
+                results.push_back(r);
+            }
+        }
+
+        // ----- Budgeted pass: everything on, let the budget shed fields -----
+        if (budgetMs > 0.0)
+        {
+            NrOutputManager::TelemetryConfig cfg;
+            cfg.includeRadioMetrics = true;
+            cfg.includeBufferMetrics = true;
+            cfg.includeSchedulerMetrics = true;
+            cfg.tickBudgetMs = budgetMs;
+            cfg.budgetGraceTicks = 1;
+            d.output->SetTelemetryConfig(cfg);
+            d.output->ConfigurePublishing(NrOutputManager::PUBLISH_FILE, "127.0.0.1", 5599,
+                                          publishFile);
+
+            NrOutputManager::TelemetryCost before = d.output->GetTelemetryCost();
+            for (uint32_t t = 0; t < ticks * 2; ++t)
+            {
+                d.output->PublishStateNow("budget");
+            }
+            NrOutputManager::TelemetryCost after = d.output->GetTelemetryCost();
+
+            std::vector<std::string> disabled(after.disabledFields.begin() +
+                                                  before.disabledFields.size(),
+                                              after.disabledFields.end());
+
+            std::cout << "  budget " << budgetMs << " ms: last tick "
+                      << after.lastCollectMs + after.lastEncodeMs + after.lastSendMs
+                      << " ms, disabled [";
+            for (size_t i = 0; i < disabled.size(); ++i)
+            {
+                std::cout << (i ? ", " : "") << disabled[i];
+            }
+            std::cout << "]\n";
+
+            json b;
+            b["ues"] = numUes;
+            b["budget_ms"] = budgetMs;
+            b["over_budget_ticks"] = after.overBudgetTicks - before.overBudgetTicks;
+            b["disabled_fields"] = disabled;
+            b["final_tick_ms"] = after.lastCollectMs + after.lastEncodeMs + after.lastSendMs;
+            budgetRuns.push_back(b);
+        }
+
+        d.output->Dispose();
+        Simulator::Destroy();
+    }
+
+    json out;
+    out["benchmark"] = "nr-telemetry-overhead";
+    out["schema_version"] = 1;
+    out["ticks_per_measurement"] = ticks;
+    out["results"] = results;
+    out["budget_runs"] = budgetRuns;
+
+    std::ofstream file(outputPath);
+    if (!file.is_open())
+    {
+        std::cerr << "✗ Failed to open " << outputPath << std::endl;
+        return 1;
+    }
+    file << out.dump(2) << std::endl;
+    std::cout << "\n✓ Results written to " << outputPath << std::endl;
+    return 0;
+}